@@ -16,6 +16,7 @@
 
 #include <utils/cli/cli_args.h>
 #include <utils/headless/headless_runner.h>
+#include <utils/lua/profile_events.h>
 #include <utils/mcp/mcp_runner.h>
 #include <frasy_interpreter.h>
 
@@ -37,6 +38,7 @@ int main(int argc, char** argv)
             Brigerad::_internalDoNotUse::initExceptionHandling();
             Brigerad::Log::Init(cliArgs.headless || cliArgs.mcpServer,
                                (cliArgs.headless || cliArgs.mcpServer) && !cliArgs.verbose);
+            if (!cliArgs.tracePath.empty()) { Frasy::Profiler::get().startTrace(cliArgs.tracePath); }
 
             BR_PROFILE_END_SESSION();
             auto app = Brigerad::CreateApplication(argc, argv);
@@ -70,6 +72,7 @@ int main(int argc, char** argv)
             BR_PROFILE_BEGIN_SESSION("Shutdown", "BrigeradProfile-Shutdown.json");
             delete app;
             BR_PROFILE_END_SESSION();
+            Frasy::Profiler::get().stopTrace();
         }
     BR_END_GUARDED_SCOPE
 
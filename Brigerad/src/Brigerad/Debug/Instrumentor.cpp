@@ -0,0 +1,150 @@
+/**
+ * @file    Instrumentor.cpp
+ * @author  Sam Martel
+ * @date    2026-10-16
+ * @brief   Background writer of the instrumentation sessions.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <https://www.gnu.org/licenses/>.
+ */
+#include "Instrumentor.h"
+
+#include <bit>
+#include <format>
+#include <iterator>
+
+namespace Brigerad {
+ProfileResultQueue::ProfileResultQueue(std::size_t capacity)
+: m_slots(std::make_unique<Slot[]>(std::bit_ceil(capacity))), m_mask(std::bit_ceil(capacity) - 1)
+{
+    for (std::size_t i = 0; i <= m_mask; ++i) {
+        m_slots[i].Sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool ProfileResultQueue::Push(const ProfileResult& result)
+{
+    std::size_t position = m_pushPosition.load(std::memory_order_relaxed);
+    Slot*       slot     = nullptr;
+    for (;;) {
+        slot                  = &m_slots[position & m_mask];
+        const auto sequence   = slot->Sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+        if (difference == 0) {
+            // The slot is free, claim it.
+            if (m_pushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) { break; }
+        }
+        else if (difference < 0) {
+            // The slot still holds the result of the previous lap, the queue is full.
+            return false;
+        }
+        else {
+            position = m_pushPosition.load(std::memory_order_relaxed);
+        }
+    }
+    slot->Result = result;
+    slot->Sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+bool ProfileResultQueue::Pop(ProfileResult& result)
+{
+    Slot& slot = m_slots[m_popPosition & m_mask];
+    if (slot.Sequence.load(std::memory_order_acquire) != m_popPosition + 1) { return false; }
+    result = slot.Result;
+    slot.Sequence.store(m_popPosition + m_mask + 1, std::memory_order_release);
+    ++m_popPosition;
+    return true;
+}
+
+Instrumentor::Instrumentor() = default;
+
+Instrumentor::~Instrumentor()
+{
+    if (m_currentSession != nullptr) { EndSession(); }
+}
+
+void Instrumentor::BeginSession(const std::string& name, const std::string& filepath, long long duration)
+{
+    std::lock_guard lock {m_sessionLock};
+    if (m_currentSession != nullptr) { return; }
+
+    // Results queued after the end of the previous session belong to none.
+    for (ProfileResult result; m_queue.Pop(result);) {}
+
+    m_outputStream.open(filepath);
+    m_outputStream << R"({"traceEvents":[)";
+    m_currentSession = std::make_unique<InstrumentationSession>(name, duration);
+    m_profileCount   = 0;
+    m_dropped.store(0, std::memory_order_relaxed);
+    m_active.store(true, std::memory_order_release);
+    m_writer = std::jthread([this](std::stop_token stop) { Run(std::move(stop)); });
+}
+
+void Instrumentor::EndSession()
+{
+    std::lock_guard lock {m_sessionLock};
+    if (m_currentSession == nullptr) { return; }
+
+    m_active.store(false, std::memory_order_release);
+    m_writer.request_stop();
+    m_writer.join();
+    Write();
+    m_outputStream << std::format(R"(],"otherData":{{"droppedEvents":{}}}}})",
+                                  m_dropped.load(std::memory_order_relaxed));
+    m_outputStream.close();
+    m_currentSession.reset();
+}
+
+void Instrumentor::WriteProfile(const ProfileResult& result)
+{
+    if (TraceSink sink = m_traceSink.load(std::memory_order_acquire); sink != nullptr) { sink(result); }
+    if (!m_active.load(std::memory_order_acquire)) { return; }
+    if (!m_queue.Push(result)) { m_dropped.fetch_add(1, std::memory_order_relaxed); }
+}
+
+void Instrumentor::Run(std::stop_token stop)
+{
+    while (!stop.stop_requested()) {
+        {
+            std::unique_lock lock {m_wakeLock};
+            m_wakeUp.wait_for(lock, stop, s_writePeriod, [] { return false; });
+        }
+        Write();
+    }
+}
+
+void Instrumentor::Write()
+{
+    const long long endPoint =
+      std::chrono::time_point_cast<std::chrono::microseconds>(m_currentSession->EndPoint).time_since_epoch().count();
+
+    m_buffer.clear();
+    for (ProfileResult result; m_queue.Pop(result);) {
+        // Past the duration of the session, the results are not recorded anymore.
+        if (result.End >= endPoint) { continue; }
+
+        if (m_profileCount++ > 0) { m_buffer += ','; }
+        std::format_to(std::back_inserter(m_buffer),
+                       R"({{"cat":"function","dur":{},"name":")",
+                       result.End - result.Start);
+        for (const char* c = result.Name; *c != '\0'; ++c) {
+            m_buffer += *c == '"' ? '\'' : *c;
+        }
+        std::format_to(std::back_inserter(m_buffer),
+                       R"(","ph":"X","pid":0,"tid":{},"ts":{}}})",
+                       result.ThreadID,
+                       result.Start);
+    }
+    if (m_buffer.empty()) { return; }
+    m_outputStream.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+    m_outputStream.flush();
+}
+}    // namespace Brigerad
@@ -24,18 +24,22 @@
 #pragma once
 #include "Brigerad/Core/Core.h"
 
-#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <fstream>
+#include <memory>
+#include <mutex>
 #include <string>
-
 #include <thread>
 
 namespace Brigerad {
 struct ProfileResult {
-    std::string Name;
-    long long   Start, End;
-    uint32_t    ThreadID;
+    const char* Name = nullptr;    //! Must live as long as the program, like the literals of the profile macros.
+    long long   Start = 0, End = 0;
+    uint32_t    ThreadID = 0;
 };
 
 struct InstrumentationSession {
@@ -49,73 +53,84 @@ struct InstrumentationSession {
     }
 };
 
-class Instrumentor {
-private:
-    InstrumentationSession* m_currentSession;
-    std::ofstream           m_outputStream;
-    int                     m_profileCount;
-
+/**
+ * Bounded lock-free queue of profile results, pushed by any thread and popped by the writer of the session.
+ */
+class ProfileResultQueue {
 public:
-    Instrumentor() : m_currentSession(nullptr), m_profileCount(0) {}
+    explicit ProfileResultQueue(std::size_t capacity);
 
-    void BeginSession(const std::string& name, const std::string& filepath = "results.json", [[maybe_unused]] long long duration = 0)
-    {
-        m_outputStream.open(filepath);
-        WriteHeader();
-        m_currentSession = new InstrumentationSession {name};
-    }
-
-    void EndSession()
-    {
-        WriteFooter();
-        m_outputStream.close();
-        delete m_currentSession;
-        m_currentSession = nullptr;
-        m_profileCount   = 0;
-    }
+    //! @return false if the queue is full.
+    bool Push(const ProfileResult& result);
+    //! Must only be called by one thread at a time.
+    bool Pop(ProfileResult& result);
 
-    void WriteProfile(const ProfileResult& result)
-    {
-        if (m_currentSession == nullptr) { return; }
+private:
+    struct Slot {
+        std::atomic_size_t Sequence;
+        ProfileResult      Result;
+    };
+
+    std::unique_ptr<Slot[]> m_slots;
+    std::size_t             m_mask;
+    alignas(64) std::atomic_size_t m_pushPosition = 0;
+    alignas(64) std::size_t m_popPosition         = 0;
+};
 
-        if (m_profileCount++ > 0) { m_outputStream << ","; }
+/**
+ * Writes the profile results of a session to a file, in the trace event format.
+ *
+ * WriteProfile only queues the result, a thread of the session formats them and writes them by batches every
+ * s_writePeriod. When the queue is full, the results are dropped and counted in the file's "otherData".
+ */
+class Instrumentor {
+public:
+    //! Receives every profile result, with or without a session, from the thread that measured it.
+    using TraceSink = void (*)(const ProfileResult&);
 
-        std::string name = result.Name;
-        std::replace(name.begin(), name.end(), '"', '\'');
+    static constexpr std::size_t               s_queueCapacity = 64 * 1024;
+    static constexpr std::chrono::milliseconds s_writePeriod {20};
 
-        m_outputStream << '{' << R"("cat":"function",)"
-                       << R"("dur":)" << (result.End - result.Start) << ',' << R"("name":")" << name << R"(",)"
-                       << R"("ph":"X",)"
-                       << R"("pid":0,)"
-                       << R"("tid":)" << result.ThreadID << ',' << R"("ts":)" << result.Start << '}';
+    Instrumentor();
+    ~Instrumentor();
+    Instrumentor(const Instrumentor&)            = delete;
+    Instrumentor& operator=(const Instrumentor&) = delete;
 
-        m_outputStream.flush();
+    void BeginSession(const std::string& name, const std::string& filepath = "results.json", long long duration = 0);
+    void EndSession();
 
-        if (result.End >= std::chrono::time_point_cast<std::chrono::microseconds>(m_currentSession->EndPoint)
-                            .time_since_epoch()
-                            .count()) {
-            EndSession();
-            return;
-        }
-    }
+    void SetTraceSink(TraceSink sink) { m_traceSink.store(sink, std::memory_order_release); }
 
-    void WriteHeader()
-    {
-        m_outputStream << R"({"otherData": {}, "traceEvents":[)";
-        m_outputStream.flush();
-    }
+    //! Safe to call from any thread.
+    void WriteProfile(const ProfileResult& result);
 
-    void WriteFooter()
-    {
-        m_outputStream << "]}";
-        m_outputStream.flush();
-    }
+    //! Results of the current (or last) session that were dropped because the writer couldn't keep up.
+    std::size_t DroppedResults() const { return m_dropped.load(std::memory_order_relaxed); }
 
     static Instrumentor& Get()
     {
         static Instrumentor instance;
         return instance;
     }
+
+private:
+    void Run(std::stop_token stop);
+    //! Format and write every queued result.
+    void Write();
+
+    std::mutex                              m_sessionLock;
+    std::unique_ptr<InstrumentationSession> m_currentSession;
+    std::ofstream                           m_outputStream;
+    std::string                             m_buffer;
+    std::size_t                             m_profileCount = 0;
+    std::mutex                              m_wakeLock;
+    std::condition_variable_any             m_wakeUp;
+    std::jthread                            m_writer;
+
+    ProfileResultQueue     m_queue {s_queueCapacity};
+    std::atomic_bool       m_active  = false;
+    std::atomic_size_t     m_dropped = 0;
+    std::atomic<TraceSink> m_traceSink = nullptr;
 };
 
 
@@ -151,7 +166,7 @@ private:
 private:
     std::chrono::time_point<std::chrono::high_resolution_clock> GetTime()
     {
-        static auto lastTime = std::chrono::high_resolution_clock::now();
+        thread_local auto lastTime = std::chrono::high_resolution_clock::now();
         auto        time     = std::chrono::high_resolution_clock::now();
 
         if (time == lastTime) { time += std::chrono::microseconds(1); }
@@ -8,5 +8,14 @@ CanOpen.objectDictionary = require("lua.core.can_open.object_dictionary")
 
 -- C++ functions
 -- see orchestrator.cpp
-CanOpen.__upload = function(nodeId, ode) error("Not loaded") end
-CanOpen.__download = function(nodeId, ode, value) error("Not loaded") end
+-- options.block = true/false forces a block or a segmented transfer, strings and domains use block transfers otherwise.
+CanOpen.__upload = function(nodeId, ode, options) error("Not loaded") end
+CanOpen.__download = function(nodeId, ode, value, options) error("Not loaded") end
+-- Batches of {nodeId, ode, value (download only), options}, possibly on several nodes, queued all at once.
+CanOpen.__uploadMany = function(requests) error("Not loaded") end
+CanOpen.__downloadMany = function(requests) error("Not loaded") end
+-- Queues the frames of a TPDO (1 to 4) of the node from now on, returns the listener.
+CanOpen.__pdoListen = function(nodeId, tpdo) error("Not loaded") end
+-- Next frame of a listener decoded as the odes mapped in it, in order. nil after timeoutMs without one.
+CanOpen.__pdoWait = function(listener, odes, timeoutMs) error("Not loaded") end
+CanOpen.__pdoStop = function(listener) error("Not loaded") end
@@ -137,7 +137,44 @@ local function ParseObjectDictionary(ini)
     return od
 end
 
+local function ParseHex(str)
+    return tonumber((string.gsub(str, "^0[xX]", "")), 16)
+end
+
+--- Entries of the object dictionaries by (index << 8 | subIndex), made on first use.
+local lookups = setmetatable({}, { __mode = "k" })
+
+local function AddToLookup(lookup, entry)
+    if entry.subIndex ~= nil then
+        lookup[(ParseHex(entry.index) << 8) | ParseHex(entry.subIndex)] = entry
+    elseif entry.data ~= nil then
+        for _, subEntry in pairs(entry.data) do AddToLookup(lookup, subEntry) end
+    else
+        for _, subEntry in pairs(entry) do
+            if type(subEntry) == "table" and subEntry.__kind == "Object Dictionary Entry" then
+                AddToLookup(lookup, subEntry)
+            end
+        end
+    end
+end
+
+--- Finds the var entry at an index and sub-index of a parsed object dictionary.
+--- @param od table
+--- @param index integer
+--- @param subIndex integer
+--- @return OdEntry?
+local function Find(od, index, subIndex)
+    local lookup = lookups[od]
+    if lookup == nil then
+        lookup = {}
+        for _, entry in pairs(od) do AddToLookup(lookup, entry) end
+        lookups[od] = lookup
+    end
+    return lookup[(index << 8) | subIndex]
+end
+
 return {
+    Find = Find,
     Parse = function(str)
         local ini = IniParser.Parse(str)
         return ParseObjectDictionary(ini)
@@ -861,14 +861,16 @@ end
 --- @return DAQ_AdcChannelResults
 function DAQ:AdcChannelResults(channel)
     CheckAdcChannel(channel)
-    local odMin = self:GetAdcChannelOb(channel, "Min")
-    local odMax = self:GetAdcChannelOb(channel, "Max")
-    local odAvg = self:GetAdcChannelOb(channel, "Average")
+    local values = self.ib:UploadMany({
+        self:GetAdcChannelOb(channel, "Min"),
+        self:GetAdcChannelOb(channel, "Max"),
+        self:GetAdcChannelOb(channel, "Average"),
+    })
 
     return {
-        min = self.ib:Upload(odMin) --[[@as number]],
-        max = self.ib:Upload(odMax) --[[@as number]],
-        average = self.ib:Upload(odAvg) --[[@as number]]
+        min = values[1] --[[@as number]],
+        max = values[2] --[[@as number]],
+        average = values[3] --[[@as number]]
     }
 end
 
@@ -915,8 +917,20 @@ end
 --- @return [AdcComplexCalibration, AdcMoreComplexCalibration, {gain: number, offset: number}]
 function DAQ:AdcCalibration()
     local od = self.ib.od["ADC Calibration"]
+    local names = {
+        "Channel 1 Gain 100R", "Channel 1 Gain 4k99", "Channel 1 Gain 100k", "Channel 1 Gain 1M",
+        "Channel 1 Offset 100R", "Channel 1 Offset 4k99", "Channel 1 Offset 100k", "Channel 1 Offset 1M",
+        "Channel 2 Gain", "Channel 2 Gain 100R", "Channel 2 Gain 4k99", "Channel 2 Gain 100k", "Channel 2 Gain 1M",
+        "Channel 2 Offset", "Channel 2 Offset 100R", "Channel 2 Offset 4k99", "Channel 2 Offset 100k",
+        "Channel 2 Offset 1M", "Channel 3 Gain", "Channel 3 Offset",
+    }
+    local odes = {}
+    for i, name in ipairs(names) do odes[i] = assert(od[name], "Missing ADC calibration entry: " .. name) end
+    -- All the entries are queued at once, then picked back by entry to fill the table.
+    local uploaded = {}
+    for i, value in ipairs(self.ib:UploadMany(odes)) do uploaded[odes[i]] = value end
     --- @return number
-    local function f(od) return self.ib:Upload(od) --[[@as number]] end
+    local function f(ode) return uploaded[ode] --[[@as number]] end
     return {
         [1] = {
             gain = {
@@ -1144,6 +1158,77 @@ DAQ.MeasureVoltageDefault = {
 --- @field sampleRate DAQ_AdcSampleRateEnum? ADC sampling rate
 --- @field debugPopup boolean|string? if present, will display a popup when routage is active. String value allows custom text
 
+--- Fields of a channel holding the results of an acquisition, which the firmware can push in TPDOs once it's done.
+DAQ.AdcResultFields = { "Min", "Max", "Average" }
+
+--- Starts listening to the TPDOs carrying the results of an acquisition on a channel.
+--- The TPDOs are found and decoded from the mapping parameters of the EDS. They are only used if, together, they map
+--- every result of the channel and nothing else, the results are polled otherwise.
+--- @param channel DAQ_AdcChannelEnum
+--- @return {fields: string[], listener: PdoListener}[]? listeners nil if the board doesn't send its results in TPDOs.
+function DAQ:ListenAdcResults(channel)
+    local fieldOf = {}
+    for _, field in ipairs(DAQ.AdcResultFields) do
+        local ode = self:GetAdcChannelOb(channel, field)
+        if ode == nil then return nil end
+        fieldOf[ode] = string.lower(field)
+    end
+
+    local pdos = {}
+    local mapped = {}
+    local mappedCount = 0
+    for tpdo = 1, 4 do
+        local mapping = self.ib:TpdoMapping(tpdo)
+        if mapping ~= nil and #mapping ~= 0 and fieldOf[mapping[1]] ~= nil then
+            local fields = {}
+            for i, ode in ipairs(mapping) do
+                local field = fieldOf[ode]
+                -- Mixed with other values, or a result mapped twice.
+                if field == nil or mapped[field] then return nil end
+                mapped[field] = true
+                mappedCount = mappedCount + 1
+                fields[i] = field
+            end
+            pdos[#pdos + 1] = { tpdo = tpdo, mapping = mapping, fields = fields }
+        end
+    end
+    if mappedCount ~= #DAQ.AdcResultFields then return nil end
+
+    local listeners = {}
+    for i, pdo in ipairs(pdos) do
+        listeners[i] = { fields = pdo.fields, listener = self.ib:ListenPdo(pdo.tpdo, pdo.mapping) }
+    end
+    return listeners
+end
+
+--- Waits for the results of an acquisition pushed in the TPDOs of listeners, then stops every listener.
+--- @param listeners {fields: string[], listener: PdoListener}[] from DAQ:ListenAdcResults
+--- @param timeoutMs integer
+--- @return DAQ_AdcChannelResults? results nil if a TPDO didn't come in time.
+function DAQ:WaitAdcResults(listeners, timeoutMs)
+    local results = {}
+    for _, pdo in ipairs(listeners) do
+        local values = results ~= nil and pdo.listener:Wait(timeoutMs) or nil
+        pdo.listener:Stop()
+        if values == nil then
+            results = nil
+        else
+            for i, field in ipairs(pdo.fields) do results[field] = values[i] end
+        end
+    end
+    return results --[[@as DAQ_AdcChannelResults?]]
+end
+
+--- Frequency of a sample rate, in Hz.
+--- @param sampleRate DAQ_AdcSampleRateEnum
+--- @return integer
+local function SampleRateToHz(sampleRate)
+    for name, value in pairs(DAQ.AdcSampleRateEnum) do
+        if value == sampleRate then return tonumber(string.match(name, "^f(%d+)Hz$")) --[[@as integer]] end
+    end
+    error("Invalid sample rate: " .. ToString(sampleRate))
+end
+
 --- Measures a voltage on one or more points.
 --- @param points DAQ_RoutingPointsEnum[]|DAQ_RoutingPointsEnum place where to measure voltage
 --- @param opt DAQ_MeasureVoltageOptParameters?
@@ -1173,7 +1258,18 @@ function DAQ:MeasureVoltage(points, opt)
 
     self:AdcChannelGain(opt.channel, opt.gain)
     self:AdcSampleRate(opt.sampleRate)
+
+    -- A board pushing its results is listened to before the acquisition starts, so they can't be missed. Waiting for
+    -- them replaces polling the samples left to take, and uploading the results.
+    local pdos = self:ListenAdcResults(opt.channel)
     self:AdcSamplesToTake(opt.samplesToTake)
+    if pdos ~= nil then
+        local timeoutMs = 1000 + math.ceil(opt.samplesToTake * 1000 / SampleRateToHz(opt.sampleRate))
+        local results = self:WaitAdcResults(pdos, timeoutMs)
+        self:ClearBus(route)
+        if results == nil then error("ADC acquisition timeout") end
+        return results
+    end
 
     while opt.samplesToTake ~= 0 do
         local previous = opt.samplesToTake
@@ -19,6 +19,7 @@ local ScopeRequirement = require("lua/core/framework/scope_requirement/module")
 local OrderRequirement = require("lua/core/framework/order_requirement")
 local SyncRequirement = require("lua/core/framework/sync_requirement")
 local Sort = require("lua/core/framework/sort_utils")
+local TestScheduler = require("lua/core/framework/test_scheduler")
 local Json = require("lua/core/vendor/json")
 
 ---@class Orchestrator
@@ -31,7 +32,8 @@ if Context.orchestrator == nil then
         solution = {},
         values = {},
         order_requirements = {},
-        sync_requirements = {}
+        sync_requirements = {},
+        parallel_tests = false
     }
 end
 
@@ -62,6 +64,24 @@ local function IsScopeEnabled(scope)
     end
 end
 
+-- Teammates sync on every test, they must all run the tests of a stage in the same order.
+local function CanRunConcurrently(tStage)
+    return Context.orchestrator.parallel_tests == true and #tStage > 1 and not Team.HasTeam()
+end
+
+local function RunTestsConcurrently(sequence, tStage)
+    local tasks = {}
+    for _, test in ipairs(tStage) do
+        local scope = Scope:New(sequence, test)
+        table.insert(tasks, {
+            resources = Context.orchestrator.sequences[sequence].tests[test].resources,
+            enter = function() Context.orchestrator.scope = scope end,
+            run = function() Orchestrator.RunTest(scope, true) end,
+        })
+    end
+    TestScheduler.Run(tasks, __now)
+end
+
 function Orchestrator.RunSequence(sIndex, scope)
     local sequence = Context.orchestrator.sequences[scope.sequence]
     Context.orchestrator.scope = scope
@@ -111,8 +131,12 @@ function Orchestrator.RunSequence(sIndex, scope)
             for _, sq in ipairs(sqStage) do
                 if (sq.name == scope.sequence) then
                     for _, tStage in ipairs(sq.tests) do
-                        for _, test in ipairs(tStage) do
-                            Orchestrator.RunTest(Scope:New(scope.sequence, test))
+                        if CanRunConcurrently(tStage) then
+                            RunTestsConcurrently(scope.sequence, tStage)
+                        else
+                            for _, test in ipairs(tStage) do
+                                Orchestrator.RunTest(Scope:New(scope.sequence, test))
+                            end
                         end
                     end
                 end
@@ -149,7 +173,9 @@ function Orchestrator.RunSequence(sIndex, scope)
     __profileEndEvent(scope.sequence, sequence.source, sequence.line)
 end
 
-function Orchestrator.RunTest(scope)
+--- @param scope Scope
+--- @param concurrent boolean? true when run by the TestScheduler, alongside other tests of the stage
+function Orchestrator.RunTest(scope, concurrent)
     local test = Context.orchestrator.sequences[scope.sequence].tests[scope.test]
     test.result.enabled = IsScopeEnabled(scope)
     Context.orchestrator.values[scope.sequence][scope.test] = {}
@@ -166,7 +192,7 @@ function Orchestrator.RunTest(scope)
         test.result.time.process = test.result.time.stop - test.result.time.start
     end
 
-    __profileStartEvent(scope.test, test.source, test.line)
+    if not concurrent then __profileStartEvent(scope.test, test.source, test.line) end
     if test.result.enabled then
         local status, err = xpcall(test.func, ErrorHandler)
         if not status then
@@ -208,7 +234,7 @@ function Orchestrator.RunTest(scope)
         test.result.skipped = true
         test.result.reason = "Disabled"
     end
-    __profileEndEvent(scope.test, test.source, test.line)
+    if not concurrent then __profileEndEvent(scope.test, test.source, test.line) end
     reportEnd()
     Team.Sync(test.result)
     if test.result.skipped then
@@ -491,6 +517,11 @@ function Orchestrator.LoadSolution(path)
     Context.orchestrator.solution = Json.decode(file:read("*all"))
 end
 
+--- Use a solution built by the C++ side, saving the round-trip through a JSON file.
+function Orchestrator.SetSolution(solution)
+    Context.orchestrator.solution = solution
+end
+
 function Orchestrator.CreateSequence(name, func, source, line)
     if Orchestrator.IsInSequence() then
         error(NestedScope())
@@ -502,14 +533,14 @@ function Orchestrator.CreateSequence(name, func, source, line)
     Context.orchestrator.values[name] = {}
 end
 
-function Orchestrator.CreateTest(name, func, source, line)
+function Orchestrator.CreateTest(name, func, source, line, resources)
     if not Orchestrator.IsInSequence() then
         error(BadScope())
     end
     if Orchestrator.IsInTest() then
         error(NestedScope())
     end
-    Context.orchestrator.sequences[Context.orchestrator.scope.sequence].tests[name] = Test:New(func, name, source, line)
+    Context.orchestrator.sequences[Context.orchestrator.scope.sequence].tests[name] = Test:New(func, name, source, line, resources)
     Context.orchestrator.values[Context.orchestrator.scope.sequence][name] = {}
 end
 
@@ -15,15 +15,27 @@
 local ScopeResult = require("lua/core/framework/scope_result")
 
 ---@class Test
-local Test = { result = {}, expectations = {}, func = nil }
+local Test = { result = {}, expectations = {}, func = nil, resources = nil }
 
-function Test:New(func, name, source, line)
+--- Resources are kept as a set, nil meaning that the test might use any resource.
+local function ToResourceSet(resources)
+    if resources == nil then return nil end
+    if type(resources) ~= "table" then resources = { resources } end
+    local set = {}
+    for _, resource in ipairs(resources) do
+        set[tostring(resource)] = true
+    end
+    return set
+end
+
+function Test:New(func, name, source, line, resources)
     return setmetatable({
         result = ScopeResult:New(),
         expectations = {},
         source = source,
         line = line,
         func = func,
+        resources = ToResourceSet(resources),
     }, Test)
 end
 
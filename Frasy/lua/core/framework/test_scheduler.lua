@@ -0,0 +1,131 @@
+--- @file    test_scheduler.lua
+--- @author  Frasy
+--- @date    2026-10-16
+--- @brief   Cooperative scheduler for the tests of a stage that use disjoint resources.
+---
+--- @copyright
+--- This program is free software: you can redistribute it and/or modify it under the
+--- terms of the GNU General Public License as published by the Free Software Foundation, either
+--- version 3 of the License, or (at your option) any later version.
+--- This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+--- even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+--- General Public License for more details.
+--- You should have received a copy of the GNU General Public License along with this program. If
+--- not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+
+---@class TestSchedulerTask
+---@field resources table<string, boolean>? Resources used by the task, nil when it may use any of them
+---@field run fun() Body of the task
+---@field enter fun()? Called every time the task is resumed, to restore its context
+
+local TestScheduler = {}
+
+local function Conflicts(a, b)
+    if a == nil or b == nil then return true end
+    for resource, _ in pairs(a) do
+        if b[resource] then return true end
+    end
+    return false
+end
+
+--- Run tasks as coroutines of the calling state, interleaving the ones that don't share any resource.
+---
+--- Tasks are started in order, as soon as none of the tasks in progress use one of their resources.
+--- While the tasks run, SleepFor yields to the other tasks instead of blocking the thread.
+--- When the caller can't yield, SleepFor blocks as usual. This happens within Exclusive and Once, whose locks are
+--- held by C++ code, so a lock is never held by a suspended task.
+--- Once a task raises an error, no other task is started. The tasks in progress run to completion, then the first
+--- error is raised again.
+--- @param tasks TestSchedulerTask[]
+--- @param now fun(): number Monotonic clock, in milliseconds
+function TestScheduler.Run(tasks, now)
+    local pending  = table.move(tasks, 1, #tasks, 1, {})
+    local running  = {}
+    local owned    = {}
+    local failure  = nil
+
+    local blockingSleep = SleepFor
+    SleepFor = function(ms)
+        if owned[coroutine.running()] == nil or not coroutine.isyieldable() then
+            return blockingSleep(ms)
+        end
+        coroutine.yield(now() + ms)
+    end
+
+    local function CanStart(task)
+        for _, entry in ipairs(running) do
+            if Conflicts(task.resources, entry.task.resources) then return false end
+        end
+        return true
+    end
+
+    local function Start(task)
+        local co = coroutine.create(task.run)
+        -- The call profiler follows a single call stack per thread, interleaved tasks would corrupt it.
+        debug.sethook(co)
+        local entry = { task = task, co = co, wake = 0 }
+        owned[co] = entry
+        table.insert(running, entry)
+    end
+
+    --- @return boolean done true once the task has returned or raised
+    local function Resume(entry)
+        if entry.task.enter ~= nil then entry.task.enter() end
+        local status, result = coroutine.resume(entry.co)
+        if not status then
+            if failure == nil then failure = { err = result } end
+            return true
+        end
+        if coroutine.status(entry.co) == "dead" then return true end
+        entry.wake = result
+        return false
+    end
+
+    local status, err = pcall(function()
+        while #pending ~= 0 or #running ~= 0 do
+            if failure ~= nil then
+                pending = {}
+            else
+                local i = 1
+                while i <= #pending do
+                    if CanStart(pending[i]) then
+                        Start(table.remove(pending, i))
+                    else
+                        i = i + 1
+                    end
+                end
+            end
+
+            local time     = now()
+            local resumed  = false
+            local earliest = nil
+            local i        = 1
+            while i <= #running do
+                local entry = running[i]
+                if entry.wake <= time then
+                    resumed = true
+                    if Resume(entry) then
+                        owned[entry.co] = nil
+                        table.remove(running, i)
+                    else
+                        i = i + 1
+                    end
+                else
+                    if earliest == nil or entry.wake < earliest then earliest = entry.wake end
+                    i = i + 1
+                end
+            end
+
+            -- Every task is waiting, nothing else to do until the first one wakes up.
+            if not resumed and earliest ~= nil then
+                blockingSleep(math.ceil(earliest - time))
+            end
+        end
+    end)
+    SleepFor = blockingSleep
+
+    if not status then error(err, 0) end
+    if failure ~= nil then error(failure.err, 0) end
+end
+
+return TestScheduler
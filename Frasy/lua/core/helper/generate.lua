@@ -14,5 +14,8 @@
 --- not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
 return function(output)
     local order = Orchestrator.Generate()
-    SaveAsJson(order, output)
+    if output ~= nil then
+        SaveAsJson(order, output)
+    end
+    return order
 end
\ No newline at end of file
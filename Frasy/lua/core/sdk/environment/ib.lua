@@ -1,3 +1,6 @@
+local DataType = require("lua.core.can_open.types.data_type")
+local ObjectDictionary = require("lua.core.can_open.object_dictionary")
+
 --- @class Ib
 --- @field kind integer
 --- @field nodeId integer
@@ -8,6 +11,36 @@
 local Ib = { kind = 0, nodeId = 0, eds = "", name = "", __kind = "ib", }
 Ib.__index = Ib
 
+--- Frames of a TPDO of a node, queued from the moment the listener was made.
+--- @class PdoListener
+--- @field tpdo integer
+--- @field mapping OdEntry[]
+--- @field private queue any
+local PdoListener = {}
+PdoListener.__index = PdoListener
+
+--- Takes the next frame of the TPDO, waiting for it if none came in yet.
+--- The entries of the mapping take the values of the frame.
+--- @param timeoutMs integer
+--- @return OdEntryType[]? values In the order of the mapping, nil if no frame came in time.
+function PdoListener:Wait(timeoutMs)
+    CheckField(timeoutMs, Is.Unsigned)
+    if self.queue ~= nil then
+        local values = CanOpen.__pdoWait(self.queue, self.mapping, timeoutMs)
+        if values == nil then return nil end
+        for i, ode in ipairs(self.mapping) do ode.value = values[i] end
+    end
+    local values = {}
+    for i, ode in ipairs(self.mapping) do values[i] = ode.value end
+    return values
+end
+
+--- Stops queuing the frames.
+function PdoListener:Stop()
+    if self.queue ~= nil then CanOpen.__pdoStop(self.queue) end
+    self.queue = nil
+end
+
 --- Creates a new instrumentation board.
 --- @return Ib
 function Ib:New()
@@ -21,51 +54,149 @@ end
 
 --- Upload (fetches) an entry from the node.
 --- @param ode OdEntry
+--- @param options? {block: boolean} Force a block (true) or segmented (false) transfer.
 --- @return OdEntryType
-function Ib:Upload(ode)
+function Ib:Upload(ode, options)
     assert(type(ode) == "table", "Ib upload, invalid ode")
     assert(ode.__kind == "Object Dictionary Entry",
         "Ib upload, argument is not an Object Dictionary Entry. " ..
         ode.__kind)
     if (ode.objectType == CanOpen.objectType.var) then
         if (Context.info.stage ~= Stage.execution) then return ode.value end
-        ode.value = CanOpen.__upload(self.nodeId, ode)
+        ode.value = CanOpen.__upload(self.nodeId, ode, options)
     elseif (ode.objectType == CanOpen.objectType.array) then
         -- do we need to update ode actual size here?
         -- I feel like this should be done by the user who's
         -- manipulating the entry
         -- FIXME wtf is going on?
-        for i = 1, ode.data[0].value do self:Upload(ode.data[i] --[[@as OdEntry]]) end
+        for i = 1, ode.data[0].value do self:Upload(ode.data[i] --[[@as OdEntry]], options) end
     elseif (ode.objectType == CanOpen.objectType.record) then
-        for k, v in ipairs(ode.__fields) do self:Upload(ode[v]) end
+        for k, v in ipairs(ode.__fields) do self:Upload(ode[v], options) end
     else
         error("Ib upload, invalid object type")
     end
     return ode.value
 end
 
+--- Upload (fetches) several var entries from the node, the requests are all queued before waiting on any.
+--- @param odes OdEntry[]
+--- @param options? {block: boolean} Force a block (true) or segmented (false) transfer.
+--- @return OdEntryType[] values In the order of odes.
+function Ib:UploadMany(odes, options)
+    local requests = {}
+    for i, ode in ipairs(odes) do
+        assert(type(ode) == "table" and ode.__kind == "Object Dictionary Entry",
+            "Ib upload many, entry " .. i .. " is not an Object Dictionary Entry")
+        assert(ode.objectType == CanOpen.objectType.var, "Ib upload many, entry " .. i .. " is not a var")
+        requests[i] = { nodeId = self.nodeId, ode = ode, options = options }
+    end
+    if (Context.info.stage == Stage.execution) then
+        local values = CanOpen.__uploadMany(requests)
+        for i, ode in ipairs(odes) do ode.value = values[i] end
+    end
+    local values = {}
+    for i, ode in ipairs(odes) do values[i] = ode.value end
+    return values
+end
+
 --- Download (sends) an entry to the node.
 --- @param ode OdEntry
 --- @param value OdEntryType|OdEntryArrayType
-function Ib:Download(ode, value)
+--- @param options? {block: boolean} Force a block (true) or segmented (false) transfer.
+function Ib:Download(ode, value, options)
     if (Context.info.stage ~= Stage.execution) then return end
     assert(value ~= nil, "Value is nil")
     assert(type(ode) == "table", "Ib download, invalid ode")
     assert(ode.__kind == "Object Dictionary Entry",
         "Ib download, not an Object Dictionary Entry")
     if (ode.objectType == CanOpen.objectType.var) then
-        CanOpen.__download(self.nodeId, ode, value)
+        CanOpen.__download(self.nodeId, ode, value, options)
     elseif (ode.objectType == CanOpen.objectType.array) then
-        for k, v in ipairs(value --[[@as OdEntryArrayType]]) do self:Download(ode.data[k], v) end
+        for k, v in ipairs(value --[[@as OdEntryArrayType]]) do self:Download(ode.data[k], v, options) end
     elseif (ode.objectType == CanOpen.objectType.record) then
         for k, v in pairs(ode.__fields) do
-            Ib:Download(ode[v], value[v])
+            Ib:Download(ode[v], value[v], options)
         end
     else
         error("Ib download, invalid object type")
     end
 end
 
+--- Download (sends) several var entries to the node, the requests are all queued before waiting on any.
+--- @param odes OdEntry[]
+--- @param values OdEntryType[] In the order of odes.
+--- @param options? {block: boolean} Force a block (true) or segmented (false) transfer.
+function Ib:DownloadMany(odes, values, options)
+    if (Context.info.stage ~= Stage.execution) then return end
+    local requests = {}
+    for i, ode in ipairs(odes) do
+        assert(values[i] ~= nil, "Value " .. i .. " is nil")
+        assert(type(ode) == "table" and ode.__kind == "Object Dictionary Entry",
+            "Ib download many, entry " .. i .. " is not an Object Dictionary Entry")
+        assert(ode.objectType == CanOpen.objectType.var, "Ib download many, entry " .. i .. " is not a var")
+        requests[i] = { nodeId = self.nodeId, ode = ode, value = values[i], options = options }
+    end
+    CanOpen.__downloadMany(requests)
+end
+
+--- Starts queuing the frames of one of the TPDOs of the node, to wait for the node to push values rather than polling
+--- them. Listen before triggering what makes the node send the TPDO, so it can't be missed.
+--- @param tpdo integer 1 to 4.
+--- @param mapping OdEntry[] The var entries the node maps in the TPDO, in order. They must have a fixed size.
+--- @return PdoListener
+function Ib:ListenPdo(tpdo, mapping)
+    CheckField(tpdo, Is.IntegerIn, 1, 4)
+    for i, ode in ipairs(mapping) do
+        assert(type(ode) == "table" and ode.__kind == "Object Dictionary Entry",
+            "Ib listen PDO, entry " .. i .. " is not an Object Dictionary Entry")
+        assert(ode.objectType == CanOpen.objectType.var, "Ib listen PDO, entry " .. i .. " is not a var")
+    end
+    local listener = setmetatable({ tpdo = tpdo, mapping = mapping }, PdoListener)
+    if (Context.info.stage == Stage.execution) then listener.queue = CanOpen.__pdoListen(self.nodeId, tpdo) end
+    return listener
+end
+
+--- Size in bits of the data types that can be mapped in a PDO.
+local s_bitLengths = {
+    [DataType.boolean] = 8,
+    [DataType.integer8] = 8,
+    [DataType.integer16] = 16,
+    [DataType.integer32] = 32,
+    [DataType.integer64] = 64,
+    [DataType.unsigned8] = 8,
+    [DataType.unsigned16] = 16,
+    [DataType.unsigned32] = 32,
+    [DataType.unsigned64] = 64,
+    [DataType.real32] = 32,
+    [DataType.real64] = 64,
+}
+
+--- Gets the var entries the node maps in one of its TPDOs, in order, as declared by the mapping parameter of its EDS
+--- (0x1A00 and up).
+--- @param tpdo integer 1 to 4.
+--- @return OdEntry[]? mapping nil if the EDS doesn't declare the TPDO, declares it disabled, or maps something that
+--- isn't one of its var entries with the size of its data type.
+function Ib:TpdoMapping(tpdo)
+    CheckField(tpdo, Is.IntegerIn, 1, 4)
+    local Find = ObjectDictionary.Find
+    local cobId = Find(self.od, 0x1800 + tpdo - 1, 1)
+    local count = Find(self.od, 0x1A00 + tpdo - 1, 0)
+    if cobId == nil or count == nil then return nil end
+    -- Bit 31 of the COB-ID is set when the TPDO isn't valid.
+    if (math.tointeger(cobId.defaultValue) or 0) & 0x80000000 ~= 0 then return nil end
+
+    local mapping = {}
+    for i = 1, math.tointeger(count.defaultValue) or 0 do
+        local object = Find(self.od, 0x1A00 + tpdo - 1, i)
+        local value = object ~= nil and math.tointeger(object.defaultValue) or nil
+        if value == nil then return nil end
+        local ode = Find(self.od, value >> 16, (value >> 8) & 0xFF)
+        if ode == nil or s_bitLengths[ode.dataType] ~= value & 0xFF then return nil end
+        mapping[i] = ode
+    end
+    return mapping
+end
+
 function Ib:Reset()
     CanOpen.__reset(self.nodeId)
 end
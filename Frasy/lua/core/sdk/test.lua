@@ -90,15 +90,32 @@ end
 ---     end)
 --- end)
 --- ```
+--- Test Resources
+--- When the orchestrator runs with parallel tests enabled, the tests of a same stage can run concurrently on their UUT
+--- if they declare the resources, usually instrumentation boards, that they use.
+--- Tests sharing a resource still run one after the other, and a test that doesn't declare its resources always runs
+--- alone. An empty list means that the test doesn't use any shared resource.
+--- While waiting in SleepFor, a test lets the others run. Exclusive and Once sections are never interleaved.
+--- ```lua
+--- Sequence("MySequence", function()
+---     Test("MeasureRails", function()
+---         ... -- DAQ measurements, with settling delays
+---     end, { "DAQ" })
+---     Test("CheckInputs", function()
+---         ... -- PIO only
+---     end, { "PIO" })
+--- end)
+--- ```
 --- @param name string? Name of the test. This will appear in the log
 --- @param func function? Body of the test
+--- @param resources string|string[]? Resources used by the test
 --- @return ScopeRequirement? test when using function as getter
-function Test(name, func)
+function Test(name, func, resources)
     if func == nil then
         return Orchestrator.GetTestScopeRequirement(name)
     else
         local ar = debug.getinfo(2, "Sl")
-        Orchestrator.CreateTest(name, func, ar.source, ar.currentline)
+        Orchestrator.CreateTest(name, func, ar.source, ar.currentline, resources)
     end
 end
 
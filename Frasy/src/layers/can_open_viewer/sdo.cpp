@@ -180,7 +180,9 @@ void Sdo::renderUploadRequestMaker(CanOpen::Node& node)
                                                                        static_cast<uint8_t>(m_uploadRequestSubIndex),
                                                                        static_cast<uint16_t>(m_uploadRequestTimeout),
                                                                        static_cast<uint8_t>(m_uploadRequestTries),
-                                                                       m_uploadRequestIsBlock,
+                                                                       m_uploadRequestIsBlock
+                                                                         ? CanOpen::SdoTransferMode::Block
+                                                                         : CanOpen::SdoTransferMode::Segmented,
                                                                        m_uploadRequestType));
     }
 }
@@ -331,7 +333,9 @@ void Sdo::renderDownloadRequestMaker(CanOpen::Node& node)
                                                       data,
                                                       static_cast<uint16_t>(m_downloadRequestTimeout),
                                                       static_cast<uint8_t>(m_downloadRequestTries),
-                                                      m_downloadRequestIsBlock));
+                                                      m_downloadRequestIsBlock
+                                                        ? CanOpen::SdoTransferMode::Block
+                                                        : CanOpen::SdoTransferMode::Segmented));
             }
         };
 
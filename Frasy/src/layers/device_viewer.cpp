@@ -337,7 +337,7 @@ void DeviceViewer::onImGuiRender()
               size_t          tot = 0;
               std::lock_guard l {devices.mutex};
               for (auto& device : devices.devices | std::views::values) {
-                  tot += device.m_queue.size();
+                  tot += device.available();
               }
               return tot;
           }(),
@@ -487,7 +487,7 @@ void DeviceViewer::renderMenuBar()
                 size_t          tot = 0;
                 std::lock_guard l {devices.mutex};
                 for (auto& device : devices.devices | std::views::values) {
-                    tot += device.m_queue.size();
+                    tot += device.available();
                 }
                 return tot;
             }());
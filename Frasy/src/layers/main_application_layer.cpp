@@ -65,6 +65,9 @@ void MainApplicationLayer::onAttach()
     m_resultAnalyzer->setGetTitle([this] { return m_orchestrator.getTitle(); });
 
     m_orchestrator.setCanOpen(&m_canOpen);
+    m_orchestrator.setParallelTests(CliArgs::get().parallelTests);
+    m_orchestrator.setArchiveFormat(
+      Analyzers::ReportFile::ParseFormat(CliArgs::get().archiveFormat).value_or(Analyzers::ReportFile::Format::Json));
 
     m_logWindow->SetVisibility(true);
 }
@@ -235,6 +238,14 @@ void MainApplicationLayer::renderProfiler()
     ImGui::SameLine();
     if (ImGui::Button("Dump Trace")) { DumpProfileEvents(); }
 
+    ImGui::SameLine();
+    if (!Profiler::get().isTracing()) {
+        if (ImGui::Button("Record Timeline")) { Profiler::get().startTrace("profile_timeline.json"); }
+    }
+    else if (ImGui::Button("Stop Timeline")) {
+        Profiler::get().stopTrace();
+    }
+
     if (!ImGui::BeginTabBar("profiler_threads")) { return; }
     for (auto&& [id, details] : Profiler::get().getEvents()) {
         renderProfilerTable(id, details);
@@ -254,7 +265,8 @@ void MainApplicationLayer::renderProfilerTable(const std::thread::id& id, const
     std::string threadId    = std::format("Thread {}", id);
 
     float totalTime      = static_cast<float>(details.getTotalTime().count());
-    auto  onHoverTooltip = [&threadId, &totalTime, &top = events.front()] {
+    auto  onHoverTooltip = [&threadId, &totalTime, &events] {
+        const auto& top = events.front();
         ImGui::BeginTooltip();
         ImGui::PushTextWrapPos(800.0f);
         ImGui::Text(threadId.c_str());
@@ -289,6 +301,10 @@ void MainApplicationLayer::renderProfilerTable(const std::thread::id& id, const
         m_profileGraphPopups.clear();
     }
     ImGui::Text("Total time: %fus", totalTime);
+    if (details.droppedEvents() != 0) {
+        ImGui::SameLine();
+        ImGui::Text("(%zu events dropped)", details.droppedEvents());
+    }
 
     float indent = 0.0f;
     Widget::Table(std::format("profile events##{}", id), 8)
@@ -545,7 +561,7 @@ void MainApplicationLayer::DumpProfileEvents()
 
 void MainApplicationLayer::generate()
 {
-    //    m_orchestrator->Generate();
+    m_orchestrator.generate();
 }
 
 void MainApplicationLayer::setTestEnable(const std::string& sequence, const std::string& test, bool enable)
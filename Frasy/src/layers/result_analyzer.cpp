@@ -51,27 +51,57 @@ void ResultAnalyzer::onImGuiRender()
               "Combine all locations into the statistic report. When false, the statistics will be on a per-location "
               "basis.");
         }
+        ImGui::Checkbox("Keep every value", &m_options.KeepValues);
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip(
+              "Keep every value measured, for exact medians, modes and histograms. When false, they are estimated from "
+              "statistics that take the same memory however many reports are analyzed.");
+        }
 
-        if (!m_generating) {
+        if (m_converting) { ImGui::Text("Converting the archived reports..."); }
+        else if (!m_generating) {
             if (ImGui::Button("generate")) {
-                m_analyzer        = Analyzers::ResultAnalyzer {m_options};
+                m_analyzer        = std::make_unique<Analyzers::ResultAnalyzer>(m_options);
                 m_doneGenerating  = false;
+                m_generating      = true;
                 m_generatorThread = Brigerad::MakeThread([this] {
-                    m_generating     = true;
-                    m_lastResults    = m_analyzer.Analyze(m_getTitle());
+                    auto results = m_analyzer->Analyze(m_getTitle());
+                    if (!m_analyzer->IsCancelled()) {
+                        m_lastResults  = std::move(results);
+                        m_hasGenerated = true;
+                    }
                     m_doneGenerating = true;
-                    m_hasGenerated   = true;
                 });
             }
             if (ImGui::IsItemHovered()) { ImGui::SetTooltip("Analyze all the reports with the given options."); }
             ImGui::SameLine();
             if (ImGui::Button("Show Last Report")) { m_renderResults = true; }
             if (ImGui::IsItemHovered()) { ImGui::SetTooltip("Display the last generated analysis report."); }
+            ImGui::SameLine();
+            if (ImGui::Button("convert Archive")) {
+                m_doneConverting  = false;
+                m_converting      = true;
+                m_converterThread = Brigerad::MakeThread([this] {
+                    auto conversion = Analyzers::ReportFile::ConvertArchive(
+                      std::filesystem::path("logs") / m_getTitle(), Analyzers::ReportFile::Format::Cbor);
+                    BR_LOG_INFO(s_windowName,
+                                "Converted {} reports to CBOR ({} failed), from {} KiB to {} KiB",
+                                conversion.Converted,
+                                conversion.Failed,
+                                conversion.BytesBefore / 1024,
+                                conversion.BytesAfter / 1024);
+                    m_doneConverting = true;
+                });
+            }
+            if (ImGui::IsItemHovered()) {
+                ImGui::SetTooltip("Convert the archived reports to CBOR, a fraction of their size as text. The reports "
+                                  "archived afterwards stay in the format given by --archive-format.");
+            }
 
             if (ImGui::Button("load Reports")) {
                 BR_PROFILE_SCOPE("Loading Analysis Reports");
                 auto pathsOpt =
-                  Brigerad::Dialogs::OpenFiles("load Reports", {}, {"*.json"}, "Log Analysis Result Files");
+                  Brigerad::Dialogs::OpenFiles("load Reports", {}, {"*.json", "*.cbor"}, "Log Analysis Result Files");
                 if (pathsOpt) {
                     for (auto&& path : *pathsOpt) {
                         try {
@@ -91,17 +121,26 @@ void ResultAnalyzer::onImGuiRender()
                 BR_PROFILE_SCOPE("Saving Analysis Report");
                 auto suggestedPath = std::filesystem::current_path();
                 suggestedPath /= "report.json";
-                auto pathOpt =
-                  Brigerad::Dialogs::SaveFile("save File", suggestedPath.string(), {"*.json"}, "Log Analysis Results");
+                auto pathOpt = Brigerad::Dialogs::SaveFile(
+                  "save File", suggestedPath.string(), {"*.json", "*.cbor"}, "Log Analysis Results");
                 if (pathOpt) { Frasy::Analyzers::Save(m_lastResults, *pathOpt); }
             }
         }
         else {
-            ImGui::Text("Generating... %zu/%zu", m_analyzer.Analyzed, m_analyzer.ToAnalyze);
+            ImGui::Text("Generating... %zu/%zu", m_analyzer->Analyzed.load(), m_analyzer->ToAnalyze.load());
+            ImGui::SameLine();
+            if (ImGui::Button("cancel")) { m_analyzer->Cancel(); }
+            if (ImGui::IsItemHovered()) {
+                ImGui::SetTooltip("Stop the analysis. The reports indexed so far are kept for the next one.");
+            }
             m_currentSequence    = nullptr;
             m_currentTest        = nullptr;
             m_currentExpectation = nullptr;
         }
+        if (m_doneConverting && m_converting) {
+            m_converterThread.join();
+            m_converting = false;
+        }
         if (m_doneGenerating && m_generating) {
             m_generatorThread.join();
             m_generating    = false;
@@ -21,13 +21,16 @@
 #include "utils/result_analyzer/analytic_results.h"
 #include "utils/result_analyzer/analyzer.h"
 #include "utils/result_analyzer/options.h"
+#include "utils/result_analyzer/report_file.h"
 
 #include <Brigerad/Core/Thread.h>
 
 #include <array>
+#include <atomic>
 #include <Brigerad.h>
 #include <functional>
 #include <map>
+#include <memory>
 #include <vector>
 
 namespace Frasy {
@@ -64,12 +67,15 @@ private:
     const Analyzers::ResultAnalysisResults::Test*           m_currentTest        = nullptr;
     Analyzers::ResultAnalysisResults::Expectation*          m_currentExpectation = nullptr;
 
-    Analyzers::ResultAnalyzer    m_analyzer;
-    bool                         m_generating     = false;
-    bool                         m_doneGenerating = false;
-    bool                         m_hasGenerated   = false;
-    std::jthread                 m_generatorThread;
-    std::function<std::string()> m_getTitle = [] { return "untitled"; };
+    std::unique_ptr<Analyzers::ResultAnalyzer> m_analyzer;
+    bool                                       m_generating     = false;
+    std::atomic<bool>                          m_doneGenerating = false;
+    bool                                       m_hasGenerated   = false;
+    std::jthread                               m_generatorThread;
+    bool                                       m_converting     = false;
+    std::atomic<bool>                          m_doneConverting = false;
+    std::jthread                               m_converterThread;
+    std::function<std::string()>               m_getTitle = [] { return "untitled"; };
 };
 }    // namespace Frasy
 
@@ -17,6 +17,7 @@
 #include "result_viewer.h"
 
 #include "imgui.h"
+#include "utils/result_analyzer/report_file.h"
 
 namespace Frasy {
 
@@ -174,7 +175,7 @@ std::vector<ResultViewer::LogInfo> ResultViewer::LoadLogs(bool loadFiles)
 {
     // For each file in the last log directory:
     // - Check if the entry is a file
-    // - Check if the file is a json file
+    // - Check if the file is a report, in JSON or CBOR
     // - Add it to the list if that's the case.
     namespace fs = std::filesystem;
     // First, check if the last log directory exists in the first place.
@@ -185,9 +186,11 @@ std::vector<ResultViewer::LogInfo> ResultViewer::LoadLogs(bool loadFiles)
 
     std::vector<LogInfo> infos;
 
-    // Check if each entry is a json file.
+    // Check if each entry is a report.
     for (const auto& entry : fs::recursive_directory_iterator(s_lastLogsPath)) {
-        if (entry.is_regular_file() && entry.path().extension() == s_logFileExtension) {
+        const auto extension = entry.path().extension();
+        if (entry.is_regular_file() &&
+            (extension == s_logFileExtension || extension == Analyzers::ReportFile::s_cborExtension)) {
             std::string path = entry.path().string();
             try {
                 OverallTestResult results = {};
@@ -206,22 +209,8 @@ std::vector<ResultViewer::LogInfo> ResultViewer::LoadLogs(bool loadFiles)
 
 ResultViewer::OverallTestResult ResultViewer::LoadResults(const std::string& path)
 {
-    auto loadJson = [](const std::string& p) -> nlohmann::json {
-        BR_PROFILE_FUNCTION();
-        std::ifstream j(p);
-
-        std::string fullFile;
-        std::string line;
-
-        while (std::getline(j, line)) {
-            fullFile += line;
-        }
-
-        j.close();
-        return nlohmann::json::parse(fullFile);
-    };
-
-    auto json = loadJson(path);
+    // The report is read whatever its format, JSON or CBOR.
+    auto json = Analyzers::ReportFile::Load(path);
     // The keys are currently hardcoded. This isn't a problem as long as we stick to the same scheme.
     // However, adding a way to configure these fields might be a good idea.
     return OverallTestResult {
@@ -29,10 +29,13 @@
 
 #include "utils/lua/profile_events.h"
 
+#include <algorithm>
 #include <cerrno>
 #include <cstdlib>
 #include <cstring>
+#include <iterator>
 #include <mutex>
+#include <vector>
 
 #include "301/CO_driver.h"
 
@@ -162,6 +165,7 @@ CO_ReturnError_t CO_CANmodule_init(CO_CANmodule_t*           CANmodule,
     CANmodule->CANerrorStatus = 0;
     CANmodule->CANnormal      = false;
     CANmodule->CANtxCount     = 0;
+    CANmodule->rxLookupValid  = false;
 
     for (uint16_t i = 0U; i < rxSize; i++) {
         rxArray[i].ident          = 0U;
@@ -218,6 +222,8 @@ CO_ReturnError_t CO_CANrxBufferInit(CO_CANmodule_t* CANmodule,
         if (rtr) { buffer->ident |= FLAG_RTR; }
         buffer->mask = (mask & CANID_MASK) | FLAG_RTR;
 
+        CANmodule->rxLookupValid = false;
+
         /* Set CAN hardware module filter and mask. */
         if (CANmodule->CANnormal) { ret = setRxFilters(CANmodule); }
     }
@@ -250,6 +256,25 @@ CO_CANtx_t* CO_CANtxBufferInit(
     return buffer;
 }
 
+/** Routing of the frames between the adapters ********************************/
+/* Node a transmitted frame is meant for, 0 if it is meant for every node. Only SDO requests and NMT commands to a
+ * single node have one, the rest (NMT to all, SYNC, TIME, our heartbeat, PDOs and emergencies) is for every bus. */
+static uint8_t destinationNodeOf(const CO_CANtx_t& buffer)
+{
+    const uint32_t ident = buffer.ident & CANID_MASK;
+    if (ident == CO_CAN_ID_NMT_SERVICE && buffer.DLC >= 2) { return buffer.data[1] & 0x7F; }
+    if (ident > CO_CAN_ID_SDO_CLI && ident <= CO_CAN_ID_SDO_CLI + 0x7F) { return ident - CO_CAN_ID_SDO_CLI; }
+    return 0;
+}
+
+/* Node that sent a received frame, 0 if the frame doesn't tell (NMT, SYNC, TIME, LSS). */
+static uint8_t sourceNodeOf(const CO_CANrxMsg_t& message)
+{
+    const uint32_t ident = message.ident;
+    if (ident < CO_CAN_ID_EMERGENCY || ident >= CO_CAN_ID_LSS_SLV) { return 0; }
+    return ident & 0x7F;
+}
+
 /* Change handling of tx buffer full in CO_CANsend(). Use CO_CANtx_t->bufferFull
  * flag. Re-transmit undelivered message inside CO_CANmodule_process(). */
 CO_ReturnError_t CO_CANsend(CO_CANmodule_t* CANmodule, CO_CANtx_t* buffer)
@@ -273,18 +298,28 @@ CO_ReturnError_t CO_CANsend(CO_CANmodule_t* CANmodule, CO_CANtx_t* buffer)
     {
         CO_LOCK_CAN_SEND(CANmodule);
         std::lock_guard l {interfaces->mutex};
-        bool            allSuccess = true;
-        for (auto& interface : interfaces->devices | std::views::values) {
-            try {
-                size_t written = interface.transmit(packet);
-                if (written != packet.sizeOfSerialPacket()) { allSuccess = false; }
-            }
-            catch (std::exception& e) {
-                log_printf(LOG_WARNING, DBG_CAN_TX_FAILED, buffer->ident, e.what());
-                allSuccess = false;
+        // Frames for a single node only go to the adapter it was heard on, the other buses don't need them. The
+        // adapters each have their own queue, a stalled one doesn't hold back the others.
+        bool              sent    = false;
+        const uint8_t     node    = destinationNodeOf(*buffer);
+        const std::size_t adapter = node == 0 ? 0 : interfaces->routes[node];
+        if (adapter != 0 && adapter <= interfaces->devices.size()) {
+            auto routed = std::next(interfaces->devices.begin(), static_cast<std::ptrdiff_t>(adapter - 1));
+            sent        = routed->second.post(packet);
+        }
+        else {
+            std::size_t refused = 0;
+            for (auto& [port, interface] : interfaces->devices) {
+                if (!interface.post(packet)) {
+                    log_printf(LOG_WARNING, DBG_CAN_TX_FAILED, buffer->ident, port.c_str());
+                    ++refused;
+                }
             }
+            sent = refused != interfaces->devices.size();
+            // Sending it again would duplicate it on the buses that took it, it is reported lost on the others.
+            if (sent && refused != 0) { err = CO_ERROR_TX_OVERFLOW; }
         }
-        if (allSuccess) {
+        if (sent) {
             if (buffer->bufferFull) {
                 buffer->bufferFull = false;
                 CANmodule->CANtxCount--;
@@ -336,6 +371,53 @@ void CO_CANmodule_process(CO_CANmodule_t* CANmodule)
     }
 }
 
+/** Build the rx lookup table from the filters ********************************/
+static void buildRxLookup(CO_CANmodule_t* CANmodule)
+{
+    FRASY_PROFILE_FUNCTION();
+    std::fill(std::begin(CANmodule->rxLookup), std::end(CANmodule->rxLookup), CO_CAN_RX_NO_BUFFER);
+    // Going backwards, the first buffer matching an ID is the last one written, like the linear search would find.
+    for (uint16_t index = CANmodule->rxSize; index-- > 0;) {
+        const CO_CANrx_t& buffer = CANmodule->rxArray[index];
+        // Received standard frames never have the RTR flag, only the ID bits decide.
+        if ((buffer.ident & FLAG_RTR) != 0) { continue; }
+        if ((buffer.mask & CANID_MASK) == CANID_MASK) {
+            CANmodule->rxLookup[buffer.ident & CANID_MASK] = index;
+            continue;
+        }
+        // Wildcard, such as the emergency consumer receiving every 0x080 + node ID.
+        for (uint32_t ident = 0; ident < CO_CAN_MSG_SFF_MAX_COB_ID; ++ident) {
+            if (((ident ^ buffer.ident) & buffer.mask) == 0) { CANmodule->rxLookup[ident] = index; }
+        }
+    }
+    CANmodule->rxLookupValid = true;
+}
+
+void CO_CANrxDispatch(CO_CANmodule_t* CANmodule, CO_CANrxMsg_t* rxMsg)
+{
+    CO_CANrx_t* rcvMsgObj = nullptr;
+    if (rxMsg->ident < CO_CAN_MSG_SFF_MAX_COB_ID) {
+        if (!CANmodule->rxLookupValid) { buildRxLookup(CANmodule); }
+        const uint16_t index = CANmodule->rxLookup[rxMsg->ident];
+        if (index != CO_CAN_RX_NO_BUFFER) { rcvMsgObj = &CANmodule->rxArray[index]; }
+    }
+    else {
+        // Extended IDs are out of the table, search rxArray from CANmodule for the same CAN-ID.
+        for (uint16_t index = 0; index < CANmodule->rxSize; index++) {
+            CO_CANrx_t* buffer = &CANmodule->rxArray[index];
+            if (((rxMsg->ident ^ buffer->ident) & buffer->mask) == 0) {
+                rcvMsgObj = buffer;
+                break;
+            }
+        }
+    }
+
+    if (rcvMsgObj != nullptr && rcvMsgObj->CANrx_callback != nullptr) {
+        // Call specific function for that "filter", it will do the processing.
+        rcvMsgObj->CANrx_callback(rcvMsgObj->object, rxMsg);
+    }
+}
+
 void CO_CANpollReceive(CO_CANmodule_t* canModule)
 {
     FRASY_PROFILE_FUNCTION();
@@ -343,34 +425,32 @@ void CO_CANpollReceive(CO_CANmodule_t* canModule)
 
     auto* interfaces = static_cast<Frasy::CanOpen::CanOpen::Interfaces_t*>(canModule->interface);
 
-    std::lock_guard l {interfaces->mutex};
-    for (auto& interface : interfaces->devices | std::views::values) {
-        while (interface.available() != 0) {
-            auto packetOpt = interface.receive().toCOCanRxMsg();
-            if (!packetOpt.has_value()) {
-                // TODO maybe handle it somehow
-                continue;
-            }
-            auto& packet = packetOpt.value();
-
-            // Message has been received. Search rxArray from CANmodule for the same CAN-ID.
-            auto* rcvMsgObj = &canModule->rxArray[0];
-            bool  matched   = false;
-            for (size_t index = 0; index < canModule->rxSize; index++) {
-                if (((packet.ident ^ rcvMsgObj->ident) & rcvMsgObj->mask) == 0) {
-                    // Received message matches this "filter".
-                    matched = true;
-                    break;
+    // The frames are taken out of the devices under the lock, but dispatched without it. Only the CANopen thread
+    // polls, the batch is reused from one call to the next.
+    static std::vector<CO_CANrxMsg_t> received;
+    received.clear();
+    {
+        std::lock_guard l {interfaces->mutex};
+        std::size_t adapter = 0;
+        for (auto& interface : interfaces->devices | std::views::values) {
+            ++adapter;
+            while (interface.available() != 0) {
+                auto packetOpt = interface.receive().toCOCanRxMsg();
+                if (!packetOpt.has_value()) {
+                    // TODO maybe handle it somehow
+                    continue;
                 }
-                rcvMsgObj++;
-            }
-
-            if (matched && (rcvMsgObj != nullptr && rcvMsgObj->CANrx_callback != nullptr)) {
-                // Call specific function for that "filter", it will do the processing.
-                rcvMsgObj->CANrx_callback(rcvMsgObj->object, &packet);
+                // The node is on the bus of this adapter, that's where its frames will be sent.
+                if (const uint8_t node = sourceNodeOf(*packetOpt); node != 0) { interfaces->routes[node] = adapter; }
+                received.push_back(*packetOpt);
             }
         }
     }
+
+    for (auto& packet : received) {
+        CO_CANrxDispatch(canModule, &packet);
+        interfaces->pdos.dispatch(packet.ident, &packet.data[0], packet.DLC);
+    }
 }
 }
 
@@ -253,13 +253,23 @@ typedef struct {
 
 
 /* Max COB ID for standard frame format */
+#    ifndef CAN_SFF_ID_BITS
+#        define CAN_SFF_ID_BITS 11
+#    endif
 #    define CO_CAN_MSG_SFF_MAX_COB_ID (1 << CAN_SFF_ID_BITS)
 
+/* Entry of CO_CANmodule_t.rxLookup for CAN-IDs no rx buffer receives */
+#    define CO_CAN_RX_NO_BUFFER 0xFFFFU
+
 /* CAN module object */
 typedef struct {
     void*             interface;
     CO_CANrx_t*       rxArray;
     uint16_t          rxSize;
+    /* Index of the first rxArray buffer matching each standard CAN-ID, or CO_CAN_RX_NO_BUFFER. Built from the
+     * filters (wildcard masks included) the first time a frame is received after CO_CANrxBufferInit changed them. */
+    uint16_t          rxLookup[CO_CAN_MSG_SFF_MAX_COB_ID];
+    volatile bool_t   rxLookupValid;
     uint32_t          rxDropCount; /* messages dropped on rx socket queue */
     CO_CANtx_t*       txArray;
     uint16_t          txSize;
@@ -289,6 +299,10 @@ typedef struct {
 } CO_storage_entry_t;
 
 
+/* Call the callback of the rx buffer receiving the message, if any. Used by CO_CANpollReceive(). */
+void CO_CANrxDispatch(CO_CANmodule_t* CANmodule, CO_CANrxMsg_t* rxMsg);
+
+
 #    ifdef CO_SINGLE_THREAD
 #        define CO_LOCK_CAN_SEND(CAN_MODULE)                                                                           \
             {                                                                                                          \
@@ -42,6 +42,9 @@ void printUsage(const char* programName)
               << "  --skip-verification     Skip hash verification stage\n"
               << "  --verbose               Show logs on stderr (headless/MCP mode only)\n"
               << "  --popup-timeout <secs>  Auto-cancel popups after N seconds (default: 0 = no timeout)\n"
+              << "  --parallel-tests        Run the tests of a stage that use disjoint resources concurrently\n"
+              << "  --archive-format <fmt>  Format of the archived reports: json or cbor (default: json)\n"
+              << "  --trace <path>          Write a Chrome trace of the whole run, open it in https://ui.perfetto.dev\n"
               << "  --help                  Show this help message and exit\n"
               << "\n"
               << "Examples:\n"
@@ -90,6 +93,9 @@ CliArgs CliArgs::parse(int argc, char** argv)
         else if (arg == "--verbose") {
             args.verbose = true;
         }
+        else if (arg == "--parallel-tests") {
+            args.parallelTests = true;
+        }
         else if (arg == "--product") {
             const char* val = peekNextArg(i, argc, argv, "--product");
             if (!val) { std::exit(2); }
@@ -124,12 +130,28 @@ CliArgs CliArgs::parse(int argc, char** argv)
             }
             ++i;
         }
+        else if (arg == "--archive-format") {
+            const char* val = peekNextArg(i, argc, argv, "--archive-format");
+            if (!val) { std::exit(2); }
+            args.archiveFormat = val;
+            if (args.archiveFormat != "json" && args.archiveFormat != "cbor") {
+                std::cerr << "Error: --archive-format must be 'json' or 'cbor', got '" << args.archiveFormat << "'\n";
+                std::exit(2);
+            }
+            ++i;
+        }
         else if (arg == "--output-dir") {
             const char* val = peekNextArg(i, argc, argv, "--output-dir");
             if (!val) { std::exit(2); }
             args.outputDir = val;
             ++i;
         }
+        else if (arg == "--trace") {
+            const char* val = peekNextArg(i, argc, argv, "--trace");
+            if (!val) { std::exit(2); }
+            args.tracePath = val;
+            ++i;
+        }
         else if (arg == "--popup-timeout") {
             const char* val = peekNextArg(i, argc, argv, "--popup-timeout");
             if (!val) { std::exit(2); }
@@ -34,6 +34,9 @@ struct CliArgs {
     bool                     skipVerification    = false;
     bool                     verbose             = false;
     int                      popupTimeoutSeconds = 0;    // 0 = no timeout
+    bool                     parallelTests       = false;
+    std::string              archiveFormat       = "json";    // "json" or "cbor"
+    std::string              tracePath;                   // Empty = no trace
 
     /// Parse command-line arguments. Stores the result globally accessible via get().
     /// If --help is present, prints usage and calls std::exit(0).
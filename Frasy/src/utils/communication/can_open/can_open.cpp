@@ -122,6 +122,7 @@ bool CanOpen::addDevice(const std::string& port)
         dev.setRxCallbackFunc([this] { rxReadyCallback(); });
         if (dev.isOpen()) {
             m_devices.devices[port] = std::move(dev);
+            m_devices.routes.fill(0);
             return true;
         }
     }
@@ -134,7 +135,9 @@ bool CanOpen::addDevice(const std::string& port)
 bool CanOpen::removeDevice(const std::string& port)
 {
     std::lock_guard l {m_devices.mutex};
-    return m_devices.devices.erase(port) == 1;
+    if (m_devices.devices.erase(port) == 0) { return false; }
+    m_devices.routes.fill(0);
+    return true;
 }
 
 // void CanOpen::open(std::string_view port)
@@ -156,18 +159,25 @@ bool CanOpen::removeDevice(const std::string& port)
 //     }
 // }
 
-void CanOpen::reopen()
+void CanOpen::reopen(std::span<const uint8_t> nodeIds)
 {
-    std::lock_guard l {m_devices.mutex};
-    for (auto&& [port, dev] : m_devices.devices) {
-        try {
-            if (dev.isOpen()) { dev.close(); }
-            dev.open();
-        }
-        catch (std::exception& e) {
-            BR_LOG_ERROR(m_tag, "Error occurred while reopening {}: {}", port, e.what());
+    {
+        std::lock_guard l {m_devices.mutex};
+        for (auto&& [port, dev] : m_devices.devices) {
+            try {
+                if (dev.isOpen()) { dev.close(); }
+                dev.open();
+            }
+            catch (std::exception& e) {
+                BR_LOG_ERROR(m_tag, "Error occurred while reopening {}: {}", port, e.what());
+            }
         }
     }
+    // The frames of the transfers in progress were lost with the port. Those of the other nodes time out and are tried
+    // again by their SDO client.
+    for (uint8_t nodeId : nodeIds) {
+        if (auto node = getNode(nodeId); node.has_value()) { (*node)->sdoInterface()->abortPending(); }
+    }
 }
 
 // void CanOpen::close()
@@ -230,6 +240,7 @@ Node* CanOpen::addNode(uint8_t nodeId, std::string_view name, std::string_view e
     // TODO that's fucking stupid, vector offers no pointer stability, ***especially*** in insertions!!!
     Node* node = &m_nodes.emplace_back(this, nodeId, name.empty() ? std::format("Node {}", nodeId) : name, edsPath);
     m_sdoClientODEntries.push_back(node->sdoInterface()->makeSdoClientOdEntry());
+    node->sdoInterface()->setRequestCallbackFunc([this] { rxReadyCallback(); });
     // TODO Node should contain the OD, so its Heartbeat Producer time should be fetched from it.
 
     // Node will not be usable until we restart CANopen.
@@ -407,8 +418,8 @@ void CanOpen::canOpenTask(std::stop_token stopToken)
             FRASY_PROFILE_SCOPE("CANopen task");
             // A conditional variable is used here in place of std::this_thread::sleep_for in order to obtain a delay
             // that can be cancelled from elsewhere.
-            // Although we're asking for a sleep duration of a minimum of 1 microsecond, we're actually getting a 1
-            // millisecond delay. The delay gets cancelled upon reception of a CAN message.
+            // The delay is the time until a service (heartbeats, SDO transfers...) needs to run again, with a timer
+            // granularity of about 1 millisecond. It gets cancelled upon reception of a CAN message or SDO request.
             // Since std::condition_variable requires a lock, we give it a fake lock so it's happy and we're not losing
             // any time acquiring and releasing it.
             struct {
@@ -416,14 +427,10 @@ void CanOpen::canOpenTask(std::stop_token stopToken)
 
                 void unlock() {}
             } fakeLock;
-            m_sleepOrTimeout.wait_for(
-              fakeLock, stopToken, std::chrono::microseconds(std::max(m_sleepForUs, 1U)), [this] {
-                  if (m_wakeupNeeded) {
-                      m_wakeupNeeded = false;
-                      return true;
-                  }
-                  return false;
-              });
+            m_sleepOrTimeout.wait_for(fakeLock,
+                                      stopToken,
+                                      std::chrono::microseconds(std::max(m_sleepForUs, 1U)),
+                                      [this] { return m_wakeupNeeded.exchange(false); });
             reset = mainLoop();
         }
     }
@@ -572,7 +579,9 @@ bool CanOpen::initCallbacks()
 
     CO_RPDO_initCallbackPre(m_co->RPDO, this, &pdoPreCallback);
 
-    CO_SDOclient_initCallbackPre(m_co->SDOclient, this, &sdoClientPreCallback);
+    for (uint8_t i = 0; i < m_co->config->CNT_SDO_CLI; ++i) {
+        CO_SDOclient_initCallbackPre(&m_co->SDOclient[i], this, &sdoClientPreCallback);
+    }
 
     CO_SDOserver_initCallbackPre(m_co->SDOserver, this, &sdoServerPreCallback);
 
@@ -621,7 +630,12 @@ CO_NMT_reset_cmd_t CanOpen::mainLoop()
         auto ret       = CO_storageWindows_auto_process(&m_storage, false);
         if (ret != 0) { BR_LOG_ERROR(m_tag, "Unable to save persistence data on fields: {:08x}", ret); }
     }
-    auto cmd   = CO_process(m_co, true, static_cast<uint32_t>(deltaUs.count()), &m_sleepForUs);
+    // Every service lowers the sleep time to when it next needs to run, received frames wake the task up sooner.
+    m_sleepForUs = s_maxSleepTimeUs;
+    auto cmd     = CO_process(m_co, true, static_cast<uint32_t>(deltaUs.count()), &m_sleepForUs);
+    for (auto&& node : m_nodes) {
+        node.sdoInterface()->process(&m_sleepForUs);
+    }
     m_greenLed = CO_LED_GREEN(m_co->LEDs, CO_LED_CANopen);
     m_redLed   = CO_LED_RED(m_co->LEDs, CO_LED_CANopen);
 
@@ -808,8 +822,8 @@ void CanOpen::sdoClientPreCallback(void* arg)
 {
     FRASY_PROFILE_FUNCTION();
     BR_CORE_ASSERT(arg != nullptr, "Arg pointer null in sdoClientPreCallback");
-    CanOpen* that = static_cast<CanOpen*>(arg);
-    BR_LOG_DEBUG(that->m_tag, "SDO Client pre callback");
+    // The SDO clients are processed by the main loop, a transfer in progress must not wait for its next pass.
+    static_cast<CanOpen*>(arg)->rxReadyCallback();
 }
 
 void CanOpen::syncPreCallback(void* arg)
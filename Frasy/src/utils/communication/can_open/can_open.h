@@ -24,6 +24,7 @@
 #include "hb_consumer.h"
 #include "node.h"
 #include "real_od.h"
+#include "services/pdo.h"
 #include "services/sdo.h"
 #include "to_string.h"
 
@@ -32,6 +33,7 @@
 #include <CO_storage.h>
 
 #include <array>
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <cstdint>
@@ -40,6 +42,7 @@
 #include <map>
 #include <mutex>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <thread>
@@ -74,6 +77,11 @@ public:
         // Mutex needs to be acquired before accessing devices.
         std::mutex                           mutex;
         std::map<std::string, SlCan::Device> devices;
+        //! Adapter each node ID was last heard on, as its position in devices plus one, learned from the received
+        //! frames. 0 until the node is heard. Cleared when an adapter is added or removed, as that moves the others.
+        std::array<std::size_t, 128> routes = {};
+        //! Subscribers of the TPDOs of the remote nodes, handed every received frame. Has its own lock.
+        PdoDispatcher pdos;
     };
     using EmergencyMessageCallback = std::function<void(const EmergencyMessage&)>;
     using Interfaces_t             = Interfaces;
@@ -90,7 +98,11 @@ public:
     bool removeDevice(const std::string& port);
 
     // void open(std::string_view port);
-    void reopen();
+    /**
+     * Closes and opens every device again.
+     * @param nodeIds Nodes whose SDO requests queued so far are failed, the requests queued after the call go on.
+     */
+    void reopen(std::span<const uint8_t> nodeIds = {});
     // void close();
     bool isOpen() const { return !m_devices.devices.empty() && m_isRunning; }
 
@@ -115,6 +127,9 @@ public:
 
     CO_t* nativeHandle() { return m_co; }
 
+    //! TPDOs of the remote nodes, to be notified of them or to wait for them instead of polling with SDO uploads.
+    PdoDispatcher& pdos() { return m_devices.pdos; }
+
     /**
      *
      * @param nodeId ID of the node.
@@ -234,7 +249,8 @@ private:
 
     /**
      * Called after a SDO client message is received from the CAN buss or when new call without delay is necessary
-     * (exchange data with own SDO server or SDO block transfer is in progress).
+     * (exchange data with own SDO server or SDO block transfer is in progress). Wakes the task up so the SdoManagers
+     * are processed right away.
      *
      * @param arg Pointer to instance of CanOpen
      */
@@ -285,7 +301,7 @@ private:
     static constexpr uint16_t s_firstHeartbeatTime     = 500;
     static constexpr uint16_t s_sdoServerTimeoutTime   = 1000;
     static constexpr uint16_t s_sdoClientTimeoutTime   = 500;
-    static constexpr bool     s_sdoClientBlockTransfer = false;
+    static constexpr bool     s_sdoClientBlockTransfer = true;
     static constexpr uint8_t  s_defaultNodeId          = 0x01;
     static constexpr uint16_t s_lssTimeout             = 50;
 
@@ -311,7 +327,7 @@ private:
 
     std::stop_source            m_stopSource;
     std::condition_variable_any m_sleepOrTimeout;
-    bool                        m_wakeupNeeded = false;
+    std::atomic_bool            m_wakeupNeeded = false;
     std::jthread                m_coThread;
     bool                        m_isRunning = false;
 
@@ -319,6 +335,8 @@ private:
     static constexpr auto                              s_autoSavePeriod = std::chrono::minutes {1};
     std::chrono::time_point<std::chrono::steady_clock> m_lastSaveTime;
     uint32_t                                           m_sleepForUs = 0;
+    //! Longest the task sleeps when no service needs it sooner and no frame is received.
+    static constexpr uint32_t s_maxSleepTimeUs = 10'000;
 
     bool m_redLed   = false;
     bool m_greenLed = false;
@@ -0,0 +1,142 @@
+/**
+ * @file    pdo.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "pdo.h"
+
+#include <algorithm>
+
+namespace Frasy::CanOpen {
+namespace {
+constexpr uint32_t s_firstTpdoId = PdoDispatcher::cobId(0, 1);
+constexpr uint32_t s_lastTpdoId  = PdoDispatcher::cobId(0x7F, PdoDispatcher::s_tpdoCount);
+}    // namespace
+
+std::optional<PdoFrame> PdoQueue::wait(std::chrono::milliseconds timeout)
+{
+    std::unique_lock lock {m_lock};
+    if (!m_cv.wait_for(lock, timeout, [this] { return !m_frames.empty() || m_closed; }) || m_frames.empty()) {
+        return std::nullopt;
+    }
+    PdoFrame frame = m_frames.front();
+    m_frames.pop_front();
+    return frame;
+}
+
+void PdoQueue::clear()
+{
+    std::lock_guard lock {m_lock};
+    m_frames.clear();
+}
+
+void PdoQueue::close()
+{
+    {
+        std::lock_guard lock {m_lock};
+        m_closed = true;
+        m_frames.clear();
+    }
+    m_cv.notify_all();
+}
+
+bool PdoQueue::isClosed() const
+{
+    std::lock_guard lock {m_lock};
+    return m_closed;
+}
+
+std::size_t PdoQueue::dropped() const
+{
+    std::lock_guard lock {m_lock};
+    return m_dropped;
+}
+
+bool PdoQueue::push(const PdoFrame& frame)
+{
+    {
+        std::lock_guard lock {m_lock};
+        if (m_closed) { return false; }
+        if (m_frames.size() >= m_capacity) {
+            ++m_dropped;
+            return true;
+        }
+        m_frames.push_back(frame);
+    }
+    m_cv.notify_one();
+    return true;
+}
+
+PdoDispatcher::Handle PdoDispatcher::subscribe(uint8_t nodeId, uint8_t tpdo, Callback callback)
+{
+    return add({.handle = 0, .cobId = cobId(nodeId, tpdo), .callback = std::move(callback), .queue = {}});
+}
+
+void PdoDispatcher::unsubscribe(Handle handle)
+{
+    std::lock_guard lock {m_lock};
+    std::erase_if(m_subscribers, [handle](const Subscriber& subscriber) { return subscriber.handle == handle; });
+    m_count.store(m_subscribers.size(), std::memory_order_relaxed);
+}
+
+std::shared_ptr<PdoQueue> PdoDispatcher::listen(uint8_t nodeId, uint8_t tpdo, std::size_t capacity)
+{
+    auto queue = std::make_shared<PdoQueue>(capacity);
+    add({.handle = 0, .cobId = cobId(nodeId, tpdo), .callback = {}, .queue = queue});
+    return queue;
+}
+
+void PdoDispatcher::dispatch(uint32_t ident, const uint8_t* data, uint8_t size)
+{
+    if (ident < s_firstTpdoId || ident > s_lastTpdoId || m_count.load(std::memory_order_relaxed) == 0) { return; }
+
+    PdoFrame frame {
+      .nodeId     = static_cast<uint8_t>(ident & 0x7F),
+      .tpdo       = static_cast<uint8_t>((ident - 0x080) >> 8),
+      .size       = std::min<uint8_t>(size, 8),
+      .data       = {},
+      .receivedAt = std::chrono::steady_clock::now(),
+    };
+    std::copy_n(data, frame.size, frame.data.begin());
+
+    std::lock_guard lock {m_lock};
+    bool            expired = false;
+    for (auto& subscriber : m_subscribers) {
+        if (subscriber.cobId != ident) { continue; }
+        if (subscriber.callback) { subscriber.callback(frame); }
+        else if (auto queue = subscriber.queue.lock(); queue == nullptr || !queue->push(frame)) {
+            expired = true;
+        }
+    }
+    if (expired) {
+        // The queues nobody holds anymore, or that were closed, are forgotten.
+        std::erase_if(m_subscribers, [](const Subscriber& subscriber) {
+            if (subscriber.callback) { return false; }
+            auto queue = subscriber.queue.lock();
+            return queue == nullptr || queue->isClosed();
+        });
+        m_count.store(m_subscribers.size(), std::memory_order_relaxed);
+    }
+}
+
+PdoDispatcher::Handle PdoDispatcher::add(Subscriber subscriber)
+{
+    std::lock_guard lock {m_lock};
+    subscriber.handle = m_nextHandle++;
+    m_subscribers.push_back(std::move(subscriber));
+    m_count.store(m_subscribers.size(), std::memory_order_relaxed);
+    return m_subscribers.back().handle;
+}
+}    // namespace Frasy::CanOpen
@@ -0,0 +1,140 @@
+/**
+ * @file    pdo.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+
+#ifndef FRASY_UTILS_COMMUNICATION_CAN_OPEN_SERVICES_PDO_H
+#define FRASY_UTILS_COMMUNICATION_CAN_OPEN_SERVICES_PDO_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace Frasy::CanOpen {
+//! A TPDO received from a remote node.
+struct PdoFrame {
+    uint8_t                               nodeId = 0;
+    uint8_t                               tpdo   = 0;    //!< 1 to 4.
+    uint8_t                               size   = 0;
+    std::array<uint8_t, 8>                data   = {};
+    std::chrono::steady_clock::time_point receivedAt;
+};
+
+/**
+ * Frames of a TPDO of a remote node, kept as they are received until a thread takes them.
+ *
+ * Made by PdoDispatcher::listen(). The frames stop being queued once the queue is closed or destroyed.
+ */
+class PdoQueue {
+public:
+    explicit PdoQueue(std::size_t capacity) : m_capacity(capacity) {}
+
+    /**
+     * Takes the oldest frame of the queue, waiting for one if it's empty.
+     *
+     * @return std::nullopt if no frame came in before the timeout, or if the queue is closed.
+     */
+    [[nodiscard]] std::optional<PdoFrame> wait(std::chrono::milliseconds timeout);
+    //! Forgets the frames received so far.
+    void clear();
+    //! Stops queuing frames, and wakes up the threads waiting for one.
+    void close();
+
+    [[nodiscard]] bool isClosed() const;
+    //! Frames that came in while the queue was full, and were dropped.
+    [[nodiscard]] std::size_t dropped() const;
+
+    //! @return false if the queue is closed.
+    bool push(const PdoFrame& frame);
+
+private:
+    mutable std::mutex      m_lock;
+    std::condition_variable m_cv;
+    std::deque<PdoFrame>    m_frames;
+    std::size_t             m_capacity;
+    std::size_t             m_dropped = 0;
+    bool                    m_closed  = false;
+};
+
+/**
+ * Hands the TPDOs of the remote nodes to whoever subscribed to them.
+ *
+ * The TPDOs are recognized by their CAN-ID in the predefined connection set (0x180, 0x280, 0x380 or 0x480, plus the
+ * node ID). The CANopen thread calls dispatch() with every frame it receives; when nothing is subscribed, that's a
+ * range check and an atomic load.
+ */
+class PdoDispatcher {
+public:
+    using Callback = std::function<void(const PdoFrame&)>;
+    using Handle   = uint64_t;
+
+    static constexpr uint8_t s_tpdoCount = 4;
+
+    [[nodiscard]] static constexpr uint16_t cobId(uint8_t nodeId, uint8_t tpdo)
+    {
+        return static_cast<uint16_t>(0x080 + (0x100 * tpdo) + nodeId);
+    }
+
+    /**
+     * Calls callback with every frame of a TPDO of a node, from the CANopen thread.
+     *
+     * The callback must be quick, and must not subscribe or unsubscribe anything.
+     *
+     * @param tpdo 1 to s_tpdoCount.
+     */
+    Handle subscribe(uint8_t nodeId, uint8_t tpdo, Callback callback);
+    void   unsubscribe(Handle handle);
+
+    /**
+     * Queues the frames of a TPDO of a node, from now on.
+     *
+     * @param tpdo 1 to s_tpdoCount.
+     * @param capacity Frames kept until the newer ones are dropped.
+     */
+    [[nodiscard]] std::shared_ptr<PdoQueue> listen(uint8_t nodeId, uint8_t tpdo, std::size_t capacity = 64);
+
+    //! Hands a received frame to the subscribers of its CAN-ID, if it's a TPDO.
+    void dispatch(uint32_t ident, const uint8_t* data, uint8_t size);
+
+    [[nodiscard]] std::size_t subscriptions() const { return m_count.load(std::memory_order_relaxed); }
+
+private:
+    struct Subscriber {
+        Handle                  handle = 0;
+        uint16_t                cobId  = 0;
+        Callback                callback;
+        std::weak_ptr<PdoQueue> queue;    //!< Used instead of the callback by the subscribers of listen().
+    };
+
+    Handle add(Subscriber subscriber);
+
+    std::atomic_size_t      m_count = 0;
+    mutable std::mutex      m_lock;
+    std::vector<Subscriber> m_subscribers;
+    Handle                  m_nextHandle = 1;
+};
+}    // namespace Frasy::CanOpen
+
+#endif    // FRASY_UTILS_COMMUNICATION_CAN_OPEN_SERVICES_PDO_H
@@ -19,20 +19,14 @@
 
 #include "../can_open.h"
 #include "../to_string.h"
-#include "Brigerad/Core/Thread.h"
 
-#include <tuple>
+#include <chrono>
 
 #include <Brigerad/Core/Log.h>
 #include <Brigerad/Debug/Instrumentor.h>
 
 #include <CO_SDOclient.h>
 
-#include <Windows.h>
-
-#include <processthreadsapi.h>
-#include <synchapi.h>
-
 namespace Frasy::CanOpen {
 
 SdoManager::SdoManager()
@@ -75,17 +69,23 @@ SdoManager::SdoManager(uint8_t nodeId)
           },
       })
 {
-    startWorkers();
 }
 
-bool SdoManager::hasUploadRequestsPending() const
+SdoManager::~SdoManager()
 {
-    return !m_pendingUploadRequests.empty();
+    abortAll();
 }
 
-size_t SdoManager::uploadRequestsPending() const
+bool SdoManager::hasRequestsPending() const
 {
-    return m_pendingUploadRequests.size();
+    std::lock_guard lock {m_pendingLock};
+    return !m_pendingRequests.empty();
+}
+
+size_t SdoManager::requestsPending() const
+{
+    std::lock_guard lock {m_pendingLock};
+    return m_pendingRequests.size();
 }
 
 OD_entry_t SdoManager::makeSdoClientOdEntry() const
@@ -98,10 +98,12 @@ SdoUploadDataResult SdoManager::uploadData(
     uint8_t  subIndex,
     uint16_t sdoTimeoutTimeMs,
     uint8_t  retries,
-    bool     isBlock,
+    SdoTransferMode mode,
     VarType  type)
 {
     FRASY_PROFILE_FUNCTION();
+    // The size of an upload is only known once it started, only the strings are expected to be large.
+    const bool isBlock = mode == SdoTransferMode::Block || (mode == SdoTransferMode::Auto && type == VarType::String);
     SdoUploadDataResult result;
     result.m_request = std::make_shared<SdoUploadRequest>(
         SdoRequestStatus::Queued,
@@ -115,164 +117,242 @@ SdoUploadDataResult SdoManager::uploadData(
 
     result.future = result.m_request->promise.get_future();
 
-    if (!isAbleToMakeUploadRequests()) {
+    if (!isAbleToMakeRequests()) {
         // It's impossible to make requests without a client to talk with!
         result.m_request->abort(CO_SDO_AB_GENERAL);
         return result;
     }
 
-    {
-        // Queue the message.
-        std::unique_lock lock{m_uploadLock};
-        m_pendingUploadRequests.emplace(result.m_request);
-        m_uploadCv.notify_all();
-    }
+    queueRequest(result.m_request);
 
     return result;
 }
 
-void SdoManager::startWorkers()
+void SdoManager::queueRequest(Request request)
 {
-    m_stopSource = {};
-    auto ret     =
-        CO_SDOclient_setup(m_sdoClient, m_clientInfo.cobIdClientToServer, m_clientInfo.cobIdServerToClient, m_nodeId);
-    if (ret != CO_SDO_RT_ok_communicationEnd) { return; }
-
-    m_uploadWorkerThread =
-        Brigerad::MakeThread([this](std::stop_source source) { uploadWorkerThread(source.get_token()); }, m_stopSource);
-    if (!Brigerad::SetThreadName(m_uploadWorkerThread.native_handle(), "SDO Upload Worker")) {
-        BR_LOG_ERROR("SDO", "Unable to set thread description");
-    }
-    if (!Brigerad::SetThreadPriority(m_uploadWorkerThread.native_handle(), THREAD_PRIORITY_ABOVE_NORMAL)) {
-        BR_LOG_ERROR("SDO", "Unable to set thread priority!");
-    }
-    m_downloadWorkerThread =
-        Brigerad::MakeThread([this](std::stop_source source) { downloadWorkerThread(source.get_token()); },
-                             m_stopSource);
-    if (!Brigerad::SetThreadName(m_downloadWorkerThread.native_handle(), "SDO Download Worker")) {
-        BR_LOG_ERROR("SDO", "Unable to set thread description");
-    }
-    if (!Brigerad::SetThreadPriority(m_downloadWorkerThread.native_handle(), THREAD_PRIORITY_ABOVE_NORMAL)) {
-        BR_LOG_ERROR("SDO", "Unable to set thread priority!");
+    {
+        std::lock_guard lock {m_pendingLock};
+        m_pendingRequests.push_back(std::move(request));
     }
+    if (m_requestCallback) { m_requestCallback(); }
 }
 
-void SdoManager::stopWorkers()
+void SdoManager::process(uint32_t* timerNextUs)
 {
-    m_stopSource.request_stop();
-    CO_SDOclientClose(m_sdoClient);
-}
-
-void SdoManager::uploadWorkerThread(const std::stop_token& stopToken)
-{
-    m_isUploadWorkerActive = true;
-    // throw std::runtime_error("AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA!");
+    FRASY_PROFILE_FUNCTION();
+    if (m_state != TransferState::Idle && m_currentGeneration != m_generation.load()) {
+        // Started before abortPending(), the requests queued since then go on.
+        std::visit([](const auto& request) { request->abort(CO_SDO_AB_GENERAL); }, m_current);
+        m_current = {};
+        m_state   = TransferState::Idle;
+    }
+    if (m_sdoClient == nullptr) { return; }
 
-    while (!stopToken.stop_requested()) {
-        std::shared_ptr<SdoUploadRequest> request;
-        // Get the first pending request in the queue.
-        {
-            std::unique_lock lock{m_uploadLock};
-            m_uploadCv.wait(lock, stopToken, [this] { return !m_pendingUploadRequests.empty(); });
-            if (m_pendingUploadRequests.empty()) { continue; }
-            request = m_pendingUploadRequests.front();
-            m_pendingUploadRequests.pop();
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+    using std::chrono::steady_clock;
+    const auto now              = steady_clock::now();
+    auto       timeDifferenceUs = static_cast<uint32_t>(duration_cast<microseconds>(now - m_lastProcessTime).count());
+    m_lastProcessTime           = now;
+
+    // A request that ends lets the next one start right away, without waiting for the next pass.
+    while (true) {
+        if (m_state == TransferState::Idle) {
+            if (!startNextRequest()) { return; }
+            timeDifferenceUs = 0;
         }
-        FRASY_PROFILE_SCOPE("Upload Request Handling");
-
-        // If it was cancelled before it became active, ditch the request.
-        if (request->status == SdoRequestStatus::CancelRequested) {
-            request->cancel();
-            continue;
+        if (m_state == TransferState::Waiting) {
+            if (now < m_nextAttemptTime) {
+                const auto left = static_cast<uint32_t>(duration_cast<microseconds>(m_nextAttemptTime - now).count());
+                if (timerNextUs != nullptr && *timerNextUs > left) { *timerNextUs = left; }
+                return;
+            }
+            startAttempt();
+            timeDifferenceUs = 0;
         }
 
-        request->status = SdoRequestStatus::OnGoing;
-
-        CO_SDO_return_t lastReturn = CO_SDO_RT_ok_communicationEnd;
-        for (int i = 0; i <= request->retries; ++i) {
-            FRASY_PROFILE_SCOPE("Upload Request Retries");
-
-            m_isWorkerWorking.wait(true);      // Wait until it's false lol
-            m_isWorkerWorking          = true; // "Lock" the workers.
-            auto [handlerCode, coCode] = handleUploadRequest(*request);
-            m_isWorkerWorking          = false;
-            m_isWorkerWorking.notify_one();
+        const auto code = std::visit(
+          [&]<typename T>(const std::shared_ptr<T>& request) {
+              if constexpr (std::is_same_v<T, SdoUploadRequest>) {
+                  return processUpload(*request, timeDifferenceUs, timerNextUs);
+              }
+              else {
+                  return processDownload(*request, timeDifferenceUs, timerNextUs);
+              }
+          },
+          m_current);
+        if (code == HandlerReturnCode::busy) { return; }
+        endAttempt(code);
+        timeDifferenceUs = 0;
+    }
+}
 
-            lastReturn = coCode;
-            if (handlerCode == HandlerReturnCode::ok) {
-                request->markAsComplete(std::span(request->data));
-                break;
-            }
-            if (handlerCode == HandlerReturnCode::cancel) {
-                request->cancel();
-                break;
-            }
-            BR_LOG_WARN(s_cliTag,
-                        "SDO Failure. Node {:02x}, index {:04x}, sub {:02x}, attempt {}, abort code {}, CO code {}",
-                        request->nodeId,
-                        request->index,
-                        request->subIndex,
-                        i + 1,
-                        request->abortCode,
-                        coCode);
-            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+bool SdoManager::startNextRequest()
+{
+    while (true) {
+        {
+            std::lock_guard lock {m_pendingLock};
+            if (m_pendingRequests.empty()) { return false; }
+            m_current = std::move(m_pendingRequests.front());
+            m_pendingRequests.pop_front();
+            m_currentGeneration = m_generation.load();
         }
-        if (request->status == SdoRequestStatus::OnGoing) { request->markAsComplete(std::unexpected(lastReturn)); }
+        const bool started = std::visit(
+          [this](const auto& request) {
+              // If it was cancelled before it became active, ditch the request.
+              if (request->status == SdoRequestStatus::CancelRequested) {
+                  request->cancel();
+                  return false;
+              }
+              request->status = SdoRequestStatus::OnGoing;
+              m_isBlock       = request->isBlock;
+              return true;
+          },
+          m_current);
+        if (started) { break; }
     }
-
-    m_isUploadWorkerActive = false;
+    m_attempt = 0;
+    startAttempt();
+    return true;
 }
 
-std::tuple<SdoManager::HandlerReturnCode, CO_SDO_return_t> SdoManager::handleUploadRequest(SdoUploadRequest& request)
+void SdoManager::startAttempt()
 {
-    FRASY_PROFILE_FUNCTION();
-    // Initiate the upload.
-    auto ret =
-        CO_SDOclientUploadInitiate(m_sdoClient, request.index, request.subIndex, request.sdoTimeoutMs, request.isBlock);
-    if (ret != CO_SDO_RT_ok_communicationEnd) { return std::make_tuple(HandlerReturnCode::error, ret); }
+    // Every attempt starts the transfer over, drop what a failed one left behind.
+    std::visit(
+      []<typename T>(const std::shared_ptr<T>& request) {
+          if constexpr (std::is_same_v<T, SdoUploadRequest>) {
+              request->data.clear();
+              request->sizeIndicated = 0;
+          }
+          request->sizeTransferred = 0;
+          request->abortCode       = CO_SDO_AB_NONE;
+      },
+      m_current);
+    m_isBlock      = m_isBlock && !m_blockTransferRefused;
+    m_initiated    = false;
+    m_bytesWritten = 0;
+    m_state        = TransferState::Active;
+}
 
-    using std::chrono::duration_cast;
-    using std::chrono::microseconds;
-    using std::chrono::milliseconds;
-    using std::chrono::steady_clock;
-    auto     last  = steady_clock::now();
-    uint32_t delta = 0;
-    // Upload the data.
-    do {
-        FRASY_PROFILE_SCOPE("SDO Upload Loop");
-        if (request.status == SdoRequestStatus::CancelRequested) {
-            return std::make_tuple(HandlerReturnCode::cancel, CO_SDO_RT_ok_communicationEnd);
-        }
-        uint32_t timeToSleep = 1'000; // 1ms
+void SdoManager::endAttempt(HandlerReturnCode code)
+{
+    std::visit(
+      [&]<typename T>(const std::shared_ptr<T>& request) {
+          auto complete = [&] {
+              if constexpr (std::is_same_v<T, SdoUploadRequest>) {
+                  if (code == HandlerReturnCode::ok) { request->markAsComplete(std::span(request->data)); }
+                  else {
+                      request->markAsComplete(std::unexpected(m_lastReturn));
+                  }
+              }
+              else {
+                  request->markAsComplete(m_lastReturn);
+              }
+              m_state = TransferState::Idle;
+          };
+
+          if (code == HandlerReturnCode::ok) {
+              complete();
+              return;
+          }
+          if (code == HandlerReturnCode::cancel) {
+              request->cancel();
+              m_state = TransferState::Idle;
+              return;
+          }
+          if (fallBackFromBlock(m_isBlock, request->sizeTransferred, request->abortCode)) {
+              // The protocol was refused, not the request, it doesn't count as an attempt.
+              m_isBlock = false;
+              startAttempt();
+              return;
+          }
+          BR_LOG_WARN(s_cliTag,
+                      "SDO Failure. Node {:02x}, index {:04x}, sub {:02x}, attempt {}, abort code {}, CO code {}",
+                      request->nodeId,
+                      request->index,
+                      request->subIndex,
+                      m_attempt + 1,
+                      request->abortCode,
+                      m_lastReturn);
+          if (++m_attempt > request->retries) {
+              complete();
+              return;
+          }
+          m_nextAttemptTime = std::chrono::steady_clock::now() + s_retryDelay;
+          m_state           = TransferState::Waiting;
+      },
+      m_current);
+    if (m_state == TransferState::Idle) { m_current = {}; }
+}
 
-        // Check and update the status of the upload.
-        {
-            FRASY_PROFILE_SCOPE("CO_SDOclientUpload");
-            ret = CO_SDOclientUpload(m_sdoClient,
-                                     delta,
-                                     request.abortCode != CO_SDO_AB_NONE && request.status != SdoRequestStatus::OnGoing,
-                                     &request.abortCode,
-                                     &request.sizeIndicated,
-                                     &request.sizeTransferred,
-                                     &timeToSleep);
-        }
+void SdoManager::abortPending()
+{
+    // The queued requests aren't touched by the CANopen thread, they are failed from here.
+    std::deque<Request> queued;
+    {
+        std::lock_guard lock {m_pendingLock};
+        queued.swap(m_pendingRequests);
+        ++m_generation;
+    }
+    for (auto& request : queued) {
+        std::visit([](const auto& r) { r->abort(CO_SDO_AB_GENERAL); }, request);
+    }
+    // Wakes the CANopen thread up, for the request in progress.
+    if (m_requestCallback) { m_requestCallback(); }
+}
 
-        if (ret < 0) {
-            // < 0 = error code, we gotta stop.
-            return std::make_tuple(HandlerReturnCode::error, ret);
-        }
+void SdoManager::abortAll()
+{
+    std::deque<Request> pending;
+    {
+        std::lock_guard lock {m_pendingLock};
+        pending.swap(m_pendingRequests);
+    }
+    if (m_state != TransferState::Idle) { pending.push_front(std::move(m_current)); }
+    m_current = {};
+    m_state   = TransferState::Idle;
+    for (auto& request : pending) {
+        std::visit(
+          [](const auto& r) {
+              if (r != nullptr) { r->abort(CO_SDO_AB_GENERAL); }
+          },
+          request);
+    }
+}
 
-        if (ret == CO_SDO_RT_uploadDataBufferFull) {
-            readUploadBufferIntoRequest(request);
-            // We're allowed to call upload again immediately when it returns CO_SDO_RT_uploadDataBufferFull.
-            timeToSleep = 0;
-        }
+SdoManager::HandlerReturnCode SdoManager::processUpload(SdoUploadRequest& request,
+                                                        uint32_t          timeDifferenceUs,
+                                                        uint32_t*         timerNextUs)
+{
+    FRASY_PROFILE_FUNCTION();
+    const bool cancel = request.status == SdoRequestStatus::CancelRequested;
+    if (!m_initiated) {
+        if (cancel) { return HandlerReturnCode::cancel; }
+        // With a block transfer, the server can still answer with a segmented one for small objects.
+        m_lastReturn =
+          CO_SDOclientUploadInitiate(m_sdoClient, request.index, request.subIndex, request.sdoTimeoutMs, m_isBlock);
+        if (m_lastReturn != CO_SDO_RT_ok_communicationEnd) { return HandlerReturnCode::error; }
+        m_initiated = true;
+    }
 
-        if (ret != CO_SDO_RT_ok_communicationEnd) {
-            delta = static_cast<uint32_t>(duration_cast<microseconds>(steady_clock::now() - last).count());
-            last  = steady_clock::now();
-        }
-    } while (ret != CO_SDO_RT_ok_communicationEnd);
+    // Cancelling sends an abort to the server.
+    m_lastReturn = CO_SDOclientUpload(m_sdoClient,
+                                      timeDifferenceUs,
+                                      cancel,
+                                      &request.abortCode,
+                                      &request.sizeIndicated,
+                                      &request.sizeTransferred,
+                                      timerNextUs);
+    if (cancel) { return HandlerReturnCode::cancel; }
+    if (m_lastReturn < 0) { return HandlerReturnCode::error; }
+    if (m_lastReturn == CO_SDO_RT_uploadDataBufferFull) {
+        readUploadBufferIntoRequest(request);
+        // We're allowed to call upload again immediately when it returns CO_SDO_RT_uploadDataBufferFull.
+        if (timerNextUs != nullptr) { *timerNextUs = 0; }
+        return HandlerReturnCode::busy;
+    }
+    if (m_lastReturn != CO_SDO_RT_ok_communicationEnd) { return HandlerReturnCode::busy; }
 
     readUploadBufferIntoRequest(request);
     BR_LOG_TRACE(s_cliTag,
@@ -281,178 +361,110 @@ std::tuple<SdoManager::HandlerReturnCode, CO_SDO_return_t> SdoManager::handleUpl
                  request.nodeId,
                  request.index,
                  request.subIndex);
-    return std::make_tuple(HandlerReturnCode::ok, ret);
+    return HandlerReturnCode::ok;
 }
 
 void SdoManager::readUploadBufferIntoRequest(SdoUploadRequest& request)
 {
     FRASY_PROFILE_FUNCTION();
+    // Bulk uploads (sample buffers, domains) indicate their size, read the FIFO straight into the request.
+    if (request.sizeIndicated > request.data.capacity()) { request.data.reserve(request.sizeIndicated); }
     size_t read = 0;
     do {
-        uint8_t tmp[16] = {};
-        read            = CO_SDOclientUploadBufRead(m_sdoClient, &tmp[0], sizeof(tmp));
-        request.data.insert(request.data.end(), std::begin(tmp), std::begin(tmp) + read);
+        const size_t offset = request.data.size();
+        request.data.resize(offset + s_uploadReadChunk);
+        read = CO_SDOclientUploadBufRead(m_sdoClient, request.data.data() + offset, s_uploadReadChunk);
+        request.data.resize(offset + read);
     } while (read > 0);
 }
 
-void SdoManager::downloadWorkerThread(const std::stop_token& stopToken)
+SdoManager::HandlerReturnCode SdoManager::processDownload(SdoDownloadRequest& request,
+                                                          uint32_t            timeDifferenceUs,
+                                                          uint32_t*           timerNextUs)
 {
-    m_isDownloadWorkerActive = true;
-
-    while (!stopToken.stop_requested()) {
-        std::shared_ptr<SdoDownloadRequest> request;
-        // Get the first pending request in the queue.
-        {
-            std::unique_lock lock{m_downloadLock};
-            m_downloadCv.wait(lock, stopToken, [this] { return !m_pendingDownloadRequests.empty(); });
-            // If we got out of the wait because of the stopToken, we don't want to handle an empty object.
-            if (m_pendingDownloadRequests.empty()) { continue; }
-            request = m_pendingDownloadRequests.front();
-            m_pendingDownloadRequests.pop();
-        }
-        FRASY_PROFILE_SCOPE("Download Request Handling");
-
-        // If it was cancelled before it became active, ditch the request.
-        if (request->status == SdoRequestStatus::CancelRequested) {
-            request->cancel();
-            continue;
-        }
+    FRASY_PROFILE_FUNCTION();
+    const bool cancel = request.status == SdoRequestStatus::CancelRequested;
+    if (!m_initiated) {
+        if (cancel) { return HandlerReturnCode::cancel; }
+        m_lastReturn = CO_SDOclientDownloadInitiate(
+          m_sdoClient, request.index, request.subIndex, request.data.size(), request.sdoTimeoutMs, m_isBlock);
+        if (m_lastReturn != CO_SDO_RT_ok_communicationEnd) { return HandlerReturnCode::error; }
+        m_initiated = true;
+    }
 
-        request->status = SdoRequestStatus::OnGoing;
-        for (uint8_t i = 0; i <= request->retries; ++i) {
-            m_isWorkerWorking.wait(true);      // Wait until it's false lol
-            m_isWorkerWorking          = true; // "Lock" the workers.
-            auto [handlerCode, coCode] = handleDownloadRequest(*request);
-            m_isWorkerWorking          = false;
-            m_isWorkerWorking.notify_one();
-
-            if (handlerCode == HandlerReturnCode::ok) {
-                request->markAsComplete(coCode);
-                break;
-            }
-            if (handlerCode == HandlerReturnCode::cancel) {
-                request->cancel();
-                break;
-            }
-            BR_LOG_WARN(s_cliTag,
-                        "SDO Failure. Node {:02x}, index {:04x}, sub {:02x}, attempt {}, abort code {}, CO code {}",
-                        request->nodeId,
-                        request->index,
-                        request->subIndex,
-                        i + 1,
-                        request->abortCode,
-                        coCode);
-            std::this_thread::sleep_for(std::chrono::milliseconds(50));
-            if (i == request->retries) { request->markAsComplete(coCode); }
-        }
+    // Keep the client's FIFO filled with what it didn't take yet.
+    if (m_bytesWritten < request.data.size()) {
+        m_bytesWritten += CO_SDOclientDownloadBufWrite(
+          m_sdoClient, request.data.data() + m_bytesWritten, request.data.size() - m_bytesWritten);
     }
 
-    m_isDownloadWorkerActive = false;
+    m_lastReturn = CO_SDOclientDownload(m_sdoClient,
+                                        timeDifferenceUs,
+                                        cancel,
+                                        m_bytesWritten < request.data.size(),
+                                        &request.abortCode,
+                                        &request.sizeTransferred,
+                                        timerNextUs);
+    if (cancel) { return HandlerReturnCode::cancel; }
+    if (m_lastReturn < 0) { return HandlerReturnCode::error; }
+    if (m_lastReturn != CO_SDO_RT_ok_communicationEnd) { return HandlerReturnCode::busy; }
+
+    BR_LOG_TRACE(s_cliTag,
+                 "Downloaded {} bytes to node {:02x}, index {:04x}, sub {:02x}",
+                 request.data.size(),
+                 request.nodeId,
+                 request.index,
+                 request.subIndex);
+    return HandlerReturnCode::ok;
 }
 
-std::tuple<SdoManager::HandlerReturnCode, CO_SDO_return_t> SdoManager::handleDownloadRequest(
-    SdoDownloadRequest& request)
+bool SdoManager::fallBackFromBlock(bool isBlock, size_t sizeTransferred, CO_SDO_abortCode_t abortCode)
 {
-    FRASY_PROFILE_FUNCTION();
-    // Initiate the download.
-    auto ret = CO_SDOclientDownloadInitiate(
-        m_sdoClient,
-        request.index,
-        request.subIndex,
-        request.data.size(),
-        request.sdoTimeoutMs,
-        request.isBlock);
-    if (ret != CO_SDO_RT_ok_communicationEnd) {
-        return std::make_tuple(HandlerReturnCode::error, ret);
-        // request.markAsComplete(ret);
-        // return;
+    // Once data went through, the server accepted the block transfer and failed for another reason.
+    if (!isBlock || sizeTransferred != 0) { return false; }
+    switch (abortCode) {
+        case CO_SDO_AB_NONE:
+        case CO_SDO_AB_TIMEOUT:
+        case CO_SDO_AB_CMD:
+        case CO_SDO_AB_BLOCK_SIZE:
+        case CO_SDO_AB_SEQ_NUM:
+        case CO_SDO_AB_CRC:
+        case CO_SDO_AB_GENERAL: break;
+        // The object itself is refused (doesn't exist, access denied...), a segmented transfer would be too.
+        default: return false;
     }
-
-    using std::chrono::duration_cast;
-    using std::chrono::microseconds;
-    using std::chrono::milliseconds;
-    using std::chrono::steady_clock;
-    auto     last  = steady_clock::now();
-    uint32_t delta = 0;
-    // Upload the data.
-    size_t lastTransSize = static_cast<size_t>(-1);
-    // Write a first bunch of data into the buffer.
-    size_t totalBytesWritten =
-        CO_SDOclientDownloadBufWrite(m_sdoClient,
-                                     request.data.data() + request.sizeTransferred,
-                                     request.data.size() - std::min(request.sizeTransferred, request.data.size()));
-    do {
-        FRASY_PROFILE_SCOPE("SDO Download Loop");
-        if (request.status == SdoRequestStatus::CancelRequested) {
-            return std::make_tuple(HandlerReturnCode::cancel, CO_SDO_RT_ok_communicationEnd);
-        }
-        uint32_t timeToSleep = 1000; // 1ms
-
-        // Fill data if we need to send the next packet.
-        if (request.sizeTransferred == totalBytesWritten && totalBytesWritten < request.data.size()) {
-            size_t written = CO_SDOclientDownloadBufWrite(m_sdoClient,
-                                                          request.data.data() + request.sizeTransferred,
-                                                          request.data.size() -
-                                                          std::min(request.sizeTransferred, request.data.size()));
-            totalBytesWritten += written;
-            BR_LOG_DEBUG(
-                s_cliTag,
-                "Written {} more bytes to buffer. ({}/{})",
-                written,
-                totalBytesWritten,
-                request.data.size());
-        }
-
-        {
-            FRASY_PROFILE_SCOPE("CO_SDOclientDownload");
-            bool bufferPartial = totalBytesWritten < request.data.size();
-            ret                =
-                CO_SDOclientDownload(m_sdoClient,
-                                     delta,
-                                     request.abortCode != CO_SDO_AB_NONE && request.status != SdoRequestStatus::OnGoing,
-                                     bufferPartial,
-                                     &request.abortCode,
-                                     &request.sizeTransferred,
-                                     &timeToSleep);
-        }
-        if (ret < 0) {
-            // < 0 = error code, we gotta stop.
-            return std::make_tuple(HandlerReturnCode::error, ret);
-        }
-
-        if (request.sizeTransferred != lastTransSize) {
-            lastTransSize = request.sizeTransferred;
-            BR_LOG_DEBUG(s_cliTag,
-                         "Transferred {} bytes over to remote node. ({}/{})",
-                         request.sizeTransferred,
-                         request.sizeTransferred,
-                         request.data.size());
-        }
-
-        if (ret != CO_SDO_RT_ok_communicationEnd) {
-            delta = static_cast<uint32_t>(duration_cast<microseconds>(steady_clock::now() - last).count());
-            last  = steady_clock::now();
-        }
-    } while (ret != CO_SDO_RT_ok_communicationEnd);
-
-    return std::make_tuple(HandlerReturnCode::ok, ret);
+    if (abortCode == CO_SDO_AB_CMD && !m_blockTransferRefused.exchange(true)) {
+        BR_LOG_INFO(s_cliTag, "Node {:02x} doesn't support block transfers, using segmented transfers", m_nodeId);
+    }
+    else {
+        BR_LOG_DEBUG(s_cliTag, "Block transfer failed on node {:02x} ({}), retrying as segmented", m_nodeId, abortCode);
+    }
+    return true;
 }
 
 void SdoManager::setNodeId(uint8_t nodeId)
 {
-    m_nodeId = nodeId;
-    startWorkers();
+    m_nodeId               = nodeId;
+    m_blockTransferRefused = false;
 }
 
 void SdoManager::setSdoClient(CO_SDOclient_t* sdoClient)
 {
-    m_sdoClient = sdoClient;
-    startWorkers();
+    if (sdoClient != nullptr &&
+        CO_SDOclient_setup(sdoClient, m_clientInfo.cobIdClientToServer, m_clientInfo.cobIdServerToClient, m_nodeId) !=
+          CO_SDO_RT_ok_communicationEnd) {
+        BR_LOG_ERROR(s_cliTag, "Unable to set up the SDO client of node {:02x}", m_nodeId);
+        sdoClient = nullptr;
+    }
+    m_sdoClient       = sdoClient;
+    m_lastProcessTime = std::chrono::steady_clock::now();
 }
 
 void SdoManager::removeSdoClient()
 {
-    m_stopSource.request_stop();
+    // The transfers can't go on without the client, their owners are better off retrying than waiting forever.
+    abortAll();
+    if (m_sdoClient != nullptr) { CO_SDOclientClose(m_sdoClient); }
     m_sdoClient = nullptr;
 }
 } // namespace Frasy::CanOpen
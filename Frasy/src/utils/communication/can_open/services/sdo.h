@@ -20,22 +20,24 @@
 #define FRASY_UTILS_COMMUNICATION_CAN_OPEN_SERVICES_SDO_H
 #include "Brigerad/Core/Core.h"
 #include "sdo_downloader.h"
+#include "sdo_transfer_mode.h"
 #include "sdo_uploader.h"
 
 #include <CO_ODinterface.h>
 #include <CO_SDOclient.h>
 
 #include <atomic>
-#include <condition_variable>
+#include <chrono>
 #include <cstdint>
+#include <deque>
 #include <expected>
 #include <functional>
 #include <memory>
-#include <queue>
+#include <mutex>
 #include <span>
 #include <string>
-#include <thread>
 #include <cstring>
+#include <variant>
 #include <utils/lua/profile_events.h>
 
 namespace Frasy::CanOpen {
@@ -48,15 +50,44 @@ struct SdoClientInfo {
     uint8_t  highestSubIndex     = 3;
 };
 
+/**
+ * SDO client of a remote node.
+ *
+ * Requests are queued from any thread and served one at a time, in order, by process(), which the CANopen thread calls
+ * on every pass of its main loop. The futures of the requests are resolved from that thread.
+ */
 class SdoManager {
     friend Node;
 
 public:
     SdoManager();
     explicit SdoManager(uint8_t nodeId);
+    ~SdoManager();
+    SdoManager(const SdoManager&)            = delete;
+    SdoManager& operator=(const SdoManager&) = delete;
+
+    [[nodiscard]] bool   hasRequestsPending() const;
+    [[nodiscard]] size_t requestsPending() const;
+
+    //! Called whenever a request is queued, so the thread calling process() can be woken up.
+    void setRequestCallbackFunc(std::function<void()> callback) { m_requestCallback = std::move(callback); }
+
+    /**
+     * Advances the transfer in progress, and starts the next queued one when it's done.
+     * Must only be called from the CANopen thread, after the received frames were polled.
+     *
+     * @param timerNextUs Lowered to the time after which process() must be called again, if it's sooner.
+     */
+    void process(uint32_t* timerNextUs);
 
-    [[nodiscard]] bool   hasUploadRequestsPending() const;
-    [[nodiscard]] size_t uploadRequestsPending() const;
+    /**
+     * Fails the requests queued so far, for when their transfers can't complete anymore, such as after the port was
+     * reopened. Can be called from any thread.
+     *
+     * The queued requests are failed right away, the one in progress on the next call to process(). The requests queued
+     * after the call aren't affected.
+     */
+    void abortPending();
 
     [[nodiscard]] OD_entry_t makeSdoClientOdEntry() const;
 
@@ -66,27 +97,35 @@ public:
      * @param index Index of object in the object dictionary of the remotet node.
      * @param subIndex Sub-index of object in the object dictionary of the remote node.
      * @param sdoTimeoutTimeMs Timeout time (in milliseconds) for SDO communication.
-     * @param isBlock Try to initiate a block transfer.
+     * @param mode Protocol of the transfer. In auto mode, strings are uploaded with a block transfer.
      * @return On success, returns a future on which the entire data transfered can be received, as well as values that
      * can be used to keep track of the transfer. On failure, returns the reason.
      */
-    SdoUploadDataResult uploadData(uint16_t index,
-                                   uint8_t  subIndex,
-                                   uint16_t sdoTimeoutTimeMs = 1000,
-                                   uint8_t  retries          = 5,
-                                   bool     isBlock          = false,
-                                   VarType  type             = VarType::Undefined);
+    SdoUploadDataResult uploadData(uint16_t        index,
+                                   uint8_t         subIndex,
+                                   uint16_t        sdoTimeoutTimeMs = 1000,
+                                   uint8_t         retries          = 5,
+                                   SdoTransferMode mode             = SdoTransferMode::Auto,
+                                   VarType         type             = VarType::Undefined);
 
+    /**
+     * Initiates a transfer of data from Frasy to a remote node.
+     *
+     * In auto mode, the data of s_blockTransferThreshold bytes or more is sent with a block transfer.
+     */
     template<std::ranges::range R>
-    SdoDownloadDataResult downloadData(uint16_t index,
-                                       uint8_t  subIndex,
-                                       R&&      data,
-                                       uint16_t sdoTimeoutTimeMs = 1000,
-                                       uint8_t  retries          = 5,
-                                       bool     isBlock          = false)
+    SdoDownloadDataResult downloadData(uint16_t        index,
+                                       uint8_t         subIndex,
+                                       R&&             data,
+                                       uint16_t        sdoTimeoutTimeMs = 1000,
+                                       uint8_t         retries          = 5,
+                                       SdoTransferMode mode             = SdoTransferMode::Auto)
     {
         FRASY_PROFILE_FUNCTION();
         SdoDownloadDataResult result;
+        auto                  bytes   = std::ranges::to<std::vector<uint8_t>>(data);
+        const bool            isBlock = mode == SdoTransferMode::Block ||
+                             (mode == SdoTransferMode::Auto && bytes.size() >= s_blockTransferThreshold);
         result.m_request = std::make_shared<SdoDownloadRequest>(SdoRequestStatus::Queued,
                                                                 m_nodeId,
                                                                 index,
@@ -94,22 +133,17 @@ public:
                                                                 isBlock,
                                                                 sdoTimeoutTimeMs,
                                                                 retries,
-                                                                std::ranges::to<std::vector<uint8_t>>(data));
+                                                                std::move(bytes));
 
         result.future = result.m_request->promise.get_future();
 
-        if (!isAbleToMakeUploadRequests()) {
+        if (!isAbleToMakeRequests()) {
             // It's impossible to make requests without a client to talk with!
             result.m_request->abort(CO_SDO_AB_GENERAL);
             return result;
         }
 
-        {
-            // Queue the message.
-            std::unique_lock lock {m_downloadLock};
-            m_pendingDownloadRequests.emplace(result.m_request);
-            m_downloadCv.notify_all();
-        }
+        queueRequest(result.m_request);
 
         BR_ASSERT(result.future.valid(), "Future is not valid!");
 
@@ -118,12 +152,12 @@ public:
 
     template<typename T>
         requires std::is_trivially_copyable_v<T>
-    SdoDownloadDataResult downloadData(uint16_t index,
-                                       uint8_t  subIndex,
-                                       const T& data,
-                                       uint16_t sdoTimeoutTimeMs = 1000,
-                                       uint8_t  tries            = 5,
-                                       bool     isBlock          = false)
+    SdoDownloadDataResult downloadData(uint16_t        index,
+                                       uint8_t         subIndex,
+                                       const T&        data,
+                                       uint16_t        sdoTimeoutTimeMs = 1000,
+                                       uint8_t         tries            = 5,
+                                       SdoTransferMode mode             = SdoTransferMode::Auto)
     {
         FRASY_PROFILE_FUNCTION();
         return downloadData(
@@ -136,30 +170,52 @@ public:
           }(),
           sdoTimeoutTimeMs,
           tries,
-          isBlock);
+          mode);
     }
 
+    //! True once the node aborted a block transfer as unsupported, its transfers are all segmented from then on.
+    [[nodiscard]] bool isBlockTransferRefused() const { return m_blockTransferRefused; }
+
+    //! Size from which a block transfer takes fewer frames than a segmented one, 3 segments and more.
+    static constexpr size_t s_blockTransferThreshold = 21;
+    //! Bytes moved out of the client's FIFO per read, a full block (127 segments) takes a handful of reads.
+    static constexpr size_t s_uploadReadChunk = 256;
+
 private:
     enum class HandlerReturnCode : uint8_t {
         ok,
         error,
         cancel,
+        busy,    //!< The transfer is still in progress.
     };
 
-    [[nodiscard]] bool isAbleToMakeUploadRequests() const
-    {
-        return m_isUploadWorkerActive && m_isDownloadWorkerActive && m_nodeId != s_noNodeId && m_sdoClient != nullptr;
-    }
+    enum class TransferState : uint8_t {
+        Idle,       //!< No request being served.
+        Active,     //!< An attempt of the current request is in progress.
+        Waiting,    //!< The last attempt failed, waiting before the next one.
+    };
 
-    void startWorkers();
-    void stopWorkers();
+    using Request = std::variant<std::shared_ptr<SdoUploadRequest>, std::shared_ptr<SdoDownloadRequest>>;
 
-    void                                           uploadWorkerThread(const std::stop_token& stopToken);
-    std::tuple<HandlerReturnCode, CO_SDO_return_t> handleUploadRequest(SdoUploadRequest& request);
-    void                                           readUploadBufferIntoRequest(SdoUploadRequest& request);
+    [[nodiscard]] bool isAbleToMakeRequests() const { return m_nodeId != s_noNodeId && m_sdoClient != nullptr; }
 
-    void                                           downloadWorkerThread(const std::stop_token& stopToken);
-    std::tuple<HandlerReturnCode, CO_SDO_return_t> handleDownloadRequest(SdoDownloadRequest& request);
+    void queueRequest(Request request);
+    //! Takes the next request that wasn't cancelled, returns false if there is none.
+    bool startNextRequest();
+    void startAttempt();
+    //! Ends the attempt, then either completes the request or schedules the next attempt.
+    void endAttempt(HandlerReturnCode code);
+    //! Fails the request in progress and every queued one.
+    void abortAll();
+
+    HandlerReturnCode processUpload(SdoUploadRequest& request, uint32_t timeDifferenceUs, uint32_t* timerNextUs);
+    void              readUploadBufferIntoRequest(SdoUploadRequest& request);
+    HandlerReturnCode processDownload(SdoDownloadRequest& request, uint32_t timeDifferenceUs, uint32_t* timerNextUs);
+    /**
+     * Decide whether a block transfer that failed should be tried again as a segmented one.
+     * Remembers that the node doesn't support block transfers when it says so.
+     */
+    bool fallBackFromBlock(bool isBlock, size_t sizeTransferred, CO_SDO_abortCode_t abortCode);
 
     void setNodeId(uint8_t nodeId);
     void setSdoClient(CO_SDOclient_t* sdoClient);
@@ -173,22 +229,25 @@ private:
     SdoClientInfo                    m_clientInfo;
     std::unique_ptr<OD_obj_record_t[]> m_odObjRecord;
 
-    //! Used to atomize SDO transactions.
-    std::atomic_bool                                m_isWorkerWorking = false;
-    std::queue<std::shared_ptr<SdoUploadRequest>>   m_pendingUploadRequests;
-    std::queue<std::shared_ptr<SdoDownloadRequest>> m_pendingDownloadRequests;
-
-    std::stop_source m_stopSource;
-
-    std::mutex                  m_uploadLock;
-    std::condition_variable_any m_uploadCv;
-    bool                        m_isUploadWorkerActive = false;
-    std::jthread                m_uploadWorkerThread;
-
-    std::mutex                  m_downloadLock;
-    std::condition_variable_any m_downloadCv;
-    bool                        m_isDownloadWorkerActive = false;
-    std::jthread                m_downloadWorkerThread;
+    std::atomic_bool      m_blockTransferRefused = false;
+    mutable std::mutex    m_pendingLock;
+    std::deque<Request>   m_pendingRequests;
+    std::function<void()> m_requestCallback;
+    //! Incremented by abortPending() under m_pendingLock, the request in progress is failed if it is from before.
+    std::atomic_uint64_t  m_generation = 0;
+
+    // Only touched by the CANopen thread.
+    static constexpr auto                 s_retryDelay = std::chrono::milliseconds {50};
+    Request                               m_current;
+    TransferState                         m_state             = TransferState::Idle;
+    uint64_t                              m_currentGeneration = 0;    //!< Generation m_current was started under.
+    bool                                  m_isBlock           = false;
+    bool                                  m_initiated         = false;
+    int                                   m_attempt           = 0;
+    CO_SDO_return_t                       m_lastReturn        = CO_SDO_RT_ok_communicationEnd;
+    size_t                                m_bytesWritten      = 0;
+    std::chrono::steady_clock::time_point m_lastProcessTime   = {};
+    std::chrono::steady_clock::time_point m_nextAttemptTime   = {};
 
     static constexpr const char* s_cliTag = "SDO Client";
     static constexpr const char* s_srvTag = "SDO Server";
@@ -0,0 +1,32 @@
+/**
+ * @file    sdo_transfer_mode.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+
+#ifndef FRASY_UTILS_COMMUNICATION_CAN_OPEN_SERVICES_SDO_TRANSFER_MODE_H
+#define FRASY_UTILS_COMMUNICATION_CAN_OPEN_SERVICES_SDO_TRANSFER_MODE_H
+
+#include <cstdint>
+
+namespace Frasy::CanOpen {
+enum class SdoTransferMode : uint8_t {
+    Auto = 0,     //!< Block transfer for the large or variable-sized objects, segmented otherwise.
+    Segmented,    //!< Expedited or segmented transfer.
+    Block,        //!< Block transfer, falls back to segmented if the server refuses it.
+};
+}
+
+#endif    // FRASY_UTILS_COMMUNICATION_CAN_OPEN_SERVICES_SDO_TRANSFER_MODE_H
@@ -0,0 +1,292 @@
+/**
+ * @file    eds_dictionary.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <https://www.gnu.org/licenses/>.
+ */
+#include "eds_dictionary.h"
+
+#include <Brigerad.h>
+
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <charconv>
+#include <fstream>
+#include <sstream>
+
+namespace Frasy::CanOpen {
+namespace {
+constexpr auto s_tag = "EDS";
+
+constexpr uint8_t s_objectTypeDomain = 0x2;
+constexpr uint8_t s_objectTypeVar    = 0x7;
+
+std::string_view trim(std::string_view text)
+{
+    constexpr std::string_view whitespace = " \t\r\n";
+    const auto                 first      = text.find_first_not_of(whitespace);
+    if (first == std::string_view::npos) { return {}; }
+    return text.substr(first, text.find_last_not_of(whitespace) - first + 1);
+}
+
+bool equalsNoCase(std::string_view a, std::string_view b)
+{
+    return std::ranges::equal(a, b, [](char l, char r) { return std::tolower(l) == std::tolower(r); });
+}
+
+//! Integer in the EDS notation: decimal, or hexadecimal with 0x. Octal isn't used by any editor we know of.
+template<typename T>
+std::optional<T> parseInteger(std::string_view text)
+{
+    text = trim(text);
+    int base = 10;
+    if (text.size() > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X')) {
+        base = 16;
+        text.remove_prefix(2);
+    }
+    T value {};
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value, base);
+    if (error != std::errc {} || end != text.data() + text.size()) { return std::nullopt; }
+    return value;
+}
+
+/**
+ * Section names are the index of the object, "1018", or the index and sub-index of a sub-object, "1018sub1".
+ * @return std::nullopt for the other sections, like [DeviceInfo].
+ */
+std::optional<std::pair<uint16_t, std::optional<uint8_t>>> parseSectionName(std::string_view name)
+{
+    if (name.size() < 4) { return std::nullopt; }
+    const auto index = parseInteger<uint16_t>(std::string {"0x"} + std::string {name.substr(0, 4)});
+    if (!index) { return std::nullopt; }
+    name.remove_prefix(4);
+    if (name.empty()) { return std::pair {*index, std::optional<uint8_t> {}}; }
+    if (!equalsNoCase(name.substr(0, std::min<std::size_t>(3, name.size())), "sub")) { return std::nullopt; }
+    const auto subIndex = parseInteger<uint8_t>(std::string {"0x"} + std::string {name.substr(3)});
+    if (!subIndex) { return std::nullopt; }
+    return std::pair {*index, std::optional<uint8_t> {*subIndex}};
+}
+
+template<typename T>
+void appendLittleEndian(std::vector<uint8_t>& bytes, T value, std::size_t size)
+{
+    auto raw = static_cast<uint64_t>(value);
+    for (std::size_t i = 0; i < size; ++i) {
+        bytes.push_back(static_cast<uint8_t>(raw >> (8 * i)));
+    }
+}
+
+bool isSigned(DataType type)
+{
+    switch (type) {
+        case DataType::integer8:
+        case DataType::integer16:
+        case DataType::integer24:
+        case DataType::integer32:
+        case DataType::integer40:
+        case DataType::integer48:
+        case DataType::integer56:
+        case DataType::integer64: return true;
+        default: return false;
+    }
+}
+
+std::vector<uint8_t> parseValue(const EdsEntry& entry, std::string_view text, uint8_t nodeId)
+{
+    std::vector<uint8_t> bytes;
+    switch (entry.dataType) {
+        case DataType::visibleString:
+        case DataType::unicodeString: return {text.begin(), text.end()};
+        case DataType::domain: return {};
+        case DataType::octetString: {
+            // Pairs of hexadecimal digits, the spaces between the bytes are optional.
+            std::string digits;
+            std::ranges::copy_if(text, std::back_inserter(digits), [](char c) { return std::isspace(c) == 0; });
+            for (std::size_t i = 0; i + 1 < digits.size(); i += 2) {
+                auto byte = parseInteger<uint8_t>("0x" + digits.substr(i, 2));
+                if (!byte) { return {}; }
+                bytes.push_back(*byte);
+            }
+            return bytes;
+        }
+        case DataType::real32:
+        case DataType::real64: {
+            const std::string number {trim(text)};
+            char*             end = nullptr;
+            const double      real = number.empty() ? 0.0 : std::strtod(number.c_str(), &end);
+            if (!number.empty() && end != number.c_str() + number.size()) {
+                BR_LOG_WARN(s_tag, "Invalid real '{}' for {:04x}sub{:x}", number, entry.index, entry.subIndex);
+            }
+            if (entry.dataType == DataType::real32) {
+                appendLittleEndian(bytes, std::bit_cast<uint32_t>(static_cast<float>(real)), 4);
+            }
+            else {
+                appendLittleEndian(bytes, std::bit_cast<uint64_t>(real), 8);
+            }
+            return bytes;
+        }
+        default: break;
+    }
+
+    // Integers, possibly relative to the node ID: "$NODEID+0x180" or "0x180+$NODEID".
+    std::string number {trim(text)};
+    int64_t     offset = 0;
+    constexpr std::string_view nodeIdToken = "$NODEID";
+    if (auto it = std::ranges::search(number, nodeIdToken, [](char l, char r) {
+                      return std::toupper(l) == r;
+                  }).begin();
+        it != number.end()) {
+        number.erase(it, it + static_cast<std::ptrdiff_t>(nodeIdToken.size()));
+        std::erase(number, '+');
+        offset = nodeId;
+    }
+
+    int64_t value = 0;
+    if (!trim(number).empty()) {
+        const auto parsed = isSigned(entry.dataType) ? parseInteger<int64_t>(number)
+                                                     : parseInteger<uint64_t>(number).transform(
+                                                         [](uint64_t v) { return static_cast<int64_t>(v); });
+        if (!parsed) {
+            BR_LOG_WARN(s_tag, "Invalid integer '{}' for {:04x}sub{:x}", text, entry.index, entry.subIndex);
+        }
+        value = parsed.value_or(0);
+    }
+    appendLittleEndian(bytes, value + offset, entry.typeSize());
+    return bytes;
+}
+
+//! Keys of a section, once it has been read entirely.
+struct Section {
+    uint16_t                           index = 0;
+    std::optional<uint8_t>             subIndex;
+    std::map<std::string, std::string> keys;
+
+    [[nodiscard]] std::string_view get(const std::string& key) const
+    {
+        auto it = keys.find(key);
+        return it == keys.end() ? std::string_view {} : std::string_view {it->second};
+    }
+};
+}    // namespace
+
+std::size_t EdsEntry::typeSize() const
+{
+    switch (dataType) {
+        case DataType::boolean:
+        case DataType::integer8:
+        case DataType::unsigned8: return 1;
+        case DataType::integer16:
+        case DataType::unsigned16: return 2;
+        case DataType::integer24:
+        case DataType::unsigned24: return 3;
+        case DataType::integer32:
+        case DataType::unsigned32:
+        case DataType::real32: return 4;
+        case DataType::integer40:
+        case DataType::unsigned40: return 5;
+        case DataType::integer48:
+        case DataType::unsigned48:
+        case DataType::timeOfDay:
+        case DataType::timeDifference: return 6;
+        case DataType::integer56:
+        case DataType::unsigned56: return 7;
+        case DataType::integer64:
+        case DataType::unsigned64:
+        case DataType::real64: return 8;
+        default: return 0;
+    }
+}
+
+EdsDictionary EdsDictionary::parse(std::string_view eds, uint8_t nodeId)
+{
+    EdsDictionary          dictionary;
+    std::optional<Section> section;
+
+    auto addSection = [&] {
+        if (!section) { return; }
+        // ARRAY and RECORD objects only describe their sub-objects, which have their own sections.
+        const auto objectType = parseInteger<uint8_t>(section->get("ObjectType")).value_or(s_objectTypeVar);
+        if (!section->subIndex && objectType != s_objectTypeVar && objectType != s_objectTypeDomain) { return; }
+
+        EdsEntry entry;
+        entry.index       = section->index;
+        entry.subIndex    = section->subIndex.value_or(0);
+        entry.name        = section->get("ParameterName");
+        entry.dataType    = static_cast<DataType>(parseInteger<uint16_t>(section->get("DataType")).value_or(
+          static_cast<uint16_t>(objectType == s_objectTypeDomain ? DataType::domain : DataType::unsigned8)));
+        entry.pdoMappable = parseInteger<int>(section->get("PDOMapping")).value_or(0) != 0;
+
+        std::string access {trim(section->get("AccessType"))};
+        std::ranges::transform(access, access.begin(), [](char c) { return static_cast<char>(std::tolower(c)); });
+        entry.readable = access != "wo";
+        entry.writable = access == "rw" || access == "wo" || access == "rwr" || access == "rww";
+        entry.value    = parseValue(entry, section->get("DefaultValue"), nodeId);
+
+        dictionary.m_entries[key(entry.index, entry.subIndex)] = std::move(entry);
+    };
+
+    std::istringstream stream {std::string {eds}};
+    std::string        rawLine;
+    while (std::getline(stream, rawLine)) {
+        const auto line = trim(rawLine);
+        if (line.empty() || line.front() == ';') { continue; }
+        if (line.front() == '[') {
+            addSection();
+            section.reset();
+            const auto close = line.find(']');
+            if (close == std::string_view::npos) { continue; }
+            if (auto name = parseSectionName(trim(line.substr(1, close - 1)))) {
+                section = Section {.index = name->first, .subIndex = name->second, .keys = {}};
+            }
+            continue;
+        }
+        if (!section) { continue; }
+        const auto equal = line.find('=');
+        if (equal == std::string_view::npos) { continue; }
+        section->keys[std::string {trim(line.substr(0, equal))}] = std::string {trim(line.substr(equal + 1))};
+    }
+    addSection();
+    return dictionary;
+}
+
+std::optional<EdsDictionary> EdsDictionary::load(const std::filesystem::path& path, uint8_t nodeId)
+{
+    std::ifstream file {path, std::ios::binary};
+    if (!file.is_open()) {
+        BR_LOG_ERROR(s_tag, "Unable to open '{}'", path.string());
+        return std::nullopt;
+    }
+    std::stringstream contents;
+    contents << file.rdbuf();
+    return parse(contents.str(), nodeId);
+}
+
+EdsEntry* EdsDictionary::find(uint16_t index, uint8_t subIndex)
+{
+    auto it = m_entries.find(key(index, subIndex));
+    return it == m_entries.end() ? nullptr : &it->second;
+}
+
+const EdsEntry* EdsDictionary::find(uint16_t index, uint8_t subIndex) const
+{
+    auto it = m_entries.find(key(index, subIndex));
+    return it == m_entries.end() ? nullptr : &it->second;
+}
+
+bool EdsDictionary::hasObject(uint16_t index) const
+{
+    auto it = m_entries.lower_bound(key(index, 0));
+    return it != m_entries.end() && it->second.index == index;
+}
+}    // namespace Frasy::CanOpen
@@ -0,0 +1,80 @@
+/**
+ * @file    eds_dictionary.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Object dictionary of a simulated node, built from an EDS file.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef FRASY_SRC_UTILS_COMMUNICATION_CAN_OPEN_SIMULATION_EDS_DICTIONARY_H
+#define FRASY_SRC_UTILS_COMMUNICATION_CAN_OPEN_SIMULATION_EDS_DICTIONARY_H
+
+#include "utils/communication/can_open/types.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Frasy::CanOpen {
+struct EdsEntry {
+    uint16_t             index       = 0;
+    uint8_t              subIndex    = 0;
+    std::string          name;
+    DataType             dataType    = DataType::domain;
+    bool                 readable    = true;
+    bool                 writable    = false;
+    bool                 pdoMappable = false;
+    std::vector<uint8_t> value;    //!< Little endian, the way SDO transfers it.
+
+    //! Size of the values of the data type in bytes, 0 for the ones whose size varies (strings and domains).
+    [[nodiscard]] std::size_t typeSize() const;
+};
+
+/**
+ * Every variable of an EDS file (CiA 306), with its default value.
+ *
+ * Variables are the VAR objects and the sub-objects of the ARRAY and RECORD ones. Their values can be changed, but
+ * variables can't be added.
+ */
+class EdsDictionary {
+public:
+    /**
+     * Parses the contents of an EDS file. Malformed values are logged and left at zero.
+     *
+     * @param nodeId Replaces $NODEID in the default values, as in "$NODEID+0x180".
+     */
+    static EdsDictionary                parse(std::string_view eds, uint8_t nodeId);
+    //! @return std::nullopt if the file can't be read.
+    static std::optional<EdsDictionary> load(const std::filesystem::path& path, uint8_t nodeId);
+
+    [[nodiscard]] EdsEntry*       find(uint16_t index, uint8_t subIndex);
+    [[nodiscard]] const EdsEntry* find(uint16_t index, uint8_t subIndex) const;
+    //! Whether the object exists, even if @p subIndex doesn't.
+    [[nodiscard]] bool            hasObject(uint16_t index) const;
+
+    [[nodiscard]] std::size_t size() const { return m_entries.size(); }
+    [[nodiscard]] auto        begin() const { return m_entries.begin(); }
+    [[nodiscard]] auto        end() const { return m_entries.end(); }
+
+private:
+    static constexpr uint32_t key(uint16_t index, uint8_t subIndex) { return (uint32_t {index} << 8) | subIndex; }
+
+    std::map<uint32_t, EdsEntry> m_entries;
+};
+}    // namespace Frasy::CanOpen
+
+#endif    // FRASY_SRC_UTILS_COMMUNICATION_CAN_OPEN_SIMULATION_EDS_DICTIONARY_H
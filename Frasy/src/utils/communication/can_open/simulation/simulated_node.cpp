@@ -0,0 +1,606 @@
+/**
+ * @file    simulated_node.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <https://www.gnu.org/licenses/>.
+ */
+#include "simulated_node.h"
+
+#include <algorithm>
+#include <array>
+
+namespace Frasy::CanOpen {
+namespace {
+constexpr uint32_t s_nmtId         = 0x000;
+constexpr uint32_t s_sdoRxBaseId   = 0x600;
+constexpr uint32_t s_sdoTxBaseId   = 0x580;
+constexpr uint32_t s_heartbeatBase = 0x700;
+
+constexpr uint8_t s_nmtStart               = 0x01;
+constexpr uint8_t s_nmtStop                = 0x02;
+constexpr uint8_t s_nmtEnterPreOperational = 0x80;
+constexpr uint8_t s_nmtResetNode           = 0x81;
+constexpr uint8_t s_nmtResetCommunication  = 0x82;
+
+constexpr uint16_t s_heartbeatTimeIndex = 0x1017;
+
+// Abort codes of CiA 301.
+constexpr uint32_t s_abortToggle    = 0x05030000;
+constexpr uint32_t s_abortCommand   = 0x05040001;
+constexpr uint32_t s_abortBlockSize = 0x05040002;
+constexpr uint32_t s_abortSequence  = 0x05040003;
+constexpr uint32_t s_abortCrc       = 0x05040004;
+constexpr uint32_t s_abortWriteOnly = 0x06010001;
+constexpr uint32_t s_abortReadOnly  = 0x06010002;
+constexpr uint32_t s_abortNoObject  = 0x06020000;
+constexpr uint32_t s_abortLength    = 0x06070010;
+constexpr uint32_t s_abortNoSubIndex = 0x06090011;
+
+constexpr std::size_t s_segmentSize = 7;
+
+//! CRC of the SDO block transfers, CRC-16-CCITT (polynomial 0x1021, starting from 0).
+uint16_t crc16(const std::vector<uint8_t>& data)
+{
+    uint16_t crc = 0;
+    for (uint8_t byte : data) {
+        crc ^= static_cast<uint16_t>(byte << 8);
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 0x8000) != 0 ? static_cast<uint16_t>((crc << 1) ^ 0x1021) : static_cast<uint16_t>(crc << 1);
+        }
+    }
+    return crc;
+}
+
+uint32_t readUint32(const uint8_t* data)
+{
+    return data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<uint32_t>(data[3]) << 24);
+}
+
+void writeUint32(uint8_t* data, uint32_t value)
+{
+    for (int i = 0; i < 4; ++i) {
+        data[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+}    // namespace
+
+SimulatedNode::SimulatedNode(std::shared_ptr<SlCan::VirtualBus> bus,
+                             uint8_t                            nodeId,
+                             EdsDictionary                      dictionary,
+                             Options                            options)
+: m_bus(std::move(bus)),
+  m_nodeId(nodeId),
+  m_options(options),
+  m_defaults(dictionary),
+  m_dictionary(std::move(dictionary)),
+  m_random(options.seed)
+{
+    m_options.blockSize = std::clamp<uint8_t>(m_options.blockSize, 1, 127);
+    m_handle            = m_bus->attach([this](const SlCan::CanPacket& frame) {
+        if (frame.isExtended || frame.isRemote) { return; }
+        if (frame.id != s_nmtId && frame.id != s_sdoRxBaseId + m_nodeId) { return; }
+
+        auto due = std::chrono::steady_clock::now() + m_options.latency;
+        std::lock_guard lock {m_incomingLock};
+        if (m_options.jitter.count() > 0) {
+            due += std::chrono::microseconds {
+              std::uniform_int_distribution<int64_t> {0, m_options.jitter.count()}(m_random)};
+        }
+        // The jitter can't reorder the frames.
+        if (!m_incoming.empty()) { due = std::max(due, m_incoming.back().due); }
+        m_incoming.push_back({due, frame});
+        m_incomingCv.notify_one();
+    });
+    m_thread = std::jthread([this](std::stop_token stopToken) { run(stopToken); });
+}
+
+SimulatedNode::~SimulatedNode()
+{
+    m_bus->detach(m_handle);
+    m_thread.request_stop();
+    if (m_thread.joinable()) { m_thread.join(); }
+}
+
+std::optional<std::vector<uint8_t>> SimulatedNode::read(uint16_t index, uint8_t subIndex) const
+{
+    std::lock_guard lock {m_dictionaryLock};
+    const auto*     entry = m_dictionary.find(index, subIndex);
+    if (entry == nullptr) { return std::nullopt; }
+    return entry->value;
+}
+
+bool SimulatedNode::write(uint16_t index, uint8_t subIndex, std::span<const uint8_t> value)
+{
+    std::lock_guard lock {m_dictionaryLock};
+    auto*           entry = m_dictionary.find(index, subIndex);
+    if (entry == nullptr || (entry->typeSize() != 0 && entry->typeSize() != value.size())) { return false; }
+    entry->value.assign(value.begin(), value.end());
+    return true;
+}
+
+void SimulatedNode::setDownloadCallback(DownloadCallback callback)
+{
+    std::lock_guard lock {m_callbackLock};
+    m_downloadCallback = std::move(callback);
+}
+
+void SimulatedNode::transmit(const SlCan::CanPacket& frame)
+{
+    m_bus->send(frame, m_handle);
+}
+
+void SimulatedNode::run(std::stop_token stopToken)
+{
+    using Clock = std::chrono::steady_clock;
+    bootUp(false);
+    auto nextHeartbeat = Clock::now();
+    while (!stopToken.stop_requested()) {
+        // It can be changed by SDO.
+        const auto heartbeatTime = this->heartbeatTime();
+
+        std::optional<SlCan::CanPacket> frame;
+        {
+            std::unique_lock lock {m_incomingLock};
+            auto             wakeUp = heartbeatTime.count() != 0 ? nextHeartbeat : Clock::time_point::max();
+            if (!m_incoming.empty()) { wakeUp = std::min(wakeUp, m_incoming.front().due); }
+            // A frame coming in changes when to wake up.
+            const bool wasEmpty = m_incoming.empty();
+            auto       arrived  = [&] { return wasEmpty && !m_incoming.empty(); };
+            if (wakeUp == Clock::time_point::max()) { m_incomingCv.wait(lock, stopToken, arrived); }
+            else {
+                m_incomingCv.wait_until(lock, stopToken, wakeUp, arrived);
+            }
+            if (!m_incoming.empty() && m_incoming.front().due <= Clock::now()) {
+                frame = m_incoming.front().frame;
+                m_incoming.pop_front();
+            }
+        }
+        if (frame) { handle(*frame); }
+
+        const auto now = Clock::now();
+        if (heartbeatTime.count() != 0 && now >= nextHeartbeat) {
+            transmit({.id      = s_heartbeatBase + m_nodeId,
+                      .dataLen = 1,
+                      .data    = {static_cast<uint8_t>(m_state.load(std::memory_order_relaxed))}});
+            nextHeartbeat = std::max(nextHeartbeat + heartbeatTime, now);
+        }
+    }
+}
+
+std::chrono::milliseconds SimulatedNode::heartbeatTime() const
+{
+    std::lock_guard lock {m_dictionaryLock};
+    const auto*     entry = m_dictionary.find(s_heartbeatTimeIndex, 0);
+    if (entry == nullptr || entry->value.size() != 2) { return std::chrono::milliseconds {0}; }
+    return std::chrono::milliseconds {entry->value[0] | (entry->value[1] << 8)};
+}
+
+void SimulatedNode::handle(const SlCan::CanPacket& frame)
+{
+    if (frame.id == s_nmtId) { handleNmt(frame); }
+    else {
+        handleSdo(frame);
+    }
+}
+
+void SimulatedNode::handleNmt(const SlCan::CanPacket& frame)
+{
+    if (frame.dataLen != 2 || (frame.data[1] != 0 && frame.data[1] != m_nodeId)) { return; }
+    switch (frame.data[0]) {
+        case s_nmtStart: m_state = NmtState::Operational; break;
+        case s_nmtStop: m_state = NmtState::Stopped; break;
+        case s_nmtEnterPreOperational: m_state = NmtState::PreOperational; break;
+        case s_nmtResetNode: bootUp(true); break;
+        case s_nmtResetCommunication: bootUp(false); break;
+        default: break;
+    }
+}
+
+void SimulatedNode::bootUp(bool resetDictionary)
+{
+    if (resetDictionary) {
+        std::lock_guard lock {m_dictionaryLock};
+        m_dictionary = m_defaults;
+    }
+    m_sdoState = SdoState::Idle;
+    m_state    = NmtState::Initializing;
+    transmit({.id = s_heartbeatBase + m_nodeId, .dataLen = 1, .data = {0x00}});
+    m_state = NmtState::PreOperational;
+}
+
+void SimulatedNode::handleSdo(const SlCan::CanPacket& frame)
+{
+    const auto state = m_state.load(std::memory_order_relaxed);
+    if (frame.dataLen != 8 || (state != NmtState::PreOperational && state != NmtState::Operational)) { return; }
+
+    // The segments of a block download have no command specifier, they can look like anything else.
+    const uint8_t* data = &frame.data[0];
+    if (m_sdoState == SdoState::BlockDownloading) {
+        blockDownloadSegment(data);
+        return;
+    }
+    if (data[0] == 0x80) {
+        // The client aborted.
+        m_sdoState = SdoState::Idle;
+        return;
+    }
+
+    switch (m_sdoState) {
+        case SdoState::BlockDownloadEnding:
+            if ((data[0] & 0xE3) == 0xC1) { endBlockDownload(data); }
+            else {
+                abort(s_abortCommand);
+            }
+            return;
+        case SdoState::BlockUploadStarting:
+            if (data[0] == 0xA3) { sendUploadBlock(); }
+            else {
+                abort(s_abortCommand);
+            }
+            return;
+        case SdoState::BlockUploading:
+            if ((data[0] & 0xE3) == 0xA2) { blockUploadAcknowledged(data); }
+            else {
+                abort(s_abortCommand);
+            }
+            return;
+        case SdoState::BlockUploadEnding:
+            if ((data[0] & 0xE3) == 0xA1) {
+                m_sdoState = SdoState::Idle;
+                m_sdoTransfers.fetch_add(1, std::memory_order_relaxed);
+            }
+            else {
+                abort(s_abortCommand);
+            }
+            return;
+        default: break;
+    }
+
+    switch (data[0] >> 5) {
+        case 0:
+            if (m_sdoState == SdoState::Downloading) { downloadSegment(data); }
+            else {
+                abort(s_abortCommand);
+            }
+            break;
+        case 1: initiateDownload(data); break;
+        case 2: initiateUpload(data); break;
+        case 3:
+            if (m_sdoState == SdoState::Uploading) { uploadSegment(data); }
+            else {
+                abort(s_abortCommand);
+            }
+            break;
+        case 5:
+            if ((data[0] & 0x03) == 0) { initiateBlockUpload(data); }
+            else {
+                abort(s_abortCommand);
+            }
+            break;
+        case 6:
+            if ((data[0] & 0x01) == 0) { initiateBlockDownload(data); }
+            else {
+                abort(s_abortCommand);
+            }
+            break;
+        default: abort(s_abortCommand); break;
+    }
+}
+
+std::expected<std::size_t, uint32_t> SimulatedNode::access(uint16_t index, uint8_t subIndex, bool write) const
+{
+    std::lock_guard lock {m_dictionaryLock};
+    const auto*     entry = m_dictionary.find(index, subIndex);
+    if (entry == nullptr) {
+        return std::unexpected(m_dictionary.hasObject(index) ? s_abortNoSubIndex : s_abortNoObject);
+    }
+    if (write && !entry->writable) { return std::unexpected(s_abortReadOnly); }
+    if (!write && !entry->readable) { return std::unexpected(s_abortWriteOnly); }
+    return entry->typeSize();
+}
+
+bool SimulatedNode::startTransfer(const uint8_t* data, bool write)
+{
+    m_sdoIndex    = static_cast<uint16_t>(data[1] | (data[2] << 8));
+    m_sdoSubIndex = data[3];
+    const auto typeSize = access(m_sdoIndex, m_sdoSubIndex, write);
+    if (!typeSize) {
+        abort(typeSize.error());
+        return false;
+    }
+    m_sdoTypeSize = *typeSize;
+    if (!write) {
+        std::lock_guard lock {m_dictionaryLock};
+        m_sdoData = m_dictionary.find(m_sdoIndex, m_sdoSubIndex)->value;
+    }
+    else {
+        m_sdoData.clear();
+    }
+    m_sdoOffset = 0;
+    m_sdoToggle = false;
+    return true;
+}
+
+bool SimulatedNode::commitDownload()
+{
+    if (m_sdoTypeSize != 0 && m_sdoData.size() != m_sdoTypeSize) {
+        abort(s_abortLength);
+        return false;
+    }
+    {
+        std::lock_guard lock {m_dictionaryLock};
+        m_dictionary.find(m_sdoIndex, m_sdoSubIndex)->value = m_sdoData;
+    }
+    m_sdoState = SdoState::Idle;
+    m_sdoTransfers.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void SimulatedNode::notifyDownload()
+{
+    DownloadCallback callback;
+    {
+        std::lock_guard lock {m_callbackLock};
+        callback = m_downloadCallback;
+    }
+    if (callback) { callback(*this, m_sdoIndex, m_sdoSubIndex); }
+}
+
+void SimulatedNode::initiateDownload(const uint8_t* data)
+{
+    if (!startTransfer(data, true)) { return; }
+    std::array<uint8_t, 8> response = {0x60, data[1], data[2], data[3]};
+
+    const bool expedited     = (data[0] & 0x02) != 0;
+    const bool sizeIndicated = (data[0] & 0x01) != 0;
+    if (expedited) {
+        std::size_t size = 4;
+        if (sizeIndicated) { size -= (data[0] >> 2) & 0x03; }
+        else if (m_sdoTypeSize != 0 && m_sdoTypeSize < size) {
+            size = m_sdoTypeSize;
+        }
+        m_sdoData.assign(data + 4, data + 4 + size);
+        if (!commitDownload()) { return; }
+        notifyDownload();
+        sendSdo(response);
+        return;
+    }
+
+    m_sdoSize  = sizeIndicated ? readUint32(data + 4) : 0;
+    m_sdoState = SdoState::Downloading;
+    sendSdo(response);
+}
+
+void SimulatedNode::downloadSegment(const uint8_t* data)
+{
+    const bool toggle = (data[0] & 0x10) != 0;
+    if (toggle != m_sdoToggle) {
+        abort(s_abortToggle);
+        return;
+    }
+    const std::size_t unused = (data[0] >> 1) & 0x07;
+    m_sdoData.insert(m_sdoData.end(), data + 1, data + 1 + s_segmentSize - unused);
+    m_sdoToggle = !m_sdoToggle;
+    if (m_sdoSize != 0 && m_sdoData.size() > m_sdoSize) {
+        abort(s_abortLength);
+        return;
+    }
+
+    const std::array<uint8_t, 8> response = {static_cast<uint8_t>(0x20 | (toggle ? 0x10 : 0x00))};
+    if ((data[0] & 0x01) == 0) {
+        sendSdo(response);
+        return;
+    }
+    if ((m_sdoSize != 0 && m_sdoData.size() != m_sdoSize)) {
+        abort(s_abortLength);
+        return;
+    }
+    if (!commitDownload()) { return; }
+    notifyDownload();
+    sendSdo(response);
+}
+
+void SimulatedNode::initiateUpload(const uint8_t* data)
+{
+    if (startTransfer(data, false)) { respondToUpload(); }
+}
+
+void SimulatedNode::respondToUpload()
+{
+    std::array<uint8_t, 8> response = {0x41, static_cast<uint8_t>(m_sdoIndex), static_cast<uint8_t>(m_sdoIndex >> 8),
+                                       m_sdoSubIndex};
+    const std::size_t      size     = m_sdoData.size();
+    if (size >= 1 && size <= 4) {
+        response[0] = static_cast<uint8_t>(0x43 | ((4 - size) << 2));
+        std::ranges::copy(m_sdoData, response.begin() + 4);
+        m_sdoState = SdoState::Idle;
+        m_sdoTransfers.fetch_add(1, std::memory_order_relaxed);
+    }
+    else {
+        writeUint32(&response[4], static_cast<uint32_t>(size));
+        m_sdoState = SdoState::Uploading;
+    }
+    sendSdo(response);
+}
+
+void SimulatedNode::uploadSegment(const uint8_t* data)
+{
+    const bool toggle = (data[0] & 0x10) != 0;
+    if (toggle != m_sdoToggle) {
+        abort(s_abortToggle);
+        return;
+    }
+    const std::size_t count = std::min(s_segmentSize, m_sdoData.size() - m_sdoOffset);
+    const bool        last  = m_sdoOffset + count == m_sdoData.size();
+
+    std::array<uint8_t, 8> response = {
+      static_cast<uint8_t>((toggle ? 0x10 : 0x00) | ((s_segmentSize - count) << 1) | (last ? 0x01 : 0x00))};
+    std::copy_n(m_sdoData.begin() + static_cast<std::ptrdiff_t>(m_sdoOffset), count, response.begin() + 1);
+    m_sdoOffset += count;
+    m_sdoToggle = !m_sdoToggle;
+    if (last) {
+        m_sdoState = SdoState::Idle;
+        m_sdoTransfers.fetch_add(1, std::memory_order_relaxed);
+    }
+    sendSdo(response);
+}
+
+void SimulatedNode::initiateBlockDownload(const uint8_t* data)
+{
+    if (!m_options.blockTransfers) {
+        m_sdoIndex    = static_cast<uint16_t>(data[1] | (data[2] << 8));
+        m_sdoSubIndex = data[3];
+        abort(s_abortCommand);
+        return;
+    }
+    if (!startTransfer(data, true)) { return; }
+    m_sdoCrc        = (data[0] & 0x04) != 0;
+    m_sdoSize       = (data[0] & 0x02) != 0 ? readUint32(data + 4) : 0;
+    m_blockSize     = m_options.blockSize;
+    m_blockSequence = 0;
+    m_blockLast     = false;
+    m_sdoState      = SdoState::BlockDownloading;
+    // The server always supports the CRC.
+    sendSdo(std::array<uint8_t, 8> {0xA4, data[1], data[2], data[3], m_blockSize});
+}
+
+void SimulatedNode::blockDownloadSegment(const uint8_t* data)
+{
+    const uint8_t sequence = data[0] & 0x7F;
+    const bool    last     = (data[0] & 0x80) != 0;
+    if (sequence == 0 || sequence > m_blockSize) {
+        abort(s_abortSequence);
+        return;
+    }
+    // A segment out of order is ignored, the acknowledgement makes the client send it again.
+    if (sequence == m_blockSequence + 1) {
+        m_sdoData.insert(m_sdoData.end(), data + 1, data + 1 + s_segmentSize);
+        m_blockSequence = sequence;
+        m_blockLast     = last;
+    }
+    if (sequence != m_blockSize && !last) { return; }
+
+    sendSdo(std::array<uint8_t, 8> {0xA2, m_blockSequence, m_blockSize});
+    m_blockSequence = 0;
+    if (m_blockLast) { m_sdoState = SdoState::BlockDownloadEnding; }
+}
+
+void SimulatedNode::endBlockDownload(const uint8_t* data)
+{
+    const std::size_t unused = (data[0] >> 2) & 0x07;
+    m_sdoData.resize(m_sdoData.size() - std::min(unused, m_sdoData.size()));
+    if (m_sdoSize != 0 && m_sdoData.size() != m_sdoSize) {
+        abort(s_abortLength);
+        return;
+    }
+    if (m_sdoCrc && crc16(m_sdoData) != static_cast<uint16_t>(data[1] | (data[2] << 8))) {
+        abort(s_abortCrc);
+        return;
+    }
+    if (!commitDownload()) { return; }
+    notifyDownload();
+    sendSdo(std::array<uint8_t, 8> {0xA1});
+}
+
+void SimulatedNode::initiateBlockUpload(const uint8_t* data)
+{
+    if (!m_options.blockTransfers) {
+        m_sdoIndex    = static_cast<uint16_t>(data[1] | (data[2] << 8));
+        m_sdoSubIndex = data[3];
+        abort(s_abortCommand);
+        return;
+    }
+    if (!startTransfer(data, false)) { return; }
+    const uint8_t blockSize = data[4];
+    if (blockSize == 0 || blockSize > 127) {
+        abort(s_abortBlockSize);
+        return;
+    }
+    // Below the protocol switch threshold, the client prefers an expedited or segmented upload.
+    const uint8_t threshold = data[5];
+    if (threshold != 0 && m_sdoData.size() <= threshold) {
+        respondToUpload();
+        return;
+    }
+
+    m_sdoCrc    = (data[0] & 0x04) != 0;
+    m_blockSize = blockSize;
+    m_sdoState  = SdoState::BlockUploadStarting;
+    std::array<uint8_t, 8> response = {0xC6, data[1], data[2], data[3]};
+    writeUint32(&response[4], static_cast<uint32_t>(m_sdoData.size()));
+    sendSdo(response);
+}
+
+void SimulatedNode::sendUploadBlock()
+{
+    std::size_t offset = m_sdoOffset;
+    m_blockSequence    = 0;
+    m_blockLast        = false;
+    while (m_blockSequence < m_blockSize && !m_blockLast) {
+        const std::size_t count = std::min(s_segmentSize, m_sdoData.size() - offset);
+        m_blockLast             = offset + count == m_sdoData.size();
+        ++m_blockSequence;
+
+        std::array<uint8_t, 8> segment = {static_cast<uint8_t>(m_blockSequence | (m_blockLast ? 0x80 : 0x00))};
+        std::copy_n(m_sdoData.begin() + static_cast<std::ptrdiff_t>(offset), count, segment.begin() + 1);
+        sendSdo(segment);
+        offset += count;
+    }
+    m_sdoState = SdoState::BlockUploading;
+}
+
+void SimulatedNode::blockUploadAcknowledged(const uint8_t* data)
+{
+    const uint8_t acknowledged = data[1];
+    const uint8_t blockSize    = data[2];
+    if (acknowledged > m_blockSequence) {
+        abort(s_abortSequence);
+        return;
+    }
+    if (blockSize == 0 || blockSize > 127) {
+        abort(s_abortBlockSize);
+        return;
+    }
+    m_sdoOffset = std::min(m_sdoOffset + (acknowledged * s_segmentSize), m_sdoData.size());
+    m_blockSize = blockSize;
+    if (!m_blockLast || acknowledged != m_blockSequence) {
+        // Sends the next block, or what the client missed of this one.
+        sendUploadBlock();
+        return;
+    }
+
+    const std::size_t remainder = m_sdoData.size() % s_segmentSize;
+    const std::size_t unused    = m_sdoData.empty() ? s_segmentSize : (remainder == 0 ? 0 : s_segmentSize - remainder);
+    const uint16_t    crc       = m_sdoCrc ? crc16(m_sdoData) : 0;
+    m_sdoState                  = SdoState::BlockUploadEnding;
+    sendSdo(std::array<uint8_t, 8> {
+      static_cast<uint8_t>(0xC1 | (unused << 2)), static_cast<uint8_t>(crc), static_cast<uint8_t>(crc >> 8)});
+}
+
+void SimulatedNode::sendSdo(std::span<const uint8_t, 8> data)
+{
+    SlCan::CanPacket frame {.id = s_sdoTxBaseId + m_nodeId, .dataLen = 8};
+    std::ranges::copy(data, &frame.data[0]);
+    transmit(frame);
+}
+
+void SimulatedNode::abort(uint32_t code)
+{
+    std::array<uint8_t, 8> response = {0x80, static_cast<uint8_t>(m_sdoIndex), static_cast<uint8_t>(m_sdoIndex >> 8),
+                                       m_sdoSubIndex};
+    writeUint32(&response[4], code);
+    m_sdoState = SdoState::Idle;
+    m_sdoAborts.fetch_add(1, std::memory_order_relaxed);
+    sendSdo(response);
+}
+}    // namespace Frasy::CanOpen
@@ -0,0 +1,197 @@
+/**
+ * @file    simulated_node.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   CANopen node on a virtual bus, standing in for an instrumentation board.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef FRASY_SRC_UTILS_COMMUNICATION_CAN_OPEN_SIMULATION_SIMULATED_NODE_H
+#define FRASY_SRC_UTILS_COMMUNICATION_CAN_OPEN_SIMULATION_SIMULATED_NODE_H
+
+#include "eds_dictionary.h"
+
+#include "utils/communication/slcan/virtual_bus.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <expected>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace Frasy::CanOpen {
+/**
+ * Serves the object dictionary of an EDS file on a VirtualBus, the way the firmware of a board would.
+ *
+ * The node sends its boot-up message when created, then its heartbeat at the period of 0x1017. It follows the NMT
+ * commands, and its SDO server does expedited, segmented and block transfers, both ways. A reset of the node puts the
+ * dictionary back to the default values of the EDS.
+ *
+ * What the board does with the values is up to the owner of the node: it is told about every SDO download through the
+ * download callback, and can change the dictionary or send frames (PDOs for instance) from there.
+ */
+class SimulatedNode {
+public:
+    enum class NmtState : uint8_t {
+        Initializing   = 0x00,
+        Stopped        = 0x04,
+        Operational    = 0x05,
+        PreOperational = 0x7F,
+    };
+
+    struct Options {
+        //! Time the node takes to handle a frame.
+        std::chrono::microseconds latency {0};
+        //! Up to this much is added to the latency, at random. The frames are still handled in order.
+        std::chrono::microseconds jitter {0};
+        //! False to model nodes that don't support SDO block transfers, they abort them.
+        bool                      blockTransfers = true;
+        //! Segments per block the node accepts in block downloads, 1 to 127.
+        uint8_t                   blockSize      = 127;
+        uint32_t                  seed           = 0;
+    };
+
+    //! Called from the thread of the node once the value is written, before the node confirms the download.
+    using DownloadCallback = std::function<void(SimulatedNode& node, uint16_t index, uint8_t subIndex)>;
+
+    SimulatedNode(std::shared_ptr<SlCan::VirtualBus> bus, uint8_t nodeId, EdsDictionary dictionary, Options options);
+    SimulatedNode(std::shared_ptr<SlCan::VirtualBus> bus, uint8_t nodeId, EdsDictionary dictionary)
+    : SimulatedNode(std::move(bus), nodeId, std::move(dictionary), Options {})
+    {
+    }
+    ~SimulatedNode();
+    SimulatedNode(const SimulatedNode&)            = delete;
+    SimulatedNode& operator=(const SimulatedNode&) = delete;
+
+    [[nodiscard]] uint8_t  nodeId() const noexcept { return m_nodeId; }
+    [[nodiscard]] NmtState state() const { return m_state.load(std::memory_order_relaxed); }
+
+    //! @return std::nullopt if the variable doesn't exist.
+    [[nodiscard]] std::optional<std::vector<uint8_t>> read(uint16_t index, uint8_t subIndex) const;
+    /**
+     * Changes a value the way the board itself would, ignoring the access type of the variable.
+     *
+     * @return false if the variable doesn't exist.
+     */
+    bool write(uint16_t index, uint8_t subIndex, std::span<const uint8_t> value);
+
+    template<typename T>
+        requires std::is_trivially_copyable_v<T>
+    bool write(uint16_t index, uint8_t subIndex, const T& value)
+    {
+        return write(index, subIndex, std::span {reinterpret_cast<const uint8_t*>(&value), sizeof(T)});
+    }
+
+    void setDownloadCallback(DownloadCallback callback);
+
+    //! Sends a frame from the node.
+    void transmit(const SlCan::CanPacket& frame);
+
+    //! SDO transfers completed, both ways.
+    [[nodiscard]] uint64_t sdoTransfers() const { return m_sdoTransfers.load(std::memory_order_relaxed); }
+    //! SDO transfers the node aborted.
+    [[nodiscard]] uint64_t sdoAborts() const { return m_sdoAborts.load(std::memory_order_relaxed); }
+
+private:
+    enum class SdoState : uint8_t {
+        Idle,
+        Downloading,            //!< Segmented download, waiting for the next segment.
+        Uploading,              //!< Segmented upload, waiting for the next segment request.
+        BlockDownloading,       //!< Receiving the segments of a block.
+        BlockDownloadEnding,    //!< Every segment was received, waiting for the CRC.
+        BlockUploadStarting,    //!< Waiting for the client to start the upload.
+        BlockUploading,         //!< A block was sent, waiting for its acknowledgement.
+        BlockUploadEnding,      //!< The end was sent, waiting for the client to confirm it.
+    };
+
+    struct Incoming {
+        std::chrono::steady_clock::time_point due;
+        SlCan::CanPacket                      frame;
+    };
+
+    void run(std::stop_token stopToken);
+    void handle(const SlCan::CanPacket& frame);
+    void handleNmt(const SlCan::CanPacket& frame);
+    void handleSdo(const SlCan::CanPacket& frame);
+    void bootUp(bool resetDictionary);
+
+    void initiateDownload(const uint8_t* data);
+    void downloadSegment(const uint8_t* data);
+    void initiateUpload(const uint8_t* data);
+    void uploadSegment(const uint8_t* data);
+    void initiateBlockDownload(const uint8_t* data);
+    void blockDownloadSegment(const uint8_t* data);
+    void endBlockDownload(const uint8_t* data);
+    void initiateBlockUpload(const uint8_t* data);
+    void sendUploadBlock();
+    void blockUploadAcknowledged(const uint8_t* data);
+
+    [[nodiscard]] std::chrono::milliseconds heartbeatTime() const;
+
+    //! @return The size of the type of the variable, or the abort code refusing the access.
+    [[nodiscard]] std::expected<std::size_t, uint32_t> access(uint16_t index, uint8_t subIndex, bool write) const;
+    //! Takes the variable of an initiate request. @return false if the transfer was aborted.
+    bool startTransfer(const uint8_t* data, bool write);
+    void respondToUpload();
+    //! Writes the downloaded data to the dictionary. @return false if the transfer was aborted.
+    bool commitDownload();
+    void notifyDownload();
+    void sendSdo(std::span<const uint8_t, 8> data);
+    void abort(uint32_t code);
+
+    std::shared_ptr<SlCan::VirtualBus> m_bus;
+    SlCan::VirtualBus::Handle          m_handle = 0;
+    uint8_t                            m_nodeId;
+    Options                            m_options;
+    std::atomic<NmtState>              m_state        = NmtState::Initializing;
+    std::atomic_uint64_t               m_sdoTransfers = 0;
+    std::atomic_uint64_t               m_sdoAborts    = 0;
+
+    const EdsDictionary m_defaults;
+    mutable std::mutex  m_dictionaryLock;
+    EdsDictionary       m_dictionary;
+    std::mutex          m_callbackLock;
+    DownloadCallback    m_downloadCallback;
+
+    std::mutex                  m_incomingLock;
+    std::condition_variable_any m_incomingCv;
+    std::deque<Incoming>        m_incoming;
+    std::mt19937                m_random;    //!< Only used with m_incomingLock held.
+
+    // State of the SDO server, only touched by the thread of the node.
+    SdoState             m_sdoState    = SdoState::Idle;
+    uint16_t             m_sdoIndex    = 0;
+    uint8_t              m_sdoSubIndex = 0;
+    std::vector<uint8_t> m_sdoData;
+    std::size_t          m_sdoTypeSize   = 0;
+    std::size_t          m_sdoOffset     = 0;    //!< Bytes of an upload acknowledged by the client.
+    std::size_t          m_sdoSize       = 0;    //!< Size indicated by the client in a download, 0 if it didn't.
+    bool                 m_sdoToggle     = false;
+    bool                 m_sdoCrc        = false;
+    uint8_t              m_blockSize     = 0;
+    uint8_t              m_blockSequence = 0;    //!< Last segment received in order, or sent, in the current block.
+    bool                 m_blockLast     = false;
+
+    std::jthread m_thread;
+};
+}    // namespace Frasy::CanOpen
+
+#endif    // FRASY_SRC_UTILS_COMMUNICATION_CAN_OPEN_SIMULATION_SIMULATED_NODE_H
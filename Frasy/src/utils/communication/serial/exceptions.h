@@ -66,6 +66,11 @@ public:
                                       expectedIdx >= len ? '\xFF' : data[expectedIdx]))
     {
     }
+
+    BadPayloadException(const uint8_t* data, size_t len, const char* reason)
+    : BasePacketException(data, len, std::format("Bad payload, {}", reason))
+    {
+    }
 };
 
 class BadCrcException : public BasePacketException
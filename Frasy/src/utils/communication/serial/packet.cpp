@@ -18,6 +18,7 @@
 
 #include "exceptions.h"
 #include "utils/misc/char_conv.h"
+#include "utils/misc/hex.h"
 #include "utils/misc/serializer.h"
 
 namespace Frasy::Serial {
@@ -117,10 +118,10 @@ Packet::Packet(const std::vector<uint8_t>& raw)
         throw BadPayloadException(raw.data(), raw.size(), expectedPayloadEndIdx);
     }
 
-    Payload.reserve(Header.PayloadSize);
-    for (size_t i = s_payloadStartOffset + 1; i < expectedPayloadEndIdx; i += 2)
+    Payload.resize(Header.PayloadSize);
+    if (!Hex::decode(&raw[s_payloadStartOffset + 1], Payload.size(), Payload.data()))
     {
-        Payload.push_back(AsciiToT<uint8_t>(&raw[i]));
+        throw BadPayloadException(raw.data(), raw.size(), "not hexadecimal");
     }
 
     m_crc    = AsciiToT<decltype(m_crc)>((&raw[expectedPayloadEndIdx]) + 1);
@@ -148,11 +149,9 @@ Packet::operator std::vector<uint8_t>() const noexcept
     out.insert(out.end(), header.begin(), header.end());
 
     out.push_back(s_payloadStartFlag);
-    for (auto&& byte : Payload)
-    {
-        auto serialized = TToAscii(byte);
-        out.insert(out.end(), serialized.begin(), serialized.end());
-    }
+    const size_t payloadOffset = out.size();
+    out.resize(payloadOffset + (Payload.size() * s_charsPerBytes));
+    Hex::encode(Payload.data(), Payload.size(), out.data() + payloadOffset);
     out.push_back(s_payloadEndFlag);
 
     auto crc       = crc32_calculate({std::vector<uint8_t>(Header), Payload});
@@ -16,6 +16,9 @@
  */
 #include "device.h"
 
+#include "rx_buffer.h"
+#include "virtual_port.h"
+
 #include "Brigerad/Core/Thread.h"
 
 #include <Brigerad.h>
@@ -23,6 +26,33 @@
 #include <utils/string_utils.h>
 
 namespace Frasy::SlCan {
+namespace {
+class SerialPort : public Port {
+public:
+    explicit SerialPort(const std::string& port)
+    : m_serial(port,
+               921600,
+               // Reads return what's there, or wait for the first byte.
+               serial::Timeout(serial::Timeout::max(), Device::s_readTimeoutMs, serial::Timeout::max(), 1, 0),
+               serial::eightbits,
+               serial::parity_none,
+               serial::stopbits_one,
+               serial::flowcontrol_software)
+    {
+    }
+
+    [[nodiscard]] bool isOpen() const override { return m_serial.isOpen(); }
+
+    size_t read(uint8_t* buffer, size_t size) override { return m_serial.read(buffer, size); }
+    size_t write(const uint8_t* data, size_t size) override { return m_serial.write(data, size); }
+    bool   cancel(std::jthread& thread) override { return CancelSynchronousIo(thread.native_handle()) != 0; }
+    void   close() override { m_serial.close(); }
+
+private:
+    serial::Serial m_serial;
+};
+}    // namespace
+
 Device::Device(std::string_view port, bool open) : m_port(std::move(port)), m_label("SlCan")
 {
     if (open) { this->open(); }
@@ -38,7 +68,7 @@ Device& Device::operator=(Device&& o) noexcept
 
     m_port           = std::move(o.m_port);
     m_label          = std::move(o.m_label);
-    m_queue          = std::move(o.m_queue);
+    m_txQueue        = std::move(o.m_txQueue);
     m_muted          = o.m_muted.load();
     m_rxMonitorFunc  = std::move(o.m_rxMonitorFunc);
     m_txMonitorFunc  = std::move(o.m_txMonitorFunc);
@@ -48,7 +78,7 @@ Device& Device::operator=(Device&& o) noexcept
         if (reopen) { open(); }
     }
     catch (std::exception& e) {
-        BR_LOG_ERROR(m_label, "Unable to configure port '{}': {}", o.m_device->getPort(), e.what());
+        BR_LOG_ERROR(m_label, "Unable to configure port '{}': {}", m_port, e.what());
     }
     return *this;
 }
@@ -65,40 +95,138 @@ size_t Device::transmit(const Packet& pkt)
         }
     }
 
+    try {
+        return write(pkt);
+    }
+    catch (serial::PortNotOpenedException e) {
+        open();
+        BR_LOG_ERROR(m_label, "Device '{}' not open, reopening", m_port);
+        return 0;
+    }
+    catch (std::exception& e) {
+        BR_LOG_ERROR(m_label, "While transmitting on '{}': {}", m_port, e.what());
+        return 0;
+    }
+}
+
+bool Device::post(const Packet& pkt)
+{
+    FRASY_PROFILE_FUNCTION();
+    if (!isOpen() && !open()) {
+        BR_LOG_ERROR(m_label, "Unable to open '{}'", m_port);
+        return false;
+    }
+    {
+        std::lock_guard lock {m_txLock};
+        if (m_txQueue.size() >= s_txQueueCapacity) { return false; }
+        m_txQueue.push_back(pkt);
+    }
+    m_txCv.notify_one();
+    return true;
+}
+
+size_t Device::write(const Packet& pkt)
+{
     uint8_t buff[Packet::s_mtu] = {};
     auto    size                = pkt.toSerial(&buff[0], sizeof(buff));
-    if (size != -1) {
+    if (size == -1) { return 0; }
+
+    size_t written = 0;
+    {
+        FRASY_PROFILE_SCOPE("Write");
+        // Both the TX thread and transmit() write to the port.
+        std::lock_guard lock {m_writeLock};
+        written = m_device->write(&buff[0], size);
+    }
+    m_txMonitorFunc(pkt);
+    return written;
+}
+
+void Device::runRx(std::stop_token stopToken)
+{
+    if (FAILED(SetThreadDescription(
+          GetCurrentThread(), std::format(L"SlCAN RX {}", StringUtils::StringToWString(m_port)).c_str()))) {
+        BR_LOG_ERROR("SlCAN", "Unable to set thread description");
+    }
+    BR_LOG_INFO(m_label, "Started RX listener on '{}'", m_port);
+    RxBuffer buffer;
+    while (!stopToken.stop_requested()) {
         try {
-            size_t written = 0;
-            {
-                FRASY_PROFILE_SCOPE("Write");
-                written = m_device->write(&buff[0], size);
+            FRASY_PROFILE_SCOPE("RX Loop");
+            if (m_device == nullptr) { break; }
+            // Blocks until bytes come in, then takes all of them at once.
+            auto         writable = buffer.writable();
+            const size_t read     = m_device->read(writable.data(), writable.size());
+            if (read == 0) { continue; }
+
+            bool queued = false;
+            buffer.commit(read, [&](const Packet& packet) {
+                if (m_muted) { return; }
+                if (m_rxMonitorFunc) { m_rxMonitorFunc(packet); }
+                if (m_rxQueue.push(packet)) { queued = true; }
+                else {
+                    m_rxDropped.fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+            if (queued) {
+                m_rxQueue.notify();
+                m_rxCallbackFunc();
             }
-            m_txMonitorFunc(pkt);
-            return written;
         }
-        catch (serial::PortNotOpenedException e) {
-            open();
-            BR_LOG_ERROR(m_label, "Device '{}' not open, reopening", m_port);
-            return 0;
+        catch (std::exception& e) {
+            if (!stopToken.stop_requested()) {
+                auto getLastError = [] {
+                    char buff[100] = {};
+                    auto len       = FormatMessageA(FORMAT_MESSAGE_FROM_SYSTEM | FORMAT_MESSAGE_IGNORE_INSERTS,
+                                              nullptr,
+                                              GetLastError(),
+                                              MAKELANGID(LANG_NEUTRAL, SUBLANG_DEFAULT),
+                                              &buff[0],
+                                              sizeof(buff),
+                                              nullptr);
+                    return std::string {&buff[0], &buff[len]};
+                };
+                BR_LOG_ERROR(
+                  m_label, "An error occurred in the listener thread: {}\n\r\t{}", e.what(), getLastError());
+            }
+            break;
+        }
+    }
+    BR_LOG_INFO(m_label, "RX listener terminated on '{}'", m_port);
+}
+
+void Device::runTx(std::stop_token stopToken)
+{
+    if (FAILED(SetThreadDescription(
+          GetCurrentThread(), std::format(L"SlCAN TX {}", StringUtils::StringToWString(m_port)).c_str()))) {
+        BR_LOG_ERROR("SlCAN", "Unable to set thread description");
+    }
+    while (true) {
+        Packet packet;
+        {
+            std::unique_lock lock {m_txLock};
+            if (!m_txCv.wait(lock, stopToken, [this] { return !m_txQueue.empty(); })) { break; }
+            packet = m_txQueue.front();
+            m_txQueue.pop_front();
+        }
+        try {
+            FRASY_PROFILE_SCOPE("TX Loop");
+            if (write(packet) != packet.sizeOfSerialPacket()) {
+                BR_LOG_WARN(m_label, "Incomplete write of a {} packet on '{}'", commandToStr(packet.command), m_port);
+            }
         }
         catch (std::exception& e) {
+            // Closing the port cancels a stalled write, this is expected then.
+            if (stopToken.stop_requested()) { break; }
             BR_LOG_ERROR(m_label, "While transmitting on '{}': {}", m_port, e.what());
-            return 0;
         }
     }
-    return 0;
 }
 
 Packet Device::receive()
 {
     FRASY_PROFILE_FUNCTION();
-    std::unique_lock lk {m_lock};
-    m_cv.wait(lk, [this] { return !m_muted && !m_queue.empty(); });
-
-    auto front = m_queue.front();
-    m_queue.pop();
-    return front;
+    return m_rxQueue.waitPop();
 }
 
 bool Device::open()
@@ -107,70 +235,21 @@ bool Device::open()
     if (isOpen()) { close(); }
 
     try {
-        m_device = std::make_unique<serial::Serial>(m_port,
-                                                    921600,
-                                                    serial::Timeout::simpleTimeout(1),
-                                                    serial::eightbits,
-                                                    serial::parity_none,
-                                                    serial::stopbits_one,
-                                                    serial::flowcontrol_software);
+        if (VirtualPort::isVirtual(m_port)) {
+            m_device = std::make_unique<VirtualPort>(VirtualBus::get(VirtualPort::busName(m_port)),
+                                                     std::chrono::milliseconds {s_readTimeoutMs});
+        }
+        else {
+            m_device = std::make_unique<SerialPort>(m_port);
+        }
     }
     catch (std::exception& e) {
         BR_LOG_ERROR(m_label, "While opening '{}': {}", m_port, e.what());
         return false;
     }
 
-    m_rxThread = Brigerad::MakeThread([&](std::stop_token stopToken) {
-        if (FAILED(SetThreadDescription(
-              GetCurrentThread(),
-              std::format(L"SlCAN RX {}", StringUtils::StringToWString(m_device->getPort())).c_str()))) {
-            BR_LOG_ERROR("SlCAN", "Unable to set thread description");
-        }
-        BR_LOG_INFO(m_label, "Started RX listener on '{}'", m_device->getPort());
-        std::string read;
-        while (!stopToken.stop_requested()) {
-            try {
-                FRASY_PROFILE_SCOPE("RX Loop");
-                if (m_device == nullptr) { break; }
-                if (m_device->available() == 0) {
-                    Sleep(1);
-                    continue;
-                }
-                read.clear();
-                // TODO this might cause problems if we don't receive a complete packet.
-                m_device->readline(read, Packet::s_mtu, "\r");
-                if (m_muted || read.empty()) { continue; }
-                BR_LOG_TRACE(m_label, "RX: {}", read);
-                std::unique_lock lock {m_lock};
-                const auto&      packet = m_queue.emplace(reinterpret_cast<const uint8_t*>(read.data()), read.size());
-                m_rxMonitorFunc(packet);
-                // manual unlocking is done before notifying, to avoid waking up
-                // the waiting thread only to block again (see notify_one for details)
-                lock.unlock();
-                m_cv.notify_one();
-                m_rxCallbackFunc();
-            }
-            catch (std::exception& e) {
-                if (!stopToken.stop_requested()) {
-                    auto getLastError = [] {
-                        char buff[100] = {};
-                        auto len       = FormatMessageA(FORMAT_MESSAGE_FROM_SYSTEM | FORMAT_MESSAGE_IGNORE_INSERTS,
-                                                  nullptr,
-                                                  GetLastError(),
-                                                  MAKELANGID(LANG_NEUTRAL, SUBLANG_DEFAULT),
-                                                  &buff[0],
-                                                  sizeof(buff),
-                                                  nullptr);
-                        return std::string {&buff[0], &buff[len]};
-                    };
-                    BR_LOG_ERROR(
-                      m_label, "An error occurred in the listener thread: {}\n\r\t{}", e.what(), getLastError());
-                }
-                break;
-            }
-        }
-        BR_LOG_INFO(m_label, "RX listener terminated on '{}'", m_port);
-    });
+    m_rxThread = Brigerad::MakeThread([this](std::stop_token stopToken) { runRx(stopToken); });
+    m_txThread = Brigerad::MakeThread([this](std::stop_token stopToken) { runTx(stopToken); });
 
     return true;
 }
@@ -180,12 +259,19 @@ void Device::close()
     // If already closed, don't do anything.
     if (!isOpen()) { return; }
 
-    // Forcefully terminate *any* I/O operation done by the thread.
-    if (CancelSynchronousIo(m_rxThread.native_handle()) == 0) {
-        BR_LOG_WARN(m_label, "CancelSynchronousIo returned {}", GetLastError());
-    }
+    // Forcefully terminate *any* I/O operation done by the thread, it is waiting for bytes most of the time.
     m_rxThread.request_stop();
+    if (!m_device->cancel(m_rxThread)) { BR_LOG_WARN(m_label, "Unable to cancel the reads, error {}", GetLastError()); }
     if (m_rxThread.joinable()) { m_rxThread.join(); }
+    // The TX thread is usually waiting for packets rather than writing, there is nothing to cancel then.
+    m_txThread.request_stop();
+    m_device->cancel(m_txThread);
+    if (m_txThread.joinable()) { m_txThread.join(); }
+    {
+        // The frames not sent yet belong to the closed session, they must not go out once reopened.
+        std::scoped_lock lock {m_writeLock, m_txLock};
+        m_txQueue.clear();
+    }
     m_device->close();
     m_device.reset();
 }
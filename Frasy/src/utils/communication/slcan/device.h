@@ -19,15 +19,19 @@
 #ifndef FRASY_SRC_UTILS_COMMUNICATION_SLCAN_DEVICE_H
 #define FRASY_SRC_UTILS_COMMUNICATION_SLCAN_DEVICE_H
 #include "packet.h"
+#include "port.h"
+#include "spsc_queue.h"
 
 #include <serial/serial.h>
 
+#include <atomic>
 #include <condition_variable>
 #include <cstddef>
+#include <deque>
 #include <functional>
 #include <mutex>
-#include <queue>
 #include <string_view>
+#include <thread>
 
 namespace Frasy {
 class DeviceViewer;
@@ -36,9 +40,20 @@ class DeviceViewer;
 namespace Frasy::SlCan {
 class Device {
 public:
+    //! Packets that can wait for the TX thread before post() refuses new ones.
+    static constexpr std::size_t s_txQueueCapacity = 256;
+    //! Received packets that can wait for receive() before new ones are dropped.
+    static constexpr std::size_t s_rxQueueCapacity = 1024;
+    //! Longest a read waits for the first byte, how quickly the RX thread notices it is stopped without a cancel.
+    static constexpr uint32_t s_readTimeoutMs = 50;
+
     Device() noexcept = default;
     Device(Device&& o) noexcept { *this = std::move(o); }
     Device(const Device&) = delete;
+    /**
+     * @param port Serial port of the adapter, or a VirtualPort name ("virtual:<bus>").
+     * @param open Open the port right away.
+     */
     explicit Device(std::string_view port, bool open = true);
     ~Device() { close(); }
 
@@ -65,9 +80,24 @@ public:
      * @return Number of bytes written, 0 on error.
      */
     size_t transmit(const Packet& pkt);
+    /**
+     * Queues the packet for the TX thread of the device, to be written without blocking the caller.
+     *
+     * Failures to write are only logged.
+     * @param pkt Packet to be sent.
+     * @return false if the port is closed or its queue is full, which means it can't keep up.
+     */
+    bool   post(const Packet& pkt);
+    /**
+     * Takes the oldest received packet, waiting for one if there is none.
+     *
+     * Must only be called by one thread at a time.
+     */
     Packet receive();
 
-    [[nodiscard]] size_t available() const { return m_queue.size(); }
+    [[nodiscard]] size_t available() const { return m_rxQueue.size(); }
+    //! Packets received while the queue was full.
+    [[nodiscard]] size_t droppedPackets() const { return m_rxDropped.load(std::memory_order_relaxed); }
 
     void setRxCallbackFunc(const std::function<void()>& func)
     {
@@ -75,21 +105,31 @@ public:
     }
 
 private:
-    std::string                     m_port;
-    std::string                     m_label;
-    std::unique_ptr<serial::Serial> m_device;    //!< The physical communication interface.
+    //! Writes the packet, without trying to open the port. Throws on errors.
+    size_t write(const Packet& pkt);
+    void   runRx(std::stop_token stopToken);
+    void   runTx(std::stop_token stopToken);
+
+    std::string           m_port;
+    std::string           m_label;
+    std::unique_ptr<Port> m_device;    //!< The serial port of the adapter, or a VirtualPort.
 
     std::jthread m_rxThread;
+    std::jthread m_txThread;
+
+    SpscQueue<Packet, s_rxQueueCapacity> m_rxQueue;
+    std::atomic_size_t                   m_rxDropped = 0;
 
-    std::mutex              m_lock;
-    std::condition_variable m_cv;
-    std::queue<Packet>      m_queue;
+    std::mutex                  m_writeLock;
+    std::mutex                  m_txLock;
+    std::condition_variable_any m_txCv;
+    std::deque<Packet>          m_txQueue;
 
     std::atomic_bool m_muted = false;
 
     // Things used by the device viewer for monitoring purposes.
     friend class DeviceViewer;
-    std::function<void(const Packet&)> m_rxMonitorFunc  = [](const Packet&) {};
+    std::function<void(const Packet&)> m_rxMonitorFunc  = {};
     std::function<void(const Packet&)> m_txMonitorFunc  = [](const Packet&) {};
     std::function<void()>              m_rxCallbackFunc = [] {};
 };
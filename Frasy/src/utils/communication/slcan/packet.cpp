@@ -16,6 +16,8 @@
  */
 #include "packet.h"
 
+#include "utils/misc/hex.h"
+
 #include <Brigerad.h>
 
 #include <cassert>
@@ -50,26 +52,15 @@ Packet::Packet(const uint8_t* data, size_t len)
     len--;                                   // Remove the command.
     if (data[len - 1] == '\r') { len--; }    // Remove the terminator, if present.
 
-    uint8_t workBuff[s_mtu];
-    // Convert from ASCII.
-    for (size_t i = 0; i < len; i++) {
-        if (data[i] >= 'a' && data[i] <= 'f') { workBuff[i] = data[i] - 'a' + 10; }
-        else if (data[i] >= 'A' && data[i] <= 'F') {
-            workBuff[i] = data[i] - 'A' + 10;
-        }
-        else if (data[i] >= '0' && data[i] <= '9') {
-            workBuff[i] = data[i] - '0';
-        }
-        else {
-            // Invalid character!
-            BR_LOG_ERROR(s_tag,
-                         "Invalid character '{}' ({:#02x}) at position {}",
-                         std::isprint(data[i]) == 0 ? ' ' : data[i],
-                         data[i],
-                         i);
-            command = Command::Invalid;
-            return;
-        }
+    // Everything after the command is hexadecimal.
+    if (const size_t invalid = Hex::findNonHex(data, len); invalid != len) {
+        BR_LOG_ERROR(s_tag,
+                     "Invalid character '{}' ({:#02x}) at position {}",
+                     std::isprint(data[invalid]) == 0 ? ' ' : data[invalid],
+                     data[invalid],
+                     invalid);
+        command = Command::Invalid;
+        return;
     }
 
     if (command == Command::SetBitRate) { this->data.bitrate = bitRateFromChar(data[1]); }
@@ -94,11 +85,11 @@ Packet::Packet(const uint8_t* data, size_t len)
             return;
         }
 
-        uint8_t* ptr             = &workBuff[0];
+        const uint8_t* ptr       = data;
         this->data.packetData.id = 0;
         for (size_t i = 0; i < idLen; i++, ptr++) {
             this->data.packetData.id *= 16;
-            this->data.packetData.id += *ptr;
+            this->data.packetData.id += Hex::s_nibbleValues[*ptr];
         }
 
         len -= idLen;
@@ -109,7 +100,7 @@ Packet::Packet(const uint8_t* data, size_t len)
                 return;
             }
 
-            this->data.packetData.dataLen = *ptr;
+            this->data.packetData.dataLen = Hex::s_nibbleValues[*ptr];
             ptr++;
             len--;
 
@@ -129,11 +120,8 @@ Packet::Packet(const uint8_t* data, size_t len)
                 return;
             }
 
-            // Copy the packet data to the buffer.
-            for (size_t i = 0; i < this->data.packetData.dataLen; i++) {
-                this->data.packetData.data[i] = (ptr[0] << 4) | ptr[1];
-                ptr += 2;
-            }
+            // The characters were checked already.
+            static_cast<void>(Hex::decode(ptr, this->data.packetData.dataLen, &this->data.packetData.data[0]));
         }
     }
 }
@@ -219,11 +207,7 @@ int8_t Packet::toSerial(uint8_t* outBuff, size_t outBuffLen) const
 
     auto addToBuff = [](uint8_t* buff, uint8_t val) -> uint8_t* {
         // Convert the value to ASCII.
-        if (val <= 9) { val += '0'; }
-        else if (val >= 0xA && val <= 0xF) {
-            val = (val - 10) + 'A';
-        }
-        *buff = val;
+        *buff = val <= 0xF ? Hex::s_digits[val] : val;
         buff++;
         return buff;
     };
@@ -238,11 +222,8 @@ int8_t Packet::toSerial(uint8_t* outBuff, size_t outBuffLen) const
 
     auto addDataToBuff = [&addToBuff](uint8_t* buff, const uint8_t* data, uint8_t len) -> uint8_t* {
         buff = addToBuff(buff, len);
-        for (uint8_t i = 0; i < len; i++) {
-            buff = addToBuff(buff, data[i] >> 4);
-            buff = addToBuff(buff, data[i] & 0xF);
-        }
-        return buff;
+        Hex::encode(data, len, buff);
+        return buff + (2 * len);
     };
 
     switch (command) {
@@ -0,0 +1,56 @@
+/**
+ * @file    port.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Byte stream to a SLCAN adapter.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef FRASY_SRC_UTILS_COMMUNICATION_SLCAN_PORT_H
+#define FRASY_SRC_UTILS_COMMUNICATION_SLCAN_PORT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+namespace Frasy::SlCan {
+/**
+ * What a Device reads and writes SLCAN frames through: the serial port of an adapter, or a VirtualPort.
+ *
+ * Reads are done by the RX thread of the device and writes by its TX thread, or by the caller of transmit().
+ */
+class Port {
+public:
+    virtual ~Port() = default;
+
+    [[nodiscard]] virtual bool isOpen() const = 0;
+
+    /**
+     * Waits for the first byte, up to Device::s_readTimeoutMs, then takes what is available without waiting further.
+     *
+     * @return The number of bytes read, 0 on a timeout. Throws on errors.
+     */
+    virtual std::size_t read(uint8_t* buffer, std::size_t size) = 0;
+    //! @return The number of bytes written. Throws on errors.
+    virtual std::size_t write(const uint8_t* data, std::size_t size) = 0;
+
+    /**
+     * Makes a read or a write that @p thread is blocked in return.
+     *
+     * @return false if it couldn't be done.
+     */
+    virtual bool cancel(std::jthread& thread) = 0;
+    virtual void close()                      = 0;
+};
+}    // namespace Frasy::SlCan
+
+#endif    // FRASY_SRC_UTILS_COMMUNICATION_SLCAN_PORT_H
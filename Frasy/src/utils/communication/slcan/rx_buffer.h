@@ -0,0 +1,90 @@
+/**
+ * @file    rx_buffer.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Splits the byte stream of a SLCAN port into packets.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef FRASY_SRC_UTILS_COMMUNICATION_SLCAN_RX_BUFFER_H
+#define FRASY_SRC_UTILS_COMMUNICATION_SLCAN_RX_BUFFER_H
+
+#include "packet.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+namespace Frasy::SlCan {
+/**
+ * Buffer the port is read into, as many bytes at a time as it has.
+ *
+ * Every complete frame ('\r' terminated) is parsed in place after a read. Only the incomplete frame at the end, if
+ * any, is moved back to the start of the buffer to be completed by the next read.
+ */
+class RxBuffer {
+public:
+    static constexpr std::size_t s_capacity = 4096;
+
+    //! Where the next read goes, never empty.
+    [[nodiscard]] std::span<uint8_t> writable() { return {m_buffer.data() + m_size, s_capacity - m_size}; }
+
+    /**
+     * Takes in the bytes read into writable() and parses every frame they complete.
+     *
+     * @param count Number of bytes read.
+     * @param onPacket Called with each parsed packet, in order.
+     * @return The number of frames parsed.
+     */
+    template<typename OnPacket>
+    std::size_t commit(std::size_t count, OnPacket&& onPacket)
+    {
+        m_size += count;
+        const uint8_t* frame  = m_buffer.data();
+        const uint8_t* end    = frame + m_size;
+        std::size_t    parsed = 0;
+        while (const auto* terminator = static_cast<const uint8_t*>(std::memchr(frame, '\r', end - frame))) {
+            // A lone '\r' is an acknowledgement from the adapter, it has nothing to parse.
+            if (terminator != frame) {
+                onPacket(Packet {frame, static_cast<std::size_t>(terminator - frame) + 1});
+                ++parsed;
+            }
+            frame = terminator + 1;
+        }
+
+        m_size = end - frame;
+        if (m_size == s_capacity) {
+            // Nothing but garbage, a frame is at most Packet::s_mtu bytes.
+            m_discarded += m_size;
+            m_size = 0;
+        }
+        else if (frame != m_buffer.data()) {
+            std::memmove(m_buffer.data(), frame, m_size);
+        }
+        return parsed;
+    }
+
+    //! Bytes of an incomplete frame waiting for the next read.
+    [[nodiscard]] std::size_t pending() const { return m_size; }
+    //! Bytes thrown away because no frame ended in the whole buffer.
+    [[nodiscard]] std::size_t discarded() const { return m_discarded; }
+
+private:
+    std::array<uint8_t, s_capacity> m_buffer    = {};
+    std::size_t                     m_size      = 0;
+    std::size_t                     m_discarded = 0;
+};
+}    // namespace Frasy::SlCan
+
+#endif    // FRASY_SRC_UTILS_COMMUNICATION_SLCAN_RX_BUFFER_H
@@ -0,0 +1,91 @@
+/**
+ * @file    spsc_queue.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Bounded lock-free queue, for one producer thread and one consumer thread.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef FRASY_SRC_UTILS_COMMUNICATION_SLCAN_SPSC_QUEUE_H
+#define FRASY_SRC_UTILS_COMMUNICATION_SLCAN_SPSC_QUEUE_H
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+
+namespace Frasy::SlCan {
+/**
+ * Preallocated ring of Capacity items. push() must only be called by the producer, pop() and waitPop() by the
+ * consumer.
+ *
+ * The producer calls notify() after pushing a batch to wake up a consumer blocked in waitPop(), rather than on every
+ * push.
+ */
+template<typename T, std::size_t Capacity>
+    requires(std::has_single_bit(Capacity))
+class SpscQueue {
+public:
+    SpscQueue()                            = default;
+    SpscQueue(const SpscQueue&)            = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    //! @return false if the queue is full.
+    bool push(const T& item)
+    {
+        const auto head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) == Capacity) { return false; }
+        m_items[head & s_mask] = item;
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    void notify() { m_head.notify_all(); }
+
+    //! @return false if the queue is empty.
+    bool pop(T& item)
+    {
+        const auto tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_head.load(std::memory_order_acquire)) { return false; }
+        item = m_items[tail & s_mask];
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    //! Blocks until an item is pushed and notified.
+    T waitPop()
+    {
+        T item;
+        while (!pop(item)) {
+            m_head.wait(m_tail.load(std::memory_order_relaxed), std::memory_order_acquire);
+        }
+        return item;
+    }
+
+    [[nodiscard]] std::size_t size() const
+    {
+        return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+    }
+    [[nodiscard]] bool empty() const { return size() == 0; }
+
+    static constexpr std::size_t capacity() { return Capacity; }
+
+private:
+    static constexpr std::size_t s_mask = Capacity - 1;
+
+    std::array<T, Capacity> m_items = {};
+    alignas(64) std::atomic_size_t m_head = 0;    //!< Position of the next push.
+    alignas(64) std::atomic_size_t m_tail = 0;    //!< Position of the next pop.
+};
+}    // namespace Frasy::SlCan
+
+#endif    // FRASY_SRC_UTILS_COMMUNICATION_SLCAN_SPSC_QUEUE_H
@@ -0,0 +1,60 @@
+/**
+ * @file    virtual_bus.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <https://www.gnu.org/licenses/>.
+ */
+#include "virtual_bus.h"
+
+#include <algorithm>
+#include <map>
+
+namespace Frasy::SlCan {
+std::shared_ptr<VirtualBus> VirtualBus::get(std::string_view name)
+{
+    static std::mutex                                                    s_lock;
+    static std::map<std::string, std::weak_ptr<VirtualBus>, std::less<>> s_buses;
+
+    std::lock_guard lock {s_lock};
+    auto            it = s_buses.find(name);
+    if (it != s_buses.end()) {
+        if (auto bus = it->second.lock()) { return bus; }
+    }
+    auto bus                    = std::make_shared<VirtualBus>(name);
+    s_buses[std::string {name}] = bus;
+    return bus;
+}
+
+VirtualBus::Handle VirtualBus::attach(Receiver receiver)
+{
+    std::lock_guard lock {m_lock};
+    const Handle    handle = m_nextHandle++;
+    m_endpoints.push_back({handle, std::move(receiver)});
+    return handle;
+}
+
+void VirtualBus::detach(Handle handle)
+{
+    std::lock_guard lock {m_lock};
+    std::erase_if(m_endpoints, [handle](const Endpoint& endpoint) { return endpoint.handle == handle; });
+}
+
+void VirtualBus::send(const CanPacket& frame, Handle from)
+{
+    std::lock_guard lock {m_lock};
+    m_framesSent.fetch_add(1, std::memory_order_relaxed);
+    for (const auto& endpoint : m_endpoints) {
+        if (endpoint.handle != from) { endpoint.receiver(frame); }
+    }
+}
+}    // namespace Frasy::SlCan
@@ -0,0 +1,82 @@
+/**
+ * @file    virtual_bus.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   In-process CAN bus, for running without adapters nor boards.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef FRASY_SRC_UTILS_COMMUNICATION_SLCAN_VIRTUAL_BUS_H
+#define FRASY_SRC_UTILS_COMMUNICATION_SLCAN_VIRTUAL_BUS_H
+
+#include "packet.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Frasy::SlCan {
+/**
+ * Every frame sent on the bus is delivered to every endpoint attached to it, except the sender, like on a real bus.
+ *
+ * Frames are delivered from the thread of the sender, one frame at a time: two endpoints sending at once are
+ * serialized, like the arbitration of a real bus would do. Receivers must therefore only queue the frames, sending
+ * from a receiver deadlocks.
+ */
+class VirtualBus {
+public:
+    using Receiver = std::function<void(const CanPacket&)>;
+    using Handle   = std::size_t;
+
+    explicit VirtualBus(std::string_view name) : m_name(name) {}
+    VirtualBus(const VirtualBus&)            = delete;
+    VirtualBus& operator=(const VirtualBus&) = delete;
+
+    /**
+     * The bus shared by everything in the process that uses @p name, created by the first one.
+     *
+     * The bus is destroyed once nothing holds it anymore.
+     */
+    static std::shared_ptr<VirtualBus> get(std::string_view name);
+
+    [[nodiscard]] const std::string& name() const noexcept { return m_name; }
+
+    //! @return What identifies the endpoint when it sends, and to detach it.
+    Handle attach(Receiver receiver);
+    //! Once this returns, the receiver is no longer called.
+    void   detach(Handle handle);
+
+    void send(const CanPacket& frame, Handle from);
+
+    [[nodiscard]] uint64_t framesSent() const { return m_framesSent.load(std::memory_order_relaxed); }
+
+private:
+    struct Endpoint {
+        Handle   handle;
+        Receiver receiver;
+    };
+
+    std::string           m_name;
+    std::mutex            m_lock;
+    std::vector<Endpoint> m_endpoints;
+    Handle                m_nextHandle = 1;
+    std::atomic_uint64_t  m_framesSent = 0;
+};
+}    // namespace Frasy::SlCan
+
+#endif    // FRASY_SRC_UTILS_COMMUNICATION_SLCAN_VIRTUAL_BUS_H
@@ -0,0 +1,114 @@
+/**
+ * @file    virtual_port.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <https://www.gnu.org/licenses/>.
+ */
+#include "virtual_port.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace Frasy::SlCan {
+VirtualPort::VirtualPort(std::shared_ptr<VirtualBus> bus, std::chrono::milliseconds readTimeout)
+: m_bus(std::move(bus)), m_readTimeout(readTimeout)
+{
+    m_handle = m_bus->attach([this](const CanPacket& frame) {
+        uint8_t    buffer[Packet::s_mtu] = {};
+        const auto size                  = Packet {frame}.toSerial(&buffer[0], sizeof(buffer));
+        if (size > 0) { queue(&buffer[0], static_cast<std::size_t>(size)); }
+    });
+}
+
+std::size_t VirtualPort::read(uint8_t* buffer, std::size_t size)
+{
+    std::unique_lock lock {m_rxLock};
+    const uint64_t   cancels = m_cancels;
+    m_rxCv.wait_for(
+      lock, m_readTimeout, [&] { return m_rxOffset != m_rx.size() || !isOpen() || m_cancels != cancels; });
+    if (!isOpen()) { throw std::runtime_error("Virtual port is closed"); }
+
+    const std::size_t count = std::min(size, m_rx.size() - m_rxOffset);
+    if (count == 0) { return 0; }
+    std::memcpy(buffer, m_rx.data() + m_rxOffset, count);
+    m_rxOffset += count;
+    if (m_rxOffset == m_rx.size()) {
+        m_rx.clear();
+        m_rxOffset = 0;
+    }
+    else if (m_rxOffset >= s_rxCapacity) {
+        // A reader that never catches up completely would otherwise grow the buffer forever.
+        m_rx.erase(m_rx.begin(), m_rx.begin() + static_cast<std::ptrdiff_t>(m_rxOffset));
+        m_rxOffset = 0;
+    }
+    return count;
+}
+
+std::size_t VirtualPort::write(const uint8_t* data, std::size_t size)
+{
+    if (!isOpen()) { throw std::runtime_error("Virtual port is closed"); }
+
+    std::lock_guard lock {m_txLock};
+    std::size_t     written = 0;
+    while (written < size) {
+        auto              writable = m_tx.writable();
+        const std::size_t count    = std::min(writable.size(), size - written);
+        std::memcpy(writable.data(), data + written, count);
+        written += count;
+        m_tx.commit(count, [this](const Packet& packet) {
+            if (auto frame = packet.toCanPacket()) { m_bus->send(*frame, m_handle); }
+            else if (packet.command != Command::Invalid) {
+                constexpr uint8_t ack = '\r';
+                queue(&ack, 1);
+            }
+        });
+    }
+    return written;
+}
+
+bool VirtualPort::cancel([[maybe_unused]] std::jthread& thread)
+{
+    // Only reads can block, writes go straight to the bus.
+    {
+        std::lock_guard lock {m_rxLock};
+        ++m_cancels;
+    }
+    m_rxCv.notify_all();
+    return true;
+}
+
+void VirtualPort::close()
+{
+    if (!m_open.exchange(false)) { return; }
+    m_bus->detach(m_handle);
+    {
+        // Taking the lock makes sure a reader is either waiting, and gets notified, or sees the port closed.
+        std::lock_guard lock {m_rxLock};
+    }
+    m_rxCv.notify_all();
+}
+
+void VirtualPort::queue(const uint8_t* data, std::size_t size)
+{
+    {
+        std::lock_guard lock {m_rxLock};
+        if (m_rx.size() - m_rxOffset + size > s_rxCapacity) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        m_rx.insert(m_rx.end(), data, data + size);
+    }
+    m_rxCv.notify_one();
+}
+}    // namespace Frasy::SlCan
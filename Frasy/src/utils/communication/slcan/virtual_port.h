@@ -0,0 +1,92 @@
+/**
+ * @file    virtual_port.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   SLCAN adapter connected to a VirtualBus.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef FRASY_SRC_UTILS_COMMUNICATION_SLCAN_VIRTUAL_PORT_H
+#define FRASY_SRC_UTILS_COMMUNICATION_SLCAN_VIRTUAL_PORT_H
+
+#include "port.h"
+#include "rx_buffer.h"
+#include "virtual_bus.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace Frasy::SlCan {
+/**
+ * Speaks SLCAN like an adapter would, but its CAN side is a VirtualBus rather than a physical one.
+ *
+ * The frames written to the port are sent on the bus, the frames of the other endpoints of the bus are read from the
+ * port. Configuration commands are acknowledged with a '\r' and otherwise ignored.
+ *
+ * A Device opens a virtual port when its port name is s_prefix followed by the name of the bus, "virtual:fixture"
+ * for instance.
+ */
+class VirtualPort : public Port {
+public:
+    static constexpr std::string_view s_prefix     = "virtual:";
+    //! Bytes waiting to be read before the frames coming from the bus are dropped, like an adapter overflowing.
+    static constexpr std::size_t      s_rxCapacity = 64 * 1024;
+
+    explicit VirtualPort(std::shared_ptr<VirtualBus> bus,
+                         std::chrono::milliseconds   readTimeout = std::chrono::milliseconds {50});
+    ~VirtualPort() override { close(); }
+    VirtualPort(const VirtualPort&)            = delete;
+    VirtualPort& operator=(const VirtualPort&) = delete;
+
+    [[nodiscard]] static bool isVirtual(std::string_view port) { return port.starts_with(s_prefix); }
+    //! Name of the bus of a virtual port name.
+    [[nodiscard]] static std::string_view busName(std::string_view port) { return port.substr(s_prefix.size()); }
+
+    [[nodiscard]] bool isOpen() const override { return m_open.load(std::memory_order_acquire); }
+
+    std::size_t read(uint8_t* buffer, std::size_t size) override;
+    std::size_t write(const uint8_t* data, std::size_t size) override;
+    bool        cancel(std::jthread& thread) override;
+    void        close() override;
+
+    [[nodiscard]] const std::shared_ptr<VirtualBus>& bus() const noexcept { return m_bus; }
+    //! Frames of the bus dropped because the port wasn't read fast enough.
+    [[nodiscard]] std::size_t droppedFrames() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    void queue(const uint8_t* data, std::size_t size);
+
+    std::shared_ptr<VirtualBus> m_bus;
+    VirtualBus::Handle          m_handle = 0;
+    std::chrono::milliseconds   m_readTimeout;
+    std::atomic_bool            m_open = true;
+
+    std::mutex              m_rxLock;
+    std::condition_variable m_rxCv;
+    std::vector<uint8_t>    m_rx;
+    std::size_t             m_rxOffset = 0;    //!< Bytes of m_rx already read.
+    uint64_t                m_cancels  = 0;
+    std::atomic_size_t      m_dropped  = 0;
+
+    std::mutex m_txLock;
+    RxBuffer   m_tx;    //!< Splits what is written into frames.
+};
+}    // namespace Frasy::SlCan
+
+#endif    // FRASY_SRC_UTILS_COMMUNICATION_SLCAN_VIRTUAL_PORT_H
@@ -98,6 +98,10 @@ int HeadlessRunner::run()
           importHeadlessPopup(lua, uut, m_args.outputFormat, m_args.popupTimeoutSeconds, m_ioMutex);
       });
 
+    m_orchestrator.setParallelTests(m_args.parallelTests);
+    m_orchestrator.setArchiveFormat(
+      Analyzers::ReportFile::ParseFormat(m_args.archiveFormat).value_or(Analyzers::ReportFile::Format::Json));
+
     // 8. Start progress reporter
     ProgressReporter progressReporter(m_args.outputFormat, product.name, m_args.serials, m_ioMutex);
     progressReporter.reportStart();
@@ -0,0 +1,185 @@
+/**
+ * @file    chunk_cache.cpp
+ * @author  Frasy
+ * @date    2026-10-16
+ * @brief   Cache of precompiled Lua chunks shared by every sol::state of the orchestrator.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <https://www.gnu.org/licenses/>.
+ */
+#include "chunk_cache.h"
+
+#include <format>
+#include <fstream>
+#include <iterator>
+
+namespace Frasy::Lua {
+namespace {
+int WriteBytecode([[maybe_unused]] lua_State* lua, const void* data, size_t size, void* userData)
+{
+    static_cast<std::string*>(userData)->append(static_cast<const char*>(data), size);
+    return 0;
+}
+
+/**
+ * Mimic what luaL_loadfile does with the start of a file: skip the UTF-8 BOM and the first line if it is a comment
+ * (e.g. a shebang), keeping the line break so that line numbers are left untouched.
+ */
+std::string_view SkipPrefix(std::string_view source)
+{
+    static constexpr std::string_view bom = "\xEF\xBB\xBF";
+    if (source.starts_with(bom)) { source.remove_prefix(bom.size()); }
+    if (source.starts_with('#')) {
+        auto eol = source.find('\n');
+        source.remove_prefix(eol == std::string_view::npos ? source.size() : eol);
+    }
+    return source;
+}
+}    // namespace
+
+void ChunkCache::setKey(const std::string& key)
+{
+    std::unique_lock lock {m_lock};
+    if (key.empty() || key != m_key) { m_chunks.clear(); }
+    m_key = key;
+}
+
+void ChunkCache::clear()
+{
+    std::unique_lock lock {m_lock};
+    m_chunks.clear();
+}
+
+int ChunkCache::load(lua_State* lua, const std::string& path)
+{
+    auto chunk = getChunk(path);
+    std::call_once(chunk->compiled, [&] { compile(lua, path, *chunk); });
+
+    if (chunk->status != LUA_OK) {
+        ++m_failures;
+        lua_pushlstring(lua, chunk->bytecode.data(), chunk->bytecode.size());
+        return chunk->status;
+    }
+    const std::string chunkName = "@" + path;
+    return luaL_loadbufferx(lua, chunk->bytecode.data(), chunk->bytecode.size(), chunkName.c_str(), "b");
+}
+
+sol::protected_function_result ChunkCache::scriptFile(sol::state_view lua, const std::string& path)
+{
+    if (load(lua.lua_state(), path) != LUA_OK) {
+        auto message = sol::stack::pop<std::string>(lua.lua_state());
+        throw sol::error(sol::detail::direct_error, message);
+    }
+    auto func   = sol::stack::pop<sol::protected_function>(lua.lua_state());
+    auto result = func();
+    if (!result.valid()) {
+        sol::error err = result;
+        throw err;
+    }
+    return result;
+}
+
+sol::object ChunkCache::requireFile(sol::state_view lua, const std::string& key, const std::string& path)
+{
+    sol::table  loaded = lua["package"]["loaded"];
+    sol::object module = loaded[key];
+    if (module.get_type() == sol::type::lua_nil) {
+        sol::object result = scriptFile(lua, path);
+        // Same as require: a module that returns nothing is stored as true.
+        module      = result.get_type() == sol::type::lua_nil ? sol::make_object(lua, true) : result;
+        loaded[key] = module;
+    }
+    lua[key] = module;
+    return module;
+}
+
+void ChunkCache::install(sol::state_view lua)
+{
+    lua_State* state = lua.lua_state();
+    lua_getglobal(state, LUA_LOADLIBNAME);
+    lua_getfield(state, -1, "searchers");
+    lua_pushlightuserdata(state, this);
+    lua_pushcclosure(state, &ChunkCache::searcher, 1);
+    // The 2nd searcher is the one looking for Lua files along package.path.
+    lua_rawseti(state, -2, 2);
+    lua_pop(state, 2);
+}
+
+std::shared_ptr<ChunkCache::Chunk> ChunkCache::getChunk(const std::string& path)
+{
+    {
+        std::shared_lock lock {m_lock};
+        if (auto it = m_chunks.find(path); it != m_chunks.end()) {
+            ++m_hits;
+            return it->second;
+        }
+    }
+
+    std::unique_lock lock {m_lock};
+    auto [it, inserted] = m_chunks.try_emplace(path, nullptr);
+    if (inserted) {
+        it->second = std::make_shared<Chunk>();
+        ++m_misses;
+    }
+    else {
+        ++m_hits;
+    }
+    return it->second;
+}
+
+void ChunkCache::compile(lua_State* lua, const std::string& path, Chunk& chunk)
+{
+    std::ifstream file {path, std::ios::binary};
+    if (!file.is_open()) {
+        chunk.status   = LUA_ERRFILE;
+        chunk.bytecode = std::format("cannot open {}", path);
+        return;
+    }
+    const std::string      content {std::istreambuf_iterator {file}, {}};
+    const std::string_view source    = SkipPrefix(content);
+    const std::string      chunkName = "@" + path;
+
+    chunk.status = luaL_loadbufferx(lua, source.data(), source.size(), chunkName.c_str(), "t");
+    if (chunk.status != LUA_OK) {
+        chunk.bytecode = lua_tostring(lua, -1);
+        lua_pop(lua, 1);
+        return;
+    }
+    // Debug information is kept, tracebacks and the profiler rely on it.
+    lua_dump(lua, &WriteBytecode, &chunk.bytecode, 0);
+    lua_pop(lua, 1);
+}
+
+int ChunkCache::searcher(lua_State* lua)
+{
+    auto*       cache = static_cast<ChunkCache*>(lua_touserdata(lua, lua_upvalueindex(1)));
+    const char* name  = luaL_checkstring(lua, 1);
+
+    // Resolve the module the same way the stock searcher does, through package.searchpath.
+    lua_getglobal(lua, LUA_LOADLIBNAME);
+    lua_getfield(lua, -1, "searchpath");
+    lua_pushstring(lua, name);
+    lua_getfield(lua, -3, "path");
+    lua_call(lua, 2, 2);
+    if (lua_isnil(lua, -2)) {
+        // Not found, return the description of the paths that were tried.
+        return 1;
+    }
+    const std::string filename = lua_tostring(lua, -2);
+    lua_pop(lua, 3);
+
+    if (cache->load(lua, filename) != LUA_OK) {
+        return luaL_error(
+          lua, "error loading module '%s' from file '%s':\n\t%s", name, filename.c_str(), lua_tostring(lua, -1));
+    }
+    lua_pushstring(lua, filename.c_str());
+    return 2;
+}
+}    // namespace Frasy::Lua
@@ -0,0 +1,116 @@
+/**
+ * @file    chunk_cache.h
+ * @author  Frasy
+ * @date    2026-10-16
+ * @brief   Cache of precompiled Lua chunks shared by every sol::state of the orchestrator.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef FRASY_UTILS_LUA_CHUNK_CACHE_H
+#define FRASY_UTILS_LUA_CHUNK_CACHE_H
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <sol/sol.hpp>
+#include <string>
+
+namespace Frasy::Lua {
+/**
+ * @brief Compiles each Lua file once and hands the resulting bytecode to every state that loads it.
+ *
+ * The cache is keyed by the content of the Lua directories: as long as the key given to setKey() doesn't change, a
+ * file is never read nor parsed twice. The orchestrator uses the hashes verified by HashDir as the key, meaning that
+ * the cache survives between runs for as long as the scripts are left untouched. An empty key disables that
+ * persistence, the cache is then flushed every time setKey() is called.
+ *
+ * Files loaded with require() go through the cache once install() has been called on a state.
+ */
+class ChunkCache {
+public:
+    struct Stats {
+        std::size_t hits     = 0;
+        std::size_t misses   = 0;
+        std::size_t failures = 0;
+    };
+
+    /**
+     * Set the key that the cached chunks are valid for.
+     * Every chunk is dropped if the key differs from the current one or if it is empty.
+     * @param key Identifier of the content of the Lua files, typically their hash.
+     */
+    void setKey(const std::string& key);
+
+    /**
+     * Drop every cached chunk.
+     */
+    void clear();
+
+    /**
+     * Load a Lua file as a function, pushing it on the stack of the state.
+     * Behaves like luaL_loadfile: on error, the error message is pushed instead.
+     * @param lua State to load the file in.
+     * @param path Path to the file.
+     * @return LUA_OK on success, the error code otherwise.
+     */
+    int load(lua_State* lua, const std::string& path);
+
+    /**
+     * Drop-in replacement for sol::state_view::script_file that goes through the cache.
+     * @param lua State to run the file in.
+     * @param path Path to the file.
+     * @return The values returned by the file.
+     * @throws sol::error if the file cannot be loaded or if it raises an error.
+     */
+    sol::protected_function_result scriptFile(sol::state_view lua, const std::string& path);
+
+    /**
+     * Drop-in replacement for sol::state_view::require_file that goes through the cache.
+     * @param lua State to load the module in.
+     * @param key Name of the module, also used as the name of the global.
+     * @param path Path to the file.
+     * @return The module.
+     */
+    sol::object requireFile(sol::state_view lua, const std::string& key, const std::string& path);
+
+    /**
+     * Replace the Lua searcher of package.searchers by one that loads the files through the cache.
+     * The cache must outlive the state.
+     * @param lua State to install the searcher in. The package library must already be opened.
+     */
+    void install(sol::state_view lua);
+
+    [[nodiscard]] Stats stats() const { return {m_hits.load(), m_misses.load(), m_failures.load()}; }
+
+private:
+    struct Chunk {
+        std::once_flag compiled;
+        int            status = LUA_OK;
+        std::string    bytecode;    //! Bytecode if the compilation succeeded, the error message otherwise.
+    };
+
+    std::shared_ptr<Chunk> getChunk(const std::string& path);
+    static void            compile(lua_State* lua, const std::string& path, Chunk& chunk);
+    static int             searcher(lua_State* lua);
+
+    mutable std::shared_mutex                     m_lock;
+    std::string                                   m_key;
+    std::map<std::string, std::shared_ptr<Chunk>> m_chunks;
+
+    std::atomic_size_t m_hits     = 0;
+    std::atomic_size_t m_misses   = 0;
+    std::atomic_size_t m_failures = 0;
+};
+}    // namespace Frasy::Lua
+
+#endif    // FRASY_UTILS_LUA_CHUNK_CACHE_H
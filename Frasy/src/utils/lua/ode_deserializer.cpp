@@ -19,6 +19,8 @@
 #include "../communication/can_open/types.h"
 #include "utils/misc/deserializer.h"
 
+#include <format>
+
 using DataType = Frasy::CanOpen::DataType;
 
 static float deserializeFloat(const std::span<uint8_t>& value)
@@ -130,3 +132,91 @@ sol::object deserializeOdeValue(sol::state_view& lua, const sol::table& ode, con
         default: throw std::runtime_error("Not implemented");
     }
 }
+
+static std::size_t fixedSize(DataType type)
+{
+    switch (type) {
+        case DataType::boolean:
+        case DataType::integer8:
+        case DataType::unsigned8: return 1;
+        case DataType::integer16:
+        case DataType::unsigned16: return 2;
+        case DataType::integer24:
+        case DataType::unsigned24: return 3;
+        case DataType::integer32:
+        case DataType::unsigned32:
+        case DataType::real32: return 4;
+        case DataType::integer40:
+        case DataType::unsigned40: return 5;
+        case DataType::integer48:
+        case DataType::unsigned48:
+        case DataType::timeOfDay:
+        case DataType::timeDifference: return 6;
+        case DataType::integer56:
+        case DataType::unsigned56: return 7;
+        case DataType::integer64:
+        case DataType::unsigned64:
+        case DataType::real64: return 8;
+        default: return 0;
+    }
+}
+
+template<typename F>
+static void fillArray(sol::table& table, const std::span<uint8_t>& value, std::size_t size, F&& deserialize)
+{
+    for (std::size_t i = 0; i < value.size() / size; ++i) {
+        table.raw_set(i + 1, deserialize(value.subspan(i * size, size)));
+    }
+}
+
+sol::table deserializeOdeArray(sol::state_view& lua, uint16_t elementType, const std::span<uint8_t>& value)
+{
+    const auto  type = static_cast<DataType>(elementType);
+    std::size_t size = fixedSize(type);
+    if (size == 0) { throw std::runtime_error(std::format("Data type {:#x} has no fixed size", elementType)); }
+    if (value.size() % size != 0) {
+        throw std::runtime_error(
+          std::format("Buffer of {} bytes is not made of {}-byte elements", value.size(), size));
+    }
+
+    auto table = lua.create_table(static_cast<int>(value.size() / size), 0);
+    switch (type) {
+        case DataType::boolean:
+            fillArray(table, value, size, [](const std::span<uint8_t>& v) { return v[0] != 0; });
+            break;
+        case DataType::real32: fillArray(table, value, size, deserializeFloat); break;
+        case DataType::real64: fillArray(table, value, size, deserializeDouble); break;
+        case DataType::timeOfDay:
+        case DataType::timeDifference:
+            fillArray(table, value, size, [&lua](const std::span<uint8_t>& v) { return deserializeTimeStruct(lua, v); });
+            break;
+        case DataType::integer8:
+        case DataType::integer16:
+        case DataType::integer24:
+        case DataType::integer32:
+        case DataType::integer40:
+        case DataType::integer48:
+        case DataType::integer56:
+        case DataType::integer64: fillArray(table, value, size, deserializeInteger); break;
+        default: fillArray(table, value, size, deserializeUnsigned); break;
+    }
+    return table;
+}
+
+sol::table deserializePdo(sol::state_view& lua, const sol::table& odes, const std::span<uint8_t>& value)
+{
+    auto        table  = lua.create_table(static_cast<int>(odes.size()), 0);
+    std::size_t offset = 0;
+    for (std::size_t i = 1; i <= odes.size(); ++i) {
+        sol::table  ode  = odes[i];
+        const auto  type = ode["dataType"].get<uint16_t>();
+        std::size_t size = fixedSize(static_cast<DataType>(type));
+        if (size == 0) { throw std::runtime_error(std::format("Data type {:#x} can't be mapped in a PDO", type)); }
+        if (offset + size > value.size()) {
+            throw std::runtime_error(std::format("PDO of {} bytes is too short for its mapping", value.size()));
+        }
+        table.raw_set(i, deserializeOdeValue(lua, ode, value.subspan(offset, size)));
+        offset += size;
+    }
+    return table;
+}
@@ -23,4 +23,20 @@
 
 sol::object deserializeOdeValue(sol::state_view& lua, const sol::table& ode, const std::span<uint8_t>& value);
 
+/**
+ * Deserializes a buffer of packed values of the same type, such as a sample buffer uploaded as a domain.
+ *
+ * @param elementType CANopen data type of every element, it must have a fixed size.
+ * @return A Lua array of the values, in the order they are in the buffer.
+ */
+sol::table deserializeOdeArray(sol::state_view& lua, uint16_t elementType, const std::span<uint8_t>& value);
+
+/**
+ * Deserializes the values mapped in a PDO, packed one after the other.
+ *
+ * @param odes Entries mapped in the PDO, in order. They must have a fixed size.
+ * @return A Lua array of the values, in the order of odes.
+ */
+sol::table deserializePdo(sol::state_view& lua, const sol::table& odes, const std::span<uint8_t>& value);
+
 #endif    // FRASY_SRC_UTILS_LUA_ODE_DESERIALIZER_H
@@ -0,0 +1,84 @@
+/**
+ * @file    generation_cache.cpp
+ * @author  Frasy
+ * @date    2026-10-16
+ * @brief   Persisted cache of the last solution generated for a product.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <https://www.gnu.org/licenses/>.
+ */
+#include "generation_cache.h"
+
+#include "utils/lua/profile_events.h"
+
+#include <Brigerad/Core/Log.h>
+
+#include <fstream>
+#include <json.hpp>
+
+namespace Frasy::Lua {
+std::optional<Models::Solution> GenerationCache::load(const std::string& key) const
+{
+    FRASY_PROFILE_FUNCTION();
+    if (key.empty()) { return std::nullopt; }
+
+    std::ifstream file {m_path};
+    if (!file.is_open()) { return std::nullopt; }
+
+    try {
+        auto json = nlohmann::json::parse(file);
+        if (json.value("version", 0) != version || json.value("key", "") != key) { return std::nullopt; }
+        return json.at("solution").get<Models::Solution>();
+    }
+    catch (const nlohmann::json::exception& e) {
+        BR_LOG_WARN(s_tag, "Ignoring invalid cache '{}': {}", m_path.string(), e.what());
+        return std::nullopt;
+    }
+}
+
+bool GenerationCache::store(const std::string& key, const Models::Solution& solution) const
+{
+    FRASY_PROFILE_FUNCTION();
+    if (key.empty()) { return false; }
+
+    std::error_code ec;
+    if (m_path.has_parent_path()) { std::filesystem::create_directories(m_path.parent_path(), ec); }
+
+    // Written next to the cache then renamed, so that an interrupted write never leaves a truncated cache behind.
+    auto temporary = m_path;
+    temporary += ".tmp";
+    {
+        std::ofstream file {temporary, std::ios::out | std::ios::trunc};
+        if (!file.is_open()) {
+            BR_LOG_WARN(s_tag, "Unable to open '{}'", temporary.string());
+            return false;
+        }
+        file << nlohmann::json {{"version", version}, {"key", key}, {"solution", solution}};
+        if (!file.good()) {
+            BR_LOG_WARN(s_tag, "Unable to write '{}'", temporary.string());
+            return false;
+        }
+    }
+
+    std::filesystem::rename(temporary, m_path, ec);
+    if (ec) {
+        BR_LOG_WARN(s_tag, "Unable to replace '{}': {}", m_path.string(), ec.message());
+        std::filesystem::remove(temporary, ec);
+        return false;
+    }
+    return true;
+}
+
+void GenerationCache::invalidate() const
+{
+    std::error_code ec;
+    std::filesystem::remove(m_path, ec);
+}
+}    // namespace Frasy::Lua
@@ -0,0 +1,72 @@
+/**
+ * @file    generation_cache.h
+ * @author  Frasy
+ * @date    2026-10-16
+ * @brief   Persisted cache of the last solution generated for a product.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef FRASY_UTILS_LUA_ORCHESTRATOR_GENERATION_CACHE_H
+#define FRASY_UTILS_LUA_ORCHESTRATOR_GENERATION_CACHE_H
+
+#include "utils/models/solution.h"
+
+#include <filesystem>
+#include <optional>
+#include <string>
+
+namespace Frasy::Lua {
+/**
+ * @brief Stores a generated solution along with the key of the sources it was generated from.
+ *
+ * Generating a solution runs every sequence and test of the product until their requirements settle, which is only
+ * needed when the scripts change. The orchestrator keys the cache on the content of the Lua directories and on the
+ * environment and tests that were loaded, so that a solution is only ever reused for the exact same sources.
+ *
+ * A missing, unreadable or outdated file is a cache miss, never an error.
+ */
+class GenerationCache {
+public:
+    //! Bumped whenever the layout of the file changes, invalidating every file written by an older version.
+    static constexpr int version = 1;
+
+    explicit GenerationCache(std::filesystem::path path) : m_path(std::move(path)) {}
+
+    /**
+     * Get the cached solution, if it was generated for the given key.
+     * @param key Key of the sources that the solution is needed for. An empty key never matches.
+     * @return The solution, or std::nullopt if the cache is missing, invalid or was generated for another key.
+     */
+    [[nodiscard]] std::optional<Models::Solution> load(const std::string& key) const;
+
+    /**
+     * Persist a solution, replacing the previous one.
+     * @param key Key of the sources that the solution was generated from. Nothing is stored if it is empty.
+     * @param solution Solution to persist.
+     * @return true if the solution was written.
+     */
+    bool store(const std::string& key, const Models::Solution& solution) const;
+
+    /**
+     * Remove the persisted solution, if any.
+     */
+    void invalidate() const;
+
+    [[nodiscard]] const std::filesystem::path& path() const { return m_path; }
+
+private:
+    std::filesystem::path m_path;
+
+    static constexpr auto s_tag = "GenerationCache";
+};
+}    // namespace Frasy::Lua
+
+#endif    // FRASY_UTILS_LUA_ORCHESTRATOR_GENERATION_CACHE_H
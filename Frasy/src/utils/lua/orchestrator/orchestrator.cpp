@@ -17,14 +17,20 @@
 
 #include "orchestrator.h"
 
+#include "../../communication/can_open/services/pdo.h"
 #include "../../communication/can_open/services/sdo.h"
+#include "../../communication/can_open/types.h"
 #include "../../communication/serial/device_map.h"
 #include "../args_checker.h"
 #include "../dummy_table_deserializer.h"
 #include "../ode_deserializer.h"
 #include "../ode_serializer.h"
 #include "../team.h"
+#include "generation_cache.h"
+#include "utils/result_analyzer/report_file.h"
+#include "utils/result_analyzer/result_index.h"
 #include "utils/lua/save_as_json.h"
+#include "utils/lua/solution_table.h"
 
 #include "Brigerad/Core/Thread.h"
 #include <Brigerad/Utils/dialogs/warning.h>
@@ -34,7 +40,9 @@
 #include <filesystem>
 #include <fstream>
 #include <json.hpp>
+#include <numeric>
 #include <regex>
+#include <utility>
 
 #include "../../version.h"
 
@@ -78,6 +86,28 @@ int OnPanic(lua_State* lua)
 
     return 0;
 }
+
+//! Runs a function when leaving the scope, whether it's left normally or by an exception.
+template<typename Fn>
+class ScopeExit {
+public:
+    explicit ScopeExit(Fn fn) : m_fn(std::move(fn)) {}
+    ~ScopeExit()
+    {
+        try {
+            m_fn();
+        }
+        catch (const std::exception& e) {
+            BR_LUA_ERROR("Exception while leaving a scope: {}", e.what());
+        }
+    }
+
+    ScopeExit(const ScopeExit&)            = delete;
+    ScopeExit& operator=(const ScopeExit&) = delete;
+
+private:
+    Fn m_fn;
+};
 }    // namespace
 
 
@@ -104,6 +134,7 @@ bool Orchestrator::loadUserFiles(const std::string& environment, const std::stri
     else {
         m_title = title;
     }
+    verifyLuaFiles(true);
     initLua(sol::state_view(*m_state));
     if (!loadEnvironment(sol::state_view(*m_state), m_environment)) { return false; }
     if (!loadTests(sol::state_view(*m_state), m_testsDir)) { return false; }
@@ -118,11 +149,20 @@ bool Orchestrator::loadUserFiles(const std::string& environment, const std::stri
     }
     m_uutStates.resize(m_map.uuts.size() + 1, UutState::Idle);
 
+    // Workers outlive a single run, they are only re-created when the environment (and thus the UUTs) changes.
+    m_entryPoints.clear();
+    m_workers.reset();
+    m_workers = std::make_unique<UutWorkerPool>(m_map.uuts);
+    for (auto uut : m_map.uuts) {
+        m_entryPoints[uut] = {};
+    }
+
     return true;
 }
 
-bool Orchestrator::verifyHash(const std::filesystem::path&        folder,
-                              const std::filesystem::path&        hashfile)
+bool Orchestrator::verifyHash(const std::filesystem::path& folder,
+                              const std::filesystem::path& hashfile,
+                              std::string&                 hash)
 {
 #ifndef BR_DEBUG
     if (!exists(hashfile)) {
@@ -140,16 +180,60 @@ bool Orchestrator::verifyHash(const std::filesystem::path&        folder,
         return false;
     }
 
-    if (const auto hash = HashDir::hashDir(folder); hash != expectedHash) {
+    if (hash = HashDir::hashDir(folder); hash != expectedHash) {
         BR_LOG_ERROR(s_tag, "{} hash mismatch", folder.string());
         return false;
     }
 #else
     (void)folder;
     (void)hashfile;
+    hash.clear();
 #endif
     return true;
 }
+
+bool Orchestrator::verifyLuaFiles(bool force)
+{
+    FRASY_PROFILE_FUNCTION();
+    std::lock_guard lock {m_verificationLock};
+    if (force || !m_luaFilesVerified.has_value()) {
+        std::string coreHash;
+        std::string userHash;
+        m_luaFilesVerified =
+          verifyHash("lua/core", "lua/core/hash", coreHash) && verifyHash("lua/user", "lua/user/hash", userHash);
+        // Compiled chunks remain valid for as long as the verified content doesn't change. Without hashes (debug
+        // builds), the chunks are recompiled every time the files are verified.
+        m_luaFilesHash = *m_luaFilesVerified ? coreHash + userHash : "";
+        m_chunks.setKey(m_luaFilesHash);
+    }
+    return *m_luaFilesVerified;
+}
+
+std::string Orchestrator::generationKey()
+{
+    FRASY_PROFILE_FUNCTION();
+    std::string sources;
+    {
+        std::lock_guard lock {m_verificationLock};
+        if (m_luaFilesVerified.value_or(false)) { sources = m_luaFilesHash; }
+    }
+    try {
+        if (sources.empty()) {
+            // Debug builds don't verify the hashes, hash what the generation loads instead.
+            sources = HashDir::hashDir("lua/core") +
+                      HashDir::hashDir(std::filesystem::path(m_environment).parent_path()) +
+                      HashDir::hashDir(m_testsDir);
+        }
+    }
+    catch (const std::exception& e) {
+        BR_LOG_WARN(s_tag, "Unable to hash the sources, the solution will not be cached: {}", e.what());
+        return "";
+    }
+    return std::format("{}|{}|{}", sources, m_environment, m_testsDir);
+}
+
+std::filesystem::path Orchestrator::generationCacheFile() const
+{ return std::filesystem::path(m_outputDirectory) / m_title / "generation_cache.json"; }
 #pragma endregion Test Related
 
 void Orchestrator::runSolution(const std::string&              operatorName,
@@ -219,7 +303,10 @@ bool Orchestrator::initLua(sol::state_view lua, std::size_t uut, Stage stage)
                            sol::lib::package,
                            sol::lib::string,
                            sol::lib::math,
-                           sol::lib::os);
+                           sol::lib::os,
+                           sol::lib::coroutine);
+        // Every file loaded from here on, including the ones pulled with require(), is only compiled once.
+        m_chunks.install(lua);
 
         // Profiling
         lua["__profileStartEvent"] = sol::overload(
@@ -228,51 +315,44 @@ bool Orchestrator::initLua(sol::state_view lua, std::size_t uut, Stage stage)
               lua_Debug ar {};
               lua_getstack(state.lua_state(), 1, &ar);
               lua_getinfo(state.lua_state(), "nSl", &ar);
-              Profiler::get().reportCallEvent({name, ar.source, ar.currentline});
+              Profiler::get().reportCallEvent(name, ar.source, ar.currentline);
           },
           [](const std::string& name, const std::string& source, int line) {
               if (name.empty()) { throw sol::error("Name cannot be empty!"); }
               if (source.empty()) { throw sol::error("Source cannot be empty!"); }
-              Profiler::get().reportCallEvent({name, source, line});
+              Profiler::get().reportCallEvent(name, source, line);
           });
 
         lua["__profileEndEvent"] = sol::overload(
-          [](sol::this_state state, const std::string& name) {
+          [](const std::string& name) {
               if (name.empty()) { throw sol::error("Name cannot be empty!"); }
-              lua_Debug ar {};
-              lua_getstack(state.lua_state(), 2, &ar);
-              lua_getinfo(state.lua_state(), "nSl", &ar);
-              Profiler::get().reportReturnEvent({name, ar.source, ar.currentline});
+              Profiler::get().reportReturnEvent();
           },
-          [](const std::string& name, const std::string& source, int line) {
+          [](const std::string& name, const std::string& source, [[maybe_unused]] int line) {
               if (name.empty()) { throw sol::error("Name cannot be empty!"); }
               if (source.empty()) { throw sol::error("Source cannot be empty!"); }
-              Profiler::get().reportReturnEvent({name, source, line});
+              Profiler::get().reportReturnEvent();
           });
 
         lua_sethook(
           lua.lua_state(),
           [](lua_State* state, lua_Debug* ar) {
               lua_getinfo(state, "nSl", ar);
-              std::string name = std::format("{}", ar->name == nullptr ? "<unknown>" : ar->name, ar->namewhat);
+              std::string_view name = ar->name == nullptr ? "<unknown>" : ar->name;
 
               if (name == "__profileStartEvent" || name == "__profileEndEvent") { return; }
               if (ar->source == nullptr) { ar->source = &ar->short_src[0]; }
-              if (ar->event == LUA_HOOKCALL) {
-                  Profiler::get().reportCallEvent({std::move(name), ar->source, ar->currentline});
-              }
-              else if (ar->event == LUA_HOOKRET) {
-                  Profiler::get().reportReturnEvent({std::move(name), ar->source, ar->currentline});
-              }
+              if (ar->event == LUA_HOOKCALL) { Profiler::get().reportCallEvent(name, ar->source, ar->currentline); }
+              else if (ar->event == LUA_HOOKRET) { Profiler::get().reportReturnEvent(); }
           },
           LUA_MASKCALL | LUA_MASKRET,
           0);
 
         // Enums
-        lua.script_file("lua/core/framework/stage.lua");
+        m_chunks.scriptFile(lua, "lua/core/framework/stage.lua");
 
         // Variables
-        lua.script_file("lua/core/framework/context.lua");
+        m_chunks.scriptFile(lua, "lua/core/framework/context.lua");
 
         lua["Context"]["info"]["stage"]   = lua["Stage"][stage2str(stage)];
         lua["Context"]["info"]["uut"]     = uut;
@@ -291,7 +371,7 @@ bool Orchestrator::initLua(sol::state_view lua, std::size_t uut, Stage stage)
         lua["__setExecutionPolicy"] = [&](bool parallel) { m_parallel = parallel; };
         lua["__getExecutionPolicy"] = [&] { return m_parallel; };
 
-        lua.script_file("lua/core/utils/global.lua");
+        m_chunks.scriptFile(lua, "lua/core/utils/global.lua");
         lua["DirList"] = [](const std::string& path) {
             FRASY_PROFILE_FUNCTION();
             std::vector<std::string> files {};
@@ -319,6 +399,10 @@ bool Orchestrator::initLua(sol::state_view lua, std::size_t uut, Stage stage)
                     std::this_thread::sleep_for(std::chrono::milliseconds(duration));
                 }
                 : []([[maybe_unused]] int duration) { FRASY_PROFILE_FUNCTION(); };
+        lua["__now"] = []() -> double {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch())
+              .count();
+        };
         lua["CombineAndBitcast"] = [](std::span<uint8_t, 4> data) -> float {
             return std::bit_cast<float>(static_cast<uint32_t>(data[0]) | static_cast<uint32_t>(data[1]) << 8 |
                                         static_cast<uint32_t>(data[2]) << 16 | static_cast<uint32_t>(data[3]) << 24);
@@ -327,6 +411,7 @@ bool Orchestrator::initLua(sol::state_view lua, std::size_t uut, Stage stage)
             FRASY_PROFILE_FUNCTION();
             SaveAsJson(std::move(table), file);
         };
+        ImportSolver(lua);
         lua["Hash"] = [](std::string_view str) -> std::int64_t {
             FRASY_PROFILE_FUNCTION();
             return std::hash<std::string_view> {}(str);
@@ -338,7 +423,7 @@ bool Orchestrator::initLua(sol::state_view lua, std::size_t uut, Stage stage)
             std::lock_guard lock(*m_expectationsMutexes[uut]);
             m_expectationsVectors[uut].push_back(Expectation::fromTable(expectation));
         };
-        lua.require_file("Json", "lua/core/vendor/json.lua");
+        m_chunks.requireFile(lua, "Json", "lua/core/vendor/json.lua");
         importLog(lua, uut, stage);
         if (m_popupImport) {
             m_popupImport(lua, uut, stage);
@@ -364,16 +449,17 @@ bool Orchestrator::initLua(sol::state_view lua, std::size_t uut, Stage stage)
                                               const std::string&, const std::string&,
                                               const std::string&, bool) {};
         }
-        lua.script_file("lua/core/framework/exception.lua");
+        m_chunks.scriptFile(lua, "lua/core/framework/exception.lua");
 
         // Framework
-        lua.script_file("lua/core/sdk/environment/team.lua");
-        lua.script_file("lua/core/sdk/environment/environment.lua");
-        lua.script_file("lua/core/framework/orchestrator.lua");
-        lua.script_file("lua/core/sdk/test.lua");
+        m_chunks.scriptFile(lua, "lua/core/sdk/environment/team.lua");
+        m_chunks.scriptFile(lua, "lua/core/sdk/environment/environment.lua");
+        m_chunks.scriptFile(lua, "lua/core/framework/orchestrator.lua");
+        lua["Context"]["orchestrator"]["parallel_tests"] = m_parallelTests;
+        m_chunks.scriptFile(lua, "lua/core/sdk/test.lua");
 
         // Communication
-        lua.script_file("lua/core/can_open/can_open.lua");
+        m_chunks.scriptFile(lua, "lua/core/can_open/can_open.lua");
 
         auto getIndexAndSubIndex = [](const sol::table& ode) {
             FRASY_PROFILE_FUNCTION();
@@ -396,91 +482,258 @@ bool Orchestrator::initLua(sol::state_view lua, std::size_t uut, Stage stage)
             return std::make_pair(index, subIndex);
         };
 
-        lua["CanOpen"]["__upload"] = [this, &getIndexAndSubIndex](
-                                       sol::this_state state, std::size_t nodeId, const sol::table& ode) {
-            FRASY_PROFILE_FUNCTION();
-            sol::state_view lua       = sol::state_view(state.lua_state());
-            auto            maybeNode = m_canOpen->getNode(static_cast<uint8_t>(nodeId));
+        // options.block opts a request in or out of block transfers, the variable-sized objects use them by default.
+        auto getTransferMode = [](const sol::table& ode, const sol::optional<sol::table>& options) {
+            if (options.has_value()) {
+                if (sol::optional<bool> block = (*options)["block"]; block.has_value()) {
+                    return *block ? CanOpen::SdoTransferMode::Block : CanOpen::SdoTransferMode::Segmented;
+                }
+            }
+            switch (static_cast<CanOpen::DataType>(ode["dataType"].get<uint16_t>())) {
+                case CanOpen::DataType::visibleString:
+                case CanOpen::DataType::octetString:
+                case CanOpen::DataType::unicodeString:
+                case CanOpen::DataType::domain: return CanOpen::SdoTransferMode::Block;
+                default: return CanOpen::SdoTransferMode::Auto;
+            }
+        };
+
+        auto getSdoInterface = [this](std::size_t nodeId) {
+            auto maybeNode = m_canOpen->getNode(static_cast<uint8_t>(nodeId));
             if (!maybeNode.has_value()) { throw sol::error(std::format("Node '{}' not found!", nodeId)); }
-            auto* interface        = (*maybeNode)->sdoInterface();
+            return (*maybeNode)->sdoInterface();
+        };
+
+        // Waits for a request to be done, throws if it failed.
+        auto awaitUpload = [](CanOpen::SdoUploadDataResult& request) {
+            request.future.wait();
+            if (request.status() != CanOpen::SdoRequestStatus::Complete &&
+                request.status() != CanOpen::SdoRequestStatus::Cancelled) {
+                throw sol::error(std::format("Request failed: {}", request.status()));
+            }
+            auto result = request.future.get();
+            if (!result.has_value()) {
+                throw sol::error(std::format("Request failed with code {}: {}\nExtra: {}",
+                                             static_cast<int>(result.error()),
+                                             result.error(),
+                                             request.abortCode()));
+            }
+            return result.value();
+        };
+        auto awaitDownload = [](CanOpen::SdoDownloadDataResult& request) {
+            request.future.wait();
+            if (request.status() != CanOpen::SdoRequestStatus::Complete &&
+                request.status() != CanOpen::SdoRequestStatus::Cancelled) {
+                throw sol::error(std::format("Request failed: {}", request.status()));
+            }
+            if (auto result = request.future.get(); result != CO_SDO_RT_ok_communicationEnd) {
+                throw sol::error(std::format("Request failed with code {}: {}\nExtra: {}",
+                                             static_cast<int>(result),
+                                             result,
+                                             request.abortCode()));
+            }
+        };
+
+        // Uploads the object and hands its bytes to deserialize, which makes the Lua value out of them.
+        auto upload = [this, getIndexAndSubIndex, getSdoInterface, awaitUpload](sol::state_view          lua,
+                                                                                std::size_t              nodeId,
+                                                                                const sol::table&        ode,
+                                                                                CanOpen::SdoTransferMode mode,
+                                                                                const auto&              deserialize) {
+            auto* interface        = getSdoInterface(nodeId);
             auto [index, subIndex] = getIndexAndSubIndex(ode);
 
             auto tryRequest = [&] {
-                auto request = interface->uploadData(static_cast<uint16_t>(index), static_cast<uint8_t>(subIndex), 200);
-                request.future.wait();
-                if (request.status() != CanOpen::SdoRequestStatus::Complete &&
-                    request.status() != CanOpen::SdoRequestStatus::Cancelled) {
-                    throw sol::error(std::format("Request failed: {}", request.status()));
-                }
-                auto result = request.future.get();
-                if (!result.has_value()) {
-                    throw sol::error(std::format("Request failed with code {}: {}\nExtra: {}",
-                                                 static_cast<int>(result.error()),
-                                                 result.error(),
-                                                 request.abortCode()));
-                }
-                auto value = deserializeOdeValue(lua, ode, result.value());
-                return value;
+                auto request =
+                  interface->uploadData(static_cast<uint16_t>(index), static_cast<uint8_t>(subIndex), 200, 5, mode);
+                return deserialize(lua, awaitUpload(request));
             };
 
             try {
                 return tryRequest();
             }
-            catch (sol::error&) {
-                BR_LOG_WARN(s_tag, "Request failed, trying to re-open port...");
-                m_canOpen->reopen();
+            catch (std::exception& e) {
+                // A timeout or an undecodable value is retried like an SDO abort, as in runBatch.
+                BR_LOG_WARN(s_tag, "Request failed, trying to re-open port... ({})", e.what());
+                m_canOpen->reopen(std::array {static_cast<uint8_t>(nodeId)});
                 return tryRequest();
             }
         };
 
-        lua["CanOpen"]["__download"] = [&](std::size_t nodeId, const sol::table& ode, sol::object value) {
+        // Submits every request of a batch before waiting on any, the nodes then work concurrently and the queue of
+        // each one is never idle between two objects. Requests that failed are submitted again once, like the
+        // single requests, after re-opening the port. nodeOf gives the node of a request.
+        auto runBatch = [this](std::size_t count, const auto& nodeOf, const auto& submit, const auto& await) {
+            std::vector<std::size_t> pending(count);
+            std::iota(pending.begin(), pending.end(), 0);
+            std::string lastError;
+            for (int attempt = 0; attempt < 2 && !pending.empty(); ++attempt) {
+                if (attempt != 0) {
+                    BR_LOG_WARN(s_tag, "{} requests failed, trying to re-open port...", pending.size());
+                    std::vector<uint8_t> nodes;
+                    for (std::size_t i : pending) {
+                        if (std::ranges::find(nodes, nodeOf(i)) == nodes.end()) { nodes.push_back(nodeOf(i)); }
+                    }
+                    m_canOpen->reopen(nodes);
+                }
+                std::vector<decltype(submit(std::size_t {}))> requests;
+                requests.reserve(pending.size());
+                for (std::size_t i : pending) {
+                    requests.push_back(submit(i));
+                }
+                std::vector<std::size_t> failed;
+                for (std::size_t r = 0; r < requests.size(); ++r) {
+                    try {
+                        await(pending[r], requests[r]);
+                    }
+                    catch (std::exception& e) {
+                        // A timeout or an undecodable value fails the request like an SDO abort does.
+                        failed.push_back(pending[r]);
+                        lastError = e.what();
+                    }
+                }
+                pending = std::move(failed);
+            }
+            if (!pending.empty()) {
+                throw sol::error(std::format("{} of {} requests failed: {}", pending.size(), count, lastError));
+            }
+        };
+
+        struct BatchEntry {
+            uint8_t                  nodeId    = 0;
+            CanOpen::SdoManager*     interface = nullptr;
+            uint16_t                 index     = 0;
+            uint8_t                  subIndex  = 0;
+            CanOpen::SdoTransferMode mode      = CanOpen::SdoTransferMode::Auto;
+            sol::table               ode;
+            std::vector<uint8_t>     data;
+        };
+        // Every entry is checked before anything is sent.
+        auto makeBatch = [getIndexAndSubIndex, getSdoInterface, getTransferMode](const sol::table& requests,
+                                                                                 bool              withValue) {
+            std::vector<BatchEntry> entries;
+            entries.reserve(requests.size());
+            for (std::size_t i = 1; i <= requests.size(); ++i) {
+                sol::table request = requests[i];
+                sol::table ode     = request["ode"];
+                auto [index, subIndex] = getIndexAndSubIndex(ode);
+                auto& entry            = entries.emplace_back();
+                entry.nodeId           = static_cast<uint8_t>(request["nodeId"].get<std::size_t>());
+                entry.interface        = getSdoInterface(entry.nodeId);
+                entry.index            = static_cast<uint16_t>(index);
+                entry.subIndex         = static_cast<uint8_t>(subIndex);
+                entry.mode             = getTransferMode(ode, request["options"].get<sol::optional<sol::table>>());
+                entry.ode              = ode;
+                if (withValue) { entry.data = serializeOdeValue(ode, request["value"].get<sol::object>()); }
+            }
+            return entries;
+        };
+
+        lua["CanOpen"]["__upload"] =
+          [upload, getTransferMode](
+            sol::this_state state, std::size_t nodeId, const sol::table& ode, const sol::optional<sol::table>& options) {
             FRASY_PROFILE_FUNCTION();
-            auto maybeNode = m_canOpen->getNode(static_cast<uint8_t>(nodeId));
-            if (!maybeNode.has_value()) { throw sol::error(std::format("Node '{}' not found!", nodeId)); }
-            auto* interface        = (*maybeNode)->sdoInterface();
+            return upload(sol::state_view(state.lua_state()),
+                          nodeId,
+                          ode,
+                          getTransferMode(ode, options),
+                          [&ode](sol::state_view& lua, const std::span<uint8_t>& bytes) {
+                              return deserializeOdeValue(lua, ode, bytes);
+                          });
+        };
+
+        // requests: array of {nodeId, ode, options?}, returns the values in the same order.
+        lua["CanOpen"]["__uploadMany"] =
+          [makeBatch, runBatch, awaitUpload](sol::this_state state, const sol::table& requests) {
+              FRASY_PROFILE_FUNCTION();
+              sol::state_view lua     = sol::state_view(state.lua_state());
+              auto            entries = makeBatch(requests, false);
+              auto            values  = lua.create_table(static_cast<int>(entries.size()), 0);
+              runBatch(
+                entries.size(),
+                [&](std::size_t i) { return entries[i].nodeId; },
+                [&](std::size_t i) {
+                    auto& entry = entries[i];
+                    return entry.interface->uploadData(entry.index, entry.subIndex, 200, 5, entry.mode);
+                },
+                [&](std::size_t i, CanOpen::SdoUploadDataResult& request) {
+                    values[i + 1] = deserializeOdeValue(lua, entries[i].ode, awaitUpload(request));
+                });
+              return values;
+          };
+
+        lua["CanOpen"]["__download"] =
+          [getIndexAndSubIndex, getSdoInterface, getTransferMode, awaitDownload, this](
+            std::size_t nodeId, const sol::table& ode, sol::object value, const sol::optional<sol::table>& options) {
+            FRASY_PROFILE_FUNCTION();
+            auto* interface        = getSdoInterface(nodeId);
             auto [index, subIndex] = getIndexAndSubIndex(ode);
             const auto sValue      = serializeOdeValue(ode, value);
+            const auto mode        = getTransferMode(ode, options);
 
             auto tryRequest = [&] {
-                auto request =
-                  interface->downloadData(static_cast<uint16_t>(index), static_cast<uint8_t>(subIndex), sValue, 200);
-                request.future.wait();
-                if (request.status() != CanOpen::SdoRequestStatus::Complete &&
-                    request.status() != CanOpen::SdoRequestStatus::Cancelled) {
-                    throw sol::error(std::format("Request failed: {}", request.status()));
-                }
-                if (auto result = request.future.get(); result != CO_SDO_RT_ok_communicationEnd) {
-                    throw sol::error(std::format("Request failed with code {}: {}\nExtra: {}",
-                                                 static_cast<int>(result),
-                                                 result,
-                                                 request.abortCode()));
-                }
+                auto request = interface->downloadData(
+                  static_cast<uint16_t>(index), static_cast<uint8_t>(subIndex), sValue, 200, 5, mode);
+                awaitDownload(request);
             };
 
             try {
                 tryRequest();
             }
-            catch (sol::error&) {
-                BR_LOG_WARN(s_tag, "Request failed, trying to re-open port...");
-                m_canOpen->reopen();
+            catch (std::exception& e) {
+                BR_LOG_WARN(s_tag, "Request failed, trying to re-open port... ({})", e.what());
+                m_canOpen->reopen(std::array {static_cast<uint8_t>(nodeId)});
                 tryRequest();
             }
         };
 
+        // requests: array of {nodeId, ode, value, options?}.
+        lua["CanOpen"]["__downloadMany"] = [makeBatch, runBatch, awaitDownload](const sol::table& requests) {
+            FRASY_PROFILE_FUNCTION();
+            auto entries = makeBatch(requests, true);
+            runBatch(
+              entries.size(),
+              [&](std::size_t i) { return entries[i].nodeId; },
+              [&](std::size_t i) {
+                  auto& entry = entries[i];
+                  return entry.interface->downloadData(entry.index, entry.subIndex, entry.data, 200, 5, entry.mode);
+              },
+              [&](std::size_t, CanOpen::SdoDownloadDataResult& request) { awaitDownload(request); });
+        };
+
         lua["CanOpen"]["__reset"] = [&](std::size_t nodeId) { m_canOpen->resetNode(static_cast<uint8_t>(nodeId)); };
 
+        // Queues the frames of a TPDO of the node from now on, until the listener is stopped or collected.
+        lua["CanOpen"]["__pdoListen"] = [this](std::size_t nodeId, std::size_t tpdo) {
+            if (tpdo < 1 || tpdo > CanOpen::PdoDispatcher::s_tpdoCount) {
+                throw sol::error(std::format("Invalid TPDO: {}", tpdo));
+            }
+            return m_canOpen->pdos().listen(static_cast<uint8_t>(nodeId), static_cast<uint8_t>(tpdo));
+        };
+        // Takes the next frame of a listener, as the values of the odes mapped in it. nil if none comes in time.
+        lua["CanOpen"]["__pdoWait"] = [](sol::this_state                           state,
+                                         const std::shared_ptr<CanOpen::PdoQueue>& queue,
+                                         const sol::table&                         odes,
+                                         std::size_t                               timeoutMs) -> sol::object {
+            FRASY_PROFILE_FUNCTION();
+            auto frame = queue->wait(std::chrono::milliseconds {timeoutMs});
+            if (!frame.has_value()) { return sol::lua_nil; }
+            sol::state_view lua = sol::state_view(state.lua_state());
+            return deserializePdo(lua, odes, std::span {frame->data.data(), frame->size});
+        };
+        lua["CanOpen"]["__pdoStop"] = [](const std::shared_ptr<CanOpen::PdoQueue>& queue) { queue->close(); };
+
 
         // Boards
         auto ibs    = lua.create_named_table("Ibs");
-        auto cepIbs = lua.script_file("lua/core/cep/ibs.lua");
+        auto cepIbs = m_chunks.scriptFile(lua, "lua/core/cep/ibs.lua");
         for (auto& [k, v] : cepIbs.get<sol::table>()) {
             ibs[k] = v;
         }
 
         // Validation of hashes must happen after everything is loaded, in case code that is executed anyways uses our
         // stuff.
-        if (!verifyHash("lua/core", "lua/core/hash")) { return false; }
-        if (!verifyHash("lua/user", "lua/user/hash")) { return false; }
+        if (!verifyLuaFiles()) { return false; }
 
         // User content
         lua["Context"]["values"]["gui"] = m_loadUserValues(lua);
@@ -498,10 +751,42 @@ bool Orchestrator::initLua(sol::state_view lua, std::size_t uut, Stage stage)
     }
 }
 
+Orchestrator::EntryPoints Orchestrator::makeEntryPoints(sol::state_view lua)
+{
+    FRASY_PROFILE_FUNCTION();
+    sol::protected_function errorHandler   = m_chunks.scriptFile(lua, "lua/core/framework/error_handler.lua");
+    auto                    makeEntryPoint = [&](const std::string& code) {
+        sol::protected_function function = lua.script(code);
+        function.set_error_handler(errorHandler);
+        return function;
+    };
+
+    EntryPoints entryPoints;
+    entryPoints.loadSolution   = makeEntryPoint("return function(s) Orchestrator.SetSolution(s) end");
+    entryPoints.validate       = makeEntryPoint("return function() Orchestrator.Validate() end");
+    entryPoints.executeSection = makeEntryPoint("return function(is) Orchestrator.ExecuteSection(is) end");
+    entryPoints.compileExecutionResults =
+      makeEntryPoint("return function(dir) Orchestrator.CompileExecutionResults(dir) end");
+    return entryPoints;
+}
+
+sol::state& Orchestrator::resetUutState(std::size_t uut)
+{
+    // The entry points reference the previous state, they must be released before it is.
+    m_entryPoints.at(uut) = {};
+    return m_workers->resetState(uut);
+}
+
+void Orchestrator::releaseUutState(std::size_t uut)
+{
+    m_entryPoints.at(uut) = {};
+    m_workers->releaseState(uut);
+}
+
 bool Orchestrator::loadEnvironment(sol::state_view lua, const std::string& filename)
 {
-    sol::protected_function run = lua.script_file("lua/core/helper/load_environment.lua");
-    run.set_error_handler(lua.script_file("lua/core/framework/error_handler.lua"));
+    sol::protected_function run = m_chunks.scriptFile(lua, "lua/core/helper/load_environment.lua");
+    run.set_error_handler(m_chunks.scriptFile(lua, "lua/core/framework/error_handler.lua"));
     auto result = run(filename);
     if (!result.valid()) {
         sol::error err = result;
@@ -516,8 +801,8 @@ bool Orchestrator::loadEnvironment(sol::state_view lua, const std::string& filen
 bool Orchestrator::loadTests(sol::state_view lua, const std::string& filename)
 {
     FRASY_PROFILE_FUNCTION();
-    sol::protected_function run = lua.script_file("lua/core/helper/load_tests.lua");
-    run.set_error_handler(lua.script_file("lua/core/framework/error_handler.lua"));
+    sol::protected_function run = m_chunks.scriptFile(lua, "lua/core/helper/load_tests.lua");
+    run.set_error_handler(m_chunks.scriptFile(lua, "lua/core/framework/error_handler.lua"));
     auto result = run(filename);
     if (!result.valid()) {
         sol::error err = result;
@@ -532,6 +817,9 @@ bool Orchestrator::loadTests(sol::state_view lua, const std::string& filename)
 void Orchestrator::runTests(const std::vector<std::string>& serials, const bool regenerate, const bool skipVerification)
 {
     updateUutState(UutState::Waiting);
+    // The files are hashed once per run, every state created for this run reuses that result and the chunks compiled
+    // for it.
+    verifyLuaFiles(true);
     {
         FRASY_PROFILE_SCOPE("Create Output Dir");
         if (!createOutputDirs()) {
@@ -568,65 +856,32 @@ bool Orchestrator::runStageGenerate(bool regenerate)
     try {
         if (m_generated && !regenerate) { return true; }
 
+        // The solution only depends on the scripts, a run with unchanged sources gets the same one.
+        const auto            key = generationKey();
+        const GenerationCache cache {generationCacheFile()};
+        if (auto cached = cache.load(key)) {
+            m_solution = std::move(*cached);
+            if (m_saveSolution) { std::ofstream(std::string(solutionFile)) << nlohmann::json(m_solution); }
+            BR_LOG_INFO(s_tag, "Sources unchanged, reusing the solution from '{}'", cache.path().string());
+            m_generated = true;
+            return true;
+        }
+
         sol::state lua;
         if (!initLua(sol::state_view(lua), 1)) { return false; }
         loadEnvironment(sol::state_view(lua), m_environment);
         loadTests(sol::state_view(lua), m_testsDir);
-        sol::protected_function run = lua.script_file("lua/core/helper/generate.lua");
-        run.set_error_handler(lua.script_file("lua/core/framework/error_handler.lua"));
-        auto result = run(solutionFile);
+        sol::protected_function run = m_chunks.scriptFile(lua, "lua/core/helper/generate.lua");
+        run.set_error_handler(m_chunks.scriptFile(lua, "lua/core/framework/error_handler.lua"));
+        // The file is only written for the report generators and for debugging, nothing in the run reads it back.
+        auto result = m_saveSolution ? run(solutionFile) : run(sol::lua_nil);
         if (!result.valid()) {
             sol::error err = result;
             lua["Log"]["E"](err.what());
         }
         else {
             lua["Log"]["I"]("Success");
-        }
-        if (result.valid()) {
-            using json               = nlohmann::json;
-            std::ifstream os         = std::ifstream(std::string(solutionFile));
-            json          generation = json::parse(os);
-            m_solution.Clear();
-
-            // Solution
-            // - Section
-            // - - Section stage
-            // - - - Sequence (Actually a subsequence)
-            // - - - - Sequence name
-            // - - - - Sequence stage
-            // - - - - - Test
-
-            m_solution.sections.reserve(generation.size());
-            for (const auto& gSc : generation) {
-                // Section
-                m_solution.sections.emplace_back();
-                auto& sc = m_solution.sections.back();
-                sc.reserve(gSc.size());
-                for (const auto& gScS : gSc) {
-                    // Section stage
-                    sc.emplace_back();
-                    auto& scs = sc.back();
-                    scs.reserve(gScS.size());
-                    for (const auto& gSq : gScS) {
-                        // Sequence
-                        scs.emplace_back();
-                        auto& sq = scs.back();
-                        sq.first = gSq["name"];
-                        sq.second.reserve(gSq["tests"].size());
-                        if (!m_solution.sequences.contains(sq.first)) { m_solution.sequences[sq.first] = {}; }
-                        for (const auto& gSqS : gSq["tests"]) {
-                            // Sequence stages
-                            sq.second.emplace_back();
-                            auto& sqs = sq.second.back();
-                            sqs.reserve(gSqS.size());
-                            for (const auto& gT : gSqS) {
-                                sqs.push_back(gT);
-                                m_solution.sequences[sq.first].tests[gT] = {};
-                            }
-                        }
-                    }
-                }
-            }
+            m_solution = SolutionFromTable(result.get<sol::table>());
         }
         if (!m_parallel) {
             if (m_solution.sections.size() != 1) {
@@ -639,6 +894,7 @@ bool Orchestrator::runStageGenerate(bool regenerate)
         }
 
         m_generated = result.valid();
+        if (m_generated) { cache.store(key, m_solution); }
         return m_generated;
     }
     catch (const std::exception& err) {
@@ -664,52 +920,48 @@ bool Orchestrator::runStageVerify(sol::state_view team)
                     if (leader == uut) { teams[leader] = Team(teamPlayers.size()); }
                 }
             }
-            std::vector<std::jthread>   threads;
             std::mutex                  mutex;
             std::map<std::size_t, bool> results;
-            for (auto& uut : devices) {
-                if (m_uutStates[uut] == UutState::Disabled) { continue; }
-                threads.emplace_back(Brigerad::MakeThread([&, uut, team] {
-                    sol::state lua;
-                    if (!initLua(sol::state_view(lua), uut, Stage::validation)) { return; }
-                    loadEnvironment(sol::state_view(lua), m_environment);
-                    loadTests(sol::state_view(lua), m_testsDir);
-                    if (hasTeam) {
-                        std::lock_guard lock {mutex};
-                        size_t          leader   = team["Context"]["team"]["players"][uut]["leader"];
-                        size_t          position = team["Context"]["team"]["players"][uut]["position"];
-                        teams[leader].InitializeState(sol::state_view(lua), uut, position, uut == leader);
-                    }
-                    sol::protected_function load_solution =
-                      lua.script("return function(fp) Orchestrator.LoadSolution(fp) end");
-                    load_solution.set_error_handler(lua.script_file("lua/core/framework/error_handler.lua"));
-                    auto rls = load_solution(solutionFile);
-                    if (!rls.valid()) {
-                        sol::error err = rls;
-                        lua["Log"]["e"](err.what());
-                        std::lock_guard lock {mutex};
-                        results[uut] = false;
-                        return;
-                    }
-
-                    sol::protected_function verify = lua.script("return function() Orchestrator.Validate() end");
-                    verify.set_error_handler(lua.script_file("lua/core/framework/error_handler.lua"));
-                    auto rv = verify();
-                    if (!rv.valid()) {
-                        sol::error err = rv;
-                        lua["Log"]["e"](err.what());
-                        std::lock_guard lock {mutex};
-                        results[uut] = false;
-                        return;
-                    }
+            std::vector<std::size_t>    enabled;
+            std::ranges::copy_if(
+              devices, std::back_inserter(enabled), [&](auto uut) { return m_uutStates[uut] != UutState::Disabled; });
+            // The validation states are of no use past this stage, release them on their own thread. They hold
+            // references to the teams of this stage, so they must be released even if the validation throws.
+            ScopeExit releaseStates {
+              [&] { m_workers->dispatch(enabled, [&](std::size_t uut) { releaseUutState(uut); }); }};
+            m_workers->dispatch(enabled, [&, team](std::size_t uut) {
+                sol::state& lua = resetUutState(uut);
+                if (!initLua(sol::state_view(lua), uut, Stage::validation)) { return; }
+                loadEnvironment(sol::state_view(lua), m_environment);
+                loadTests(sol::state_view(lua), m_testsDir);
+                if (hasTeam) {
+                    std::lock_guard lock {mutex};
+                    size_t          leader   = team["Context"]["team"]["players"][uut]["leader"];
+                    size_t          position = team["Context"]["team"]["players"][uut]["position"];
+                    teams[leader].InitializeState(sol::state_view(lua), uut, position, uut == leader);
+                }
+                auto& entryPoints = m_entryPoints.at(uut) = makeEntryPoints(lua);
+                auto  rls         = entryPoints.loadSolution(SolutionToTable(lua, m_solution));
+                if (!rls.valid()) {
+                    sol::error err = rls;
+                    lua["Log"]["e"](err.what());
+                    std::lock_guard lock {mutex};
+                    results[uut] = false;
+                    return;
+                }
 
+                auto rv = entryPoints.validate();
+                if (!rv.valid()) {
+                    sol::error err = rv;
+                    lua["Log"]["e"](err.what());
                     std::lock_guard lock {mutex};
-                    results[uut] = true;
-                }));
-            }
-            for (auto& thread : threads) {
-                thread.join();
-            }
+                    results[uut] = false;
+                    return;
+                }
+
+                std::lock_guard lock {mutex};
+                results[uut] = true;
+            });
             size_t expectedResults =
               std::accumulate(devices.begin(), devices.end(), size_t(0), [&](size_t tot, const auto& uut) {
                   return tot + (m_uutStates[uut] == UutState::Disabled ? 0 : 1);
@@ -739,14 +991,9 @@ void Orchestrator::runStageExecute(sol::state_view team, const std::vector<std::
         auto        stages   = team["Context"]["worker"]["stages"].get<std::vector<sol::object>>();
         std::size_t uutCount = team["Context"]["map"]["uuts"].get<sol::table>().size();
 
-        std::map<std::size_t, Team>       teams;
-        std::map<std::size_t, sol::state> states;
-        std::mutex                        mutex;
-        std::map<std::size_t, bool>       results;
-
-        for (std::size_t uut = 0; uut <= uutCount; ++uut) {
-            states[uut] = sol::state();
-        }
+        std::map<std::size_t, Team> teams;
+        std::mutex                  mutex;
+        std::map<std::size_t, bool> results;
 
         auto hasAnyUutCrashed = [&]() {
             FRASY_PROFILE_FUNCTION();
@@ -770,46 +1017,35 @@ void Orchestrator::runStageExecute(sol::state_view team, const std::vector<std::
                         if (leader == uut) { teams[leader] = Team(teamPlayers.size()); }
                     }
                 }
-                std::vector<std::jthread> threads;
-                threads.reserve(devices.size());
-                for (auto& uut : devices) {
-                    threads.emplace_back(Brigerad::MakeThread([&, uut, team] {
-                        if (!Brigerad::SetThreadName(Brigerad::GetCurrentThread(), std::format("UUT {}", uut))) {
-                            BR_LOG_ERROR(s_tag, "Unable to set thread name");
-                        }
-                        if (m_uutStates[uut] == UutState::Disabled) { return; }
-                        // states[] is not yet populated, each call will modify it
-                        // thus, we must have a mutex here
-                        mutex.lock();
-                        sol::state_view lua = states[uut];
-                        mutex.unlock();
-                        if (!initLua(lua, uut, Stage::execution)) { return; }
-                        lua["Context"]["info"]["operator"] = m_operator;
-                        lua["Context"]["info"]["serial"]   = serials[uut];
-                        // LoadIb(lua);
-                        loadEnvironment(lua, m_environment);
-                        loadTests(lua, m_testsDir);
-                        if (hasTeam) {
-                            std::lock_guard lock {mutex};
-                            size_t          leader   = team["Context"]["team"]["players"][uut]["leader"];
-                            size_t          position = team["Context"]["team"]["players"][uut]["position"];
-                            teams[leader].InitializeState(lua, uut, position, uut == leader);
-                        }
+                m_workers->dispatch(devices, [&, team](std::size_t uut) {
+                    if (m_uutStates[uut] == UutState::Disabled) { return; }
+                    sol::state_view lua = resetUutState(uut);
+                    if (!initLua(lua, uut, Stage::execution)) {
+                        std::lock_guard lock {mutex};
+                        results[uut] = false;
+                        return;
+                    }
+                    lua["Context"]["info"]["operator"] = m_operator;
+                    lua["Context"]["info"]["serial"]   = serials[uut];
+                    // LoadIb(lua);
+                    loadEnvironment(lua, m_environment);
+                    loadTests(lua, m_testsDir);
+                    if (hasTeam) {
+                        std::lock_guard lock {mutex};
+                        size_t          leader   = team["Context"]["team"]["players"][uut]["leader"];
+                        size_t          position = team["Context"]["team"]["players"][uut]["position"];
+                        teams[leader].InitializeState(lua, uut, position, uut == leader);
+                    }
 
-                        sol::protected_function run =
-                          lua.script("return function(fp) Orchestrator.LoadSolution(fp) end");
-                        run.set_error_handler(lua.script_file("lua/core/framework/error_handler.lua"));
-                        auto result = run(solutionFile);
-                        if (!result.valid()) {
-                            sol::error err = result;
-                            lua["Log"]["E"](err.what());
-                        }
-                        results[uut] = result.valid();
-                    }));
-                }
-                for (auto& thread : threads) {
-                    thread.join();
-                }
+                    auto& entryPoints = m_entryPoints.at(uut) = makeEntryPoints(lua);
+                    auto  result      = entryPoints.loadSolution(SolutionToTable(lua, m_solution));
+                    if (!result.valid()) {
+                        sol::error err = result;
+                        lua["Log"]["E"](err.what());
+                    }
+                    std::lock_guard lock {mutex};
+                    results[uut] = result.valid();
+                });
                 updateUutState(UutState::Waiting, devices);
             }
         };
@@ -818,38 +1054,34 @@ void Orchestrator::runStageExecute(sol::state_view team, const std::vector<std::
             for (std::size_t is = 1; is <= m_solution.sections.size(); ++is) {
                 if (hasAnyUutCrashed()) { return; }
                 for (sol::object& stage : stages) {
-                    auto                      devices = stage.as<std::vector<std::size_t>>();
-                    std::vector<std::jthread> threads;
-                    threads.reserve(devices.size());
-                    for (auto& uut : devices) {
-                        threads.emplace_back(Brigerad::MakeThread([&, uut] {
-                            if (!Brigerad::SetThreadName(Brigerad::GetCurrentThread(), std::format("UUT {}", uut))) {
-                                BR_LOG_ERROR(s_tag, "Unable to set thread name");
-                            }
-                            if (m_uutStates[uut] == UutState::Disabled) { return; }
-                            mutex.lock();
-                            sol::state_view lua = states[uut];
-                            updateUutState(UutState::Running, std::vector {uut});
-                            mutex.unlock();
-                            sol::protected_function run =
-                              lua.script("return function(is) Orchestrator.ExecuteSection(is) end");
-                            run.set_error_handler(lua.script_file("lua/core/framework/error_handler.lua"));
-                            auto result = run(is);
-                            if (!result.valid()) {
-                                sol::error err = result;
-                                BR_LUA_ERROR(err.what());
-                                lua["Log"]["e"](err.what());
-                            }
-                            results[uut] = result.valid();
-                        }));
-                        if (!m_parallel) {
-                            threads.back().join();
-                            updateUutState(UutState::Waiting, std::vector {uut});
+                    auto devices = stage.as<std::vector<std::size_t>>();
+                    auto job     = [&](std::size_t uut) {
+                        if (m_uutStates[uut] == UutState::Disabled) { return; }
+                        auto& entryPoints = m_entryPoints.at(uut);
+                        if (!entryPoints.executeSection.valid()) {
+                            // The state of that UUT could not be set up.
+                            std::lock_guard lock {mutex};
+                            results[uut] = false;
+                            return;
                         }
-                    }
-                    if (m_parallel) {
-                        for (auto& thread : threads) {
-                            thread.join();
+                        mutex.lock();
+                        sol::state_view lua = m_workers->state(uut);
+                        updateUutState(UutState::Running, std::vector {uut});
+                        mutex.unlock();
+                        auto result = entryPoints.executeSection(is);
+                        if (!result.valid()) {
+                            sol::error err = result;
+                            BR_LUA_ERROR(err.what());
+                            lua["Log"]["e"](err.what());
+                        }
+                        std::lock_guard lock {mutex};
+                        results[uut] = result.valid();
+                    };
+                    if (m_parallel) { m_workers->dispatch(devices, job); }
+                    else {
+                        for (auto& uut : devices) {
+                            m_workers->dispatch(uut, job);
+                            updateUutState(UutState::Waiting, std::vector {uut});
                         }
                     }
                     updateUutState(UutState::Waiting, devices);
@@ -861,40 +1093,40 @@ void Orchestrator::runStageExecute(sol::state_view team, const std::vector<std::
             for (sol::object& stage : stages) {
                 auto devices = stage.as<std::vector<std::size_t>>();
                 updateUutState(UutState::Running, devices);
-                std::vector<std::jthread> threads;
-                threads.reserve(devices.size());
-                for (auto& uut : devices) {
-                    threads.emplace_back(Brigerad::MakeThread([&, uut] {
-                        if (!Brigerad::SetThreadName(Brigerad::GetCurrentThread(), std::format("UUT {}", uut))) {
-                            BR_LOG_ERROR(s_tag, "Unable to set thread name");
+                m_workers->dispatch(devices, [&](std::size_t uut) {
+                    if (m_uutStates[uut] == UutState::Disabled) { return; }
+                    auto& entryPoints = m_entryPoints.at(uut);
+                    if (!entryPoints.compileExecutionResults.valid()) {
+                        std::lock_guard lock {mutex};
+                        results[uut] = false;
+                        return;
+                    }
+                    sol::state& lua    = m_workers->state(uut);
+                    auto        result = entryPoints.compileExecutionResults(
+                      std::format("{}/{}", m_outputDirectory, lastSubdirectory));
+                    if (!result.valid()) {
+                        try {
+                            sol::error err = result;
+                            lua["Log"]["E"](err.what());
                         }
-                        if (m_uutStates[uut] == UutState::Disabled) { return; }
-                        mutex.lock();
-                        sol::state& lua = states[uut];
-                        mutex.unlock();
-                        sol::protected_function run =
-                          lua.script("return function(dir) Orchestrator.CompileExecutionResults(dir) end");
-                        run.set_error_handler(lua.script_file("lua/core/framework/error_handler.lua"));
-                        auto result = run(std::format("{}/{}", m_outputDirectory, lastSubdirectory));
-                        if (!result.valid()) {
-                            try {
-                                sol::error err = result;
-                                lua["Log"]["E"](err.what());
-                            }
-                            catch (...) {
-                                lua["Log"]["E"](
-                                  "That's a tough one...");    // TODO find why sol::error throw an exception
-                            }
+                        catch (...) {
+                            lua["Log"]["E"]("That's a tough one...");    // TODO find why sol::error throw an exception
                         }
-                        results[uut] = result.valid();
-                    }));
-                }
-                for (auto& thread : threads) {
-                    thread.join();
-                }
+                    }
+                    std::lock_guard lock {mutex};
+                    results[uut] = result.valid();
+                });
             }
         };
 
+        // The states hold references to the teams of this run, they must not outlive it, even if a step throws.
+        ScopeExit releaseStates {[&] {
+            for (sol::object& stage : stages) {
+                m_workers->dispatch(stage.as<std::vector<std::size_t>>(),
+                                    [&](std::size_t uut) { releaseUutState(uut); });
+            }
+        }};
+
         auto checkAllResults = [&] {
             for (sol::object& stage : stages) {
                 auto devices = stage.as<std::vector<std::size_t>>();
@@ -903,7 +1135,18 @@ void Orchestrator::runStageExecute(sol::state_view team, const std::vector<std::
         };
 
         loadSolutions();
-        runSections();
+        {
+            // Everything the sections need is loaded along with the solutions, no Lua file should be read from the
+            // disk past this point. A miss of the chunk cache in there means that the warm-up is incomplete.
+            const auto warmStats = m_chunks.stats();
+            runSections();
+            if (auto misses = m_chunks.stats().misses - warmStats.misses; misses != 0) {
+                BR_LOG_WARN(s_tag, "{} Lua file(s) loaded from the disk while executing the sections", misses);
+            }
+            else {
+                BR_LOG_DEBUG(s_tag, "No Lua file loaded from the disk while executing the sections");
+            }
+        }
         compileResults();
         checkAllResults();
 
@@ -919,28 +1162,39 @@ void Orchestrator::checkResults(const std::vector<std::size_t>& devices)
 {
     FRASY_PROFILE_FUNCTION();
     using nlohmann::json;
+    std::vector<Analyzers::ResultIndex::Entry> archived;
     for (const auto& uut : devices) {
         if (std::string resultFile = std::format("{}/{}/{}.json", m_outputDirectory, lastSubdirectory, uut);
             std::filesystem::exists(resultFile)) {
-            std::ifstream ifs {resultFile};
-            std::string   content = std::string(std::istreambuf_iterator {ifs}, {});
-            json          data    = json::parse(content);
-            bool          passed  = data["info"]["pass"];
-            std::string   serial  = data["info"]["serial"];
-            m_uutStates[uut]      = passed ? UutState::Passed : UutState::Failed;
-            std::filesystem::copy(resultFile,
-                                  std::format("{}/{}/{}/{}_{}.txt",
-                                              m_outputDirectory,
-                                              m_title,
-                                              passed ? passSubdirectory : failSubdirectory,
-                                              std::chrono::system_clock::now().time_since_epoch().count(),
-                                              serial));
+            // The report is parsed once, the archive and the index are both made out of that document.
+            json          data      = Analyzers::ReportFile::Load(resultFile);
+            bool          passed    = data["info"]["pass"];
+            std::string   serial    = data["info"]["serial"];
+            int64_t       timestamp = std::chrono::system_clock::now().time_since_epoch().count();
+            std::string   archive   = std::format("{}/{}_{}{}",
+                                                  passed ? passSubdirectory : failSubdirectory,
+                                                  timestamp,
+                                                  serial,
+                                                  Analyzers::ReportFile::ExtensionOf(m_archiveFormat));
+            m_uutStates[uut] = passed ? UutState::Passed : UutState::Failed;
+            std::string destination = std::format("{}/{}/{}", m_outputDirectory, m_title, archive);
+            Analyzers::ReportFile::Save(data, destination, m_archiveFormat);
+            archived.push_back({.File = std::move(archive), .Timestamp = timestamp, .Report = std::move(data)});
         }
         else if (m_uutStates[uut] != UutState::Disabled) {
             m_uutStates[uut] = UutState::Error;
             BR_LUA_ERROR("Missing report for UUT {}, files '{}' does not exist.", uut, resultFile);
         }
     }
+
+    // The result analyzer reads the index rather than every archived report.
+    try {
+        Analyzers::ResultIndex::Append(
+          std::filesystem::path(m_outputDirectory) / m_title / Analyzers::ResultIndex::s_directory, archived);
+    }
+    catch (const std::exception& e) {
+        BR_LOG_ERROR(s_tag, "Unable to add the reports to the result index: {}", e.what());
+    }
 }
 
 void Orchestrator::toggleUut(std::size_t index)
@@ -974,7 +1228,12 @@ void Orchestrator::generate()
 
     m_running = std::async(std::launch::async, [this] {
         BR_BEGIN_GUARDED_SCOPE
-        { runStageGenerate(true); }
+        {
+            verifyLuaFiles(true);
+            // Asked for explicitly, the persisted solution must not be reused.
+            GenerationCache {generationCacheFile()}.invalidate();
+            runStageGenerate(true);
+        }
         BR_END_GUARDED_SCOPE
     });
 }
@@ -1042,7 +1301,7 @@ void Orchestrator::importOnce(sol::state_view lua, [[maybe_unused]] Stage stage)
 #pragma region Log
 void Orchestrator::importLog(sol::state_view lua, std::size_t uut, [[maybe_unused]] Stage stage)
 {
-    lua.script_file("lua/core/sdk/log.lua");
+    m_chunks.scriptFile(lua, "lua/core/sdk/log.lua");
     lua["Log"]["C"] = [uut](const std::string& message) { BR_LOG_CRITICAL(std::format("UUT{}", uut), message); };
     lua["Log"]["E"] = [uut](const std::string& message) { BR_LOG_ERROR(std::format("UUT{}", uut), message); };
     lua["Log"]["W"] = [uut](const std::string& message) { BR_LOG_WARN(std::format("UUT{}", uut), message); };
@@ -1090,7 +1349,7 @@ void Orchestrator::renderPopups()
 
 void Orchestrator::importPopup(sol::state_view lua, std::size_t uut, Stage stage)
 {
-    lua.script_file("lua/core/sdk/popup.lua");
+    m_chunks.scriptFile(lua, "lua/core/sdk/popup.lua");
     lua["__popup"]            = lua.create_table();
     lua["__popup"]["Consume"] = [&, uut](sol::table builder) { m_popups[Popup::GetName(uut, builder)].Consume(); };
     if (stage == Stage::execution) {
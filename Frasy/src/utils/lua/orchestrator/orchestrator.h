@@ -21,9 +21,12 @@
 #include "../../communication/can_open/can_open.h"
 #include "../../communication/serial/device.h"
 #include "../../UutState.h"
+#include "../chunk_cache.h"
 #include "../map.h"
+#include "uut_worker_pool.h"
 #include "utils/lua/popup.h"
 #include "utils/models/solution.h"
+#include "utils/result_analyzer/report_file.h"
 
 #include "../expectation.h"
 #include <functional>
@@ -32,6 +35,7 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <sol/sol.hpp>
 #include <string>
 #include <vector>
@@ -68,7 +72,7 @@ public:
     bool loadUserFiles(const std::string& environment, const std::string& testsDir, const std::string& title = "");
 
     /**
-     * Async request to generate the solution
+     * Async request to generate the solution, even if the sources are unchanged
      * Success will be reported through Interface::OnGenerated() callback
      */
     void generate();
@@ -113,7 +117,8 @@ public:
      * Use UutState() to know the state of the UUT
      * @param operatorName
      * @param serials list of UUT serial, must match the number of UUTs
-     * @param regenerate if true, will force the generation of the solution
+     * @param regenerate if true, the sources are checked again and the solution is only generated if they changed
+     * since the last generation. Use generate() to force it.
      * @param skipVerification if true, will skip the validation step
      * @param onDoneCallback void callback invoked when done
      */
@@ -130,6 +135,28 @@ public:
      */
     const Models::Solution& getSolution();
 
+    /**
+     * Choose whether the generated solution is also written to solutionFile.
+     * The states get the solution straight from memory, the file is only read by the report generators
+     * (see Report::SolutionLoader) and is useful to inspect a generation.
+     * @param save true to write the file (default), false to skip it
+     */
+    void setSaveSolution(bool save) { m_saveSolution = save; }
+
+    /**
+     * Choose whether the tests of a same stage that declared disjoint resources run concurrently on their UUT.
+     * See TestScheduler (lua/core/framework/test_scheduler.lua). Only affects the states created afterwards.
+     * @param parallel true to interleave the tests, false to run them one after the other (default)
+     */
+    void setParallelTests(bool parallel) { m_parallelTests = parallel; }
+
+    /**
+     * Choose the format of the reports archived in <output>/<title>/pass and fail. The report of the last run of each
+     * UUT stays in JSON.
+     * @param format Json (default), or Cbor for an archive a fraction of the size
+     */
+    void setArchiveFormat(Analyzers::ReportFile::Format format) { m_archiveFormat = format; }
+
     /**
      * Allows orchestrator to display Lua popups
      * Already call by Frasy::MainLayer::OnGuiRender()
@@ -161,14 +188,29 @@ public:
     }
 
 private:
+    /**
+     * Functions of a UUT state that the orchestrator calls into.
+     * Compiled once, when the state is set up, and reused for every section.
+     */
+    struct EntryPoints {
+        sol::protected_function loadSolution;
+        sol::protected_function validate;
+        sol::protected_function executeSection;
+        sol::protected_function compileExecutionResults;
+    };
+
+    EntryPoints makeEntryPoints(sol::state_view lua);
+    sol::state& resetUutState(std::size_t uut);
+    void        releaseUutState(std::size_t uut);
+
     bool        createOutputDirs();
     bool        initLua(sol::state_view lua, std::size_t uut = 0, Stage stage = Stage::generation);
     void        importExclusive(sol::state_view lua, Stage stage);
     void        importOnce(sol::state_view lua, Stage stage);
-    static void importLog(sol::state_view lua, std::size_t uut, Stage stage);
+    void        importLog(sol::state_view lua, std::size_t uut, Stage stage);
     void        importPopup(sol::state_view lua, std::size_t uut, Stage stage);
-    static bool loadEnvironment(sol::state_view lua, const std::string& filename);
-    static bool loadTests(sol::state_view lua, const std::string& filename);
+    bool        loadEnvironment(sol::state_view lua, const std::string& filename);
+    bool        loadTests(sol::state_view lua, const std::string& filename);
     void        runTests(const std::vector<std::string>& serials, bool regenerate, bool skipVerification);
 
     void populateMap();
@@ -180,13 +222,30 @@ private:
     void runStageExecute(sol::state_view team, const std::vector<std::string>& serials);
     void checkResults(const std::vector<std::size_t>& devices);
 
-    static bool verifyHash(const std::filesystem::path& folder, const std::filesystem::path& hashfile);
+    static bool verifyHash(const std::filesystem::path& folder, const std::filesystem::path& hashfile, std::string& hash);
+
+    /**
+     * Verify the hashes of the Lua directories.
+     * The result is cached, only the first call (or a forced one) actually hashes the directories.
+     * @param force if true, the directories will be hashed again
+     * @return true if both directories match their hash
+     */
+    bool verifyLuaFiles(bool force = false);
+
+    /**
+     * Identify the sources that the solution is generated from.
+     * @return The key of the generation cache, empty if the sources could not be hashed
+     */
+    std::string                         generationKey();
+    [[nodiscard]] std::filesystem::path generationCacheFile() const;
 
     std::unique_ptr<sol::state> m_state = nullptr;
     std::vector<UutState>       m_uutStates;
     std::future<void>           m_running;
     Map                         m_map;
-    bool                        m_generated = false;
+    bool                        m_generated     = false;
+    bool                        m_saveSolution  = true;
+    bool                        m_parallelTests = false;
     std::string                 m_title;
     std::string                 m_environment;
     std::string                 m_testsDir;
@@ -195,6 +254,8 @@ private:
     bool                        m_parallel  = true;
     bool                        m_ibEnabled = true;
 
+    Analyzers::ReportFile::Format m_archiveFormat = Analyzers::ReportFile::Format::Json;
+
     std::map<std::string, Popup> m_popups;
     std::unique_ptr<std::mutex>  m_popupMutex = nullptr;
 
@@ -203,6 +264,11 @@ private:
     std::mutex                                  m_onceLock;
     std::map<std::size_t, std::once_flag>       m_onceFlagMap;
 
+    ChunkCache          m_chunks;
+    std::mutex          m_verificationLock;
+    std::optional<bool> m_luaFilesVerified;
+    std::string         m_luaFilesHash;    //! Hash of lua/core and lua/user, empty if not verified (or in debug).
+
     std::function<void(sol::state_view lua)>       m_loadUserFunctions = []([[maybe_unused]] sol::state_view lua) {};
     std::function<sol::table(sol::state_view lua)> m_loadUserBoards    = [](sol::state_view lua) {
         return lua.create_table();
@@ -221,6 +287,12 @@ private:
 
     const char* (*m_getApplicationVersion)() = [] { return "1.0.0"; };
 
+    //! Declared after the other members, the states owned by the workers reference the orchestrator and must be
+    //! destroyed before the rest of it. Only m_entryPoints, which references the states, comes after.
+    std::unique_ptr<UutWorkerPool> m_workers = nullptr;
+    //! Entry points of the state of each worker, declared after the pool so that they are released before the states.
+    std::map<std::size_t, EntryPoints> m_entryPoints;
+
     static constexpr auto s_tag = "Orchestrator";
 };
 }    // namespace Frasy::Lua
@@ -0,0 +1,119 @@
+/**
+ * @file    uut_worker_pool.cpp
+ * @author  Frasy
+ * @date    2026-10-16
+ * @brief   Long-lived pool of per-UUT worker threads used by the orchestrator.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <https://www.gnu.org/licenses/>.
+ */
+#include "uut_worker_pool.h"
+
+#include "utils/lua/profile_events.h"
+
+#include <Brigerad/Core/Log.h>
+#include <Brigerad/Core/Thread.h>
+
+#include <format>
+#include <stdexcept>
+
+namespace Frasy::Lua {
+UutWorkerPool::UutWorkerPool(const std::vector<std::size_t>& uuts)
+{
+    for (auto uut : uuts) {
+        auto worker   = std::make_unique<Worker>();
+        worker->uut   = uut;
+        worker->state = std::make_unique<sol::state>();
+        auto& ref     = *worker;
+        worker->thread =
+          Brigerad::MakeThread([&ref](const std::stop_token& stopToken) { workerLoop(stopToken, ref); });
+        m_workers[uut] = std::move(worker);
+    }
+}
+
+void UutWorkerPool::dispatch(const std::vector<std::size_t>& uuts, const Job& job)
+{
+    FRASY_PROFILE_FUNCTION();
+    if (uuts.empty()) { return; }
+
+    // Resolve every worker first, so that an invalid UUT doesn't leave the latch waiting on jobs that were never
+    // handed out.
+    std::vector<Worker*> workers;
+    workers.reserve(uuts.size());
+    for (auto uut : uuts) {
+        workers.push_back(&getWorker(uut));
+    }
+
+    std::latch done {static_cast<std::ptrdiff_t>(workers.size())};
+    for (auto* worker : workers) {
+        {
+            std::lock_guard lock {worker->mutex};
+            worker->job  = &job;
+            worker->done = &done;
+        }
+        worker->cv.notify_one();
+    }
+    done.wait();
+}
+
+sol::state& UutWorkerPool::resetState(std::size_t uut)
+{
+    auto& worker = getWorker(uut);
+    worker.state = std::make_unique<sol::state>();
+    return *worker.state;
+}
+
+void UutWorkerPool::releaseState(std::size_t uut)
+{ getWorker(uut).state.reset(); }
+
+sol::state& UutWorkerPool::state(std::size_t uut)
+{
+    auto& worker = getWorker(uut);
+    if (!worker.state) { worker.state = std::make_unique<sol::state>(); }
+    return *worker.state;
+}
+
+void UutWorkerPool::workerLoop(const std::stop_token& stopToken, Worker& worker)
+{
+    if (!Brigerad::SetThreadName(Brigerad::GetCurrentThread(), std::format("UUT {}", worker.uut))) {
+        BR_LOG_ERROR(s_tag, "Unable to set thread name");
+    }
+
+    while (!stopToken.stop_requested()) {
+        const Job*  job  = nullptr;
+        std::latch* done = nullptr;
+        {
+            std::unique_lock lock {worker.mutex};
+            if (!worker.cv.wait(lock, stopToken, [&worker] { return worker.job != nullptr; })) { return; }
+            job  = worker.job;
+            done = worker.done;
+        }
+
+        // Each job is guarded on its own, a crashing job must still release the dispatcher.
+        BR_BEGIN_GUARDED_SCOPE
+        { (*job)(worker.uut); }
+        BR_END_GUARDED_SCOPE
+
+        {
+            std::lock_guard lock {worker.mutex};
+            worker.job  = nullptr;
+            worker.done = nullptr;
+        }
+        done->count_down();
+    }
+}
+
+UutWorkerPool::Worker& UutWorkerPool::getWorker(std::size_t uut)
+{
+    auto it = m_workers.find(uut);
+    if (it == m_workers.end()) { throw std::runtime_error(std::format("Invalid uut: {}", uut)); }
+    return *it->second;
+}
+}    // namespace Frasy::Lua
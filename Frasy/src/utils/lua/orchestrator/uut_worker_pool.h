@@ -0,0 +1,112 @@
+/**
+ * @file    uut_worker_pool.h
+ * @author  Frasy
+ * @date    2026-10-16
+ * @brief   Long-lived pool of per-UUT worker threads used by the orchestrator.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef FRASY_UTILS_LUA_ORCHESTRATOR_UUT_WORKER_POOL_H
+#define FRASY_UTILS_LUA_ORCHESTRATOR_UUT_WORKER_POOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <latch>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sol/sol.hpp>
+#include <thread>
+#include <vector>
+
+namespace Frasy::Lua {
+/**
+ * @brief One pinned worker thread per UUT, each owning the sol::state of that UUT.
+ *
+ * Workers are created once, when the user files are loaded, and live until the pool is destroyed. Every stage of
+ * every section is dispatched to the workers instead of spawning (and joining) a thread per UUT, so that section
+ * transitions only cost a wake-up and a latch, and thread-local state (thread name, profiler, logs) persists across
+ * the whole run.
+ *
+ * The states are only ever touched by their own worker while a job is running, the pool itself does not lock them.
+ */
+class UutWorkerPool {
+public:
+    using Job = std::function<void(std::size_t uut)>;
+
+    explicit UutWorkerPool(const std::vector<std::size_t>& uuts);
+    ~UutWorkerPool() = default;
+
+    UutWorkerPool(const UutWorkerPool&)            = delete;
+    UutWorkerPool& operator=(const UutWorkerPool&) = delete;
+    UutWorkerPool(UutWorkerPool&&)                 = delete;
+    UutWorkerPool& operator=(UutWorkerPool&&)      = delete;
+
+    /**
+     * Run a job on each of the requested UUTs concurrently, blocking until all of them are done.
+     * @param uuts UUTs to run the job on. Every UUT must be part of the pool.
+     * @param job Job to run, invoked once per UUT with the index of that UUT.
+     */
+    void dispatch(const std::vector<std::size_t>& uuts, const Job& job);
+
+    /**
+     * Run a job on a single UUT, blocking until it is done.
+     * @param uut UUT to run the job on.
+     * @param job Job to run.
+     */
+    void dispatch(std::size_t uut, const Job& job) { dispatch(std::vector {uut}, job); }
+
+    /**
+     * Replace the state of a UUT by a brand new one.
+     * Should only be called from a job running on that UUT, or while the pool is idle.
+     * @param uut UUT to reset.
+     * @return The new state.
+     */
+    sol::state& resetState(std::size_t uut);
+
+    /**
+     * Destroy the state of a UUT, releasing everything it holds.
+     * Should only be called from a job running on that UUT, or while the pool is idle.
+     * @param uut UUT to release.
+     */
+    void releaseState(std::size_t uut);
+
+    /**
+     * Get the current state of a UUT.
+     * Should only be called from a job running on that UUT, or while the pool is idle.
+     * @param uut UUT to get the state of.
+     * @return The state of the UUT.
+     */
+    sol::state& state(std::size_t uut);
+
+    [[nodiscard]] bool contains(std::size_t uut) const { return m_workers.contains(uut); }
+
+private:
+    struct Worker {
+        std::size_t                 uut = 0;
+        std::unique_ptr<sol::state> state;
+        std::mutex                  mutex;
+        std::condition_variable_any cv;
+        const Job*                  job  = nullptr;
+        std::latch*                 done = nullptr;
+        std::jthread                thread;    //! Declared last so that it is joined before the rest is destroyed.
+    };
+
+    static void workerLoop(const std::stop_token& stopToken, Worker& worker);
+    Worker&     getWorker(std::size_t uut);
+
+    std::map<std::size_t, std::unique_ptr<Worker>> m_workers;
+
+    static constexpr auto s_tag = "UutWorkerPool";
+};
+}    // namespace Frasy::Lua
+
+#endif    // FRASY_UTILS_LUA_ORCHESTRATOR_UUT_WORKER_POOL_H
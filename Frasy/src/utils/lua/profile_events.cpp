@@ -0,0 +1,553 @@
+/**
+ * @file    profile_events.cpp
+ * @author  Frasy
+ * @date    2026-10-16
+ * @brief   Per-thread recording of the profile events, merged on demand.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <https://www.gnu.org/licenses/>.
+ */
+#include "profile_events.h"
+
+#include "trace_writer.h"
+
+#include <Brigerad/Debug/Instrumentor.h>
+
+#include <algorithm>
+#include <array>
+#include <format>
+#include <functional>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+namespace Frasy {
+namespace {
+using Clock = std::chrono::steady_clock;
+
+//! Id of the records marking the end of the innermost event.
+constexpr ProfileEventId s_returnRecord = (std::numeric_limits<ProfileEventId>::max)();
+constexpr std::size_t    s_chunkSize    = 4096;
+
+struct Record {
+    ProfileEventId id;
+    Clock::rep     time;
+};
+
+/**
+ * Fixed-size block of records, written by its thread and read by the merge.
+ * size is only increased by the writer, next is set once the chunk is full.
+ */
+struct Chunk {
+    std::array<Record, s_chunkSize> records;
+    std::atomic_size_t              size = 0;
+    std::atomic<Chunk*>             next = nullptr;
+};
+
+struct HeaderKey {
+    std::string name;
+    std::string source;
+    int         line = 0;
+};
+
+struct HeaderView {
+    std::string_view name;
+    std::string_view source;
+    int              line = 0;
+};
+
+struct HeaderHash {
+    using is_transparent = void;
+
+    std::size_t operator()(const HeaderView& header) const
+    {
+        std::size_t hash = std::hash<std::string_view> {}(header.name);
+        hash ^= std::hash<std::string_view> {}(header.source) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        hash ^= std::hash<int> {}(header.line) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        return hash;
+    }
+    std::size_t operator()(const HeaderKey& header) const
+    {
+        return (*this)(HeaderView {header.name, header.source, header.line});
+    }
+};
+
+struct HeaderEqual {
+    using is_transparent = void;
+
+    bool operator()(const auto& a, const auto& b) const
+    {
+        return a.line == b.line && std::string_view {a.name} == std::string_view {b.name} &&
+               std::string_view {a.source} == std::string_view {b.source};
+    }
+};
+
+std::string CurrentThreadLabel()
+{
+#if defined(__cpp_lib_formatters) && __cpp_lib_formatters >= 202302L
+    // Get the thread's description, if one was set. Otherwise, make a label that uses the thread's ID.
+    HANDLE  currentThread = GetCurrentThread();
+    PWSTR   data          = nullptr;
+    HRESULT hr            = GetThreadDescription(currentThread, &data);
+    if (SUCCEEDED(hr) && std::wcslen(data) > 0) {
+        std::string label = StringUtils::WStringToString(data);
+        LocalFree(data);
+        return label;
+    }
+    return std::format("Thread {}", std::this_thread::get_id());
+#else
+    return std::format("Thread {}", std::this_thread::get_id()._Get_underlying_id());
+#endif
+}
+
+/**
+ * Flags the buffer of the thread once it exits, so that the merge can release it.
+ * Shared with the buffer, so that a thread exiting after the profiler is destroyed doesn't write to freed memory.
+ */
+struct ThreadExit {
+    std::shared_ptr<std::atomic_bool> finished;
+
+    ~ThreadExit()
+    {
+        if (finished) { finished->store(true, std::memory_order_release); }
+    }
+};
+
+thread_local ThreadExit t_threadExit;
+
+std::int64_t Nanoseconds(Clock::rep time)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::duration(time)).count();
+}
+
+std::string_view Category(const ProfileEventHeader& header)
+{
+    return header.source.ends_with(".lua") ? "lua" : "frasy";
+}
+
+void SortEvents(std::list<ProfileEvent>& events, const std::function<bool(const ProfileEvent&, const ProfileEvent&)>& cmp)
+{
+    events.sort(cmp);
+    for (auto&& event : events) {
+        SortEvents(event.childs, cmp);
+    }
+}
+}    // namespace
+
+struct Profiler::ThreadBuffer {
+    ThreadBuffer() : head(new Chunk), tail(head) {}
+    ~ThreadBuffer()
+    {
+        while (head != nullptr) {
+            delete std::exchange(head, head->next.load(std::memory_order_acquire));
+        }
+    }
+    ThreadBuffer(const ThreadBuffer&)            = delete;
+    ThreadBuffer& operator=(const ThreadBuffer&) = delete;
+
+    const std::thread::id threadId = std::this_thread::get_id();
+    const std::string     label    = CurrentThreadLabel();
+
+    // Reader side, only used with the pump lock held.
+    Chunk*              head               = nullptr;
+    std::size_t         consumed           = 0;
+    std::vector<Record> collected;    //! Taken from the chunks, waiting for the merge.
+    std::vector<Record> open;         //! Calls of the events in progress, to time them in the trace.
+    std::size_t         collectedDropped   = 0;
+    std::int64_t        collectedDepth     = 0;
+    std::int64_t        collectedDropDepth = 0;
+    bool                collectedDropping  = false;
+    bool                exited             = false;
+
+    // Writer side, only used by the thread.
+    Chunk*                                                                 tail      = nullptr;
+    std::size_t                                                            tailSize  = 0;
+    std::int64_t                                                           depth     = 0;
+    std::int64_t                                                           dropDepth = 0;
+    bool                                                                   dropping  = false;
+    std::unordered_map<HeaderKey, ProfileEventId, HeaderHash, HeaderEqual> headers;
+
+    std::atomic_size_t                chunks   = 1;
+    std::atomic_size_t                dropped  = 0;
+    std::shared_ptr<std::atomic_bool> finished = std::make_shared<std::atomic_bool>(false);
+
+    void call(ProfileEventId id)
+    {
+        if (!dropping &&
+            (chunks.load(std::memory_order_relaxed) - 1) * s_chunkSize + tailSize >= s_maxPendingRecords) {
+            // Nobody collects the events, drop them until the current depth is back, so that the tree stays valid.
+            dropping  = true;
+            dropDepth = depth;
+        }
+        ++depth;
+        if (dropping) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        append(id);
+    }
+
+    //! Always recorded while its call was, so the backlog can exceed the limit by the depth of the call stack.
+    void ret()
+    {
+        --depth;
+        if (dropping) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            dropping = depth > dropDepth;
+            return;
+        }
+        append(s_returnRecord);
+    }
+
+    void append(ProfileEventId id)
+    {
+        if (tailSize == s_chunkSize) {
+            auto* chunk = new Chunk;
+            chunks.fetch_add(1, std::memory_order_relaxed);
+            tail->next.store(chunk, std::memory_order_release);
+            tail     = chunk;
+            tailSize = 0;
+        }
+        tail->records[tailSize] = {id, Clock::now().time_since_epoch().count()};
+        tail->size.store(++tailSize, std::memory_order_release);
+    }
+
+    [[nodiscard]] bool hasPending() const
+    {
+        return head->size.load(std::memory_order_acquire) != consumed ||
+               head->next.load(std::memory_order_acquire) != nullptr;
+    }
+
+    //! Keep a record for the merge. Past the limit, whole scopes are dropped like when recording them.
+    void collect(const Record& record)
+    {
+        if (record.id == s_returnRecord) {
+            --collectedDepth;
+            if (collectedDropping) {
+                ++collectedDropped;
+                collectedDropping = collectedDepth > collectedDropDepth;
+                return;
+            }
+        }
+        else {
+            if (!collectedDropping && collected.size() >= s_maxPendingRecords) {
+                collectedDropping  = true;
+                collectedDropDepth = collectedDepth;
+            }
+            ++collectedDepth;
+            if (collectedDropping) {
+                ++collectedDropped;
+                return;
+            }
+        }
+        collected.push_back(record);
+    }
+};
+
+Profiler::Profiler() = default;
+
+Profiler::~Profiler()
+{
+    // The writer's thread pumps the events, it must be done before the buffers are released.
+    stopTrace();
+}
+
+void Profiler::reset()
+{
+    std::lock_guard lock {m_mergeLock};
+    merge();
+    m_events.clear();
+}
+
+void Profiler::reset(std::thread::id id)
+{
+    std::lock_guard lock {m_mergeLock};
+    merge();
+    if (auto it = m_events.find(id); it != m_events.end()) { it->second.reset(); }
+}
+
+const std::map<std::thread::id, ProfilerDetails>& Profiler::getEvents()
+{
+    std::lock_guard lock {m_mergeLock};
+    merge();
+    return m_events;
+}
+
+ProfileEventId Profiler::intern(std::string_view name, std::string_view source, int line)
+{
+    ProfileEventHeader header {std::string(name), std::string(source), line};
+    std::lock_guard    lock {m_headersLock};
+    auto [it, inserted] = m_headerIds.try_emplace(header, static_cast<ProfileEventId>(m_headers.size()));
+    if (inserted) { m_headers.push_back(std::move(header)); }
+    return it->second;
+}
+
+bool Profiler::reportCallEvent(ProfileEventId id)
+{
+    if (!m_enabled.load(std::memory_order_relaxed)) { return false; }
+    threadBuffer()->call(id);
+    return true;
+}
+
+bool Profiler::reportCallEvent(std::string_view name, std::string_view source, int line)
+{
+    if (!m_enabled.load(std::memory_order_relaxed)) { return false; }
+    auto* buffer = threadBuffer();
+    auto  it     = buffer->headers.find(HeaderView {name, source, line});
+    if (it == buffer->headers.end()) {
+        it = buffer->headers
+               .emplace(HeaderKey {std::string(name), std::string(source), line}, intern(name, source, line))
+               .first;
+    }
+    buffer->call(it->second);
+    return true;
+}
+
+void Profiler::reportReturnEvent()
+{
+    if (!m_enabled.load(std::memory_order_relaxed)) { return; }
+    threadBuffer()->ret();
+}
+
+Profiler::ThreadBuffer* Profiler::threadBuffer()
+{
+    // Trivially destructible, so that accessing it doesn't go through the initialization guard of t_threadExit.
+    thread_local ThreadBuffer* t_buffer = nullptr;
+    if (t_buffer == nullptr) [[unlikely]] {
+        auto buffer           = std::make_unique<ThreadBuffer>();
+        t_threadExit.finished = buffer->finished;
+        std::lock_guard lock {m_buffersLock};
+        t_buffer = m_buffers.emplace_back(std::move(buffer)).get();
+    }
+    return t_buffer;
+}
+
+void Profiler::merge()
+{
+    struct Collected {
+        ThreadBuffer*       buffer;
+        std::vector<Record> records;
+        std::size_t         dropped;
+    };
+    std::vector<Collected> collected;
+    {
+        std::lock_guard lock {m_pumpLock};
+        pump();
+        std::lock_guard buffersLock {m_buffersLock};
+        for (auto&& buffer : m_buffers) {
+            if (buffer->collected.empty() && buffer->collectedDropped == 0) { continue; }
+            collected.push_back({buffer.get(),
+                                 std::exchange(buffer->collected, {}),
+                                 std::exchange(buffer->collectedDropped, 0)});
+        }
+    }
+
+    auto process = [this](const std::vector<Record>& records, ProfilerDetails& details) {
+        for (const auto& record : records) {
+            const auto time = Clock::time_point(Clock::duration(record.time));
+            if (record.id == s_returnRecord) {
+                // Events started before a reset are not tracked anymore.
+                if (details.m_activeEvent == nullptr) { continue; }
+                auto* event = details.m_activeEvent;
+                ++event->hitCount;
+                auto& marker    = event->history.back();
+                marker.end      = time;
+                marker.delta    = std::chrono::duration_cast<std::chrono::microseconds>(marker.end - marker.start);
+                event->totalTime += marker.delta;
+                event->minTime = (std::min)(event->minTime, marker.delta);
+                event->maxTime = (std::max)(event->maxTime, marker.delta);
+                event->avgTime = event->totalTime / event->hitCount;
+
+                // Prune old data from the history.
+                while (event->history.size() > s_maxHistorySize) {
+                    event->history.pop_front();
+                }
+
+                details.m_activeEvent = event->parent;
+                details.m_dirty       = true;
+                continue;
+            }
+
+            auto& siblings = details.m_activeEvent == nullptr ? details.m_events : details.m_activeEvent->childs;
+            auto  it = std::ranges::find_if(siblings, [&](const ProfileEvent& event) { return event.id == record.id; });
+            if (it == siblings.end()) {
+                auto& event  = siblings.emplace_back();
+                event.id     = record.id;
+                event.header = m_headers[record.id];
+                event.parent = details.m_activeEvent;
+                it           = std::prev(siblings.end());
+            }
+            it->history.push_back({.start = time, .end = time});
+            details.m_activeEvent = &*it;
+        }
+    };
+
+    {
+        std::lock_guard lock {m_headersLock};
+        for (auto&& [buffer, records, dropped] : collected) {
+            auto& details = m_events.try_emplace(buffer->threadId, buffer->threadId, buffer->label).first->second;
+            details.m_droppedEvents += dropped;
+            process(records, details);
+        }
+    }
+
+    for (auto&& [id, details] : m_events) {
+        if (!details.m_dirty) { continue; }
+        SortEvents(details.m_events, m_sortFunction);
+        details.m_dirty = false;
+    }
+
+    // Only released once their records are merged, so that the merge above never reads a released buffer.
+    std::lock_guard lock {m_pumpLock};
+    releaseExitedThreads();
+}
+
+void Profiler::pump()
+{
+    std::vector<ThreadBuffer*> buffers;
+    {
+        std::lock_guard lock {m_buffersLock};
+        buffers.reserve(m_buffers.size());
+        for (auto&& buffer : m_buffers) {
+            buffers.push_back(buffer.get());
+        }
+    }
+
+    std::vector<TraceEvent> trace;
+    std::lock_guard         lock {m_headersLock};
+    for (auto* buffer : buffers) {
+        // Checked before draining: once finished, the thread doesn't write anything anymore.
+        const bool finished = buffer->finished->load(std::memory_order_acquire);
+        buffer->collectedDropped += buffer->dropped.exchange(0, std::memory_order_relaxed);
+        if (buffer->hasPending()) {
+            const auto first = trace.size();
+            drain(*buffer, trace);
+            if (m_trace != nullptr && trace.size() != first) {
+                m_trace->nameThread(TraceWriter::threadId(buffer->threadId), buffer->label);
+            }
+        }
+        buffer->exited = finished;
+    }
+    if (m_trace != nullptr && !trace.empty()) { m_trace->write(std::move(trace)); }
+}
+
+void Profiler::drain(ThreadBuffer& buffer, std::vector<TraceEvent>& trace)
+{
+    const auto threadId = TraceWriter::threadId(buffer.threadId);
+    auto       process  = [&](const Record& record) {
+        buffer.collect(record);
+        if (record.id != s_returnRecord) {
+            buffer.open.push_back(record);
+            return;
+        }
+        // Unbalanced end events from Lua are ignored.
+        if (buffer.open.empty()) { return; }
+        const auto call = buffer.open.back();
+        buffer.open.pop_back();
+        if (m_trace == nullptr) { return; }
+        const auto& header = m_headers[call.id];
+        trace.push_back({.name     = header.name,
+                         .category = Category(header),
+                         .source   = header.source,
+                         .line     = header.currentLine,
+                         .threadId = threadId,
+                         .start    = Nanoseconds(call.time),
+                         .duration = Nanoseconds(record.time - call.time)});
+    };
+
+    for (;;) {
+        const auto size = buffer.head->size.load(std::memory_order_acquire);
+        for (; buffer.consumed < size; ++buffer.consumed) {
+            process(buffer.head->records[buffer.consumed]);
+        }
+        if (buffer.consumed != s_chunkSize) { break; }
+        auto* next = buffer.head->next.load(std::memory_order_acquire);
+        if (next == nullptr) { break; }
+        delete std::exchange(buffer.head, next);
+        buffer.consumed = 0;
+        buffer.chunks.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+void Profiler::releaseExitedThreads()
+{
+    std::lock_guard lock {m_buffersLock};
+    std::erase_if(m_buffers, [](const auto& buffer) {
+        return buffer->exited && buffer->collected.empty() && buffer->collectedDropped == 0;
+    });
+}
+
+bool Profiler::startTrace(const std::filesystem::path& path)
+{
+    {
+        std::lock_guard lock {m_pumpLock};
+        if (m_trace != nullptr) {
+            BR_LOG_ERROR("Profiler", "A trace is already in progress");
+            return false;
+        }
+        // The events that completed before the trace aren't part of it.
+        pump();
+        try {
+            m_trace = std::make_unique<TraceWriter>(path, [this] {
+                std::lock_guard lock {m_pumpLock};
+                pump();
+            });
+        }
+        catch (const std::exception& e) {
+            BR_LOG_ERROR("Profiler", "Unable to start the trace: {}", e.what());
+            return false;
+        }
+    }
+    Brigerad::Instrumentor::Get().SetTraceSink(&Profiler::traceInstrumentorScope);
+    BR_LOG_INFO("Profiler", "Tracing to '{}'", path.string());
+    return true;
+}
+
+void Profiler::stopTrace()
+{
+    Brigerad::Instrumentor::Get().SetTraceSink(nullptr);
+    std::unique_ptr<TraceWriter> trace;
+    {
+        std::lock_guard lock {m_pumpLock};
+        if (m_trace == nullptr) { return; }
+        pump();
+        trace = std::move(m_trace);
+    }
+    // Destroyed without the lock, its thread might be waiting for it to pump.
+    trace.reset();
+}
+
+bool Profiler::isTracing()
+{
+    std::lock_guard lock {m_pumpLock};
+    return m_trace != nullptr;
+}
+
+void Profiler::traceInstrumentorScope(const Brigerad::ProfileResult& result)
+{
+    using BrigeradClock = std::chrono::high_resolution_clock;
+    // Brigerad times its scopes in microseconds of its own clock, which is the steady clock with MSVC.
+    static const std::int64_t s_offset =
+      std::is_same_v<BrigeradClock, Clock>
+        ? 0
+        : std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch() -
+                                                               BrigeradClock::now().time_since_epoch())
+            .count();
+
+    auto&           profiler = get();
+    std::lock_guard lock {profiler.m_pumpLock};
+    if (profiler.m_trace == nullptr) { return; }
+    profiler.m_trace->write(TraceEvent {.name     = profiler.m_trace->intern(result.Name),
+                                        .category = "brigerad",
+                                        .threadId = result.ThreadID,
+                                        .start    = result.Start * 1000 + s_offset,
+                                        .duration = (result.End - result.Start) * 1000});
+}
+}    // namespace Frasy
@@ -24,13 +24,21 @@
 
 #include <utils/string_utils.h>
 
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <deque>
+#include <filesystem>
 #include <functional>
 #include <list>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <numeric>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
 
 #ifndef WIN32_LEAN_AND_MEAN
 #define WIN32_LEAN_AND_MEAN
@@ -42,7 +50,14 @@
 
 #include "processthreadsapi.h"
 
+namespace Brigerad {
+struct ProfileResult;
+}
+
 namespace Frasy {
+class TraceWriter;
+struct TraceEvent;
+
 /**
  * Identification Information of a profile event.
  */
@@ -54,6 +69,11 @@ struct ProfileEventHeader {
     auto operator<=>(const ProfileEventHeader&) const = default;
 };
 
+/**
+ * Interned ProfileEventHeader, see Profiler::intern.
+ */
+using ProfileEventId = std::uint32_t;
+
 struct ProfileEventMarkers {
     std::chrono::time_point<std::chrono::steady_clock> start = std::chrono::steady_clock::now();
     std::chrono::time_point<std::chrono::steady_clock> end   = std::chrono::steady_clock::now();
@@ -61,6 +81,7 @@ struct ProfileEventMarkers {
 };
 
 struct ProfileEvent {
+    ProfileEventId                  id = 0;
     ProfileEventHeader              header;
     int                             hitCount  = 0;
     std::chrono::microseconds       totalTime = std::chrono::microseconds(0);
@@ -75,9 +96,16 @@ struct ProfileEvent {
 
 class ProfilerDetails {
 public:
+    ProfilerDetails(std::thread::id threadId, std::string label)
+        : m_threadId(threadId), m_label(std::move(label))
+    {
+    }
+
     const std::string&             label() const { return m_label; }
     const std::thread::id&         threadId() const { return m_threadId; }
     const std::list<ProfileEvent>& getEvents() const { return m_events; }
+    //! Events that were not recorded because nobody collected the events of the thread in time.
+    std::size_t droppedEvents() const { return m_droppedEvents; }
 
     std::chrono::microseconds getTotalTime() const
     {
@@ -88,32 +116,33 @@ public:
             [](std::chrono::microseconds tot, const ProfileEvent& event) { return tot + event.totalTime; });
     }
 
-    void reset() { m_events.clear(); }
+    void reset()
+    {
+        m_events.clear();
+        m_activeEvent = nullptr;
+    }
 
 private:
     friend class Profiler;
     ProfileEvent*           m_activeEvent = nullptr;
     std::list<ProfileEvent> m_events; //! List because of constant insertion at end + pointer stability.
-    std::thread::id         m_threadId = std::this_thread::get_id();
-
-#if defined(__cpp_lib_formatters) && __cpp_lib_formatters >= 202302L
-    std::string m_label = [] {
-        // Get the thread's description, if one was set. Otherwise, make a label that uses the thread's ID.
-        HANDLE  currentThread = GetCurrentThread();
-        PWSTR   data          = nullptr;
-        HRESULT hr            = GetThreadDescription(currentThread, &data);
-        if (SUCCEEDED(hr) && std::wcslen(data) > 0) {
-            std::string label = StringUtils::WStringToString(data);
-            LocalFree(data);
-            return label;
-        }
-        return std::format("Thread {}", std::this_thread::get_id());
-    }();
-#else
-    std::string m_label = std::format("Thread {}", std::this_thread::get_id()._Get_underlying_id());
-#endif
+    std::thread::id         m_threadId;
+    std::string             m_label;
+    std::size_t             m_droppedEvents = 0;
+    bool                    m_dirty         = false;
 };
 
+/**
+ * Collects the call and return events of every thread.
+ *
+ * Reporting an event only appends a record to a buffer owned by the calling thread, without any lock or allocation
+ * in the common case. The records are merged into the per-thread trees of ProfileEvent when getEvents() is called,
+ * i.e. when the profiler panel renders or a trace is dumped.
+ * Each thread keeps at most s_maxPendingRecords records waiting to be merged, the events past that are dropped.
+ *
+ * While a trace is started, the records are also collected periodically by the TraceWriter, which writes every
+ * completed event to the timeline of its thread along with the scopes of Brigerad::Instrumentor.
+ */
 class Profiler {
 public:
     static Profiler& get()
@@ -122,83 +151,54 @@ public:
         return s_instance;
     }
 
-    void reset() { m_events.clear(); }
-    void reset(std::thread::id id) { m_events[id].reset(); }
-    void enable() { m_enabled = true; }
-    void disable() { m_enabled = false; }
-
-    const std::map<std::thread::id, ProfilerDetails>& getEvents() const { return m_events; }
-
-    void reportCallEvent(const ProfileEventHeader& header)
-    {
-        if (!m_enabled) { return; }
-        auto isEvent = [&header](const ProfileEvent& event) { return event.header == header; };
-
-        auto  id     = std::this_thread::get_id();
-        auto& events = m_events[id];
-
-        if (events.m_activeEvent == nullptr) {
-            // We're at the top level! Check if we've already seen that event before.
-            if (auto it = std::ranges::find_if(events.m_events, isEvent); it != events.m_events.end()) {
-                events.m_activeEvent = &*it;
-            }
-            else {
-                // Event doesn't exist.
-                events.m_events.emplace_back(header);
-                events.m_activeEvent = &events.m_events.back();
-            }
-            events.m_activeEvent->history.emplace_back(std::chrono::steady_clock::now());
-        }
-        else {
-            // We're a child of someone, create a new child if we've never seen it before.
-            auto* parent = events.m_activeEvent;
-            if (auto it = std::ranges::find_if(events.m_activeEvent->childs, isEvent);
-                it != events.m_activeEvent->childs.end()) {
-                events.m_activeEvent = &*it;
-            }
-            else {
-                events.m_activeEvent->childs.emplace_back(header);
-                events.m_activeEvent         = &events.m_activeEvent->childs.back();
-                events.m_activeEvent->parent = parent;
-            }
-            events.m_activeEvent->history.emplace_back(std::chrono::steady_clock::now());
-        }
-    }
-
-    void reportReturnEvent([[maybe_unused]] const ProfileEventHeader& header)
-    {
-        if (!m_enabled) { return; }
-        auto id = std::this_thread::get_id();
-
-        auto& event = m_events[id];
-        if (event.m_activeEvent == nullptr) {
-            BR_LUA_WARN("No active event to return from!");
-            return;
-        }
-
-        ++event.m_activeEvent->hitCount;
-        auto& marker = event.m_activeEvent->history.back();
-        marker.end = std::chrono::steady_clock::now();
-        marker.delta = std::chrono::duration_cast<std::chrono::microseconds>(marker.end - marker.start);
-        event.m_activeEvent->totalTime += marker.delta;
-        event.m_activeEvent->minTime = (std::min)(event.m_activeEvent->minTime, marker.delta);
-        event.m_activeEvent->maxTime = (std::max)(event.m_activeEvent->maxTime, marker.delta);
-        event.m_activeEvent->avgTime = event.m_activeEvent->totalTime / event.m_activeEvent->hitCount;
-
-        // Prune old data from the history.
-        while (event.m_activeEvent->history.size() > s_maxHistorySize) {
-            event.m_activeEvent->history.pop_front();
-        }
-
-        // TODO Sorting in here ain't exactly the least intrusive approach. It sure is the easiest tho
-        // Sort the whole branch back to the root
-        for (auto* parent = event.m_activeEvent->parent; parent != nullptr; parent = parent->parent) {
-            parent->childs.sort(m_sortFunction);
-        }
-        event.m_events.sort(m_sortFunction);
-
-        event.m_activeEvent = event.m_activeEvent->parent;
-    }
+    Profiler();
+    ~Profiler();
+    Profiler(const Profiler&)            = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    void reset();
+    void reset(std::thread::id id);
+    void enable() { m_enabled.store(true, std::memory_order_relaxed); }
+    void disable() { m_enabled.store(false, std::memory_order_relaxed); }
+
+    /**
+     * Merge the events recorded by every thread since the last call.
+     * Must not be called concurrently with reset() or itself from several threads, like the panel does.
+     * @return The events of each thread that reported any.
+     */
+    const std::map<std::thread::id, ProfilerDetails>& getEvents();
+
+    /**
+     * Start writing every event that completes from now on to a Chrome trace file.
+     * @return false if a trace is already in progress or the file can't be created.
+     */
+    bool startTrace(const std::filesystem::path& path);
+    /**
+     * Write the events collected so far and close the trace file, if a trace is in progress.
+     */
+    void stopTrace();
+    bool isTracing();
+
+    /**
+     * Get the identifier of an event, to report it without copying or hashing its header.
+     * @return The same identifier for every call with the same header, from any thread.
+     */
+    ProfileEventId intern(std::string_view name, std::string_view source, int line);
+
+    /**
+     * Report the start of an event.
+     * @return true if the event was recorded, in which case reportReturnEvent() must be called when it ends.
+     */
+    bool reportCallEvent(ProfileEventId id);
+    /**
+     * Report the start of an event whose header isn't known in advance, such as a Lua function.
+     * Looks the header up in a cache of the calling thread, slower than reporting an interned event.
+     */
+    bool reportCallEvent(std::string_view name, std::string_view source, int line);
+    /**
+     * Report the end of the innermost event in progress on the calling thread.
+     */
+    void reportReturnEvent();
 
     static bool sortByHitCountAsc(const ProfileEvent& a, const ProfileEvent& b) { return a.hitCount < b.hitCount; }
     static bool sortByHitCountDesc(const ProfileEvent& a, const ProfileEvent& b) { return a.hitCount > b.hitCount; }
@@ -210,29 +210,60 @@ public:
     {
         BR_ASSERT(func, "Function is not callable");
         m_sortFunction = func;
+        for (auto&& [id, details] : m_events) {
+            details.m_dirty = true;
+        }
     }
 
+    static constexpr size_t s_maxHistorySize    = 10'000;
+    static constexpr size_t s_maxPendingRecords = 256 * 1024;
+
 private:
-    bool                                       m_enabled = true;
+    struct ThreadBuffer;
+
+    ThreadBuffer* threadBuffer();
+    //! Must be called with m_mergeLock held.
+    void merge();
+    //! Take the records of every thread, hand the completed events to the trace. Must be called with m_pumpLock held.
+    void pump();
+    //! Must be called with m_pumpLock and m_headersLock held.
+    void drain(ThreadBuffer& buffer, std::vector<TraceEvent>& trace);
+    //! Must be called with m_pumpLock held.
+    void releaseExitedThreads();
+    //! Forwards the scopes of Brigerad::Instrumentor to the trace.
+    static void traceInstrumentorScope(const Brigerad::ProfileResult& result);
+
+    std::atomic_bool                           m_enabled = true;
     std::map<std::thread::id, ProfilerDetails> m_events;
+    std::mutex                                 m_mergeLock;
 
-    std::function<bool(const ProfileEvent&, const ProfileEvent&)> m_sortFunction = sortByTotalTimeDesc;
+    std::mutex                   m_pumpLock;
+    std::unique_ptr<TraceWriter> m_trace;
+
+    std::mutex                                   m_headersLock;
+    std::deque<ProfileEventHeader>               m_headers; //! Indexed by ProfileEventId, deque for reference stability.
+    std::map<ProfileEventHeader, ProfileEventId> m_headerIds;
+
+    std::mutex                                 m_buffersLock;
+    std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;
 
-    static constexpr size_t s_maxHistorySize = 10'000;
+    std::function<bool(const ProfileEvent&, const ProfileEvent&)> m_sortFunction = sortByTotalTimeDesc;
 };
 
 class ProfileEventMarker {
 public:
-    ProfileEventMarker(std::string name, std::string source, int line)
-        : m_header{std::move(name), std::move(source), line}
+    explicit ProfileEventMarker(ProfileEventId id) : m_recorded(Profiler::get().reportCallEvent(id)) {}
+
+    ~ProfileEventMarker()
     {
-        Profiler::get().reportCallEvent(m_header);
+        if (m_recorded) { Profiler::get().reportReturnEvent(); }
     }
 
-    ~ProfileEventMarker() { Profiler::get().reportReturnEvent(m_header); }
+    ProfileEventMarker(const ProfileEventMarker&)            = delete;
+    ProfileEventMarker& operator=(const ProfileEventMarker&) = delete;
 
 private:
-    ProfileEventHeader m_header;
+    bool m_recorded;
 };
 } // namespace Frasy
 
@@ -241,11 +272,16 @@ private:
 #if defined(FRASY_PROFILE)
 /**
  * @brief Measure the execution time of the current scope.
+ * The header of the event is interned the first time the scope is entered.
  */
 #    define FRASY_PROFILE_SCOPE_NAME_HELPER(line) timer##line
 #    define FRASY_PROFILE_SCOPE_NAME(line)        FRASY_PROFILE_SCOPE_NAME_HELPER(line)
+#    define FRASY_PROFILE_SCOPE_ID_HELPER(line)   timerId##line
+#    define FRASY_PROFILE_SCOPE_ID(line)          FRASY_PROFILE_SCOPE_ID_HELPER(line)
 #    define FRASY_PROFILE_SCOPE(name)                                                                                  \
-        ::Frasy::ProfileEventMarker FRASY_PROFILE_SCOPE_NAME(__LINE__)(name, __FILE__, __LINE__)
+        static const ::Frasy::ProfileEventId FRASY_PROFILE_SCOPE_ID(__LINE__) =                                       \
+          ::Frasy::Profiler::get().intern(name, __FILE__, __LINE__);                                                   \
+        ::Frasy::ProfileEventMarker FRASY_PROFILE_SCOPE_NAME(__LINE__)(FRASY_PROFILE_SCOPE_ID(__LINE__))
 /**
  * @brief Measure the execution time of the current function.
  */
@@ -19,9 +19,14 @@
 
 #include "Brigerad/Core/Log.h"
 
+#include <algorithm>
+#include <filesystem>
 #include <format>
 #include <fstream>
 #include <json.hpp>
+#include <memory>
+#include <string_view>
+#include <vector>
 
 namespace Frasy::Lua
 {
@@ -29,83 +34,220 @@ namespace
 {
 using json = nlohmann::json;
 
-template<typename T>
-void AddToJson(json& j, sol::object key, sol::object value)    // NOLINT(performance-unnecessary-value-param)
+//! Output of the serializer, handed to the file in blocks rather than a character at a time.
+class FileWriter final : public nlohmann::detail::output_adapter_protocol<char>
 {
-    if (j.is_array()) { j += value.as<T>(); }
-    else { j[key.as<std::string>()] = value.as<T>(); }
-}
+public:
+    explicit FileWriter(const std::string& file) : m_file(file)
+    {
+        if (!m_file) { throw std::runtime_error(std::format("Unable to open '{}'", file)); }
+        m_buffer.reserve(s_bufferSize);
+    }
+
+    void write_character(char c) override
+    {
+        m_buffer.push_back(c);
+        if (m_buffer.size() >= s_bufferSize) { Flush(); }
+    }
+
+    void write_characters(const char* s, std::size_t length) override
+    {
+        m_buffer.append(s, length);
+        if (m_buffer.size() >= s_bufferSize) { Flush(); }
+    }
+
+    void Flush()
+    {
+        m_file.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+        m_buffer.clear();
+        if (!m_file) { throw std::runtime_error("Unable to write the file"); }
+    }
+
+private:
+    static constexpr std::size_t s_bufferSize = 64 * 1024;
+
+    std::ofstream m_file;
+    std::string   m_buffer;
+};
 
-json MakeJson(sol::table table)    // NOLINT(performance-unnecessary-value-param)
+/**
+ * Writes a Lua table as JSON while walking it, without building a nlohmann::json out of it first. The output is the
+ * same as json::dump(2) of that document: the keys of the objects are sorted, the strings and numbers are written by
+ * nlohmann's own serializer.
+ */
+class JsonWriter
 {
-    json      j;
-    sol::type key_type    = sol::type::none;
-    sol::type object_type = sol::type::none;
-    for (auto [key, value] : table)
+public:
+    JsonWriter(lua_State* lua, std::shared_ptr<FileWriter> output)
+    : m_lua(lua), m_output(output), m_serializer(std::move(output), ' ', nlohmann::detail::error_handler_t::replace)
     {
-        if (key_type == sol::type::none)
-        {
-            key_type = key.get_type();
-            if (key_type == sol::type::number) { j = json::array(); }
-            else if (key_type == sol::type::string) { j = json::object(); }
-            else
-            {
-                throw std::runtime_error(
-                  std::format("Invalid key, not a string nor a number. Type: {}", (int)key_type));
-            }
-        }
-        if (key.get_type() != key_type)
+    }
+
+    //! Writes the table at index of the stack, which is left as it was.
+    void WriteTable(int index, unsigned int indent)
+    {
+        index = lua_absindex(m_lua, index);
+        if (lua_checkstack(m_lua, 4) == 0) { throw std::runtime_error("Table is nested too deeply"); }
+
+        lua_pushnil(m_lua);
+        if (lua_next(m_lua, index) == 0)
         {
-            throw std::runtime_error(std::format(
-              "Key type has changed on same level. Expected: {}, Got: {}", (int)key_type, (int)key.get_type()));
+            // An empty table is neither an array nor an object.
+            Write("null");
+            return;
         }
-        if (key_type == sol::type::number)
+
+        // The type of the first key tells if it is an array or an object, the others must have the same.
+        const int keyType = lua_type(m_lua, -2);
+        if (keyType == LUA_TNUMBER) { WriteArray(index, indent); }
+        else if (keyType == LUA_TSTRING) { WriteObject(index, indent); }
+        else { throw std::runtime_error(std::format("Invalid key, not a string nor a number. Type: {}", keyType)); }
+    }
+
+private:
+    //! Writes the array at index, its first key and value being on the top of the stack.
+    void WriteArray(int index, unsigned int indent)
+    {
+        const int valueType = lua_type(m_lua, -1);
+        Write("[\n");
+        bool first = true;
+        do
         {
-            if (object_type == sol::type::none) { object_type = value.get_type(); }
-            if (object_type != value.get_type())
+            CheckKey(LUA_TNUMBER);
+            if (const int type = lua_type(m_lua, -1); type != valueType)
             {
                 throw std::runtime_error(std::format(
-                  "Object type has changed while in an array. Expected: {}, Got: {}",
-                  (int)key_type,
-                  (int)key.get_type()));
+                  "Object type has changed while in an array. Expected: {}, Got: {}", valueType, type));
             }
+            if (!first) { Write(",\n"); }
+            first = false;
+            WriteIndent(indent + 2);
+            WriteValue(-1, indent + 2);
+            lua_pop(m_lua, 1);
+        } while (lua_next(m_lua, index) != 0);
+        Write("\n");
+        WriteIndent(indent);
+        Write("]");
+    }
+
+    //! Writes the object at index, its first key and value being on the top of the stack.
+    void WriteObject(int index, unsigned int indent)
+    {
+        // nlohmann::json sorts the keys of its objects, they are gathered and sorted before any value is written. The
+        // strings belong to the table, they live as long as it does. The nested objects share the vector.
+        const std::size_t first = m_keys.size();
+        do
+        {
+            CheckKey(LUA_TSTRING);
+            std::size_t length = 0;
+            const char* key    = lua_tolstring(m_lua, -2, &length);
+            m_keys.emplace_back(key, length);
+            lua_pop(m_lua, 1);
+        } while (lua_next(m_lua, index) != 0);
+        const std::size_t last = m_keys.size();
+        std::sort(m_keys.begin() + static_cast<std::ptrdiff_t>(first), m_keys.end());
+
+        Write("{\n");
+        for (std::size_t i = first; i < last; ++i)
+        {
+            const std::string_view key = m_keys[i];
+            if (i != first) { Write(",\n"); }
+            WriteIndent(indent + 2);
+            WriteString(key);
+            Write(": ");
+            lua_pushlstring(m_lua, key.data(), key.size());
+            lua_rawget(m_lua, index);
+            WriteValue(-1, indent + 2);
+            lua_pop(m_lua, 1);
         }
-        switch (value.get_type())
+        Write("\n");
+        WriteIndent(indent);
+        Write("}");
+        m_keys.resize(first);
+    }
+
+    void WriteValue(int index, unsigned int indent)
+    {
+        switch (const int type = lua_type(m_lua, index); type)
         {
-            case sol::type::string: AddToJson<std::string>(j, key, value); break;
-            case sol::type::number: AddToJson<double>(j, key, value); break;
-            case sol::type::boolean: AddToJson<bool>(j, key, value); break;
-            case sol::type::table:
-            case sol::type::userdata:
-            case sol::type::lightuserdata:
+            case LUA_TSTRING:
             {
-                if (j.is_array()) { j += MakeJson(value); }
-                else { j[key.as<std::string>()] = MakeJson(value); }
+                std::size_t length = 0;
+                const char* value  = lua_tolstring(m_lua, index, &length);
+                WriteString({value, length});
                 break;
             }
-            case sol::type::thread:
-            case sol::type::poly:
-            case sol::type::function:
-            case sol::type::none:
-            case sol::type::lua_nil:
-                throw std::runtime_error("Object is not jsonable. Type: " + std::to_string((int)value.get_type()));
+            case LUA_TNUMBER:
+                m_number.get_ref<json::number_float_t&>() = lua_tonumber(m_lua, index);
+                m_serializer.dump(m_number, false, false, 0);
+                break;
+            case LUA_TBOOLEAN: Write(lua_toboolean(m_lua, index) != 0 ? "true" : "false"); break;
+            case LUA_TTABLE: WriteTable(index, indent); break;
+            default: throw std::runtime_error("Object is not jsonable. Type: " + std::to_string(type));
         }
     }
-    return j;
-}
+
+    //! Throws if the key below the value on the top of the stack isn't of the type of the first one.
+    void CheckKey(int expected)
+    {
+        if (const int type = lua_type(m_lua, -2); type != expected)
+        {
+            throw std::runtime_error(
+              std::format("Key type has changed on same level. Expected: {}, Got: {}", expected, type));
+        }
+    }
+
+    void WriteString(std::string_view str)
+    {
+        m_string.get_ref<json::string_t&>().assign(str);
+        m_serializer.dump(m_string, false, false, 0);
+    }
+
+    void WriteIndent(unsigned int indent)
+    {
+        if (m_indent.size() < indent) { m_indent.resize(static_cast<std::size_t>(indent) * 2, ' '); }
+        m_output->write_characters(m_indent.data(), indent);
+    }
+
+    void Write(std::string_view str) { m_output->write_characters(str.data(), str.size()); }
+
+    lua_State*                         m_lua;
+    std::shared_ptr<FileWriter>        m_output;
+    nlohmann::detail::serializer<json> m_serializer;
+    json                               m_string = json::string_t {};
+    json                               m_number = json::number_float_t {};
+    std::string                        m_indent;
+    std::vector<std::string_view>      m_keys;    //!< Keys of the objects being written, innermost last.
+};
 }    // namespace
 
 void SaveAsJson(sol::table table, const std::string& file)
 {
+    // The file is written next to its destination and only replaces it once complete, nothing is left behind if the
+    // table can't be saved.
+    lua_State*        lua       = table.lua_state();
+    const int         top       = lua_gettop(lua);
+    const std::string temporary = file + ".tmp";
     try
     {
-        json          object = MakeJson(table); // NOLINT(performance-unnecessary-value-param)
-        std::ofstream o      = std::ofstream(file);
-        o << object.dump(2, ' ', false, nlohmann::detail::error_handler_t::replace);
-        o.close();
+        {
+            auto output = std::make_shared<FileWriter>(temporary);
+            table.push();
+            if (lua_type(lua, -1) != LUA_TTABLE)
+            {
+                throw std::runtime_error("Object is not jsonable. Type: " + std::to_string(lua_type(lua, -1)));
+            }
+            JsonWriter(lua, output).WriteTable(-1, 0);
+            output->Flush();
+        }
+        lua_settop(lua, top);
+        std::filesystem::rename(temporary, file);
     }
     catch (const std::runtime_error& e)
     {
+        lua_settop(lua, top);
+        std::error_code ec;
+        std::filesystem::remove(temporary, ec);
         BR_LUA_ERROR("Failed to save table as json. Reason: {}", e.what());
     }
 }
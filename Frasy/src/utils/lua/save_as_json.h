@@ -21,6 +21,12 @@
 
 namespace Frasy::Lua {
 
+/**
+ * Writes a table to file as indented JSON. Tables indexed by numbers are arrays, tables indexed by strings are objects,
+ * with their keys sorted. An empty table is written as null.
+ *
+ * Errors, like a table mixing key types or holding a function, are logged and leave the file untouched.
+ */
 void SaveAsJson(sol::table table, const std::string& file);
 
 }
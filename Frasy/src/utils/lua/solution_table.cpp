@@ -0,0 +1,221 @@
+/**
+ * @file    solution_table.cpp
+ * @author  Frasy
+ * @date    2026-10-16
+ * @brief   Lua side of the solution: conversion to and from Models::Solution, and the solver bindings.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <https://www.gnu.org/licenses/>.
+ */
+#include "solution_table.h"
+
+#include "utils/lua/profile_events.h"
+#include "utils/models/solver.h"
+
+#include <format>
+
+namespace Frasy::Lua {
+namespace {
+template<typename T>
+T GetField(const sol::table& table, const auto& key, sol::type expected, std::string_view what)
+{
+    sol::object object = table.raw_get<sol::object>(key);
+    if (object.get_type() != expected) {
+        throw sol::error(sol::detail::direct_error,
+                         std::format("Invalid solution: {} is a {}, expected a {}",
+                                     what,
+                                     sol::type_name(table.lua_state(), object.get_type()),
+                                     sol::type_name(table.lua_state(), expected)));
+    }
+    return object.as<T>();
+}
+
+sol::table GetTable(const sol::table& table, const auto& key, std::string_view what)
+{ return GetField<sol::table>(table, key, sol::type::table, what); }
+
+std::string GetString(const sol::table& table, const auto& key, std::string_view what)
+{ return GetField<std::string>(table, key, sol::type::string, what); }
+
+template<typename T, typename Fill>
+sol::table MakeArray(sol::state_view lua, const std::vector<T>& items, Fill&& fill)
+{
+    auto array = lua.create_table(static_cast<int>(items.size()), 0);
+    for (std::size_t i = 0; i < items.size(); ++i) {
+        array.raw_set(i + 1, fill(items[i]));
+    }
+    return array;
+}
+
+std::vector<std::string> ToStrings(const sol::table& table)
+{
+    std::vector<std::string> strings;
+    strings.reserve(table.size());
+    for (std::size_t i = 1; i <= table.size(); ++i) {
+        strings.push_back(GetString(table, i, "scope"));
+    }
+    return strings;
+}
+
+Models::Solver::Layers ToLayers(const sol::table& table)
+{
+    Models::Solver::Layers layers;
+    layers.reserve(table.size());
+    for (std::size_t i = 1; i <= table.size(); ++i) {
+        layers.push_back(ToStrings(GetTable(table, i, "layer")));
+    }
+    return layers;
+}
+
+Models::Solver::Sections ToSections(const sol::table& table)
+{
+    Models::Solver::Sections sections;
+    sections.reserve(table.size());
+    for (std::size_t i = 1; i <= table.size(); ++i) {
+        sections.push_back(ToLayers(GetTable(table, i, "section")));
+    }
+    return sections;
+}
+
+/// Keys of a table used as a set, i.e. {name = true}.
+std::vector<std::string> Keys(const sol::optional<sol::table>& table)
+{
+    std::vector<std::string> keys;
+    if (!table.has_value()) { return keys; }
+    for (auto&& [key, value] : *table) {
+        if (key.get_type() == sol::type::string) { keys.push_back(key.as<std::string>()); }
+    }
+    return keys;
+}
+
+sol::table FromLayers(sol::state_view lua, const Models::Solver::Layers& layers)
+{
+    return MakeArray(lua, layers, [&](const Models::Solver::Layer& layer) {
+        return MakeArray(lua, layer, [](const std::string& scope) { return scope; });
+    });
+}
+}    // namespace
+
+// Solution
+// - Section
+// - - Section stage
+// - - - Sequence (Actually a subsequence)
+// - - - - Sequence name
+// - - - - Sequence stage
+// - - - - - Test
+Models::Solution SolutionFromTable(const sol::table& table)
+{
+    FRASY_PROFILE_FUNCTION();
+    Models::Solution solution;
+    solution.sections.reserve(table.size());
+    for (std::size_t iSc = 1; iSc <= table.size(); ++iSc) {
+        auto  gSc = GetTable(table, iSc, "section");
+        auto& sc  = solution.sections.emplace_back();
+        sc.reserve(gSc.size());
+        for (std::size_t iScS = 1; iScS <= gSc.size(); ++iScS) {
+            auto  gScS = GetTable(gSc, iScS, "section stage");
+            auto& scs  = sc.emplace_back();
+            scs.reserve(gScS.size());
+            for (std::size_t iSq = 1; iSq <= gScS.size(); ++iSq) {
+                auto  gSq    = GetTable(gScS, iSq, "sequence");
+                auto  gTests = GetTable(gSq, "tests", "sequence tests");
+                auto& sq     = scs.emplace_back();
+                sq.first     = GetString(gSq, "name", "sequence name");
+                sq.second.reserve(gTests.size());
+                auto& sequence = solution.sequences[sq.first];
+                for (std::size_t iSqS = 1; iSqS <= gTests.size(); ++iSqS) {
+                    auto  gSqS = GetTable(gTests, iSqS, "sequence stage");
+                    auto& sqs  = sq.second.emplace_back();
+                    sqs.reserve(gSqS.size());
+                    for (std::size_t iT = 1; iT <= gSqS.size(); ++iT) {
+                        auto& test = sqs.emplace_back(GetString(gSqS, iT, "test name"));
+                        sequence.tests.try_emplace(test);
+                    }
+                }
+            }
+        }
+    }
+    return solution;
+}
+
+sol::table SolutionToTable(sol::state_view lua, const Models::Solution& solution)
+{
+    FRASY_PROFILE_FUNCTION();
+    return MakeArray(lua, solution.sections, [&](const Models::Solution::section& section) {
+        return MakeArray(lua, section, [&](const std::vector<Models::Solution::subsequence>& stage) {
+            return MakeArray(lua, stage, [&](const Models::Solution::subsequence& sequence) {
+                auto tests = MakeArray(lua, sequence.second, [&](const std::vector<std::string>& testStage) {
+                    return MakeArray(lua, testStage, [](const std::string& test) { return test; });
+                });
+                auto table = lua.create_table(0, 2);
+                table.raw_set("name", sequence.first, "tests", tests);
+                return table;
+            });
+        });
+    });
+}
+
+void ImportSolver(sol::state_view lua)
+{
+    auto solver = lua.create_named_table("__solver");
+
+    solver["SortScopes"] = [](sol::this_state                   state,
+                              const sol::table&                 scopes,
+                              const sol::optional<std::string>& first,
+                              const sol::optional<std::string>& last,
+                              const sol::optional<sol::table>&  requirements) -> std::tuple<sol::object, sol::object> {
+        FRASY_PROFILE_FUNCTION();
+        sol::state_view lua {state};
+        try {
+            Models::Solver::Dependencies dependencies;
+            if (requirements.has_value()) {
+                for (auto&& [name, scopeRequirements] : *requirements) {
+                    if (name.get_type() != sol::type::string || scopeRequirements.get_type() != sol::type::table) {
+                        continue;
+                    }
+                    dependencies[name.as<std::string>()] = Keys(scopeRequirements.as<sol::table>());
+                }
+            }
+            auto layers = Models::Solver::SortScopes(ToStrings(scopes),
+                                                     first ? std::optional {*first} : std::nullopt,
+                                                     last ? std::optional {*last} : std::nullopt,
+                                                     dependencies);
+            return {FromLayers(lua, layers), sol::lua_nil};
+        }
+        catch (const Models::Solver::InvalidRequirement& e) {
+            return {sol::lua_nil, sol::make_object(lua, e.what())};
+        }
+    };
+
+    solver["Sectionize"] = [](sol::this_state                  state,
+                              const sol::table&                stages,
+                              const sol::optional<sol::table>& requirements) {
+        FRASY_PROFILE_FUNCTION();
+        sol::state_view lua {state};
+        auto            synchronized = Keys(requirements);
+        auto            sections     = Models::Solver::Sectionize(
+          ToLayers(stages), std::unordered_set<std::string>(synchronized.begin(), synchronized.end()));
+        return MakeArray(lua, sections, [&](const Models::Solver::Layers& section) { return FromLayers(lua, section); });
+    };
+
+    solver["CombineSectionized"] = [](sol::this_state   state,
+                                      const sol::table& sectionizedSequences,
+                                      const sol::table& sectionizedTests) {
+        FRASY_PROFILE_FUNCTION();
+        std::unordered_map<std::string, Models::Solver::Sections> tests;
+        for (auto&& [sequence, sections] : sectionizedTests) {
+            if (sequence.get_type() != sol::type::string || sections.get_type() != sol::type::table) { continue; }
+            tests[sequence.as<std::string>()] = ToSections(sections.as<sol::table>());
+        }
+        Models::Solution solution;
+        solution.sections = Models::Solver::CombineSectionized(ToSections(sectionizedSequences), tests);
+        return SolutionToTable(state, solution);
+    };
+}
+}    // namespace Frasy::Lua
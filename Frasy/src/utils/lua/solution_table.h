@@ -0,0 +1,58 @@
+/**
+ * @file    solution_table.h
+ * @author  Frasy
+ * @date    2026-10-16
+ * @brief   Lua side of the solution: conversion to and from Models::Solution, and the solver bindings.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef FRASY_UTILS_LUA_SOLUTION_TABLE_H
+#define FRASY_UTILS_LUA_SOLUTION_TABLE_H
+
+#include "utils/models/solution.h"
+
+#include <sol/sol.hpp>
+
+namespace Frasy::Lua {
+/**
+ * Build a solution from the table returned by Orchestrator.Generate().
+ *
+ * The table has the layout of Context.orchestrator.solution:
+ * section[] -> section stage[] -> {name = sequence, tests = sequence stage[] -> test[]}
+ *
+ * @param table Solution, as generated in Lua.
+ * @return The solution, with every sequence and test of the table registered in Solution::sequences.
+ * @throws sol::error if the table doesn't have the expected layout.
+ */
+Models::Solution SolutionFromTable(const sol::table& table);
+
+/**
+ * Build the Lua representation of a solution, as expected by Orchestrator.SetSolution().
+ * Only the sections are converted, the enable state of the sequences and tests is managed on the C++ side.
+ *
+ * @param lua State to create the table in.
+ * @param solution Solution to convert.
+ * @return A brand new table, owned by @p lua.
+ */
+sol::table SolutionToTable(sol::state_view lua, const Models::Solution& solution);
+
+/**
+ * Expose Models::Solver to Lua, as the __solver table used by sort_utils.lua.
+ *
+ * Each function takes and returns the tables of its Sort counterpart. On an invalid requirement, SortScopes returns
+ * nil and the error message instead, so that the caller can raise the appropriate Lua exception.
+ *
+ * @param lua State to register the functions in.
+ */
+void ImportSolver(sol::state_view lua);
+}    // namespace Frasy::Lua
+
+#endif    // FRASY_UTILS_LUA_SOLUTION_TABLE_H
@@ -0,0 +1,153 @@
+/**
+ * @file    trace_writer.cpp
+ * @author  Frasy
+ * @date    2026-10-16
+ * @brief   Writes the profile events to a Chrome trace file, in the background.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <https://www.gnu.org/licenses/>.
+ */
+#include "trace_writer.h"
+
+#include <format>
+#include <iterator>
+#include <stdexcept>
+
+namespace Frasy {
+namespace {
+void AppendEscaped(std::string& out, std::string_view str)
+{
+    for (char c : str) {
+        switch (c) {
+            case '"': out += R"(\")"; break;
+            case '\\': out += R"(\\)"; break;
+            case '\n': out += R"(\n)"; break;
+            case '\t': out += R"(\t)"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    std::format_to(std::back_inserter(out), "\\u{:04x}", static_cast<unsigned char>(c));
+                }
+                else {
+                    out += c;
+                }
+                break;
+        }
+    }
+}
+
+//! Trace timestamps are in microseconds, the fractional part keeps the resolution of the clock.
+void AppendMicroseconds(std::string& out, std::int64_t ns)
+{
+    if (ns < 0) {
+        out += '-';
+        ns = -ns;
+    }
+    std::format_to(std::back_inserter(out), "{}.{:03}", ns / 1000, ns % 1000);
+}
+}    // namespace
+
+TraceWriter::TraceWriter(const std::filesystem::path& path, Collect collect)
+: m_output(path, std::ios::binary), m_collect(std::move(collect))
+{
+    if (!m_output.is_open()) { throw std::runtime_error(std::format("Unable to open '{}'", path.string())); }
+    m_output << R"({"displayTimeUnit":"ms","traceEvents":[)"
+             << "\n"
+             << R"({"name":"process_name","ph":"M","pid":0,"tid":0,"args":{"name":"Frasy"}})";
+    m_thread = std::jthread([this](std::stop_token stop) { run(std::move(stop)); });
+}
+
+TraceWriter::~TraceWriter()
+{
+    m_thread.request_stop();
+    m_thread.join();
+    flush();
+    m_output << "\n]}\n";
+}
+
+void TraceWriter::write(std::vector<TraceEvent>&& events)
+{
+    std::lock_guard lock {m_lock};
+    if (m_pending.empty()) { m_pending = std::move(events); }
+    else {
+        m_pending.insert(m_pending.end(), events.begin(), events.end());
+    }
+}
+
+void TraceWriter::write(const TraceEvent& event)
+{
+    std::lock_guard lock {m_lock};
+    m_pending.push_back(event);
+}
+
+void TraceWriter::nameThread(std::uint32_t threadId, std::string_view name)
+{
+    std::lock_guard lock {m_lock};
+    if (m_namedThreads.insert(threadId).second) { m_pendingNames.emplace_back(threadId, name); }
+}
+
+std::string_view TraceWriter::intern(std::string_view str)
+{
+    std::lock_guard lock {m_lock};
+    auto            it = m_strings.find(str);
+    if (it == m_strings.end()) { it = m_strings.emplace(str).first; }
+    return *it;
+}
+
+void TraceWriter::run(std::stop_token stop)
+{
+    while (!stop.stop_requested()) {
+        {
+            std::unique_lock lock {m_lock};
+            m_wakeUp.wait_for(lock, stop, s_period, [] { return false; });
+        }
+        if (stop.stop_requested()) { break; }
+        m_collect();
+        flush();
+    }
+}
+
+void TraceWriter::flush()
+{
+    std::vector<TraceEvent>                            events;
+    std::vector<std::pair<std::uint32_t, std::string>> names;
+    {
+        std::lock_guard lock {m_lock};
+        events.swap(m_pending);
+        names.swap(m_pendingNames);
+    }
+    if (events.empty() && names.empty()) { return; }
+
+    m_buffer.clear();
+    for (const auto& [threadId, name] : names) {
+        std::format_to(std::back_inserter(m_buffer),
+                       ",\n" R"({{"name":"thread_name","ph":"M","pid":0,"tid":{},"args":{{"name":")",
+                       threadId);
+        AppendEscaped(m_buffer, name);
+        m_buffer += R"("}})";
+    }
+    for (const auto& event : events) {
+        m_buffer += ",\n" R"({"name":")";
+        AppendEscaped(m_buffer, event.name);
+        m_buffer += R"(","cat":")";
+        AppendEscaped(m_buffer, event.category);
+        std::format_to(std::back_inserter(m_buffer), R"(","ph":"X","pid":0,"tid":{},"ts":)", event.threadId);
+        AppendMicroseconds(m_buffer, event.start);
+        m_buffer += R"(,"dur":)";
+        AppendMicroseconds(m_buffer, event.duration);
+        if (!event.source.empty()) {
+            m_buffer += R"(,"args":{"source":")";
+            AppendEscaped(m_buffer, event.source);
+            std::format_to(std::back_inserter(m_buffer), R"(","line":{}}})", event.line);
+        }
+        m_buffer += '}';
+    }
+    m_output.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+}
+}    // namespace Frasy
@@ -0,0 +1,108 @@
+/**
+ * @file    trace_writer.h
+ * @author  Frasy
+ * @date    2026-10-16
+ * @brief   Writes the profile events to a Chrome trace file, in the background.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef FRASY_UTILS_LUA_TRACE_WRITER_H
+#define FRASY_UTILS_LUA_TRACE_WRITER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace Frasy {
+/**
+ * Completed scope, as shown on the timeline of its thread.
+ * The strings must outlive the writer, see TraceWriter::intern for the ones that don't.
+ */
+struct TraceEvent {
+    std::string_view name;
+    std::string_view category;
+    std::string_view source;
+    int              line     = 0;
+    std::uint32_t    threadId = 0;
+    std::int64_t     start    = 0;    //! Nanoseconds, on the steady clock.
+    std::int64_t     duration = 0;    //! Nanoseconds.
+};
+
+/**
+ * Writes events to a file in the Chrome trace event format, which chrome://tracing and https://ui.perfetto.dev open.
+ *
+ * Events are queued by batches and formatted by a thread of the writer, which also calls the collect function
+ * every s_period so that the sources of events can hand their batches over. The file is completed when the writer is
+ * destroyed.
+ */
+class TraceWriter {
+public:
+    using Collect = std::function<void()>;
+
+    /**
+     * @throws std::runtime_error if the file can't be opened.
+     */
+    TraceWriter(const std::filesystem::path& path, Collect collect);
+    ~TraceWriter();
+    TraceWriter(const TraceWriter&)            = delete;
+    TraceWriter& operator=(const TraceWriter&) = delete;
+
+    void write(std::vector<TraceEvent>&& events);
+    void write(const TraceEvent& event);
+    //! Name shown for the timeline of a thread, only the first name given to a thread is kept.
+    void nameThread(std::uint32_t threadId, std::string_view name);
+    //! Copy of a string that lives as long as the writer.
+    std::string_view intern(std::string_view str);
+
+    //! Identifier of a thread in the trace, the same one Brigerad::Instrumentor uses.
+    static std::uint32_t threadId(std::thread::id id)
+    {
+        return static_cast<std::uint32_t>(std::hash<std::thread::id> {}(id));
+    }
+
+    static constexpr std::chrono::milliseconds s_period {100};
+
+private:
+    struct StringHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view str) const { return std::hash<std::string_view> {}(str); }
+    };
+
+    void run(std::stop_token stop);
+    //! Format and write everything that was queued so far.
+    void flush();
+
+    std::ofstream m_output;
+    std::string   m_buffer;
+    Collect       m_collect;
+
+    std::mutex                                                   m_lock;
+    std::condition_variable_any                                  m_wakeUp;
+    std::vector<TraceEvent>                                      m_pending;
+    std::vector<std::pair<std::uint32_t, std::string>>           m_pendingNames;
+    std::unordered_set<std::uint32_t>                            m_namedThreads;
+    std::unordered_set<std::string, StringHash, std::equal_to<>> m_strings; //! Node based, the views stay valid.
+
+    std::jthread m_thread;
+};
+}    // namespace Frasy
+
+#endif    // FRASY_UTILS_LUA_TRACE_WRITER_H
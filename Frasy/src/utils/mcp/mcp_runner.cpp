@@ -551,7 +551,7 @@ nlohmann::json McpRunner::handleUploadSdo(const nlohmann::json& args)
     auto& node = maybeNode.value();
     auto* sdo  = node->sdoInterface();
 
-    auto request = sdo->uploadData(index, subIndex, 500, 3, false, varType);
+    auto request = sdo->uploadData(index, subIndex, 500, 3, CanOpen::SdoTransferMode::Auto, varType);
 
     auto result = request.future.get();
     if (request.status() != CanOpen::SdoRequestStatus::Complete &&
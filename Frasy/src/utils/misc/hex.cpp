@@ -0,0 +1,314 @@
+/**
+ * @file    hex.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <https://www.gnu.org/licenses/>.
+ */
+#include "hex.h"
+
+#include <bit>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#    define FRASY_HEX_X86 1
+#    include <immintrin.h>
+#    if defined(_MSC_VER)
+#        include <intrin.h>
+#    endif
+#else
+#    define FRASY_HEX_X86 0
+#endif
+
+// MSVC compiles any intrinsic, GCC and Clang only the ones of the target of the function.
+#if FRASY_HEX_X86 && (defined(__GNUC__) || defined(__clang__))
+#    define FRASY_TARGET_SSSE3 __attribute__((target("ssse3")))
+#    define FRASY_TARGET_AVX2  __attribute__((target("avx2")))
+#else
+#    define FRASY_TARGET_SSSE3
+#    define FRASY_TARGET_AVX2
+#endif
+
+namespace Frasy::Hex {
+namespace {
+constexpr std::array<std::array<uint8_t, 2>, 256> s_pairs = [] {
+    std::array<std::array<uint8_t, 2>, 256> pairs = {};
+    for (std::size_t i = 0; i < pairs.size(); ++i) {
+        pairs[i] = {s_digits[i >> 4], s_digits[i & 0xF]};
+    }
+    return pairs;
+}();
+
+void encodeScalar(const uint8_t* bytes, std::size_t count, uint8_t* chars)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto& pair = s_pairs[bytes[i]];
+        chars[2 * i]     = pair[0];
+        chars[2 * i + 1] = pair[1];
+    }
+}
+
+bool decodeScalar(const uint8_t* chars, std::size_t count, uint8_t* bytes)
+{
+    // The invalid value is the only one with high bits, they are checked once at the end.
+    uint8_t seen = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const uint8_t high = s_nibbleValues[chars[2 * i]];
+        const uint8_t low  = s_nibbleValues[chars[2 * i + 1]];
+        seen |= high | low;
+        bytes[i] = static_cast<uint8_t>((high << 4) | (low & 0xF));
+    }
+    return (seen & 0xF0) == 0;
+}
+
+std::size_t findNonHexScalar(const uint8_t* chars, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        if (s_nibbleValues[chars[i]] == s_invalidNibble) { return i; }
+    }
+    return count;
+}
+
+#if FRASY_HEX_X86
+/* The characters are turned into their values, along with a mask of the valid ones:
+ *   - digits: c - '0' <= 9
+ *   - letters: (c | 0x20) - 'a' <= 5, setting bit 5 folds the uppercase letters onto the lowercase ones.
+ * The unsigned comparisons are done as min(x, limit) == x. */
+FRASY_TARGET_SSSE3 inline __m128i nibbles128(__m128i chars, __m128i& valid)
+{
+    const __m128i digit    = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+    const __m128i letter   = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    const __m128i isDigit  = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+    const __m128i isLetter = _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(5)), letter);
+    valid                  = _mm_or_si128(isDigit, isLetter);
+    return _mm_or_si128(_mm_and_si128(isDigit, digit),
+                        _mm_and_si128(isLetter, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+}
+
+FRASY_TARGET_SSSE3 inline __m128i digits128(__m128i nibbles)
+{
+    const __m128i digits = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F');
+    return _mm_shuffle_epi8(digits, nibbles);
+}
+
+FRASY_TARGET_SSSE3 void encodeSsse3(const uint8_t* bytes, std::size_t count, uint8_t* chars)
+{
+    const __m128i mask = _mm_set1_epi8(0x0F);
+    std::size_t   i    = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m128i in   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + i));
+        const __m128i high = _mm_and_si128(_mm_srli_epi16(in, 4), mask);
+        const __m128i low  = _mm_and_si128(in, mask);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(chars + 2 * i), digits128(_mm_unpacklo_epi8(high, low)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(chars + 2 * i + 16), digits128(_mm_unpackhi_epi8(high, low)));
+    }
+    // The data of a CAN frame.
+    if (i + 8 <= count) {
+        const __m128i in   = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(bytes + i));
+        const __m128i high = _mm_and_si128(_mm_srli_epi16(in, 4), mask);
+        const __m128i low  = _mm_and_si128(in, mask);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(chars + 2 * i), digits128(_mm_unpacklo_epi8(high, low)));
+        i += 8;
+    }
+    encodeScalar(bytes + i, count - i, chars + 2 * i);
+}
+
+FRASY_TARGET_SSSE3 bool decodeSsse3(const uint8_t* chars, std::size_t count, uint8_t* bytes)
+{
+    // Each pair of nibbles is summed as high * 16 + low.
+    const __m128i weights = _mm_set1_epi16(0x0110);
+    __m128i       valid   = _mm_set1_epi8(-1);
+    std::size_t   i       = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i       isValid;
+        const __m128i nibbles = nibbles128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(chars + 2 * i)), isValid);
+        const __m128i values  = _mm_maddubs_epi16(nibbles, weights);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(bytes + i), _mm_packus_epi16(values, values));
+        valid = _mm_and_si128(valid, isValid);
+    }
+    return _mm_movemask_epi8(valid) == 0xFFFF && decodeScalar(chars + 2 * i, count - i, bytes + i);
+}
+
+FRASY_TARGET_SSSE3 std::size_t findNonHexSsse3(const uint8_t* chars, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i valid;
+        nibbles128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(chars + i)), valid);
+        const auto invalid = static_cast<unsigned>(~_mm_movemask_epi8(valid)) & 0xFFFF;
+        if (invalid != 0) { return i + std::countr_zero(invalid); }
+    }
+    return i + findNonHexScalar(chars + i, count - i);
+}
+
+/* The SSSE3 functions handle what doesn't fill a 256 bits register, like the frames of the SLCAN adapters. They aren't
+ * VEX encoded when built with GCC or Clang, running them with the upper halves of the registers dirty costs more than
+ * the AVX2 loop saves. */
+FRASY_TARGET_AVX2 inline void zeroUpper()
+{
+    _mm256_zeroupper();
+}
+
+FRASY_TARGET_AVX2 inline __m256i nibbles256(__m256i chars, __m256i& valid)
+{
+    const __m256i digit    = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+    const __m256i letter   = _mm256_sub_epi8(_mm256_or_si256(chars, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    const __m256i isDigit  = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+    const __m256i isLetter = _mm256_cmpeq_epi8(_mm256_min_epu8(letter, _mm256_set1_epi8(5)), letter);
+    valid                  = _mm256_or_si256(isDigit, isLetter);
+    return _mm256_or_si256(_mm256_and_si256(isDigit, digit),
+                           _mm256_and_si256(isLetter, _mm256_add_epi8(letter, _mm256_set1_epi8(10))));
+}
+
+FRASY_TARGET_AVX2 void encodeAvx2(const uint8_t* bytes, std::size_t count, uint8_t* chars)
+{
+    if (count < 32) {
+        encodeSsse3(bytes, count, chars);
+        return;
+    }
+    const __m256i mask   = _mm256_set1_epi8(0x0F);
+    const __m256i digits = _mm256_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E',
+                                            'F', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D',
+                                            'E', 'F');
+    std::size_t   i      = 0;
+    for (; i + 32 <= count; i += 32) {
+        const __m256i in   = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + i));
+        const __m256i high = _mm256_and_si256(_mm256_srli_epi16(in, 4), mask);
+        const __m256i low  = _mm256_and_si256(in, mask);
+        // The unpacks work within each 128 bits lane: bytes 0-7 and 16-23, then 8-15 and 24-31.
+        const __m256i first  = _mm256_shuffle_epi8(digits, _mm256_unpacklo_epi8(high, low));
+        const __m256i second = _mm256_shuffle_epi8(digits, _mm256_unpackhi_epi8(high, low));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(chars + 2 * i), _mm256_permute2x128_si256(first, second, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(chars + 2 * i + 32),
+                            _mm256_permute2x128_si256(first, second, 0x31));
+    }
+    zeroUpper();
+    encodeSsse3(bytes + i, count - i, chars + 2 * i);
+}
+
+FRASY_TARGET_AVX2 bool decodeAvx2(const uint8_t* chars, std::size_t count, uint8_t* bytes)
+{
+    if (count < 16) { return decodeSsse3(chars, count, bytes); }
+    const __m256i weights = _mm256_set1_epi16(0x0110);
+    __m256i       valid   = _mm256_set1_epi8(-1);
+    std::size_t   i       = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256i       isValid;
+        const __m256i nibbles =
+          nibbles256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(chars + 2 * i)), isValid);
+        const __m256i values = _mm256_maddubs_epi16(nibbles, weights);
+        // The packed bytes are in the low half of each lane.
+        const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(values, values), 0b11'01'10'00);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(bytes + i), _mm256_castsi256_si128(packed));
+        valid = _mm256_and_si256(valid, isValid);
+    }
+    const bool isValid = _mm256_movemask_epi8(valid) == -1;
+    zeroUpper();
+    return isValid && decodeSsse3(chars + 2 * i, count - i, bytes + i);
+}
+
+FRASY_TARGET_AVX2 std::size_t findNonHexAvx2(const uint8_t* chars, std::size_t count)
+{
+    if (count < 32) { return findNonHexSsse3(chars, count); }
+    std::size_t i = 0;
+    for (; i + 32 <= count; i += 32) {
+        __m256i valid;
+        nibbles256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(chars + i)), valid);
+        const auto invalid = ~static_cast<uint32_t>(_mm256_movemask_epi8(valid));
+        if (invalid != 0) { return i + std::countr_zero(invalid); }
+    }
+    zeroUpper();
+    return i + findNonHexSsse3(chars + i, count - i);
+}
+
+Isa detectIsa()
+{
+#    if defined(_MSC_VER) && !defined(__clang__)
+    int info[4] = {};
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+    __cpuid(info, 1);
+    const bool ssse3   = (info[2] & (1 << 9)) != 0;
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx     = (info[2] & (1 << 28)) != 0;
+    bool       avx2    = false;
+    // The OS must also save the AVX registers.
+    if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6) {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) != 0;
+    }
+#    else
+    __builtin_cpu_init();
+    const bool ssse3 = __builtin_cpu_supports("ssse3") != 0;
+    const bool avx2  = __builtin_cpu_supports("avx2") != 0;
+#    endif
+    if (avx2) { return Isa::Avx2; }
+    if (ssse3) { return Isa::Ssse3; }
+    return Isa::Scalar;
+}
+#else
+Isa detectIsa()
+{
+    return Isa::Scalar;
+}
+#endif
+}    // namespace
+
+bool isSupported(Isa isa)
+{
+    return static_cast<int>(isa) <= static_cast<int>(bestIsa());
+}
+
+Isa bestIsa()
+{
+    static const Isa s_best = detectIsa();
+    return s_best;
+}
+
+void encode(const uint8_t* bytes, std::size_t count, uint8_t* chars, Isa isa)
+{
+#if FRASY_HEX_X86
+    switch (isa) {
+        case Isa::Avx2: encodeAvx2(bytes, count, chars); return;
+        case Isa::Ssse3: encodeSsse3(bytes, count, chars); return;
+        case Isa::Scalar:
+        default: break;
+    }
+#endif
+    encodeScalar(bytes, count, chars);
+}
+
+bool decode(const uint8_t* chars, std::size_t count, uint8_t* bytes, Isa isa)
+{
+#if FRASY_HEX_X86
+    switch (isa) {
+        case Isa::Avx2: return decodeAvx2(chars, count, bytes);
+        case Isa::Ssse3: return decodeSsse3(chars, count, bytes);
+        case Isa::Scalar:
+        default: break;
+    }
+#endif
+    return decodeScalar(chars, count, bytes);
+}
+
+std::size_t findNonHex(const uint8_t* chars, std::size_t count, Isa isa)
+{
+#if FRASY_HEX_X86
+    switch (isa) {
+        case Isa::Avx2: return findNonHexAvx2(chars, count);
+        case Isa::Ssse3: return findNonHexSsse3(chars, count);
+        case Isa::Scalar:
+        default: break;
+    }
+#endif
+    return findNonHexScalar(chars, count);
+}
+}    // namespace Frasy::Hex
@@ -0,0 +1,76 @@
+/**
+ * @file    hex.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Conversions between bytes and ASCII hexadecimal, shared by the SLCAN and serial packet codecs.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef FRASY_UTILS_MISC_HEX_H
+#define FRASY_UTILS_MISC_HEX_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace Frasy::Hex {
+static constexpr uint8_t s_invalidNibble = 0xFF;
+
+//! Value of each hexadecimal character (either case), s_invalidNibble for the others.
+inline constexpr std::array<uint8_t, 256> s_nibbleValues = [] {
+    std::array<uint8_t, 256> values = {};
+    values.fill(s_invalidNibble);
+    for (uint8_t i = 0; i < 10; ++i) {
+        values['0' + i] = i;
+    }
+    for (uint8_t i = 0; i < 6; ++i) {
+        values['A' + i] = 10 + i;
+        values['a' + i] = 10 + i;
+    }
+    return values;
+}();
+
+inline constexpr std::array<uint8_t, 16> s_digits = {
+  '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'};
+
+/**
+ * Instruction sets the conversions can use. The best one the CPU supports is picked at run time, the others are there
+ * for the tests and the benchmarks.
+ */
+enum class Isa {
+    Scalar,
+    Ssse3,
+    Avx2,
+};
+
+[[nodiscard]] bool isSupported(Isa isa);
+[[nodiscard]] Isa  bestIsa();
+
+/**
+ * Writes the 2 * count uppercase characters of the bytes, most significant nibble first.
+ */
+void encode(const uint8_t* bytes, std::size_t count, uint8_t* chars, Isa isa = bestIsa());
+
+/**
+ * Reads count bytes from their 2 * count characters, in either case.
+ *
+ * @return false if one of the characters isn't hexadecimal, the bytes are then unspecified.
+ */
+[[nodiscard]] bool decode(const uint8_t* chars, std::size_t count, uint8_t* bytes, Isa isa = bestIsa());
+
+/**
+ * @return The position of the first character that isn't hexadecimal, count if they all are.
+ */
+[[nodiscard]] std::size_t findNonHex(const uint8_t* chars, std::size_t count, Isa isa = bestIsa());
+}    // namespace Frasy::Hex
+
+#endif    // FRASY_UTILS_MISC_HEX_H
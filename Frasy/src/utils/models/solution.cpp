@@ -21,6 +21,7 @@
 #include "json.hpp"
 
 #include <fstream>
+#include <ranges>
 
 namespace Frasy::Models
 {
@@ -40,4 +41,40 @@ void Solution::SetTestEnable(const std::string& sequence, const std::string& tes
 {
     sequences.at(sequence).tests.at(test).enabled = enabled;
 }
+
+void to_json(nlohmann::json& j, const Solution& solution)
+{
+    j = nlohmann::json::array();
+    for (const auto& section : solution.sections) {
+        auto& jSection = j.emplace_back(nlohmann::json::array());
+        for (const auto& stage : section) {
+            auto& jStage = jSection.emplace_back(nlohmann::json::array());
+            for (const auto& [name, tests] : stage) {
+                jStage.push_back({{"name", name}, {"tests", tests}});
+            }
+        }
+    }
+}
+
+void from_json(const nlohmann::json& j, Solution& solution)
+{
+    solution.Clear();
+    solution.sections.reserve(j.size());
+    for (const auto& jSection : j) {
+        auto& section = solution.sections.emplace_back();
+        section.reserve(jSection.size());
+        for (const auto& jStage : jSection) {
+            auto& stage = section.emplace_back();
+            stage.reserve(jStage.size());
+            for (const auto& jSequence : jStage) {
+                auto& [name, tests] = stage.emplace_back(jSequence.at("name").get<std::string>(),
+                                                         jSequence.at("tests").get<std::vector<std::vector<std::string>>>());
+                auto& sequence      = solution.sequences[name];
+                for (const auto& test : tests | std::views::join) {
+                    sequence.tests.try_emplace(test);
+                }
+            }
+        }
+    }
+}
 }    // namespace Frasy::Models
\ No newline at end of file
@@ -18,6 +18,7 @@
 #define KONGSBERG_FRASY_FRASY_SRC_UTILS_MODELS_SOLUTION_H
 #include "sequence.h"
 
+#include <json.hpp>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -38,6 +39,19 @@ struct Solution
     void SetSequenceEnable(const std::string& sequence, bool enabled);
     void SetTestEnable(const std::string& sequence, const std::string& test, bool enabled);
 };
+
+/**
+ * Serialize the sections of a solution, using the same layout as the solution generated in Lua:
+ * [ section[ stage[ {name, tests: stage[ test ]} ] ] ]
+ * The enable state of the sequences and tests is not serialized.
+ */
+void to_json(nlohmann::json& j, const Solution& solution);
+
+/**
+ * Load a solution serialized by to_json, or saved in Lua with SaveAsJson.
+ * Every sequence and test found in the sections is registered in Solution::sequences.
+ */
+void from_json(const nlohmann::json& j, Solution& solution);
 }    // namespace Frasy::Models
 
 #endif    // KONGSBERG_FRASY_FRASY_SRC_UTILS_MODELS_SOLUTION_H
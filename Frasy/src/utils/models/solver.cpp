@@ -0,0 +1,144 @@
+/**
+ * @file    solver.cpp
+ * @author  Frasy
+ * @date    2026-10-16
+ * @brief   Ordering of the scopes of a solution according to their requirements.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <https://www.gnu.org/licenses/>.
+ */
+#include "solver.h"
+
+#include <algorithm>
+#include <iterator>
+#include <string_view>
+
+namespace Frasy::Models::Solver {
+Layers SortScopes(const std::vector<std::string>&   scopes,
+                  const std::optional<std::string>& first,
+                  const std::optional<std::string>& last,
+                  const Dependencies&               dependencies)
+{
+    // Each scope is a node, identified by its position in the list so that the layers keep the order of the scopes.
+    std::vector<const std::string*>                                nodes;
+    std::unordered_map<std::string_view, std::vector<std::size_t>> positions;
+    nodes.reserve(scopes.size());
+    for (const auto& scope : scopes) {
+        if (scope == first || scope == last) { continue; }
+        positions[scope].push_back(nodes.size());
+        nodes.push_back(&scope);
+    }
+
+    std::vector<std::vector<std::size_t>> dependents(nodes.size());
+    std::vector<std::size_t>              pending(nodes.size(), 0);
+    for (std::size_t node = 0; node < nodes.size(); ++node) {
+        auto it = dependencies.find(*nodes[node]);
+        if (it == dependencies.end()) { continue; }
+        for (const auto& dependency : it->second) {
+            auto dependencyPositions = positions.find(dependency);
+            if (dependencyPositions == positions.end()) { continue; }
+            for (auto position : dependencyPositions->second) {
+                dependents[position].push_back(node);
+                ++pending[node];
+            }
+        }
+    }
+
+    Layers order;
+    if (first.has_value()) { order.push_back({*first}); }
+
+    std::vector<std::size_t> frontier;
+    for (std::size_t node = 0; node < nodes.size(); ++node) {
+        if (pending[node] == 0) { frontier.push_back(node); }
+    }
+    std::size_t sorted = 0;
+    while (sorted != nodes.size()) {
+        if (frontier.empty()) {
+            std::string remaining;
+            for (std::size_t node = 0; node < nodes.size(); ++node) {
+                if (pending[node] != 0) { remaining += (remaining.empty() ? "" : ", ") + *nodes[node]; }
+            }
+            throw InvalidRequirement("Circular requirements between: " + remaining);
+        }
+
+        std::vector<std::size_t> next;
+        auto&                    layer = order.emplace_back();
+        layer.reserve(frontier.size());
+        for (auto node : frontier) {
+            layer.push_back(*nodes[node]);
+            for (auto dependent : dependents[node]) {
+                if (--pending[dependent] == 0) { next.push_back(dependent); }
+            }
+        }
+        sorted += frontier.size();
+        std::ranges::sort(next);
+        frontier = std::move(next);
+    }
+
+    if (last.has_value()) { order.push_back({*last}); }
+    return order;
+}
+
+Sections Sectionize(const Layers& stages, const std::unordered_set<std::string>& synchronized)
+{
+    Sections output;
+    Layers   currentSection;
+    for (const auto& stage : stages) {
+        // Feed current section with unsynchronized scopes
+        Layer currentStage;
+        std::ranges::copy_if(stage, std::back_inserter(currentStage), [&](const auto& name) {
+            return !synchronized.contains(name);
+        });
+        if (!currentStage.empty()) { currentSection.push_back(std::move(currentStage)); }
+
+        // Feed possible synchronized scopes
+        for (const auto& name : stage) {
+            if (!synchronized.contains(name)) { continue; }
+            if (!currentSection.empty()) { output.push_back(std::move(currentSection)); }
+            output.push_back({{name}});
+            currentSection = {};
+        }
+    }
+    if (!currentSection.empty()) { output.push_back(std::move(currentSection)); }
+    return output;
+}
+
+std::vector<Solution::section> CombineSectionized(const Sections&                                  sequences,
+                                                  const std::unordered_map<std::string, Sections>& tests)
+{
+    static const Sections          noTests;
+    std::vector<Solution::section> output;
+    for (const auto& section : sequences) {
+        Solution::section currentSection;
+        for (const auto& sequenceStage : section) {
+            std::vector<Solution::subsequence> currentSequenceStage;
+            for (const auto& sequence : sequenceStage) {
+                auto        it            = tests.find(sequence);
+                const auto& sequenceTests = it != tests.end() ? it->second : noTests;
+                if (sequenceTests.size() == 1) {
+                    currentSequenceStage.emplace_back(sequence, sequenceTests.front());
+                    continue;
+                }
+                // Each section of tests closes the current section of the solution.
+                for (const auto& testSection : sequenceTests) {
+                    currentSequenceStage.emplace_back(sequence, testSection);
+                    currentSection.push_back(std::move(currentSequenceStage));
+                    output.push_back(std::move(currentSection));
+                    currentSequenceStage = {};
+                    currentSection       = {};
+                }
+            }
+            if (!currentSequenceStage.empty()) { currentSection.push_back(std::move(currentSequenceStage)); }
+        }
+        if (!currentSection.empty()) { output.push_back(std::move(currentSection)); }
+    }
+    return output;
+}
+}    // namespace Frasy::Models::Solver
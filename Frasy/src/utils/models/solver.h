@@ -0,0 +1,85 @@
+/**
+ * @file    solver.h
+ * @author  Frasy
+ * @date    2026-10-16
+ * @brief   Ordering of the scopes of a solution according to their requirements.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef FRASY_UTILS_MODELS_SOLVER_H
+#define FRASY_UTILS_MODELS_SOLVER_H
+
+#include "solution.h"
+
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * Native implementation of the sort done by Orchestrator.Generate(), exposed to Lua through sort_utils.lua.
+ *
+ * The scopes (sequences, or the tests of a sequence) are sorted in layers: a layer holds every scope whose
+ * dependencies are all in the previous layers, in the order the scopes were given. The layers are then split into
+ * sections at each synchronized scope, and the sections of the sequences and of their tests are combined into the
+ * sections of the solution.
+ */
+namespace Frasy::Models::Solver {
+using Layer        = std::vector<std::string>;
+using Layers       = std::vector<Layer>;
+using Sections     = std::vector<Layers>;
+using Dependencies = std::unordered_map<std::string, std::vector<std::string>>;
+
+class InvalidRequirement : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+/**
+ * Sort scopes in layers, using Kahn's algorithm.
+ * Dependencies on scopes that are not part of @p scopes (including @p first and @p last) are considered met.
+ *
+ * @param scopes Scopes to sort.
+ * @param first Scope to place alone in the first layer, if any.
+ * @param last Scope to place alone in the last layer, if any.
+ * @param dependencies Scopes that each scope must run after.
+ * @return The layers, in execution order.
+ * @throws InvalidRequirement if the dependencies are circular.
+ */
+Layers SortScopes(const std::vector<std::string>&   scopes,
+                  const std::optional<std::string>& first,
+                  const std::optional<std::string>& last,
+                  const Dependencies&               dependencies);
+
+/**
+ * Split sorted layers in sections, each synchronized scope getting a section of its own.
+ *
+ * @param stages Layers returned by SortScopes.
+ * @param synchronized Scopes that have a sync requirement.
+ * @return The sections, in execution order.
+ */
+Sections Sectionize(const Layers& stages, const std::unordered_set<std::string>& synchronized);
+
+/**
+ * Combine the sections of the sequences with the sections of their tests.
+ * A sequence whose tests are split in multiple sections ends the current section after each of them.
+ *
+ * @param sequences Sections of the sequences.
+ * @param tests Sections of the tests of each sequence.
+ * @return The sections of the solution.
+ */
+std::vector<Solution::section> CombineSectionized(const Sections&                                  sequences,
+                                                  const std::unordered_map<std::string, Sections>& tests);
+}    // namespace Frasy::Models::Solver
+
+#endif    // FRASY_UTILS_MODELS_SOLVER_H
@@ -22,6 +22,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <variant>
 #include <vector>
 
@@ -31,12 +32,24 @@ struct ResultAnalysisResults
 {
     struct Expectation
     {
-        virtual ~Expectation()                                       = default;
+        //! A value of the expectation in a report, as kept in the result index.
+        struct Observation
+        {
+            bool             Passed = false;
+            float            Value  = 0.0f;    //!< Value checked by the numeric expectations, NaN if not a number.
+            std::string_view Text   = {};      //!< Value checked by the other expectations, as JSON.
+            std::string_view Type   = {};      //!< Type of the expected value.
+        };
+
+        virtual ~Expectation()                                                = default;
         std::string            Name;
-        virtual void           AddValue(const nlohmann::json& value) = 0;
-        virtual void           MakeStats()                           = 0;
-        virtual void           Render()                              = 0;
-        virtual nlohmann::json serialize()                           = 0;
+        virtual void           AddValue(const nlohmann::json& value)          = 0;
+        virtual void           AddObservation(const Observation& observation) = 0;
+        //! Adds the values of the same expectation, gathered from other reports. Both must be of the same type.
+        virtual void           Merge(const Expectation& other)                = 0;
+        virtual void           MakeStats()                                    = 0;
+        virtual void           Render()                                       = 0;
+        virtual nlohmann::json serialize()                                    = 0;
     };
     struct Test
     {
@@ -28,229 +28,491 @@
 #include "expectations/to_be_near.h"
 #include "expectations/to_be_true.h"
 #include "expectations/to_be_type.h"
+#include "expectations/to_be_value_base.h"
+#include "report_file.h"
 
 #include <Brigerad.h>
 #include <Brigerad/Debug/Instrumentor.h>
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <exception>
 #include <filesystem>
 #include <format>
-#include <fstream>
 #include <json.hpp>
+#include <mutex>
+#include <numeric>
 #include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace Frasy::Analyzers {
 namespace {
+namespace fs = std::filesystem;
+
+using Results = ResultAnalysisResults;
+
+//! Reports added to the index between two commits, when indexing the archived reports.
+constexpr size_t s_indexBatchSize = 256;
+
 float Percent(size_t v, size_t tot)
 {
     return (static_cast<float>(v) / static_cast<float>(tot)) * 100.0f;
 }
 
+double Average(const std::vector<double>& values)
+{
+    return std::accumulate(values.begin(), values.end(), 0.0) / static_cast<double>(values.size());
+}
+
 nlohmann::json LoadJson(const std::string& path)
 {
     BR_PROFILE_FUNCTION();
-    // Open the file or create it if it doesn't exist.
-    std::fstream file(path, std::ios::out | std::ios::app);
-    file.close();
-    std::ifstream j(path);
-
-    std::string fullFile;
-    std::string line;
-
-    while (std::getline(j, line)) {
-        fullFile += line;
-    }
-    j.close();
-
     try {
-        return nlohmann::json::parse(fullFile);
+        return ReportFile::Load(path);
     }
-    catch (nlohmann::json::parse_error& e) {
+    catch (std::exception& e) {
         BR_APP_ERROR("An error occurred while parsing '{}': {}", path, e.what());
         return {};
     }
 }
 
-std::vector<std::string> LoadMatchingFiles(const std::string&                       path,
-                                           const std::vector<std::array<char, 32>>& serialNumbers)
+//! Paths of the archived reports, relative to root. A report being converted to another format is listed once.
+std::vector<std::string> ListArchivedReports(const fs::path& root)
 {
-    namespace fs = std::filesystem;
-    auto numbers = [&serialNumbers]() {
-        std::vector<std::string_view> numbers = {};
-        numbers.reserve(serialNumbers.size());
-
-        for (auto&& number : serialNumbers) {
-            numbers.emplace_back(number.data());
+    std::vector<std::string>        files = {};
+    std::unordered_set<std::string> keys  = {};
+    for (std::string_view directory : {"fail", "pass"}) {
+        try {
+            for (const auto& entry : fs::recursive_directory_iterator(root / directory)) {
+                if (!entry.is_regular_file() || entry.path().extension() == ".tmp") { continue; }
+                auto file = entry.path().lexically_relative(root).generic_string();
+                if (keys.emplace(ReportFile::ArchiveKey(file)).second) { files.push_back(std::move(file)); }
+            }
+        }
+        catch (std::filesystem::filesystem_error& e) {
+            BR_LOG_ERROR("Analyzer", "{}", e.what());
         }
+    }
+    return files;
+}
 
-        return numbers;
-    }();
+//! The reports are archived as <timestamp>_<serial>.txt, or .cbor.
+int64_t TimestampOf(std::string_view file)
+{
+    file              = file.substr(file.find_last_of('/') + 1);
+    int64_t timestamp = 0;
+    std::from_chars(file.data(), file.data() + file.size(), timestamp);
+    return timestamp;
+}
 
-    std::vector<std::string> files = {};
+bool MentionsAny(const std::vector<std::array<char, 32>>& list, std::string_view str)
+{
+    return std::ranges::any_of(list, [str](const std::array<char, 32>& item) {
+        return str.find(std::string_view(item.data())) != std::string::npos;
+    });
+}
 
-    try {
-        for (const auto& entry : fs::recursive_directory_iterator(path)) {
-            if (serialNumbers.empty() ||
-                std::ranges::any_of(numbers, [entryPath = entry.path().string()](const auto& number) {
-                    return entryPath.find(number) != std::string::npos;
-                })) {
-                files.emplace_back(entry.path().string());
-            }
+//! Whether the name of each string of the index is one of a list of the options, decided once per string.
+class NameFilter {
+public:
+    NameFilter(const ResultIndex& index, const std::vector<std::array<char, 32>>& names)
+    : m_index(index), m_names(names), m_matches(names.empty() ? 0 : index.StringCount(), s_unknown)
+    {
+    }
+
+    bool operator()(uint32_t id)
+    {
+        if (m_names.empty()) { return true; }
+        int8_t& match = m_matches[id];
+        if (match == s_unknown) {
+            match = std::ranges::any_of(m_names, [name = std::string_view(m_index.String(id))](const auto& item) {
+                return std::string_view(item.data()) == name;
+            });
         }
+        return match == 1;
+    }
+
+private:
+    static constexpr int8_t s_unknown = -1;
+
+    const ResultIndex&                       m_index;
+    const std::vector<std::array<char, 32>>& m_names;
+    std::vector<int8_t>                      m_matches;
+};
+
+//! The results of a name under a parent, such as a test of a sequence, found without comparing the names.
+struct ChildKey {
+    const void* Parent = nullptr;
+    uint32_t    Name   = 0;
+
+    bool operator==(const ChildKey&) const = default;
+};
+struct ChildKeyHash {
+    size_t operator()(const ChildKey& key) const
+    {
+        return std::hash<const void*> {}(key.Parent) ^ (std::hash<uint32_t> {}(key.Name) * 0x9E3779B97F4A7C15ULL);
     }
-    catch (std::filesystem::filesystem_error& e) {
-        BR_LOG_ERROR("Analyzer", "{}", e.what());
+};
+template<typename T>
+using ChildCache = std::unordered_map<ChildKey, T*, ChildKeyHash>;
+
+template<typename T>
+void Count(T& results, uint8_t flags, double duration)
+{
+    results.Total++;
+    if ((flags & ResultIndex::Enabled) != 0) { results.Enabled++; }
+    if ((flags & ResultIndex::Skipped) != 0) { results.Skipped++; }
+    if ((flags & ResultIndex::Passed) != 0) { results.Passed++; }
+    results.Durations.push_back(duration);
+}
+
+template<typename T>
+void MakePercents(T& results)
+{
+    results.EnabledPercent  = Percent(results.Enabled, results.Total);
+    results.SkippedPercent  = Percent(results.Skipped, results.Total);
+    results.PassedPercent   = Percent(results.Passed, results.Total - results.Skipped);
+    results.AverageDuration = Average(results.Durations);
+}
+
+/**
+ * Calls work(i) for every i of [0, count) from up to threads threads, the calling one included, until cancelled.
+ * The work is taken one item at a time, so that a slow item doesn't hold back the others.
+ *
+ * @throws The first exception thrown by work, once every thread is done.
+ */
+template<typename Work>
+void ParallelFor(size_t count, size_t threads, const std::atomic<bool>& cancelled, Work&& work)
+{
+    std::atomic<size_t> next = 0;
+    std::exception_ptr  error;
+    std::once_flag      errorSet;
+    auto                worker = [&] {
+        try {
+            for (size_t i = next++; i < count && !cancelled; i = next++) { work(i); }
+        }
+        catch (...) {
+            std::call_once(errorSet, [&] { error = std::current_exception(); });
+            next = count;
+        }
+    };
+
+    {
+        std::vector<std::jthread> pool;
+        for (size_t i = 1; i < std::min(threads, count); ++i) { pool.emplace_back(worker); }
+        worker();
     }
-    return files;
+    if (error) { std::rethrow_exception(error); }
+}
+
+//! Moves the results missing from into, then merges those in both with merge.
+template<typename T, typename Merge>
+void MergeChildren(std::map<std::string, T>& into, std::map<std::string, T>& from, Merge&& merge)
+{
+    into.merge(from);
+    for (auto&& [name, child] : from) { merge(into.at(name), child); }
 }
 
-std::vector<std::string> LoadAllMatchingFiles(const std::string&                       title,
-                                              const std::vector<std::array<char, 32>>& serialNumbers)
+template<typename T>
+void MergeCounts(T& into, T& from)
 {
-    auto r   = LoadMatchingFiles(std::format("logs/{}/fail", title), serialNumbers);
-    auto tmp = LoadMatchingFiles(std::format("logs/{}/pass", title), serialNumbers);
-    r.insert(r.end(), tmp.begin(), tmp.end());
-    return r;
+    into.Total += from.Total;
+    into.Enabled += from.Enabled;
+    into.Skipped += from.Skipped;
+    into.Passed += from.Passed;
+    into.Durations.insert(into.Durations.end(), from.Durations.begin(), from.Durations.end());
+}
+
+void Merge(Results::Test& into, Results::Test& from)
+{
+    MergeCounts(into, from);
+    MergeChildren(into.Expectations, from.Expectations, [&into](auto& expectation, auto& other) {
+        try {
+            expectation->Merge(*other);
+        }
+        catch (std::exception& e) {
+            BR_LOG_ERROR("Analyzer",
+                         "Error while merging expectation '{}' of test '{}': {}",
+                         expectation->Name,
+                         into.Name,
+                         e.what());
+        }
+    });
+}
+
+void Merge(Results::Sequence& into, Results::Sequence& from)
+{
+    MergeCounts(into, from);
+    MergeChildren(into.Tests, from.Tests, [](auto& test, auto& other) { Merge(test, other); });
+}
+
+void Merge(Results& into, Results& from)
+{
+    MergeChildren(into.Locations, from.Locations, [](auto& location, auto& other) {
+        location.Total += other.Total;
+        location.Passed += other.Passed;
+        location.Durations.insert(location.Durations.end(), other.Durations.begin(), other.Durations.end());
+        MergeChildren(location.Sequences, other.Sequences, [](auto& sequence, auto& otherSequence) {
+            Merge(sequence, otherSequence);
+        });
+    });
 }
 }    // namespace
 
+//! A range of reports of the index, with the rows of their children.
+struct ResultAnalyzer::Shard {
+    //! Rows [Begin, End) of a table.
+    struct Rows {
+        size_t Begin = 0;
+        size_t End   = 0;
+
+        [[nodiscard]] size_t Size() const { return End - Begin; }
+    };
+
+    Rows Reports;
+    Rows Sequences;
+    Rows Tests;
+    Rows Expectations;
+};
 
 ResultAnalysisResults ResultAnalyzer::Analyze(const std::string& title)
 {
     m_results = {};
-    // Load all files that match the options from the pass and fail directory
-    auto logs = LoadAllMatchingFiles(title, m_options.SerialNumbers);
-    ToAnalyze = logs.size();
-    // For each file found, ignore those with UUTs that do not interest us
-    for (auto&& log : logs) {
+    ToAnalyze = 0;
+    Analyzed  = 0;
+
+    const fs::path root      = fs::path("logs") / title;
+    const fs::path directory = root / ResultIndex::s_directory;
+    auto           index     = LoadIndex(directory);
+
+    // Reports archived before the index existed, or while it couldn't be written, are added to it first. A report
+    // converted to another format since it was indexed is the same report.
+    auto indexed = [&index] {
+        std::unordered_set<std::string_view> files;
+        files.reserve(index.Reports.File.size());
+        for (uint32_t file : index.Reports.File) { files.insert(ReportFile::ArchiveKey(index.String(file))); }
+        return files;
+    }();
+    std::vector<std::string> missing;
+    for (auto&& file : ListArchivedReports(root)) {
+        if (!indexed.contains(ReportFile::ArchiveKey(file))) { missing.push_back(std::move(file)); }
+    }
+    if (!missing.empty()) {
+        BR_LOG_INFO("Analyzer", "Adding {} archived reports to the index...", missing.size());
+        ToAnalyze = missing.size() + index.Reports.Flags.size();
+        IndexReports(root, missing);
+        index = LoadIndex(directory);
+    }
+
+    ToAnalyze = Analyzed + index.Reports.Flags.size();
+    if (!m_cancelled) { AnalyzeIndex(index); }
+    if (m_cancelled) {
+        BR_LOG_INFO("Analyzer", "Analysis of '{}' cancelled", title);
+        m_results = {};
+    }
+    return m_results;
+}
+
+ResultIndex ResultAnalyzer::LoadIndex(const std::filesystem::path& directory)
+{
+    try {
+        return ResultIndex::Load(directory);
+    }
+    catch (std::exception& e) {
+        // It is rebuilt from the reports.
+        BR_LOG_ERROR("Analyzer", "Unable to load the result index: {}", e.what());
+        ResultIndex::Remove(directory);
+        return {};
+    }
+}
+
+void ResultAnalyzer::IndexReports(const std::filesystem::path& root, const std::vector<std::string>& files)
+{
+    // Reading the reports is what takes time, they are read in parallel and added to the index a batch at a time.
+    std::vector<ResultIndex::Entry> entries;
+    const size_t                    threads = Threads();
+    for (size_t first = 0; first < files.size() && !m_cancelled; first += s_indexBatchSize) {
+        entries.resize(std::min(s_indexBatchSize, files.size() - first));
+        ParallelFor(entries.size(), threads, m_cancelled, [&](size_t i) {
+            const auto& file = files[first + i];
+            BR_LOG_DEBUG("Analyzer", "Indexing log '{}'...", file);
+            entries[i] = {.File = file, .Timestamp = TimestampOf(file), .Report = LoadJson((root / file).string())};
+            Analyzed++;
+        });
+        // A cancelled batch is left out, as some of its reports weren't read.
+        if (m_cancelled) { break; }
+
         try {
-            BR_LOG_DEBUG("Analyzer", "Analyzing log '{}'...", log);
-            AnalyzeFile(log);
+            ResultIndex::Append(root / ResultIndex::s_directory, entries);
         }
-        catch (nlohmann::json::exception& e) {
-            BR_LOG_ERROR("Analyzer", "An error occurred while analyzing '{}': {}", log, e.what());
+        catch (std::exception& e) {
+            BR_LOG_ERROR("Analyzer", "Unable to add reports to the index: {}", e.what());
         }
-        Analyzed++;
     }
+}
+
+void ResultAnalyzer::AnalyzeIndex(const ResultIndex& index)
+{
+    BR_PROFILE_FUNCTION();
+    const size_t reports = index.Reports.Flags.size();
+    const size_t threads = std::min(Threads(), std::max<size_t>(reports, 1));
+
+    // Each thread takes a range of reports, whose children are ranges of rows as well.
+    auto childrenOf = [](const std::vector<uint32_t>& parents, const Shard::Rows& range) {
+        return Shard::Rows {
+          .Begin = static_cast<size_t>(std::ranges::lower_bound(parents, range.Begin) - parents.begin()),
+          .End   = static_cast<size_t>(std::ranges::lower_bound(parents, range.End) - parents.begin()),
+        };
+    };
+    std::vector<Shard> shards(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        auto& shard        = shards[i];
+        shard.Reports      = {.Begin = reports * i / threads, .End = reports * (i + 1) / threads};
+        shard.Sequences    = childrenOf(index.Sequences.Report, shard.Reports);
+        shard.Tests        = childrenOf(index.Tests.Sequence, shard.Sequences);
+        shard.Expectations = childrenOf(index.Expectations.Test, shard.Tests);
+    }
+
+    std::vector<Results> results(threads);
+    ParallelFor(threads, threads, m_cancelled, [&](size_t i) { results[i] = AnalyzeShard(index, shards[i]); });
+    if (m_cancelled) { return; }
+
+    // Merged in the order of the reports. The counts, sums and bounds are the same as on one thread, the merged
+    // quantile estimates are only approximate.
+    m_results = std::move(results.front());
+    for (size_t i = 1; i < threads; ++i) { Merge(m_results, results[i]); }
 
+    std::vector<Results::Expectation*> expectations;
     for (auto&& [name, location] : m_results.Locations) {
+        location.PassedPercent   = Percent(location.Passed, location.Total);
+        location.AverageDuration = Average(location.Durations);
         for (auto&& [sName, sequence] : location.Sequences) {
+            MakePercents(sequence);
             for (auto&& [tName, test] : sequence.Tests) {
-                for (auto&& [eName, expectation] : test.Expectations) {
-                    expectation->MakeStats();
-                }
+                MakePercents(test);
+                for (auto&& [eName, expectation] : test.Expectations) { expectations.push_back(expectation.get()); }
             }
         }
     }
-
-    return m_results;
+    ParallelFor(expectations.size(), Threads(), m_cancelled, [&](size_t i) { expectations[i]->MakeStats(); });
 }
 
-void ResultAnalyzer::AnalyzeFile(const std::string& path)
+ResultAnalysisResults ResultAnalyzer::AnalyzeShard(const ResultIndex& index, const Shard& shard)
 {
-    auto file = LoadJson(path);
-
-    const auto& info     = file.at("info");
-    std::string location = info.at("uut").dump();
-
-    // Check if this log is one that interests us based on its location.
-    if (m_options.Uuts.empty() || std::ranges::any_of(m_options.Uuts, [&location](const std::array<char, 32>& u) {
-            return location.find(std::string_view(u.data())) != std::string::npos;
-        })) {
-        // File is of interest, proceed with the analysis.
-        if (m_options.Ganged) { location = "Total"; }
-        else {
-            location = std::format("Location {}", info.at("uut").get<int>());
+    Results     results;
+    const auto& reports = index.Reports;
+
+    // Results of every row of a table, nullptr for the rows left out by the options.
+    std::vector<Results::Location*>                  locations(shard.Reports.Size(), nullptr);
+    std::unordered_map<uint32_t, Results::Location*> locationOfUut;
+    for (size_t row = shard.Reports.Begin; row < shard.Reports.End; ++row, ++Analyzed) {
+        const uint8_t  flags = reports.Flags[row];
+        const uint32_t uut   = reports.Uut[row];
+        if ((flags & ResultIndex::Invalid) != 0) { continue; }
+        if (!m_options.SerialNumbers.empty() &&
+            !MentionsAny(m_options.SerialNumbers, index.String(reports.File[row]))) {
+            continue;
         }
-        auto& locationResults = m_results.Locations[location];
-        locationResults.Name  = location;
-        locationResults.Total++;
-        if (info.at("pass").get<bool>()) { locationResults.Passed++; }
-        locationResults.PassedPercent = Percent(locationResults.Passed, locationResults.Total);
-
-        locationResults.Durations.push_back(info.at("time").at("process").get<double>());
-        locationResults.AverageDuration =
-          std::accumulate(locationResults.Durations.begin(), locationResults.Durations.end(), 0.0);
-        locationResults.AverageDuration /= static_cast<double>(locationResults.Durations.size());
-
-        auto sequences = file.at("sequences");
-        for (auto [name, sequence] : sequences.items()) {
-            if (m_options.Sequences.empty() ||
-                std::ranges::any_of(m_options.Sequences, [&name](const auto& sequenceName) {
-                    return std::string_view(sequenceName.data()) == name;
-                })) {
-                BR_LOG_DEBUG("Analyzer", "Analyzing sequence '{}'...", name);
-                AnalyzeSequence(sequence, locationResults.Sequences[name]);
-                locationResults.Sequences[name].Name = name;
-            }
-            else {
-                BR_LOG_DEBUG("Analyzer", "Ignored sequence '{}'...", name);
-            }
+        if (!m_options.Uuts.empty() && !MentionsAny(m_options.Uuts, std::to_string(uut))) { continue; }
+
+        auto*& location = locationOfUut[m_options.Ganged ? 0 : uut];
+        if (location == nullptr) {
+            std::string name = m_options.Ganged ? std::string {"Total"} : std::format("Location {}", uut);
+            location         = &results.Locations[name];
+            location->Name   = std::move(name);
         }
+        location->Total++;
+        if ((flags & ResultIndex::Passed) != 0) { location->Passed++; }
+        location->Durations.push_back(reports.Duration[row]);
+        locations[row - shard.Reports.Begin] = location;
     }
-}
 
-void ResultAnalyzer::AnalyzeSequence(const nlohmann::json& sequence, ResultAnalysisResults::Sequence& results)
-{
-    results.Total++;
-    if (sequence.at("enabled").get<bool>()) { results.Enabled++; }
-    results.EnabledPercent = Percent(results.Enabled, results.Total);
-    if (sequence.at("skipped").get<bool>()) { results.Skipped++; }
-    results.SkippedPercent = Percent(results.Skipped, results.Total);
-    if (sequence.at("pass").get<bool>()) { results.Passed++; }
-    results.PassedPercent = Percent(results.Passed, results.Total - results.Skipped);
-
-    results.Durations.push_back(sequence.at("time").at("process").get<double>());
-    results.AverageDuration = std::accumulate(results.Durations.begin(), results.Durations.end(), 0.0);
-    results.AverageDuration /= static_cast<double>(results.Durations.size());
-
-    auto tests = sequence.at("tests");
-    for (auto [name, test] : tests.items()) {
-        if (m_options.Tests.empty() || std::ranges::any_of(m_options.Tests, [&name](const auto& testName) {
-                return std::string_view(testName.data()) == name;
-            })) {
-            BR_LOG_DEBUG("Analyzer", "Analyzing test '{}'...", name);
-            AnalyzeTest(test, results.Tests[name]);
-            results.Tests[name].Name = name;
+    const auto&                     sequenceRows = index.Sequences;
+    std::vector<Results::Sequence*> sequences(shard.Sequences.Size(), nullptr);
+    ChildCache<Results::Sequence>   sequenceOf;
+    NameFilter                      isSequenceAnalyzed {index, m_options.Sequences};
+    for (size_t row = shard.Sequences.Begin; row < shard.Sequences.End; ++row) {
+        auto* location = locations[sequenceRows.Report[row] - shard.Reports.Begin];
+        if (location == nullptr || !isSequenceAnalyzed(sequenceRows.Name[row])) { continue; }
+        auto*& sequence = sequenceOf[{location, sequenceRows.Name[row]}];
+        if (sequence == nullptr) {
+            const auto& name = index.String(sequenceRows.Name[row]);
+            sequence         = &location->Sequences[name];
+            sequence->Name   = name;
         }
-        else {
-            BR_LOG_DEBUG("Analyzer", "Ignored test '{}'...", name);
+        Count(*sequence, sequenceRows.Flags[row], sequenceRows.Duration[row]);
+        sequences[row - shard.Sequences.Begin] = sequence;
+    }
+
+    const auto&                 testRows = index.Tests;
+    std::vector<Results::Test*> tests(shard.Tests.Size(), nullptr);
+    ChildCache<Results::Test>   testOf;
+    NameFilter                  isTestAnalyzed {index, m_options.Tests};
+    for (size_t row = shard.Tests.Begin; row < shard.Tests.End; ++row) {
+        auto* sequence = sequences[testRows.Sequence[row] - shard.Sequences.Begin];
+        if (sequence == nullptr || !isTestAnalyzed(testRows.Name[row])) { continue; }
+        auto*& test = testOf[{sequence, testRows.Name[row]}];
+        if (test == nullptr) {
+            const auto& name = index.String(testRows.Name[row]);
+            test             = &sequence->Tests[name];
+            test->Name       = name;
         }
+        Count(*test, testRows.Flags[row], testRows.Duration[row]);
+        tests[row - shard.Tests.Begin] = test;
     }
-}
 
-void ResultAnalyzer::AnalyzeTest(const nlohmann::json& test, ResultAnalysisResults::Test& results)
-{
-    results.Total++;
-    if (test.at("enabled").get<bool>()) { results.Enabled++; }
-    results.EnabledPercent = Percent(results.Enabled, results.Total);
-    if (test.at("skipped").get<bool>()) { results.Skipped++; }
-    results.SkippedPercent = Percent(results.Skipped, results.Total);
-    if (test.at("pass").get<bool>()) { results.Passed++; }
-    results.PassedPercent = Percent(results.Passed, results.Total - results.Skipped);
-
-    results.Durations.push_back(test.at("time").at("process").get<double>());
-    results.AverageDuration = std::accumulate(results.Durations.begin(), results.Durations.end(), 0.0);
-    results.AverageDuration /= static_cast<double>(results.Durations.size());
-
-    auto expectations = test.at("expectations");
-    for (auto expectation : expectations) {
-        std::string name = std::format("Expectation {}", results.Expectations.size() + 1);
-        if (expectation.contains("name")) { name = expectation.at("name").get<std::string>(); }
-        try {
-            if (!results.Expectations.contains(name)) {
-                results.Expectations[name] = std::move(MakeExpectationFromDetails(expectation));
+    const auto&                               expectationRows = index.Expectations;
+    ChildCache<Results::Expectation>          expectationOf;
+    std::unordered_map<uint32_t, const char*> typeOf;    // Type of the expected value of each definition.
+    for (size_t row = shard.Expectations.Begin; row < shard.Expectations.End; ++row) {
+        auto* test = tests[expectationRows.Test[row] - shard.Tests.Begin];
+        if (test == nullptr) { continue; }
+
+        const uint32_t definition = expectationRows.Definition[row];
+        auto [expectation, isNew] = expectationOf.try_emplace({test, expectationRows.Name[row]}, nullptr);
+        if (isNew) {
+            const auto& name = index.String(expectationRows.Name[row]);
+            try {
+                auto& expectationResults = test->Expectations[name];
+                if (expectationResults == nullptr) {
+                    expectationResults = MakeExpectationFromDetails(nlohmann::json::parse(index.String(definition)));
+                    if (auto* values = dynamic_cast<ToBeValueBase*>(expectationResults.get()); values != nullptr) {
+                        values->KeepValues = m_options.KeepValues;
+                    }
+                }
+                expectation->second = expectationResults.get();
+            }
+            catch (std::exception& e) {
+                BR_LOG_ERROR("Analyzer", "Error while analyzing expectation '{}': {}", name, e.what());
+                test->Expectations.erase(name);
             }
-            AnalyzeExpectation(expectation, results.Expectations[name]);
         }
-        catch (std::exception& e) {
-            BR_LOG_ERROR("Analyzer", "Error while analyzing expectation '{}': {}", name, e.what());
+        if (expectation->second == nullptr) { continue; }
+
+        Results::Expectation::Observation observation = {
+          .Passed = (expectationRows.Flags[row] & ResultIndex::Passed) != 0,
+          .Value  = expectationRows.Value[row],
+        };
+        if (const uint32_t text = expectationRows.Text[row]; text != ResultIndex::s_noString) {
+            auto [type, isNewDefinition] = typeOf.try_emplace(definition, "null");
+            if (isNewDefinition) {
+                const auto details = nlohmann::json::parse(index.String(definition));
+                if (details.contains("expected")) { type->second = details.at("expected").type_name(); }
+            }
+            observation.Text = index.String(text);
+            observation.Type = type->second;
         }
+        expectation->second->AddObservation(observation);
     }
+    return results;
 }
 
-void ResultAnalyzer::AnalyzeExpectation(const nlohmann::json&                                expectation,
-                                        std::shared_ptr<ResultAnalysisResults::Expectation>& results)
+size_t ResultAnalyzer::Threads() const
 {
-    results->AddValue(expectation);
+    if (m_options.Threads != 0) { return m_options.Threads; }
+    return std::max(std::thread::hardware_concurrency(), 1U);
 }
 
 std::shared_ptr<ResultAnalysisResults::Expectation> ResultAnalyzer::MakeExpectationFromDetails(
@@ -20,8 +20,13 @@
 
 #include "analytic_results.h"
 #include "options.h"
+#include "result_index.h"
 
+#include <atomic>
+#include <filesystem>
 #include <json.hpp>
+#include <string>
+#include <vector>
 
 namespace Frasy::Analyzers
 {
@@ -31,23 +36,41 @@ public:
     ResultAnalyzer() = default;
     ResultAnalyzer(const ResultOptions& options) : m_options(options) {}
 
+    /**
+     * Analyzes the reports archived for a product, as kept in its result index.
+     *
+     * The archived reports missing from the index, such as those archived before it existed, are added to it first.
+     * The reports are split across the threads of the options, each gathering the results of its share of the reports,
+     * which are merged once they are all done.
+     *
+     * @return Empty results if the analysis was cancelled.
+     */
     ResultAnalysisResults Analyze(const std::string& title);
+    /**
+     * Stops the analysis running on another thread as soon as possible, along with any later one. The reports indexed
+     * until then stay in the index, the next analysis resumes from there.
+     */
+    void               Cancel() { m_cancelled = true; }
+    [[nodiscard]] bool IsCancelled() const { return m_cancelled; }
 
-    size_t ToAnalyze = 0;
-    size_t Analyzed = 0;
+    std::atomic<size_t> ToAnalyze = 0;
+    std::atomic<size_t> Analyzed  = 0;
 
 private:
-    void AnalyzeFile(const std::string& path);
-    void AnalyzeSequence(const nlohmann::json& sequence, ResultAnalysisResults::Sequence& results);
-    void AnalyzeTest(const nlohmann::json& test, ResultAnalysisResults::Test& results);
-    void AnalyzeExpectation(const nlohmann::json&                               expectation,
-                            std::shared_ptr<ResultAnalysisResults::Expectation>& results);
+    struct Shard;
+
+    ResultIndex           LoadIndex(const std::filesystem::path& directory);
+    void                  IndexReports(const std::filesystem::path& root, const std::vector<std::string>& files);
+    void                  AnalyzeIndex(const ResultIndex& index);
+    ResultAnalysisResults AnalyzeShard(const ResultIndex& index, const Shard& shard);
+    [[nodiscard]] size_t  Threads() const;
 
     std::shared_ptr<ResultAnalysisResults::Expectation> MakeExpectationFromDetails(const nlohmann::json& expectation);
 
 private:
     ResultOptions         m_options = {};
     ResultAnalysisResults m_results = {};
+    std::atomic<bool>     m_cancelled = false;
 };
 }    // namespace Frasy::Analyzers
 
@@ -51,6 +51,33 @@ public:
         Values[valueStr].Seen++;
     }
 
+    void AddObservation(const Observation& observation) override
+    {
+        Total++;
+        if (observation.Passed) { Passed++; }
+
+        auto [it, inserted] = Values.try_emplace(std::string {observation.Text});
+        if (inserted) {
+            it->second = {
+              .Type   = std::string {observation.Type},
+              .Passed = observation.Passed,
+            };
+        }
+        it->second.Seen++;
+    }
+
+    void Merge(const Expectation& other) override
+    {
+        const auto& values = dynamic_cast<const ToBeExactBase&>(other);
+        Total += values.Total;
+        Passed += values.Passed;
+        for (auto&& [text, value] : values.Values) {
+            // The first occurrence of a value decides whether it passes, as when they are added one by one.
+            auto [it, inserted] = Values.try_emplace(text, value);
+            if (!inserted) { it->second.Seen += value.Seen; }
+        }
+    }
+
     void MakeStats() override {}
 
     void Render() override
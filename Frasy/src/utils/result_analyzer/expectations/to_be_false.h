@@ -30,6 +30,12 @@ struct ToBeFalseExpectation : public ToBeExactBase
         fakeValue["value"]       = value.at("pass").get<bool>();
         ToBeExactBase::AddValue(fakeValue);
     }
+    void AddObservation(const Observation& observation) override
+    {
+        Observation fakeObservation = observation;    // Same as the value field of AddValue.
+        fakeObservation.Text        = observation.Passed ? "true" : "false";
+        ToBeExactBase::AddObservation(fakeObservation);
+    }
     void Render() override
     {
         ImGui::BulletText("Expected: To Be False");
@@ -18,9 +18,14 @@
 #ifndef FRASY_SRC_UTILS_RESULT_ANALYZER_EXPECTATIONS_TO_BE_VALUE_BASE_H
 #define FRASY_SRC_UTILS_RESULT_ANALYZER_EXPECTATIONS_TO_BE_VALUE_BASE_H
 
+#include "../value_statistics.h"
+
+#include <algorithm>
+#include <cmath>
 #include <imgui.h>
 #include <implot.h>
 #include <limits>
+#include <vector>
 
 namespace Frasy::Analyzers
 {
@@ -33,25 +38,47 @@ struct ToBeValueBase : public ResultAnalysisResults::Expectation
     {
         Total++;
         if (value.at("pass").get<bool>()) { Passed++; }
-        float v = value.at("value").get<float>();
-        Values.push_back(v);
+        AddNumber(value.at("value").get<float>());
+    }
+
+    void AddObservation(const Observation& observation) override
+    {
+        Total++;
+        if (observation.Passed) { Passed++; }
+        if (!std::isnan(observation.Value)) { AddNumber(observation.Value); }
+    }
+
+    void Merge(const Expectation& other) override
+    {
+        const auto& values = dynamic_cast<const ToBeValueBase&>(other);
+        Total += values.Total;
+        Passed += values.Passed;
+        Statistics.Merge(values.Statistics);
+        Values.insert(Values.end(), values.Values.begin(), values.Values.end());
     }
 
     void MakeStats() override
     {
-        const auto [min, max] = std::minmax_element(Values.begin(), Values.end());
-        MinObserved           = *min;
-        MaxObserved           = *max;
-        std::sort(Values.begin(), Values.end());
-        Mean = std::accumulate(Values.begin(), Values.end(), 0.0f);
-        Mean /= static_cast<float>(Values.size());
-
-        FindMedian();
-        FindMode();
-        FindStdDev();
+        if (Statistics.Count() == 0) { return; }
+        MinObserved = static_cast<float>(Statistics.Min());
+        MaxObserved = static_cast<float>(Statistics.Max());
+        Mean        = static_cast<float>(Statistics.Mean());
+        StdDev      = static_cast<float>(Statistics.StdDev());
+        Range       = MaxObserved - MinObserved;
+
+        if (!Values.empty())
+        {
+            std::sort(Values.begin(), Values.end());
+            FindMedian();
+            FindMode();
+        }
+        else
+        {
+            Median = static_cast<float>(Statistics.Quantile(0.5));
+            FindEstimatedMode();
+        }
         FindPpPpk();
-
-        Range = MaxObserved - MinObserved;
+        m_histogram = {};
     }
 
     void Render() override
@@ -90,9 +117,12 @@ struct ToBeValueBase : public ResultAnalysisResults::Expectation
             ImGui::SameLine();
             ImGui::CheckboxFlags(
               "Cumulative", reinterpret_cast<unsigned int*>(&HistogramFlags), ImPlotHistogramFlags_Cumulative);
-            ImGui::SameLine();
-            ImGui::CheckboxFlags(
-              "No Outliers", reinterpret_cast<unsigned int*>(&HistogramFlags), ImPlotHistogramFlags_NoOutliers);
+            if (!Values.empty())
+            {
+                ImGui::SameLine();
+                ImGui::CheckboxFlags(
+                  "No Outliers", reinterpret_cast<unsigned int*>(&HistogramFlags), ImPlotHistogramFlags_NoOutliers);
+            }
 
             ImGui::TreePop();
         }
@@ -103,8 +133,24 @@ struct ToBeValueBase : public ResultAnalysisResults::Expectation
             ImPlot::SetupAxes(nullptr, nullptr, xFlags, ImPlotAxisFlags_AutoFit);
             ImPlot::SetNextFillStyle(IMPLOT_AUTO_COL, 0.5f);
 
-            ImPlot::PlotHistogram(
-              "Values Read", Values.data(), (int)Values.size(), Bins, 1.0, ImPlotRange(), HistogramFlags);
+            if (!Values.empty())
+            {
+                ImPlot::PlotHistogram(
+                  "Values Read", Values.data(), (int)Values.size(), Bins, 1.0, ImPlotRange(), HistogramFlags);
+            }
+            else if (Statistics.Count() != 0)
+            {
+                // Without the values, the histogram is estimated from their statistics. There's nothing to estimate
+                // when no value was a number, the observed bounds are left to their sentinels then.
+                const auto& histogram = EstimatedHistogram();
+                ImPlot::PlotBars("Values Read",
+                                 histogram.Centers.data(),
+                                 histogram.Counts.data(),
+                                 (int)histogram.Counts.size(),
+                                 histogram.Width,
+                                 (HistogramFlags & ImPlotHistogramFlags_Horizontal) != 0 ? ImPlotBarsFlags_Horizontal
+                                                                                         : ImPlotBarsFlags_None);
+            }
             ImPlot::PlotInfLines("Minimum Accepted", &Min, 1);
             ImPlot::PlotInfLines("Maximum Accepted", &Max, 1);
             ImPlot::EndPlot();
@@ -120,6 +166,7 @@ struct ToBeValueBase : public ResultAnalysisResults::Expectation
         j["min"]          = Min;
         j["max"]          = Max;
         j["values"]       = Values;
+        j["statistics"]   = Statistics.serialize();
         j["min_observed"] = MinObserved;
         j["max_observed"] = MaxObserved;
         j["mean"]         = Mean;
@@ -138,7 +185,10 @@ struct ToBeValueBase : public ResultAnalysisResults::Expectation
     float              Expected = 0;
     float              Min      = 0;
     float              Max      = 0;
-    std::vector<float> Values   = {};
+    //! Every value, only kept if KeepValues is set, for the exact median and mode.
+    std::vector<float> Values     = {};
+    bool               KeepValues = false;
+    ValueStatistics    Statistics = {};
 
     float MinObserved = std::numeric_limits<float>::max();
     float MaxObserved = std::numeric_limits<float>::lowest();
@@ -155,25 +205,105 @@ struct ToBeValueBase : public ResultAnalysisResults::Expectation
     int                  Bins           = ImPlotBin_Sqrt;
 
 private:
+    struct Histogram
+    {
+        std::vector<double>  Centers = {};
+        std::vector<double>  Counts  = {};
+        double               Width   = 1.0;
+        int                  Bins    = 0;
+        ImPlotHistogramFlags Flags   = {};
+    };
+    Histogram m_histogram = {};    //!< Estimated histogram, for the current settings.
+
+    void AddNumber(float value)
+    {
+        Statistics.Add(value);
+        if (KeepValues) { Values.push_back(value); }
+    }
+
     void FindMedian()
     {
+        const size_t middle = Values.size() / 2;
         if ((Values.size() % 2) == 1)
         {
             // Odd size, median is right at the middle.
-            if (Values.size() == 1) { Median = Values[0]; }
-            else { Median = Values[(Values.size() / 2) + 1]; }
+            Median = Values[middle];
         }
         else
         {
             // Even size, median is the average of the two values around the middle.
-            if (Values.empty()) { Median = 0.0f; }
-            else if (Values.size() == 2) { Median = (Values[0] + Values[1]) / 2.0f; }
-            else
-            {
-                size_t idx = (Values.size() / 2);
-                Median     = (Values[idx] + Values[idx + 1]) / 2.0f;
-            }
+            Median = (Values[middle - 1] + Values[middle]) / 2.0f;
+        }
+    }
+
+    //! Middle of the fullest bin of the estimated distribution.
+    void FindEstimatedMode()
+    {
+        if (Range <= 0.0f)
+        {
+            Mode = MinObserved;
+            return;
+        }
+        const size_t bins   = std::clamp<size_t>(static_cast<size_t>(std::sqrt(Statistics.Count())), 1, 100);
+        const auto   counts = Statistics.Histogram(MinObserved, MaxObserved, bins);
+        const auto   fullest = static_cast<size_t>(std::ranges::max_element(counts) - counts.begin());
+        Mode = MinObserved + ((static_cast<float>(fullest) + 0.5f) * Range / static_cast<float>(bins));
+    }
+
+    //! Histogram of the statistics, with the bins and flags of the settings. Empty if there are no statistics.
+    const Histogram& EstimatedHistogram()
+    {
+        if (Statistics.Count() == 0)
+        {
+            m_histogram = {};
+            return m_histogram;
+        }
+        if (m_histogram.Bins == Bins && m_histogram.Flags == HistogramFlags && !m_histogram.Counts.empty())
+        {
+            return m_histogram;
+        }
+
+        const double count = static_cast<double>(Statistics.Count());
+        double       min   = MinObserved;
+        double       max   = MaxObserved;
+        if (max <= min)
+        {
+            min -= 0.5;
+            max += 0.5;
+        }
+        size_t bins = 0;
+        switch (Bins)
+        {
+            case ImPlotBin_Sqrt: bins = static_cast<size_t>(std::ceil(std::sqrt(count))); break;
+            case ImPlotBin_Sturges: bins = static_cast<size_t>(std::ceil(std::log2(count))) + 1; break;
+            case ImPlotBin_Rice: bins = static_cast<size_t>(std::ceil(2.0 * std::cbrt(count))); break;
+            case ImPlotBin_Scott:
+                bins = StdDev > 0.0f
+                         ? static_cast<size_t>(std::ceil((max - min) / (3.49 * StdDev / std::cbrt(count))))
+                         : 1;
+                break;
+            default: bins = static_cast<size_t>(std::max(Bins, 1)); break;
+        }
+        bins = std::clamp<size_t>(bins, 1, 1000);
+
+        m_histogram        = {.Width = (max - min) / static_cast<double>(bins), .Bins = Bins, .Flags = HistogramFlags};
+        m_histogram.Counts = Statistics.Histogram(min, max, bins);
+        for (size_t i = 0; i < bins; ++i)
+        {
+            m_histogram.Centers.push_back(min + ((static_cast<double>(i) + 0.5) * m_histogram.Width));
         }
+        if ((HistogramFlags & ImPlotHistogramFlags_Cumulative) != 0)
+        {
+            for (size_t i = 1; i < bins; ++i) { m_histogram.Counts[i] += m_histogram.Counts[i - 1]; }
+        }
+        if ((HistogramFlags & ImPlotHistogramFlags_Density) != 0 && count > 0.0)
+        {
+            // As ImPlot does, a cumulative density ends at 1.
+            const double scale = (HistogramFlags & ImPlotHistogramFlags_Cumulative) != 0 ? count
+                                                                                         : count * m_histogram.Width;
+            for (auto&& bin : m_histogram.Counts) { bin /= scale; }
+        }
+        return m_histogram;
     }
 
     void FindMode()
@@ -201,16 +331,6 @@ private:
         }
     }
 
-    void FindStdDev()
-    {
-        StdDev = std::accumulate(
-          Values.begin(),
-          Values.end(),
-          0.0f,
-          [mean = Mean](float tot, float value) { return tot + std::pow(value - mean, 2.0f); });
-        StdDev = std::sqrt(StdDev / static_cast<float>(Values.size()));
-    }
-
     void FindPpPpk()
     {
         /**
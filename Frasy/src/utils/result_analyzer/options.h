@@ -19,6 +19,7 @@
 #define FRASY_SRC_UTILS_RESULT_ANALYZER_OPTIONS_H
 
 #include <array>
+#include <cstddef>
 #include <vector>
 
 namespace Frasy::Analyzers
@@ -30,7 +31,9 @@ struct ResultOptions
     std::vector<std::array<char, 32>> Sequences     = {};    //!< Sequences to analyze.
     std::vector<std::array<char, 32>> Tests         = {};    //!< Tests to analyze.
 
-    bool Ganged = true;                                      //!< Combine the results of all UUT locations together.
+    bool        Ganged     = true;     //!< Combine the results of all UUT locations together.
+    bool        KeepValues = false;    //!< Keep every value of the numeric expectations, for exact medians and modes.
+    std::size_t Threads    = 0;        //!< Threads reading the reports, 0 to use one per core.
 };
 }    // namespace Frasy::Analyzers
 #endif    // FRASY_SRC_UTILS_RESULT_ANALYZER_OPTIONS_H
@@ -0,0 +1,133 @@
+/**
+ * @file    report_file.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#include "report_file.h"
+
+#include <Brigerad.h>
+#include <Brigerad/Debug/Instrumentor.h>
+#include <array>
+#include <format>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+namespace Frasy::Analyzers {
+namespace {
+namespace fs = std::filesystem;
+
+//! Self-described CBOR tag (RFC 8949, 3.4.6).
+constexpr std::array<uint8_t, 3> s_cborMagic = {0xD9, 0xD9, 0xF7};
+
+std::string ReadFile(const fs::path& path)
+{
+    std::ifstream file {path, std::ios::binary};
+    if (!file) { throw std::runtime_error(std::format("Unable to open '{}'", path.string())); }
+    return {std::istreambuf_iterator<char> {file}, {}};
+}
+}    // namespace
+
+nlohmann::json ReportFile::Load(const std::filesystem::path& path)
+{
+    BR_PROFILE_FUNCTION();
+    const std::string content = ReadFile(path);
+    const bool isCbor = content.size() >= s_cborMagic.size() &&
+                        std::equal(s_cborMagic.begin(), s_cborMagic.end(), content.begin(), [](uint8_t magic, char c) {
+                            return magic == static_cast<uint8_t>(c);
+                        });
+    if (isCbor) { return nlohmann::json::from_cbor(content.begin() + s_cborMagic.size(), content.end()); }
+    return nlohmann::json::parse(content);
+}
+
+void ReportFile::Save(const nlohmann::json& document, const std::filesystem::path& path, Format format)
+{
+    BR_PROFILE_FUNCTION();
+    fs::path temporary = path;
+    temporary += ".tmp";
+    {
+        std::ofstream file {temporary, std::ios::binary | std::ios::trunc};
+        if (!file) { throw std::runtime_error(std::format("Unable to write '{}'", temporary.string())); }
+        if (format == Format::Cbor) {
+            std::vector<uint8_t> bytes(s_cborMagic.begin(), s_cborMagic.end());
+            nlohmann::json::to_cbor(document, bytes);
+            file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        }
+        else {
+            file << document.dump(2, ' ', false, nlohmann::detail::error_handler_t::replace);
+        }
+        if (!file) { throw std::runtime_error(std::format("Unable to write '{}'", temporary.string())); }
+    }
+    fs::rename(temporary, path);
+}
+
+std::optional<ReportFile::Format> ReportFile::ParseFormat(std::string_view name)
+{
+    if (name == "json") { return Format::Json; }
+    if (name == "cbor") { return Format::Cbor; }
+    return std::nullopt;
+}
+
+std::string_view ReportFile::ExtensionOf(Format format)
+{
+    return format == Format::Cbor ? s_cborExtension : s_jsonExtension;
+}
+
+std::string_view ReportFile::ArchiveKey(std::string_view file)
+{
+    const size_t name = file.find_last_of('/') == std::string_view::npos ? 0 : file.find_last_of('/') + 1;
+    const size_t dot  = file.find_last_of('.');
+    return dot == std::string_view::npos || dot < name ? file : file.substr(0, dot);
+}
+
+ReportFile::Conversion ReportFile::ConvertArchive(const std::filesystem::path& root,
+                                                  Format                       format,
+                                                  const std::atomic<bool>*     cancelled)
+{
+    BR_PROFILE_FUNCTION();
+    const std::string_view extension = ExtensionOf(format);
+    Conversion             conversion;
+    for (std::string_view directory : {"fail", "pass"}) {
+        if (!fs::exists(root / directory)) { continue; }
+
+        std::vector<fs::path> files;
+        for (const auto& entry : fs::recursive_directory_iterator(root / directory)) {
+            const auto current = entry.path().extension();
+            if (entry.is_regular_file() && current != extension &&
+                (current == s_jsonExtension || current == s_cborExtension)) {
+                files.push_back(entry.path());
+            }
+        }
+
+        for (const auto& file : files) {
+            if (cancelled != nullptr && *cancelled) { return conversion; }
+            try {
+                fs::path converted = file;
+                converted.replace_extension(extension);
+                const auto size = fs::file_size(file);
+                Save(Load(file), converted, format);
+                fs::remove(file);
+                conversion.Converted++;
+                conversion.BytesBefore += size;
+                conversion.BytesAfter += fs::file_size(converted);
+            }
+            catch (std::exception& e) {
+                BR_LOG_ERROR("Analyzer", "Unable to convert '{}': {}", file.string(), e.what());
+                conversion.Failed++;
+            }
+        }
+    }
+    return conversion;
+}
+}    // namespace Frasy::Analyzers
@@ -0,0 +1,81 @@
+/**
+ * @file    report_file.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#ifndef FRASY_SRC_UTILS_RESULT_ANALYZER_REPORT_FILE_H
+#define FRASY_SRC_UTILS_RESULT_ANALYZER_REPORT_FILE_H
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <json.hpp>
+#include <optional>
+#include <string_view>
+
+namespace Frasy::Analyzers {
+/**
+ * A report, or any other JSON document, stored either as text or as CBOR.
+ *
+ * A CBOR file starts with the self-described CBOR tag, which no JSON text can start with, so the two are told apart by
+ * their content whatever their extension. CBOR drops the whitespace of the text and stores the numbers in binary, an
+ * archived report takes a fraction of the space.
+ */
+class ReportFile {
+public:
+    enum class Format {
+        Json,
+        Cbor,
+    };
+
+    //! Extension of the reports archived as text, in logs/<title>/pass and fail.
+    static constexpr std::string_view s_jsonExtension = ".txt";
+    static constexpr std::string_view s_cborExtension = ".cbor";
+
+    //! Outcome of ConvertArchive().
+    struct Conversion {
+        std::size_t Converted   = 0;
+        std::size_t Failed      = 0;
+        uint64_t    BytesBefore = 0;    //!< Size of the converted reports, before.
+        uint64_t    BytesAfter  = 0;    //!< Size of the converted reports, after.
+    };
+
+    /**
+     * Reads a document in either format.
+     *
+     * @throws nlohmann::json::exception if it isn't valid in its format.
+     * @throws std::runtime_error if it can't be read.
+     */
+    static nlohmann::json Load(const std::filesystem::path& path);
+    //! Writes a document in format, replacing the file in one step so that it is never seen half written.
+    static void           Save(const nlohmann::json& document, const std::filesystem::path& path, Format format);
+
+    //! Format of a name given on the command line, "json" or "cbor".
+    static std::optional<Format> ParseFormat(std::string_view name);
+    static std::string_view      ExtensionOf(Format format);
+    //! Path of an archived report without its extension, the same for every format of the report.
+    static std::string_view      ArchiveKey(std::string_view file);
+
+    /**
+     * Converts the reports archived in root/pass and root/fail to format. Each report is written in its new format
+     * before the old file is deleted, the conversion can be stopped at any time and started again.
+     */
+    static Conversion ConvertArchive(const std::filesystem::path& root,
+                                     Format                       format,
+                                     const std::atomic<bool>*     cancelled = nullptr);
+};
+}    // namespace Frasy::Analyzers
+
+#endif    // FRASY_SRC_UTILS_RESULT_ANALYZER_REPORT_FILE_H
@@ -0,0 +1,419 @@
+/**
+ * @file    result_index.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <https://www.gnu.org/licenses/>.
+ */
+#include "result_index.h"
+
+#include <Brigerad.h>
+#include <Brigerad/Debug/Instrumentor.h>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace Frasy::Analyzers {
+namespace {
+namespace fs = std::filesystem;
+
+constexpr uint32_t         s_magic       = 0x58444946;    // "FIDX"
+constexpr uint32_t         s_version     = 1;
+constexpr std::string_view s_commitFile  = "commit";
+constexpr std::string_view s_stringsFile = "strings";
+
+//! Fields of an expectation that don't change from a report to the next.
+constexpr std::array<std::string_view, 7> s_definitionFields = {
+  "method", "name", "expected", "min", "max", "deviation", "percentage"};
+constexpr std::array<std::string_view, 7> s_numericMethods = {"ToBeNear",
+                                                              "ToBeInRange",
+                                                              "ToBeInPercentage",
+                                                              "ToBeGreater",
+                                                              "ToBeGreaterOrEqual",
+                                                              "ToBeLesser",
+                                                              "ToBeLesserOrEqual"};
+constexpr std::array<std::string_view, 4> s_otherMethods   = {"ToBeTrue", "ToBeFalse", "ToBeEqual", "ToBeType"};
+
+//! Content of the commit file, the rows of every table visible to the readers.
+struct Counts {
+    uint32_t Magic        = s_magic;
+    uint32_t Version      = s_version;
+    uint64_t StringBytes  = 0;
+    uint64_t Strings      = 0;
+    uint64_t Reports      = 0;
+    uint64_t Sequences    = 0;
+    uint64_t Tests        = 0;
+    uint64_t Expectations = 0;
+
+    bool operator==(const Counts&) const = default;
+};
+
+struct StringHash {
+    using is_transparent = void;
+    std::size_t operator()(std::string_view str) const { return std::hash<std::string_view> {}(str); }
+};
+
+//! What an append needs to know about an index, kept between the appends of this process.
+struct Writer {
+    Counts                                                                 Committed;
+    std::unordered_map<std::string, uint32_t, StringHash, std::equal_to<>> Ids;
+};
+
+std::mutex                 s_lock;
+std::map<fs::path, Writer> s_writers;
+
+template<typename Index, typename Fn>
+void ForEachColumn(Index& index, const Counts& counts, Fn&& fn)
+{
+    fn("reports.file", index.Reports.File, counts.Reports);
+    fn("reports.serial", index.Reports.Serial, counts.Reports);
+    fn("reports.uut", index.Reports.Uut, counts.Reports);
+    fn("reports.flags", index.Reports.Flags, counts.Reports);
+    fn("reports.timestamp", index.Reports.Timestamp, counts.Reports);
+    fn("reports.duration", index.Reports.Duration, counts.Reports);
+    fn("sequences.report", index.Sequences.Report, counts.Sequences);
+    fn("sequences.name", index.Sequences.Name, counts.Sequences);
+    fn("sequences.flags", index.Sequences.Flags, counts.Sequences);
+    fn("sequences.duration", index.Sequences.Duration, counts.Sequences);
+    fn("tests.sequence", index.Tests.Sequence, counts.Tests);
+    fn("tests.name", index.Tests.Name, counts.Tests);
+    fn("tests.flags", index.Tests.Flags, counts.Tests);
+    fn("tests.duration", index.Tests.Duration, counts.Tests);
+    fn("expectations.test", index.Expectations.Test, counts.Expectations);
+    fn("expectations.name", index.Expectations.Name, counts.Expectations);
+    fn("expectations.definition", index.Expectations.Definition, counts.Expectations);
+    fn("expectations.text", index.Expectations.Text, counts.Expectations);
+    fn("expectations.flags", index.Expectations.Flags, counts.Expectations);
+    fn("expectations.value", index.Expectations.Value, counts.Expectations);
+}
+
+Counts RowsOf(const ResultIndex& index)
+{
+    return {
+      .Reports      = index.Reports.Flags.size(),
+      .Sequences    = index.Sequences.Flags.size(),
+      .Tests        = index.Tests.Flags.size(),
+      .Expectations = index.Expectations.Flags.size(),
+    };
+}
+
+[[noreturn]] void ThrowCorrupted(const fs::path& path, std::string_view what)
+{
+    throw std::runtime_error(std::format("Result index file '{}' is corrupted: {}", path.string(), what));
+}
+
+std::optional<Counts> ReadCounts(const fs::path& directory)
+{
+    const fs::path path = directory / s_commitFile;
+    std::ifstream  file(path, std::ios::binary);
+    if (!file.is_open()) { return std::nullopt; }
+    Counts counts;
+    file.read(reinterpret_cast<char*>(&counts), sizeof(counts));
+    if (!file || counts.Magic != s_magic) { ThrowCorrupted(path, "invalid header"); }
+    if (counts.Version != s_version) { ThrowCorrupted(path, std::format("unknown version {}", counts.Version)); }
+    return counts;
+}
+
+void WriteCounts(const fs::path& directory, const Counts& counts)
+{
+    // Renamed over the previous one once complete, the readers never see half of it.
+    const fs::path path      = directory / s_commitFile;
+    fs::path       temporary = path;
+    temporary += ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&counts), sizeof(counts));
+        if (!file) { throw std::runtime_error(std::format("Unable to write '{}'", temporary.string())); }
+    }
+    fs::rename(temporary, path);
+}
+
+//! Discards what an interrupted append wrote past the committed bytes of a file.
+void TruncateTo(const fs::path& path, uint64_t bytes)
+{
+    std::error_code ec;
+    const auto      size = fs::file_size(path, ec);
+    if (ec) {
+        if (bytes != 0) { ThrowCorrupted(path, "missing"); }
+        return;
+    }
+    if (size < bytes) { ThrowCorrupted(path, "shorter than its committed rows"); }
+    if (size > bytes) { fs::resize_file(path, bytes); }
+}
+
+template<typename T>
+void ReadColumn(const fs::path& path, uint64_t rows, std::vector<T>& column)
+{
+    column.resize(rows);
+    if (rows == 0) { return; }
+    std::ifstream file(path, std::ios::binary);
+    file.read(reinterpret_cast<char*>(column.data()), static_cast<std::streamsize>(rows * sizeof(T)));
+    if (!file) { ThrowCorrupted(path, "shorter than its committed rows"); }
+}
+
+template<typename T>
+void AppendColumn(const fs::path& path, uint64_t committedRows, const std::vector<T>& rows)
+{
+    TruncateTo(path, committedRows * sizeof(T));
+    std::ofstream file(path, std::ios::binary | std::ios::app);
+    file.write(reinterpret_cast<const char*>(rows.data()), static_cast<std::streamsize>(rows.size() * sizeof(T)));
+    if (!file) { throw std::runtime_error(std::format("Unable to write '{}'", path.string())); }
+}
+
+//! The strings are stored one after the other, each preceded by its length on 32 bits.
+std::vector<std::string> ReadStrings(const fs::path& path, const Counts& counts)
+{
+    std::vector<char> bytes(counts.StringBytes);
+    if (!bytes.empty()) {
+        std::ifstream file(path, std::ios::binary);
+        file.read(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        if (!file) { ThrowCorrupted(path, "shorter than its committed strings"); }
+    }
+
+    std::vector<std::string> strings;
+    strings.reserve(counts.Strings);
+    std::size_t offset = 0;
+    while (strings.size() < counts.Strings) {
+        uint32_t length = 0;
+        if (offset + sizeof(length) > bytes.size()) { ThrowCorrupted(path, "truncated string"); }
+        std::memcpy(&length, bytes.data() + offset, sizeof(length));
+        offset += sizeof(length);
+        if (offset + length > bytes.size()) { ThrowCorrupted(path, "truncated string"); }
+        strings.emplace_back(bytes.data() + offset, length);
+        offset += length;
+    }
+    return strings;
+}
+
+uint64_t AppendStrings(const fs::path& path, uint64_t committedBytes, const std::vector<std::string>& strings)
+{
+    TruncateTo(path, committedBytes);
+    std::string bytes;
+    for (const auto& str : strings) {
+        const auto length = static_cast<uint32_t>(str.size());
+        bytes.append(reinterpret_cast<const char*>(&length), sizeof(length));
+        bytes.append(str);
+    }
+    std::ofstream file(path, std::ios::binary | std::ios::app);
+    file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    if (!file) { throw std::runtime_error(std::format("Unable to write '{}'", path.string())); }
+    return bytes.size();
+}
+
+void CheckReferences(const std::vector<uint32_t>& column, uint64_t limit, std::string_view name, bool optional)
+{
+    for (uint32_t id : column) {
+        if (id >= limit && !(optional && id == ResultIndex::s_noString)) {
+            throw std::runtime_error(std::format("Result index column '{}' refers to a missing row", name));
+        }
+    }
+}
+
+//! The rows of a table follow the order of their parents, so the children of a range of parents are a range of rows.
+void CheckOrder(const std::vector<uint32_t>& column, std::string_view name)
+{
+    if (!std::ranges::is_sorted(column)) {
+        throw std::runtime_error(std::format("Result index column '{}' isn't in the order of its parents", name));
+    }
+}
+
+Writer& GetWriter(const fs::path& directory)
+{
+    const Counts counts = ReadCounts(directory).value_or(Counts {});
+    if (auto it = s_writers.find(directory); it != s_writers.end() && it->second.Committed == counts) {
+        return it->second;
+    }
+
+    // Never appended to by this process, or changed since: its dictionary is loaded again.
+    Writer writer {.Committed = counts, .Ids = {}};
+    auto   strings = ReadStrings(directory / s_stringsFile, counts);
+    writer.Ids.reserve(strings.size());
+    for (uint32_t id = 0; id < strings.size(); ++id) { writer.Ids.try_emplace(std::move(strings[id]), id); }
+    return s_writers[directory] = std::move(writer);
+}
+
+uint8_t FlagsOf(const nlohmann::json& data)
+{
+    uint8_t flags = 0;
+    if (data.at("enabled").get<bool>()) { flags |= ResultIndex::Enabled; }
+    if (data.at("skipped").get<bool>()) { flags |= ResultIndex::Skipped; }
+    if (data.at("pass").get<bool>()) { flags |= ResultIndex::Passed; }
+    return flags;
+}
+
+using Intern = std::function<uint32_t(std::string_view)>;
+
+//! Adds the rows of the sequences, tests and expectations of a report.
+void FlattenReport(const nlohmann::json& report, ResultIndex& batch, const Counts& base, const Intern& intern)
+{
+    const auto reportRow = static_cast<uint32_t>(base.Reports + batch.Reports.Flags.size());
+    for (auto&& [sequenceName, sequence] : report.at("sequences").items()) {
+        const auto sequenceRow = static_cast<uint32_t>(base.Sequences + batch.Sequences.Flags.size());
+        batch.Sequences.Report.push_back(reportRow);
+        batch.Sequences.Name.push_back(intern(sequenceName));
+        batch.Sequences.Flags.push_back(FlagsOf(sequence));
+        batch.Sequences.Duration.push_back(sequence.at("time").at("process").get<double>());
+
+        for (auto&& [testName, test] : sequence.at("tests").items()) {
+            const auto testRow = static_cast<uint32_t>(base.Tests + batch.Tests.Flags.size());
+            batch.Tests.Sequence.push_back(sequenceRow);
+            batch.Tests.Name.push_back(intern(testName));
+            batch.Tests.Flags.push_back(FlagsOf(test));
+            batch.Tests.Duration.push_back(test.at("time").at("process").get<double>());
+
+            for (const auto& expectation : test.at("expectations")) {
+                // The analyzer can't tell apart the expectations without a name, nor use those it doesn't know.
+                if (!expectation.contains("name")) { continue; }
+                const auto method  = expectation.at("method").get<std::string_view>();
+                const bool numeric = std::ranges::find(s_numericMethods, method) != s_numericMethods.end();
+                if (!numeric && std::ranges::find(s_otherMethods, method) == s_otherMethods.end()) { continue; }
+
+                nlohmann::json definition = nlohmann::json::object();
+                for (auto field : s_definitionFields) {
+                    if (auto it = expectation.find(field); it != expectation.end()) { definition[field] = *it; }
+                }
+                const auto value = expectation.find("value");
+
+                batch.Expectations.Test.push_back(testRow);
+                batch.Expectations.Name.push_back(intern(expectation.at("name").get<std::string_view>()));
+                batch.Expectations.Definition.push_back(intern(definition.dump()));
+                batch.Expectations.Flags.push_back(expectation.at("pass").get<bool>() ? ResultIndex::Passed : 0);
+                if (numeric) {
+                    batch.Expectations.Text.push_back(ResultIndex::s_noString);
+                    batch.Expectations.Value.push_back(value != expectation.end() && value->is_number()
+                                                         ? value->get<float>()
+                                                         : std::numeric_limits<float>::quiet_NaN());
+                }
+                else {
+                    batch.Expectations.Text.push_back(
+                      intern(value != expectation.end() ? value->dump(2, ' ', true) : std::string {"null"}));
+                    batch.Expectations.Value.push_back(std::numeric_limits<float>::quiet_NaN());
+                }
+            }
+        }
+    }
+}
+}    // namespace
+
+ResultIndex ResultIndex::Load(const std::filesystem::path& directory)
+{
+    BR_PROFILE_FUNCTION();
+    ResultIndex index;
+    const auto  counts = ReadCounts(directory);
+    if (!counts.has_value()) { return index; }
+
+    index.m_strings = ReadStrings(directory / s_stringsFile, *counts);
+    ForEachColumn(index, *counts, [&directory](std::string_view name, auto& column, uint64_t rows) {
+        ReadColumn(directory / name, rows, column);
+    });
+
+    CheckReferences(index.Reports.File, counts->Strings, "reports.file", false);
+    CheckReferences(index.Reports.Serial, counts->Strings, "reports.serial", false);
+    CheckReferences(index.Sequences.Report, counts->Reports, "sequences.report", false);
+    CheckReferences(index.Sequences.Name, counts->Strings, "sequences.name", false);
+    CheckReferences(index.Tests.Sequence, counts->Sequences, "tests.sequence", false);
+    CheckReferences(index.Tests.Name, counts->Strings, "tests.name", false);
+    CheckReferences(index.Expectations.Test, counts->Tests, "expectations.test", false);
+    CheckReferences(index.Expectations.Name, counts->Strings, "expectations.name", false);
+    CheckReferences(index.Expectations.Definition, counts->Strings, "expectations.definition", false);
+    CheckReferences(index.Expectations.Text, counts->Strings, "expectations.text", true);
+    CheckOrder(index.Sequences.Report, "sequences.report");
+    CheckOrder(index.Tests.Sequence, "tests.sequence");
+    CheckOrder(index.Expectations.Test, "expectations.test");
+    return index;
+}
+
+void ResultIndex::Append(const std::filesystem::path& directory, std::span<const Entry> entries)
+{
+    BR_PROFILE_FUNCTION();
+    if (entries.empty()) { return; }
+
+    std::lock_guard lock {s_lock};
+    fs::create_directories(directory);
+    Writer&      writer = GetWriter(directory);
+    const Counts base   = writer.Committed;
+
+    ResultIndex batch;
+    Intern      intern = [&](std::string_view str) -> uint32_t {
+        auto [it, inserted] =
+          writer.Ids.try_emplace(std::string {str}, static_cast<uint32_t>(base.Strings + batch.m_strings.size()));
+        if (inserted) { batch.m_strings.push_back(it->first); }
+        return it->second;
+    };
+
+    try {
+        for (const auto& entry : entries) {
+            uint8_t  flags    = 0;
+            uint32_t serial   = 0;
+            uint32_t uut      = 0;
+            double   duration = 0.0;
+            Counts   rows     = RowsOf(batch);
+            try {
+                const auto& info = entry.Report.at("info");
+                serial           = intern(info.at("serial").get<std::string_view>());
+                uut              = info.at("uut").get<uint32_t>();
+                duration         = info.at("time").at("process").get<double>();
+                flags            = info.at("pass").get<bool>() ? Passed : 0;
+                FlattenReport(entry.Report, batch, base, intern);
+            }
+            catch (const nlohmann::json::exception& e) {
+                BR_LOG_ERROR("Analyzer", "Unable to index '{}': {}", entry.File, e.what());
+                ForEachColumn(batch, rows, [](std::string_view, auto& column, uint64_t size) {
+                    column.resize(size);
+                });
+                flags = Invalid;
+            }
+            batch.Reports.File.push_back(intern(entry.File));
+            batch.Reports.Serial.push_back(serial);
+            batch.Reports.Uut.push_back(uut);
+            batch.Reports.Flags.push_back(flags);
+            batch.Reports.Timestamp.push_back(entry.Timestamp);
+            batch.Reports.Duration.push_back(duration);
+        }
+
+        const Counts added     = RowsOf(batch);
+        Counts       committed = base;
+        committed.StringBytes += AppendStrings(directory / s_stringsFile, base.StringBytes, batch.m_strings);
+        committed.Strings += batch.m_strings.size();
+        committed.Reports += added.Reports;
+        committed.Sequences += added.Sequences;
+        committed.Tests += added.Tests;
+        committed.Expectations += added.Expectations;
+        ForEachColumn(batch, base, [&directory](std::string_view name, const auto& column, uint64_t rows) {
+            AppendColumn(directory / name, rows, column);
+        });
+        WriteCounts(directory, committed);
+        writer.Committed = committed;
+    }
+    catch (...) {
+        // The dictionary now holds strings that were never committed.
+        s_writers.erase(directory);
+        throw;
+    }
+}
+
+void ResultIndex::Remove(const std::filesystem::path& directory)
+{
+    std::lock_guard lock {s_lock};
+    s_writers.erase(directory);
+    fs::remove_all(directory);
+}
+}    // namespace Frasy::Analyzers
@@ -0,0 +1,120 @@
+/**
+ * @file    result_index.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#ifndef FRASY_SRC_UTILS_RESULT_ANALYZER_RESULT_INDEX_H
+#define FRASY_SRC_UTILS_RESULT_ANALYZER_RESULT_INDEX_H
+
+#include <cstdint>
+#include <filesystem>
+#include <json.hpp>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Frasy::Analyzers {
+/**
+ * Append-only columnar store of the reports archived for a product, kept next to them in logs/<title>/index.
+ *
+ * Every report is flattened into rows of four tables (reports, sequences, tests and expectations), each row pointing
+ * to the row of its parent. Each column of a table is a file of packed values, names and texts are interned in a
+ * dictionary of strings. Loading an index is a handful of reads, instead of parsing every report again. The rows of a
+ * table are in the order of their parents, the children of a range of reports are thus a range of rows of each table.
+ *
+ * The rows are only visible once committed: Append() writes the columns first, then the number of rows of every table
+ * in the commit file. Whatever was written past the committed rows, by an append that was interrupted, is discarded by
+ * the next one. The columns are in the byte order of the machine that wrote them.
+ */
+class ResultIndex {
+public:
+    static constexpr std::string_view s_directory = "index";
+    static constexpr uint32_t         s_noString  = UINT32_MAX;
+
+    enum Flags : uint8_t {
+        Enabled = 1 << 0,
+        Skipped = 1 << 1,
+        Passed  = 1 << 2,
+        Invalid = 1 << 3,    //!< Report that couldn't be read, only its file is known.
+    };
+
+    struct ReportColumns {
+        std::vector<uint32_t> File;         //!< Path of the report, relative to logs/<title>.
+        std::vector<uint32_t> Serial;
+        std::vector<uint32_t> Uut;
+        std::vector<uint8_t>  Flags;
+        std::vector<int64_t>  Timestamp;    //!< When the report was archived, in ticks of the system clock.
+        std::vector<double>   Duration;
+    };
+    struct SequenceColumns {
+        std::vector<uint32_t> Report;
+        std::vector<uint32_t> Name;
+        std::vector<uint8_t>  Flags;
+        std::vector<double>   Duration;
+    };
+    struct TestColumns {
+        std::vector<uint32_t> Sequence;
+        std::vector<uint32_t> Name;
+        std::vector<uint8_t>  Flags;
+        std::vector<double>   Duration;
+    };
+    struct ExpectationColumns {
+        std::vector<uint32_t> Test;
+        std::vector<uint32_t> Name;
+        std::vector<uint32_t> Definition;    //!< Method and parameters of the expectation, as JSON.
+        std::vector<uint32_t> Text;          //!< Value checked by the non-numeric expectations, as JSON.
+        std::vector<uint8_t>  Flags;
+        std::vector<float>    Value;         //!< Value checked by the numeric expectations, NaN if not a number.
+    };
+
+    //! A report to add to the index.
+    struct Entry {
+        std::string    File;    //!< Path of the report, relative to logs/<title>.
+        int64_t        Timestamp = 0;
+        nlohmann::json Report;
+    };
+
+    /**
+     * Loads the committed rows of the index kept in directory.
+     *
+     * @return An empty index if there is none yet.
+     * @throws std::runtime_error if the index is corrupted.
+     */
+    static ResultIndex Load(const std::filesystem::path& directory);
+    /**
+     * Adds reports to the index kept in directory, creating it if needed. The reports are committed all at once.
+     *
+     * A report that isn't in the format of the orchestrator is only recorded as Invalid, so it isn't read again.
+     * Appends to the same index are serialized across threads.
+     */
+    static void Append(const std::filesystem::path& directory, std::span<const Entry> entries);
+    //! Deletes the index kept in directory, to build it again from the reports.
+    static void Remove(const std::filesystem::path& directory);
+
+    [[nodiscard]] const std::string& String(uint32_t id) const { return m_strings[id]; }
+    [[nodiscard]] std::size_t        StringCount() const { return m_strings.size(); }
+
+    ReportColumns      Reports;
+    SequenceColumns    Sequences;
+    TestColumns        Tests;
+    ExpectationColumns Expectations;
+
+private:
+    std::vector<std::string> m_strings;
+};
+}    // namespace Frasy::Analyzers
+
+#endif    // FRASY_SRC_UTILS_RESULT_ANALYZER_RESULT_INDEX_H
@@ -26,8 +26,10 @@
 #include "expectations/to_be_true.h"
 #include "expectations/to_be_type.h"
 #include "expectations/to_be_value_base.h"
+#include "report_file.h"
 
 #include <Brigerad/Debug/Instrumentor.h>
+#include <filesystem>
 #include <fstream>
 #include <json.hpp>
 
@@ -36,20 +38,6 @@ namespace Frasy::Analyzers
 
 namespace
 {
-nlohmann::json LoadJson(const std::string& path)
-{
-    BR_PROFILE_FUNCTION();
-    std::ifstream j(path);
-
-    std::string fullFile;
-    std::string line;
-
-    while (std::getline(j, line)) { fullFile += line; }
-    j.close();
-
-    return nlohmann::json::parse(fullFile);
-}
-
 void LoadToBeValueExpectation(std::shared_ptr<ResultAnalysisResults::Expectation>& expectation,
                               const nlohmann::json&                                data)
 {
@@ -69,6 +57,13 @@ void LoadToBeValueExpectation(std::shared_ptr<ResultAnalysisResults::Expectation
     ptr->StdDev        = data.at("std_dev").get<float>();
     ptr->Pp            = data.at("pp").get<float>();
     ptr->Ppk           = data.at("ppk").get<float>();
+    ptr->KeepValues    = !ptr->Values.empty();
+    if (data.contains("statistics")) { ptr->Statistics = ValueStatistics::deserialize(data.at("statistics")); }
+    else
+    {
+        // Saved before the statistics were, they are made again from the values.
+        for (float value : ptr->Values) { ptr->Statistics.Add(value); }
+    }
 }
 
 std::shared_ptr<ResultAnalysisResults::Expectation> LoadToBeInPercentageExpectation(const nlohmann::json& data)
@@ -236,7 +231,7 @@ ResultAnalysisResults::Location LoadLocation(const nlohmann::json& data)
 
 ResultAnalysisResults Load(const std::string& path)
 {
-    auto                  j       = LoadJson(path);
+    auto                  j       = ReportFile::Load(path);
     ResultAnalysisResults results = {};
 
     for (auto&& [name, location] : j.items()) { results.Locations[name] = LoadLocation(location); }
@@ -311,6 +306,12 @@ void Save(const ResultAnalysisResults& results, const std::string& path)
 
     for (auto&& [name, location] : results.Locations) { j[name] = SaveLocation(location); }
 
+    // The analysis of a large archive is much smaller in CBOR, it is used for the files named so.
+    if (std::filesystem::path(path).extension() == ReportFile::s_cborExtension) {
+        ReportFile::Save(j, path, ReportFile::Format::Cbor);
+        return;
+    }
+
     std::ofstream file = std::ofstream(path);
 
     file << j.dump(2, ' ', true, nlohmann::detail::error_handler_t::replace);
@@ -0,0 +1,233 @@
+/**
+ * @file    value_statistics.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#include "value_statistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+
+namespace Frasy::Analyzers {
+namespace {
+//! Values added before they are folded into the clusters.
+constexpr std::size_t s_bufferSize = static_cast<std::size_t>(ValueStatistics::s_compression) * 5;
+
+/**
+ * Scale of the clusters: a cluster spans at most one unit of k. k is steep near the tails, where the clusters are thus
+ * small, and flat around the median.
+ */
+double K(double q)
+{
+    return ValueStatistics::s_compression / (2.0 * std::numbers::pi) * std::asin((2.0 * q) - 1.0);
+}
+
+double KInverse(double k)
+{
+    k = std::min(k, ValueStatistics::s_compression / 4.0);
+    return (std::sin(k * 2.0 * std::numbers::pi / ValueStatistics::s_compression) + 1.0) / 2.0;
+}
+}    // namespace
+
+void ValueStatistics::Add(double value)
+{
+    if (m_count == 0) {
+        m_min = value;
+        m_max = value;
+    }
+    else {
+        m_min = std::min(m_min, value);
+        m_max = std::max(m_max, value);
+    }
+    m_count++;
+    const double delta = value - m_mean;
+    m_mean += delta / static_cast<double>(m_count);
+    m_m2 += delta * (value - m_mean);
+
+    m_buffer.push_back({.Mean = value, .Weight = 1.0});
+    if (m_buffer.size() >= s_bufferSize) { Compress(); }
+}
+
+void ValueStatistics::Merge(const ValueStatistics& other)
+{
+    if (other.m_count == 0) { return; }
+    if (m_count == 0) {
+        *this = other;
+        return;
+    }
+
+    const double count = static_cast<double>(m_count);
+    const double added = static_cast<double>(other.m_count);
+    const double delta = other.m_mean - m_mean;
+    m_mean += delta * added / (count + added);
+    m_m2 += other.m_m2 + (delta * delta * count * added / (count + added));
+    m_count += other.m_count;
+    m_min = std::min(m_min, other.m_min);
+    m_max = std::max(m_max, other.m_max);
+
+    m_buffer.insert(m_buffer.end(), other.m_centroids.begin(), other.m_centroids.end());
+    m_buffer.insert(m_buffer.end(), other.m_buffer.begin(), other.m_buffer.end());
+    if (m_buffer.size() >= s_bufferSize) { Compress(); }
+}
+
+double ValueStatistics::Variance() const
+{
+    return m_count == 0 ? 0.0 : m_m2 / static_cast<double>(m_count);
+}
+
+double ValueStatistics::StdDev() const
+{
+    return std::sqrt(Variance());
+}
+
+double ValueStatistics::Quantile(double q) const
+{
+    const auto centroids = Centroids();
+    if (centroids.empty()) { return std::numeric_limits<double>::quiet_NaN(); }
+    if (centroids.size() == 1) { return centroids.front().Mean; }
+
+    // Half of the weight of a cluster is on each side of its mean, the values are spread evenly between the means.
+    const double index = std::clamp(q, 0.0, 1.0) * static_cast<double>(m_count);
+    const auto&  first = centroids.front();
+    if (index < first.Weight / 2.0) { return m_min + ((index / (first.Weight / 2.0)) * (first.Mean - m_min)); }
+
+    double before = first.Weight / 2.0;
+    for (std::size_t i = 0; i + 1 < centroids.size(); ++i) {
+        const double between = (centroids[i].Weight + centroids[i + 1].Weight) / 2.0;
+        if (before + between > index) {
+            const double t = (index - before) / between;
+            return centroids[i].Mean + (t * (centroids[i + 1].Mean - centroids[i].Mean));
+        }
+        before += between;
+    }
+
+    const auto& last = centroids.back();
+    return std::min(m_max, last.Mean + (((index - before) / (last.Weight / 2.0)) * (m_max - last.Mean)));
+}
+
+double ValueStatistics::Cdf(double x) const
+{
+    return Cdf(Centroids(), x);
+}
+
+std::vector<double> ValueStatistics::Histogram(double min, double max, std::size_t bins) const
+{
+    std::vector<double> counts(bins, 0.0);
+    if (bins == 0 || max <= min) { return counts; }
+
+    const auto   centroids = Centroids();
+    const double width     = (max - min) / static_cast<double>(bins);
+    double       below     = Cdf(centroids, min);
+    for (std::size_t i = 0; i < bins; ++i) {
+        const double edge  = i + 1 == bins ? max : min + (width * static_cast<double>(i + 1));
+        const double above = Cdf(centroids, edge);
+        counts[i]          = (above - below) * static_cast<double>(m_count);
+        below              = above;
+    }
+    return counts;
+}
+
+nlohmann::json ValueStatistics::serialize() const
+{
+    nlohmann::json j = {
+      {"count", m_count},
+      {"mean", m_mean},
+      {"m2", m_m2},
+      {"min", m_min},
+      {"max", m_max},
+    };
+    j["centroids"] = nlohmann::json::array();
+    for (auto&& centroid : Centroids()) { j["centroids"].push_back({centroid.Mean, centroid.Weight}); }
+    return j;
+}
+
+ValueStatistics ValueStatistics::deserialize(const nlohmann::json& j)
+{
+    ValueStatistics statistics;
+    statistics.m_count = j.at("count").get<std::size_t>();
+    statistics.m_mean  = j.at("mean").get<double>();
+    statistics.m_m2    = j.at("m2").get<double>();
+    statistics.m_min   = j.at("min").get<double>();
+    statistics.m_max   = j.at("max").get<double>();
+    for (auto&& centroid : j.at("centroids")) {
+        statistics.m_buffer.push_back({.Mean = centroid.at(0).get<double>(), .Weight = centroid.at(1).get<double>()});
+    }
+    statistics.Compress();
+    return statistics;
+}
+
+void ValueStatistics::Compress()
+{
+    if (m_buffer.empty()) { return; }
+    const auto centroids = Centroids();
+    m_buffer.clear();
+    m_centroids.clear();
+
+    double total = 0.0;
+    for (auto&& centroid : centroids) { total += centroid.Weight; }
+
+    // Neighbouring clusters are merged as long as the result spans less than one unit of k.
+    Centroid current = centroids.front();
+    double   before  = 0.0;
+    double   limit   = KInverse(K(0.0) + 1.0) * total;
+    for (std::size_t i = 1; i < centroids.size(); ++i) {
+        const auto& next = centroids[i];
+        if (before + current.Weight + next.Weight <= limit) {
+            current.Weight += next.Weight;
+            current.Mean += (next.Mean - current.Mean) * next.Weight / current.Weight;
+            continue;
+        }
+        before += current.Weight;
+        m_centroids.push_back(current);
+        current = next;
+        limit   = KInverse(K(before / total) + 1.0) * total;
+    }
+    m_centroids.push_back(current);
+}
+
+double ValueStatistics::Cdf(const std::vector<Centroid>& centroids, double x) const
+{
+    if (m_count == 0 || x < m_min) { return 0.0; }
+    if (x >= m_max) { return 1.0; }
+    if (centroids.size() == 1) { return (x - m_min) / (m_max - m_min); }
+
+    const double total = static_cast<double>(m_count);
+    const auto&  first = centroids.front();
+    if (x < first.Mean) { return (first.Weight / 2.0) * (x - m_min) / (first.Mean - m_min) / total; }
+
+    double before = first.Weight / 2.0;
+    for (std::size_t i = 0; i + 1 < centroids.size(); ++i) {
+        const double between = (centroids[i].Weight + centroids[i + 1].Weight) / 2.0;
+        if (x < centroids[i + 1].Mean) {
+            const double t = (x - centroids[i].Mean) / (centroids[i + 1].Mean - centroids[i].Mean);
+            return (before + (t * between)) / total;
+        }
+        before += between;
+    }
+
+    const auto& last = centroids.back();
+    return std::min(1.0, (before + ((last.Weight / 2.0) * (x - last.Mean) / (m_max - last.Mean))) / total);
+}
+
+std::vector<ValueStatistics::Centroid> ValueStatistics::Centroids() const
+{
+    if (m_buffer.empty()) { return m_centroids; }
+    std::vector<Centroid> centroids = m_centroids;
+    centroids.insert(centroids.end(), m_buffer.begin(), m_buffer.end());
+    std::ranges::stable_sort(centroids, {}, &Centroid::Mean);
+    return centroids;
+}
+}    // namespace Frasy::Analyzers
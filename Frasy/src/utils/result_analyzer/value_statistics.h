@@ -0,0 +1,82 @@
+/**
+ * @file    value_statistics.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#ifndef FRASY_SRC_UTILS_RESULT_ANALYZER_VALUE_STATISTICS_H
+#define FRASY_SRC_UTILS_RESULT_ANALYZER_VALUE_STATISTICS_H
+
+#include <cstddef>
+#include <json.hpp>
+#include <vector>
+
+namespace Frasy::Analyzers {
+/**
+ * Statistics of a stream of values, kept in a bounded amount of memory however many values are added.
+ *
+ * The count, mean and variance are exact (Welford's algorithm), as are the extremes. The distribution is summarized by
+ * a t-digest: clusters of neighbouring values, smaller towards the tails, from which the quantiles and histograms are
+ * estimated. Two statistics merge into the statistics of both streams, in any order.
+ */
+class ValueStatistics {
+public:
+    //! Bounds the number of clusters of the digest, higher is more precise.
+    static constexpr double s_compression = 100.0;
+
+    void Add(double value);
+    void Merge(const ValueStatistics& other);
+
+    [[nodiscard]] std::size_t Count() const { return m_count; }
+    [[nodiscard]] double      Min() const { return m_min; }
+    [[nodiscard]] double      Max() const { return m_max; }
+    [[nodiscard]] double      Mean() const { return m_mean; }
+    //! Variance of the population of values.
+    [[nodiscard]] double      Variance() const;
+    [[nodiscard]] double      StdDev() const;
+
+    //! Estimated value under which lies the fraction q of the values, NaN if there are none.
+    [[nodiscard]] double              Quantile(double q) const;
+    //! Estimated fraction of the values under x.
+    [[nodiscard]] double              Cdf(double x) const;
+    //! Estimated number of values in each of bins bins of equal width, spanning [min, max].
+    [[nodiscard]] std::vector<double> Histogram(double min, double max, std::size_t bins) const;
+
+    [[nodiscard]] nlohmann::json serialize() const;
+    static ValueStatistics       deserialize(const nlohmann::json& j);
+
+private:
+    struct Centroid {
+        double Mean   = 0.0;
+        double Weight = 0.0;
+    };
+
+    //! Folds the values added since the last time into the clusters.
+    void Compress();
+    //! The clusters along with the values added since they were compressed.
+    [[nodiscard]] std::vector<Centroid> Centroids() const;
+    [[nodiscard]] double                Cdf(const std::vector<Centroid>& centroids, double x) const;
+
+    std::size_t m_count = 0;
+    double      m_mean  = 0.0;
+    double      m_m2    = 0.0;    //!< Sum of the squared differences to the mean.
+    double      m_min   = 0.0;
+    double      m_max   = 0.0;
+
+    std::vector<Centroid> m_centroids;    //!< Sorted by mean.
+    std::vector<Centroid> m_buffer;
+};
+}    // namespace Frasy::Analyzers
+
+#endif    // FRASY_SRC_UTILS_RESULT_ANALYZER_VALUE_STATISTICS_H
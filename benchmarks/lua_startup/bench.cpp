@@ -0,0 +1,98 @@
+/**
+ * @file    bench.cpp
+ * @brief   Cost of building a UUT Lua state, with and without the chunk cache.
+ *
+ * Loads the same framework files as Orchestrator::initLua, in the same order, either straight from the sources
+ * (script_file) or through Frasy::Lua::ChunkCache. Must be run from the directory holding lua/core.
+ *
+ * Frasy only runs on Windows: figures taken from a build for another platform, with the Windows parts stubbed out,
+ * don't tell what the orchestrator gains.
+ */
+#include <benchmark/benchmark.h>
+#include <utils/lua/chunk_cache.h>
+
+#include <array>
+#include <string_view>
+
+namespace {
+constexpr std::array s_frameworkFiles = {
+  "lua/core/framework/stage.lua",
+  "lua/core/framework/context.lua",
+  "lua/core/utils/global.lua",
+  "lua/core/sdk/log.lua",
+  "lua/core/sdk/popup.lua",
+  "lua/core/framework/exception.lua",
+  "lua/core/sdk/environment/team.lua",
+  "lua/core/sdk/environment/environment.lua",
+  "lua/core/framework/orchestrator.lua",
+  "lua/core/sdk/test.lua",
+  "lua/core/can_open/can_open.lua",
+  "lua/core/cep/ibs.lua",
+  "lua/core/helper/load_environment.lua",
+  "lua/core/helper/load_tests.lua",
+  "lua/core/framework/error_handler.lua",
+};
+
+/// Prepare a state the way initLua does, minus the C++ bindings that the framework files don't need to load.
+sol::state MakeState()
+{
+    sol::state lua;
+    lua.open_libraries(sol::lib::debug,
+                       sol::lib::base,
+                       sol::lib::table,
+                       sol::lib::io,
+                       sol::lib::package,
+                       sol::lib::string,
+                       sol::lib::math,
+                       sol::lib::os);
+    lua["__profileStartEvent"] = [](sol::variadic_args) {};
+    lua["__profileEndEvent"]   = [](sol::variadic_args) {};
+    return lua;
+}
+
+template<typename Loader>
+void LoadFramework(sol::state& lua, Loader&& load)
+{
+    for (std::string_view file : s_frameworkFiles) {
+        load(std::string(file));
+        if (file == "lua/core/framework/context.lua") { lua["Context"]["info"]["stage"] = lua["Stage"]["execution"]; }
+    }
+}
+
+void BM_StateStartup_Source(benchmark::State& state)
+{
+    for (auto _ : state) {
+        auto lua = MakeState();
+        LoadFramework(lua, [&](const std::string& file) { lua.script_file(file); });
+        benchmark::DoNotOptimize(lua.lua_state());
+    }
+}
+BENCHMARK(BM_StateStartup_Source)->ThreadRange(1, 16)->UseRealTime();
+
+void BM_StateStartup_ChunkCache(benchmark::State& state)
+{
+    static Frasy::Lua::ChunkCache cache;
+    for (auto _ : state) {
+        auto lua = MakeState();
+        cache.install(lua);
+        LoadFramework(lua, [&](const std::string& file) { cache.scriptFile(lua, file); });
+        benchmark::DoNotOptimize(lua.lua_state());
+    }
+    state.counters["misses"] = static_cast<double>(cache.stats().misses);
+}
+BENCHMARK(BM_StateStartup_ChunkCache)->ThreadRange(1, 16)->UseRealTime();
+
+/// Worst case for the cache: every state has to compile everything, i.e. the first state of a run after an edit.
+void BM_StateStartup_ChunkCacheCold(benchmark::State& state)
+{
+    Frasy::Lua::ChunkCache cache;
+    for (auto _ : state) {
+        cache.clear();
+        auto lua = MakeState();
+        cache.install(lua);
+        LoadFramework(lua, [&](const std::string& file) { cache.scriptFile(lua, file); });
+        benchmark::DoNotOptimize(lua.lua_state());
+    }
+}
+BENCHMARK(BM_StateStartup_ChunkCacheCold);
+}    // namespace
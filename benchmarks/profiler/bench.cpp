@@ -0,0 +1,149 @@
+/**
+ * @file    bench.cpp
+ * @brief   Cost of recording a profile event, with the per-thread buffers and with the former locked tree.
+ *
+ * The recorded events are merged every s_mergePeriod iterations, like the profiler panel does once per frame, and the
+ * merge is part of the measured time. The former profiler updated its tree on every event and had no merge.
+ */
+#include <benchmark/benchmark.h>
+#include <utils/lua/profile_events.h>
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace {
+constexpr std::int64_t s_mergePeriod = 64 * 1024;
+
+/// Former implementation, the tree of the calling thread updated in place, re-sorted on every return.
+class LegacyProfiler {
+public:
+    void reportCallEvent(const Frasy::ProfileEventHeader& header)
+    {
+        std::lock_guard lock {m_lock};
+        auto            isEvent = [&header](const Frasy::ProfileEvent& event) { return event.header == header; };
+        auto&           details = m_events[std::this_thread::get_id()];
+        auto&           siblings = details.active == nullptr ? details.events : details.active->childs;
+        auto            it       = std::ranges::find_if(siblings, isEvent);
+        if (it == siblings.end()) {
+            auto& event  = siblings.emplace_back();
+            event.header = header;
+            event.parent = details.active;
+            it           = std::prev(siblings.end());
+        }
+        details.active = &*it;
+        details.active->history.emplace_back(std::chrono::steady_clock::now());
+    }
+
+    void reportReturnEvent()
+    {
+        std::lock_guard lock {m_lock};
+        auto&           details = m_events[std::this_thread::get_id()];
+        auto*           event   = details.active;
+        ++event->hitCount;
+        auto& marker = event->history.back();
+        marker.end   = std::chrono::steady_clock::now();
+        marker.delta = std::chrono::duration_cast<std::chrono::microseconds>(marker.end - marker.start);
+        event->totalTime += marker.delta;
+        event->minTime = (std::min)(event->minTime, marker.delta);
+        event->maxTime = (std::max)(event->maxTime, marker.delta);
+        event->avgTime = event->totalTime / event->hitCount;
+        while (event->history.size() > 10'000) {
+            event->history.pop_front();
+        }
+        for (auto* parent = event->parent; parent != nullptr; parent = parent->parent) {
+            parent->childs.sort(Frasy::Profiler::sortByTotalTimeDesc);
+        }
+        details.events.sort(Frasy::Profiler::sortByTotalTimeDesc);
+        details.active = event->parent;
+    }
+
+private:
+    struct Details {
+        Frasy::ProfileEvent*           active = nullptr;
+        std::list<Frasy::ProfileEvent> events;
+    };
+    std::mutex                         m_lock;
+    std::map<std::thread::id, Details> m_events;
+};
+
+LegacyProfiler s_legacy;
+
+class LegacyMarker {
+public:
+    LegacyMarker(std::string name, std::string source, int line) : m_header {std::move(name), std::move(source), line}
+    {
+        s_legacy.reportCallEvent(m_header);
+    }
+    ~LegacyMarker() { s_legacy.reportReturnEvent(); }
+
+private:
+    Frasy::ProfileEventHeader m_header;
+};
+
+void MergeIfDue(benchmark::State& state, std::int64_t iteration)
+{
+    // Only one thread plays the profiler panel.
+    if (state.thread_index() == 0 && iteration % s_mergePeriod == 0) {
+        benchmark::DoNotOptimize(Frasy::Profiler::get().getEvents());
+    }
+}
+
+void BM_ProfileScope_Legacy(benchmark::State& state)
+{
+    for (auto _ : state) {
+        LegacyMarker outer("Outer", __FILE__, __LINE__);
+        LegacyMarker inner("Inner", __FILE__, __LINE__);
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+
+void BM_ProfileScope(benchmark::State& state)
+{
+    if (state.thread_index() == 0) { Frasy::Profiler::get().reset(); }
+    std::int64_t iteration = 0;
+    for (auto _ : state) {
+        {
+            FRASY_PROFILE_SCOPE("Outer");
+            FRASY_PROFILE_SCOPE("Inner");
+        }
+        MergeIfDue(state, ++iteration);
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+
+/// Events coming from the Lua hook, whose names are only known at run time.
+void BM_ProfileLuaEvent_Legacy(benchmark::State& state)
+{
+    const std::string name = "Expect";
+    for (auto _ : state) {
+        s_legacy.reportCallEvent({name, "@lua/core/sdk/expect.lua", 42});
+        s_legacy.reportReturnEvent();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_ProfileLuaEvent(benchmark::State& state)
+{
+    if (state.thread_index() == 0) { Frasy::Profiler::get().reset(); }
+    auto&             profiler  = Frasy::Profiler::get();
+    const std::string name      = "Expect";
+    std::int64_t      iteration = 0;
+    for (auto _ : state) {
+        profiler.reportCallEvent(name, "@lua/core/sdk/expect.lua", 42);
+        profiler.reportReturnEvent();
+        MergeIfDue(state, ++iteration);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+}    // namespace
+
+BENCHMARK(BM_ProfileScope_Legacy)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_ProfileScope)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_ProfileLuaEvent_Legacy);
+BENCHMARK(BM_ProfileLuaEvent);
@@ -0,0 +1,147 @@
+/**
+ * @file    bench.cpp
+ * @brief   Time taken by ResultAnalyzer::Analyze on an archive of reports, with and without its result index.
+ *
+ * Each report has 5 sequences of 10 tests with 5 numeric expectations. BM_AnalyzeCold starts without an index and
+ * parses every report to build it, which is what every analysis cost before the index existed. BM_AnalyzeIndexed
+ * answers from the index alone. BM_MedianSorted and BM_MedianStreamed compare keeping every value of an expectation to
+ * the ValueStatistics that replace them.
+ */
+#include <benchmark/benchmark.h>
+#include <utils/result_analyzer/analyzer.h>
+#include <utils/result_analyzer/result_index.h>
+#include <utils/result_analyzer/value_statistics.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+namespace fs = std::filesystem;
+using Frasy::Analyzers::ResultAnalyzer;
+using Frasy::Analyzers::ResultIndex;
+using Frasy::Analyzers::ResultOptions;
+using Frasy::Analyzers::ValueStatistics;
+
+constexpr std::string_view s_title = "Bench";
+
+nlohmann::json MakeReport(int uut, int serial, std::mt19937& rng)
+{
+    std::normal_distribution<float> noise {3.3f, 0.05f};
+
+    nlohmann::json report;
+    report["info"] = {
+      {"uut", uut}, {"serial", std::format("SN{}", serial)}, {"pass", true}, {"time", {{"process", 2.0}}}};
+    for (int s = 0; s < 5; ++s) {
+        auto& sequence = report["sequences"][std::format("Sequence {}", s)];
+        sequence       = {{"enabled", true}, {"skipped", false}, {"pass", true}, {"time", {{"process", 0.4}}}};
+        for (int t = 0; t < 10; ++t) {
+            auto& test = sequence["tests"][std::format("Test {}", t)];
+            test       = {{"enabled", true}, {"skipped", false}, {"pass", true}, {"time", {{"process", 0.04}}}};
+            test["expectations"] = nlohmann::json::array();
+            for (int e = 0; e < 5; ++e) {
+                const float value = noise(rng);
+                test["expectations"].push_back({{"name", std::format("Rail {}", e)},
+                                                {"method", "ToBeInRange"},
+                                                {"min", 3.2},
+                                                {"max", 3.4},
+                                                {"value", value},
+                                                {"pass", 3.2f <= value && value <= 3.4f}});
+            }
+        }
+    }
+    return report;
+}
+
+//! Archives reports in logs/<title>/pass under a temporary working directory.
+class Archive {
+public:
+    explicit Archive(int reports) : m_root(fs::temp_directory_path() / std::format("frasy_bench_archive_{}", reports))
+    {
+        fs::remove_all(m_root);
+        fs::create_directories(m_root / "logs" / s_title / "pass");
+        m_previous = fs::current_path();
+        fs::current_path(m_root);
+
+        std::mt19937 rng {static_cast<uint32_t>(reports)};
+        for (int i = 0; i < reports; ++i) {
+            std::ofstream(fs::path("logs") / s_title / "pass" / std::format("{}_SN{}.txt", i, i))
+              << MakeReport(i % 4 + 1, i, rng).dump(2, ' ');
+        }
+    }
+    ~Archive()
+    {
+        fs::current_path(m_previous);
+        fs::remove_all(m_root);
+    }
+
+    static void RemoveIndex() { ResultIndex::Remove(fs::path("logs") / s_title / ResultIndex::s_directory); }
+
+private:
+    fs::path m_root;
+    fs::path m_previous;
+};
+
+//! The second argument is the number of threads, 0 for one per core.
+ResultOptions Options(const benchmark::State& state)
+{
+    return {.Threads = static_cast<size_t>(state.range(1))};
+}
+
+void BM_AnalyzeCold(benchmark::State& state)
+{
+    Archive archive {static_cast<int>(state.range(0))};
+    for (auto _ : state) {
+        state.PauseTiming();
+        Archive::RemoveIndex();
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(ResultAnalyzer {Options(state)}.Analyze(std::string {s_title}));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AnalyzeCold)->ArgsProduct({{500, 2000}, {1, 0}})->Unit(benchmark::kMillisecond);
+
+void BM_AnalyzeIndexed(benchmark::State& state)
+{
+    Archive archive {static_cast<int>(state.range(0))};
+    ResultAnalyzer {}.Analyze(std::string {s_title});
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ResultAnalyzer {Options(state)}.Analyze(std::string {s_title}));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AnalyzeIndexed)->ArgsProduct({{500, 2000}, {1, 0}})->Unit(benchmark::kMillisecond);
+
+//! Median of a year of measurements of an expectation, from every value kept and sorted.
+void BM_MedianSorted(benchmark::State& state)
+{
+    std::mt19937                    rng {1};
+    std::normal_distribution<float> noise {3.3f, 0.05f};
+    for (auto _ : state) {
+        std::vector<float> values;
+        for (int64_t i = 0; i < state.range(0); ++i) { values.push_back(noise(rng)); }
+        std::ranges::sort(values);
+        benchmark::DoNotOptimize(values[values.size() / 2]);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MedianSorted)->Arg(1'000'000)->Unit(benchmark::kMillisecond);
+
+//! Median of the same measurements, estimated by ValueStatistics.
+void BM_MedianStreamed(benchmark::State& state)
+{
+    std::mt19937                    rng {1};
+    std::normal_distribution<float> noise {3.3f, 0.05f};
+    for (auto _ : state) {
+        ValueStatistics statistics;
+        for (int64_t i = 0; i < state.range(0); ++i) { statistics.Add(noise(rng)); }
+        benchmark::DoNotOptimize(statistics.Quantile(0.5));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MedianStreamed)->Arg(1'000'000)->Unit(benchmark::kMillisecond);
+}    // namespace
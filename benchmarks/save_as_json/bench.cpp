@@ -0,0 +1,97 @@
+/**
+ * @file    bench.cpp
+ * @brief   Time taken by Lua::SaveAsJson to write a report of 10k expectations.
+ *
+ * The report has 10 sequences of 10 tests with 100 numeric expectations, laid out as
+ * Orchestrator.CompileExecutionResults builds it. BM_SaveAsJson writes it while walking the table. BM_SaveAsJson_Dom
+ * builds a nlohmann::json out of the table first and dumps it, which is what SaveAsJson did before. Both run on several
+ * threads at once, like the UUTs do at the end of a run.
+ */
+#include <benchmark/benchmark.h>
+#include <json.hpp>
+#include <sol/sol.hpp>
+#include <utils/lua/save_as_json.h>
+
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <string>
+
+namespace {
+constexpr const char* s_report = R"(
+    local report = {
+        info = { uut = 1, serial = "SN0001", pass = true, date = "2026-10-17", time = { process = 12.5 } },
+        sequences = {},
+    }
+    for s = 1, 10 do
+        local sequence = { enabled = true, skipped = false, pass = true, tests = {}, time = { process = 1.25 } }
+        for t = 1, 10 do
+            local test = { enabled = true, skipped = false, pass = true, expectations = {}, time = { process = 0.125 } }
+            for e = 1, 100 do
+                test.expectations[e] = {
+                    name = "Expectation " .. e,
+                    method = "ToBeInRange",
+                    min = 3.2,
+                    max = 3.4,
+                    value = 3.3 + (e % 7) / 1000,
+                    pass = true,
+                    note = "",
+                }
+            end
+            sequence.tests["Test " .. t] = test
+        end
+        report.sequences["Sequence " .. s] = sequence
+    end
+    return report
+)";
+
+std::string OutputFile(const benchmark::State& state)
+{
+    return (std::filesystem::temp_directory_path() / std::format("frasy_save_as_json_{}.json", state.thread_index()))
+      .string();
+}
+
+//! The implementation SaveAsJson replaced, without its validation.
+nlohmann::json MakeJson(const sol::table& table)
+{
+    nlohmann::json j;
+    for (auto [key, value] : table) {
+        nlohmann::json element;
+        switch (value.get_type()) {
+            case sol::type::string: element = value.as<std::string>(); break;
+            case sol::type::number: element = value.as<double>(); break;
+            case sol::type::boolean: element = value.as<bool>(); break;
+            default: element = MakeJson(value.as<sol::table>()); break;
+        }
+        if (key.get_type() == sol::type::number) { j.push_back(std::move(element)); }
+        else { j[key.as<std::string>()] = std::move(element); }
+    }
+    return j;
+}
+
+void BM_SaveAsJson(benchmark::State& state)
+{
+    sol::state lua;
+    lua.open_libraries(sol::lib::base);
+    sol::table  report = lua.script(s_report);
+    std::string file   = OutputFile(state);
+    for (auto _ : state) { Frasy::Lua::SaveAsJson(report, file); }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * std::filesystem::file_size(file)));
+    std::filesystem::remove(file);
+}
+BENCHMARK(BM_SaveAsJson)->ThreadRange(1, 8)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+void BM_SaveAsJson_Dom(benchmark::State& state)
+{
+    sol::state lua;
+    lua.open_libraries(sol::lib::base);
+    sol::table  report = lua.script(s_report);
+    std::string file   = OutputFile(state);
+    for (auto _ : state) {
+        std::ofstream(file) << MakeJson(report).dump(2, ' ', false, nlohmann::detail::error_handler_t::replace);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * std::filesystem::file_size(file)));
+    std::filesystem::remove(file);
+}
+BENCHMARK(BM_SaveAsJson_Dom)->ThreadRange(1, 8)->UseRealTime()->Unit(benchmark::kMillisecond);
+}    // namespace
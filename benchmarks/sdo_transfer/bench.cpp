@@ -0,0 +1,221 @@
+/**
+ * @file    bench.cpp
+ * @brief   Bytes per second of SDO transfers with a simulated board, through the whole SLCAN path of a virtual port.
+ *
+ * The client speaks SLCAN to a VirtualPort like the CANopen driver does to an adapter: its frames are encoded to
+ * text, split by an RxBuffer on the other side, sent on a VirtualBus and answered by a SimulatedNode running in its own
+ * thread. Segmented transfers take a round trip per 7 bytes, block transfers a round trip per block of 127 segments.
+ * No latency is simulated, the results are the cost of the software path alone.
+ */
+#include <benchmark/benchmark.h>
+#include <utils/communication/can_open/simulation/simulated_node.h>
+#include <utils/communication/slcan/rx_buffer.h>
+#include <utils/communication/slcan/virtual_port.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+using Frasy::CanOpen::EdsDictionary;
+using Frasy::CanOpen::SimulatedNode;
+using Frasy::SlCan::CanPacket;
+using Frasy::SlCan::Packet;
+using Frasy::SlCan::RxBuffer;
+using Frasy::SlCan::VirtualBus;
+using Frasy::SlCan::VirtualPort;
+using Frame = std::array<uint8_t, 8>;
+
+constexpr uint8_t  s_nodeId    = 0x10;
+constexpr uint32_t s_requestId = 0x600 + s_nodeId;
+constexpr uint32_t s_replyId   = 0x580 + s_nodeId;
+constexpr uint8_t  s_blockSize = 127;
+
+constexpr auto s_eds = R"(
+[1017]
+ParameterName=Producer heartbeat time
+DataType=0x0006
+AccessType=rw
+DefaultValue=0
+
+[2000]
+ParameterName=Waveform
+ObjectType=0x2
+DataType=0x000F
+AccessType=rw
+)";
+
+/// SDO client on the SLCAN side of a virtual port.
+class Client {
+public:
+    explicit Client(std::shared_ptr<VirtualBus> bus) : m_port(std::move(bus)) {}
+
+    void send(const Frame& data)
+    {
+        CanPacket frame {.id = s_requestId, .dataLen = 8};
+        std::ranges::copy(data, &frame.data[0]);
+        uint8_t    buffer[Packet::s_mtu] = {};
+        const auto size                  = Packet {frame}.toSerial(&buffer[0], sizeof(buffer));
+        m_port.write(&buffer[0], static_cast<std::size_t>(size));
+    }
+
+    Frame receive()
+    {
+        while (m_frames.empty()) {
+            auto writable = m_rx.writable();
+            m_rx.commit(m_port.read(writable.data(), writable.size()), [this](const Packet& packet) {
+                if (auto frame = packet.toCanPacket(); frame && frame->id == s_replyId) {
+                    Frame data = {};
+                    std::copy_n(&frame->data[0], 8, data.begin());
+                    m_frames.push_back(data);
+                }
+            });
+        }
+        const Frame frame = m_frames.front();
+        m_frames.pop_front();
+        if (frame[0] == 0x80) { throw std::runtime_error("SDO transfer aborted by the node"); }
+        return frame;
+    }
+
+    Frame request(const Frame& data)
+    {
+        send(data);
+        return receive();
+    }
+
+private:
+    VirtualPort       m_port;
+    RxBuffer          m_rx;
+    std::deque<Frame> m_frames;
+};
+
+Frame Initiate(uint8_t command, std::size_t size)
+{
+    return {command, 0x00, 0x20, 0x00, static_cast<uint8_t>(size), static_cast<uint8_t>(size >> 8)};
+}
+
+std::vector<uint8_t> UploadSegmented(Client& client)
+{
+    std::vector<uint8_t> data;
+    client.request(Initiate(0x40, 0));
+    for (uint8_t toggle = 0;; toggle ^= 0x10) {
+        const auto segment = client.request({static_cast<uint8_t>(0x60 | toggle)});
+        data.insert(data.end(), &segment[1], &segment[8 - ((segment[0] >> 1) & 0x07)]);
+        if ((segment[0] & 0x01) != 0) { return data; }
+    }
+}
+
+std::vector<uint8_t> UploadBlock(Client& client)
+{
+    std::vector<uint8_t> data;
+    client.request({0xA0, 0x00, 0x20, 0x00, s_blockSize});
+    client.send({0xA3});
+    for (bool last = false; !last;) {
+        uint8_t sequence = 0;
+        while (sequence < s_blockSize && !last) {
+            const auto segment = client.receive();
+            last               = (segment[0] & 0x80) != 0;
+            sequence           = segment[0] & 0x7F;
+            data.insert(data.end(), &segment[1], &segment[8]);
+        }
+        client.send({0xA2, sequence, s_blockSize});
+    }
+    const auto end = client.receive();
+    data.resize(data.size() - ((end[0] >> 2) & 0x07));
+    client.send({0xA1});
+    return data;
+}
+
+void DownloadSegmented(Client& client, const std::vector<uint8_t>& data)
+{
+    client.request(Initiate(0x21, data.size()));
+    uint8_t toggle = 0;
+    for (std::size_t offset = 0; offset < data.size(); offset += 7, toggle ^= 0x10) {
+        const std::size_t count   = std::min<std::size_t>(7, data.size() - offset);
+        const bool        last    = offset + count == data.size();
+        Frame             segment = {static_cast<uint8_t>(toggle | ((7 - count) << 1) | (last ? 0x01 : 0x00))};
+        std::copy_n(data.begin() + static_cast<std::ptrdiff_t>(offset), count, segment.begin() + 1);
+        client.request(segment);
+    }
+}
+
+void DownloadBlock(Client& client, const std::vector<uint8_t>& data)
+{
+    const auto    response  = client.request(Initiate(0xC2, data.size()));
+    const uint8_t blockSize = response[4];
+    std::size_t   offset    = 0;
+    while (offset < data.size()) {
+        uint8_t sequence = 0;
+        while (sequence < blockSize && offset < data.size()) {
+            const std::size_t count   = std::min<std::size_t>(7, data.size() - offset);
+            const bool        last    = offset + count == data.size();
+            Frame             segment = {static_cast<uint8_t>(++sequence | (last ? 0x80 : 0x00))};
+            std::copy_n(data.begin() + static_cast<std::ptrdiff_t>(offset), count, segment.begin() + 1);
+            client.send(segment);
+            offset += count;
+        }
+        client.receive();
+    }
+    const auto unused = static_cast<uint8_t>((7 - data.size() % 7) % 7);
+    client.request({static_cast<uint8_t>(0xC1 | (unused << 2))});
+}
+
+struct Bench {
+    std::shared_ptr<VirtualBus> bus = std::make_shared<VirtualBus>("bench");
+    Client                      client {bus};
+    SimulatedNode               node {bus, s_nodeId, EdsDictionary::parse(s_eds, s_nodeId)};
+    std::vector<uint8_t>        data;
+
+    explicit Bench(std::size_t size) : data(size)
+    {
+        for (std::size_t i = 0; i < size; ++i) {
+            data[i] = static_cast<uint8_t>(i * 7);
+        }
+        node.write(0x2000, 0, data);
+    }
+};
+
+void BM_Upload_Segmented(benchmark::State& state)
+{
+    Bench bench {static_cast<std::size_t>(state.range(0))};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(UploadSegmented(bench.client));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void BM_Upload_Block(benchmark::State& state)
+{
+    Bench bench {static_cast<std::size_t>(state.range(0))};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(UploadBlock(bench.client));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void BM_Download_Segmented(benchmark::State& state)
+{
+    Bench bench {static_cast<std::size_t>(state.range(0))};
+    for (auto _ : state) {
+        DownloadSegmented(bench.client, bench.data);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void BM_Download_Block(benchmark::State& state)
+{
+    Bench bench {static_cast<std::size_t>(state.range(0))};
+    for (auto _ : state) {
+        DownloadBlock(bench.client, bench.data);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+}    // namespace
+
+BENCHMARK(BM_Upload_Segmented)->Arg(256)->Arg(4096)->UseRealTime();
+BENCHMARK(BM_Upload_Block)->Arg(256)->Arg(4096)->UseRealTime();
+BENCHMARK(BM_Download_Segmented)->Arg(256)->Arg(4096)->UseRealTime();
+BENCHMARK(BM_Download_Block)->Arg(256)->Arg(4096)->UseRealTime();
@@ -0,0 +1,206 @@
+/**
+ * @file    bench.cpp
+ * @brief   Frames per second of the SLCAN packet codec, and bytes per second of the hex conversions it is built on.
+ *
+ * The frames are full data frames (8 bytes), the most common and the longest ones. The former codec converted every
+ * character with a chain of comparisons, the hex conversions are measured with every instruction set the CPU has.
+ */
+#include <benchmark/benchmark.h>
+#include <utils/communication/slcan/packet.h>
+#include <utils/misc/hex.h>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+using Frasy::Hex::Isa;
+using Frasy::SlCan::CanPacket;
+using Frasy::SlCan::Packet;
+
+constexpr std::array<const char*, 4> s_frames = {
+  "t58A84B002100A0B0C0D\r",
+  "t18B80123456789ABCDEF\r",
+  "T0000070A8fedcba9876543210\r",
+  "t28C8DEADBEEF00112233\r",
+};
+
+/// Former decoder of data frames.
+bool LegacyDecode(const uint8_t* data, std::size_t len, CanPacket& packet)
+{
+    const bool extended = data[0] == 'T';
+    data++;
+    len -= 2;
+    uint8_t workBuff[Packet::s_mtu];
+    for (std::size_t i = 0; i < len; i++) {
+        if (data[i] >= 'a' && data[i] <= 'f') { workBuff[i] = data[i] - 'a' + 10; }
+        else if (data[i] >= 'A' && data[i] <= 'F') {
+            workBuff[i] = data[i] - 'A' + 10;
+        }
+        else if (data[i] >= '0' && data[i] <= '9') {
+            workBuff[i] = data[i] - '0';
+        }
+        else {
+            return false;
+        }
+    }
+    const std::size_t idLen = extended ? Packet::s_extIdLen : Packet::s_stdIdLen;
+    uint8_t*          ptr   = &workBuff[0];
+    packet.id               = 0;
+    for (std::size_t i = 0; i < idLen; i++, ptr++) {
+        packet.id = (packet.id * 16) + *ptr;
+    }
+    packet.dataLen = *ptr++;
+    for (std::size_t i = 0; i < packet.dataLen; i++) {
+        packet.data[i] = (ptr[0] << 4) | ptr[1];
+        ptr += 2;
+    }
+    return true;
+}
+
+/// Former encoder of data frames.
+std::size_t LegacyEncode(const CanPacket& packet, uint8_t* out)
+{
+    auto addToBuff = [](uint8_t* buff, uint8_t val) -> uint8_t* {
+        if (val <= 9) { val += '0'; }
+        else if (val >= 0xA && val <= 0xF) {
+            val = (val - 10) + 'A';
+        }
+        *buff = val;
+        return buff + 1;
+    };
+    uint8_t* ptr = out;
+    *ptr++       = packet.isExtended ? 'T' : 't';
+    auto id      = packet.id;
+    auto idLen   = packet.isExtended ? Packet::s_extIdLen : Packet::s_stdIdLen;
+    for (std::size_t i = idLen; i > 0; i--) {
+        addToBuff(&ptr[i - 1], id & 0xF);
+        id >>= 4;
+    }
+    ptr += idLen;
+    ptr = addToBuff(ptr, packet.dataLen);
+    for (uint8_t i = 0; i < packet.dataLen; i++) {
+        ptr = addToBuff(ptr, packet.data[i] >> 4);
+        ptr = addToBuff(ptr, packet.data[i] & 0xF);
+    }
+    *ptr++ = '\r';
+    return ptr - out;
+}
+
+void BM_DecodeFrame_Legacy(benchmark::State& state)
+{
+    CanPacket packet;
+    for (auto _ : state) {
+        for (const char* frame : s_frames) {
+            benchmark::DoNotOptimize(LegacyDecode(reinterpret_cast<const uint8_t*>(frame), std::strlen(frame), packet));
+            benchmark::DoNotOptimize(packet);
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * s_frames.size()));
+}
+
+void BM_DecodeFrame(benchmark::State& state)
+{
+    for (auto _ : state) {
+        for (const char* frame : s_frames) {
+            Packet packet {reinterpret_cast<const uint8_t*>(frame), std::strlen(frame)};
+            benchmark::DoNotOptimize(packet);
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * s_frames.size()));
+}
+
+std::vector<Packet> DecodedFrames()
+{
+    std::vector<Packet> packets;
+    for (const char* frame : s_frames) {
+        packets.emplace_back(reinterpret_cast<const uint8_t*>(frame), std::strlen(frame));
+    }
+    return packets;
+}
+
+void BM_EncodeFrame_Legacy(benchmark::State& state)
+{
+    const auto packets               = DecodedFrames();
+    uint8_t    buffer[Packet::s_mtu] = {};
+    for (auto _ : state) {
+        for (const auto& packet : packets) {
+            benchmark::DoNotOptimize(LegacyEncode(packet.data.packetData, &buffer[0]));
+            benchmark::ClobberMemory();
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * packets.size()));
+}
+
+void BM_EncodeFrame(benchmark::State& state)
+{
+    const auto packets               = DecodedFrames();
+    uint8_t    buffer[Packet::s_mtu] = {};
+    for (auto _ : state) {
+        for (const auto& packet : packets) {
+            benchmark::DoNotOptimize(packet.toSerial(&buffer[0], sizeof(buffer)));
+            benchmark::ClobberMemory();
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * packets.size()));
+}
+
+/// Arguments: number of bytes, instruction set.
+void BM_HexDecode(benchmark::State& state)
+{
+    const auto isa = static_cast<Isa>(state.range(1));
+    if (!Frasy::Hex::isSupported(isa)) {
+        state.SkipWithError("Instruction set not supported");
+        return;
+    }
+    const auto           count = static_cast<std::size_t>(state.range(0));
+    std::vector<uint8_t> bytes(count);
+    std::vector<uint8_t> chars(2 * count);
+    std::mt19937         generator {42};
+    for (auto& byte : bytes) {
+        byte = static_cast<uint8_t>(generator());
+    }
+    Frasy::Hex::encode(bytes.data(), count, chars.data(), Isa::Scalar);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Frasy::Hex::decode(chars.data(), count, bytes.data(), isa));
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * count));
+}
+
+void BM_HexEncode(benchmark::State& state)
+{
+    const auto isa = static_cast<Isa>(state.range(1));
+    if (!Frasy::Hex::isSupported(isa)) {
+        state.SkipWithError("Instruction set not supported");
+        return;
+    }
+    const auto           count = static_cast<std::size_t>(state.range(0));
+    std::vector<uint8_t> bytes(count);
+    std::vector<uint8_t> chars(2 * count);
+    for (auto _ : state) {
+        Frasy::Hex::encode(bytes.data(), count, chars.data(), isa);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * count));
+}
+
+void HexArguments(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->ArgNames({"bytes", "isa"});
+    for (int64_t count : {8, 64, 1024}) {
+        for (auto isa : {Isa::Scalar, Isa::Ssse3, Isa::Avx2}) {
+            benchmark->Args({count, static_cast<int64_t>(isa)});
+        }
+    }
+}
+}    // namespace
+
+BENCHMARK(BM_DecodeFrame_Legacy);
+BENCHMARK(BM_DecodeFrame);
+BENCHMARK(BM_EncodeFrame_Legacy);
+BENCHMARK(BM_EncodeFrame);
+BENCHMARK(BM_HexDecode)->Apply(HexArguments);
+BENCHMARK(BM_HexEncode)->Apply(HexArguments);
@@ -0,0 +1,132 @@
+/**
+ * @file    bench.cpp
+ * @brief   Throughput of the SLCAN receiver, from the bytes of the port to the packets taken by the CANopen thread.
+ *
+ * The byte stream is the traffic of a bench of s_nodeCount boards (heartbeats, SDO answers and TPDOs), handed over
+ * in reads of s_readSize bytes, the size of a full-speed USB packet. The former receiver took the stream one line at a
+ * time into a string, and queued each packet under a lock with two callbacks. The new one parses every frame of a read
+ * in place and pushes it into the lock-free queue. The time the former one slept while polling the port isn't part of
+ * the measure.
+ *
+ * The real receive thread reads a Windows serial port, only a run of the Windows build gives representative figures.
+ */
+#include <benchmark/benchmark.h>
+#include <utils/communication/slcan/rx_buffer.h>
+#include <utils/communication/slcan/spsc_queue.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <string>
+
+namespace {
+constexpr int         s_nodeCount = 12;
+constexpr std::size_t s_readSize  = 64;
+
+std::string MakeStream()
+{
+    std::string stream;
+    for (int round = 0; round < 100; ++round) {
+        for (int node = 2; node < 2 + s_nodeCount; ++node) {
+            stream += std::format("t{:03X}105\r", 0x700 + node);
+            stream += std::format("t{:03X}84B0021{:02X}{:08X}\r", 0x580 + node, round % 8, round * node);
+            stream += std::format("t{:03X}8{:016X}\r", 0x180 + node, 0x0123456789ABCDEFULL + round);
+        }
+    }
+    return stream;
+}
+
+std::size_t CountFrames(const std::string& stream)
+{
+    return std::ranges::count(stream, '\r');
+}
+
+/// Former receiver, minus the port.
+class LegacyReceiver {
+public:
+    void feed(const char* bytes, std::size_t size)
+    {
+        for (std::size_t i = 0; i < size; ++i) {
+            m_line += bytes[i];
+            if (bytes[i] != '\r') { continue; }
+            std::unique_lock lock {m_lock};
+            const auto& packet = m_queue.emplace(reinterpret_cast<const uint8_t*>(m_line.data()), m_line.size());
+            m_rxMonitorFunc(packet);
+            lock.unlock();
+            m_cv.notify_one();
+            m_rxCallbackFunc();
+            m_line.clear();
+        }
+    }
+
+    std::size_t drain()
+    {
+        std::size_t      count = 0;
+        std::unique_lock lock {m_lock};
+        while (!m_queue.empty()) {
+            benchmark::DoNotOptimize(m_queue.front());
+            m_queue.pop();
+            ++count;
+        }
+        return count;
+    }
+
+private:
+    std::string                                      m_line;
+    std::mutex                                       m_lock;
+    std::condition_variable                          m_cv;
+    std::queue<Frasy::SlCan::Packet>                 m_queue;
+    std::function<void(const Frasy::SlCan::Packet&)> m_rxMonitorFunc  = [](const Frasy::SlCan::Packet&) {};
+    std::function<void()>                            m_rxCallbackFunc = [] {};
+};
+
+void BM_Receive_Legacy(benchmark::State& state)
+{
+    const auto     stream = MakeStream();
+    LegacyReceiver receiver;
+    for (auto _ : state) {
+        std::size_t received = 0;
+        for (std::size_t offset = 0; offset < stream.size(); offset += s_readSize) {
+            receiver.feed(stream.data() + offset, (std::min)(s_readSize, stream.size() - offset));
+            received += receiver.drain();
+        }
+        benchmark::DoNotOptimize(received);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * stream.size()));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * CountFrames(stream)));
+}
+
+void BM_Receive(benchmark::State& state)
+{
+    const auto                                          stream = MakeStream();
+    Frasy::SlCan::RxBuffer                              buffer;
+    Frasy::SlCan::SpscQueue<Frasy::SlCan::Packet, 1024> queue;
+    for (auto _ : state) {
+        std::size_t received = 0;
+        for (std::size_t offset = 0; offset < stream.size(); offset += s_readSize) {
+            const auto size     = (std::min)(s_readSize, stream.size() - offset);
+            auto       writable = buffer.writable();
+            std::memcpy(writable.data(), stream.data() + offset, size);
+            buffer.commit(size, [&](const Frasy::SlCan::Packet& packet) { queue.push(packet); });
+            queue.notify();
+
+            Frasy::SlCan::Packet packet;
+            while (queue.pop(packet)) {
+                benchmark::DoNotOptimize(packet);
+                ++received;
+            }
+        }
+        benchmark::DoNotOptimize(received);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * stream.size()));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * CountFrames(stream)));
+}
+}    // namespace
+
+BENCHMARK(BM_Receive_Legacy);
+BENCHMARK(BM_Receive);
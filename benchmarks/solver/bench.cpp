@@ -0,0 +1,162 @@
+/**
+ * @file    bench.cpp
+ * @brief   Cost of ordering the scopes of a solution, natively and with the former pure Lua sort.
+ *
+ * The synthetic products have N tests, each depending on up to 3 of the 64 tests defined before it, which is about
+ * what large regression products look like once their requirements are collected. Must be run from the directory
+ * holding lua/core.
+ */
+#include <benchmark/benchmark.h>
+#include <utils/lua/solution_table.h>
+#include <utils/models/solver.h>
+
+#include <algorithm>
+#include <format>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+struct Product {
+    std::vector<std::string>            scopes;
+    Frasy::Models::Solver::Dependencies dependencies;
+    std::unordered_set<std::string>     synchronized;
+};
+
+Product MakeProduct(std::size_t tests)
+{
+    std::mt19937 rng {42};
+    Product      product;
+    product.scopes.reserve(tests);
+    for (std::size_t i = 0; i < tests; ++i) {
+        auto& name         = product.scopes.emplace_back(std::format("Test{}", i));
+        auto& dependencies = product.dependencies[name];
+
+        const std::size_t count = i == 0 ? 0 : rng() % 4;
+        for (std::size_t d = 0; d < count; ++d) {
+            dependencies.push_back(product.scopes[i - 1 - rng() % std::min<std::size_t>(i, 64)]);
+        }
+        if (rng() % 100 == 0) { product.synchronized.insert(name); }
+    }
+    return product;
+}
+
+/// Same product, as the tables built by Orchestrator.Generate().
+void PushProduct(sol::state& lua, const Product& product)
+{
+    auto scopes       = lua.create_table(static_cast<int>(product.scopes.size()), 0);
+    auto requirements = lua.create_table(0, static_cast<int>(product.scopes.size()));
+    for (std::size_t i = 0; i < product.scopes.size(); ++i) {
+        const auto& name = product.scopes[i];
+        scopes[i + 1]    = name;
+        auto deps        = lua.create_table();
+        for (const auto& dependency : product.dependencies.at(name)) {
+            deps[dependency] = 0;
+        }
+        requirements[name] = deps;
+    }
+    auto synchronized = lua.create_table();
+    for (const auto& name : product.synchronized) {
+        synchronized[name] = 0;
+    }
+    lua["scopes"]       = scopes;
+    lua["requirements"] = requirements;
+    lua["synchronized"] = synchronized;
+}
+
+sol::state MakeState()
+{
+    sol::state lua;
+    lua.open_libraries(sol::lib::base, sol::lib::table, sol::lib::package, sol::lib::string);
+    lua.script("function InvalidRequirement(what) return what end");
+    return lua;
+}
+
+/// The layering loop of sort_utils.lua before the sort was moved to Frasy::Models::Solver.
+constexpr auto s_legacySort = R"(
+local function HasMetDependencies(requirement, scopes)
+    for dep, _ in pairs(requirement) do
+        for _, scope in ipairs(scopes) do
+            if scope == dep then return false end
+        end
+    end
+    return true
+end
+
+return function(scopes, requirements)
+    local order = {}
+    while (#scopes ~= 0) do
+        local layer   = {}
+        local removal = {}
+        for index, name in ipairs(scopes) do
+            if HasMetDependencies(requirements[name], scopes) then
+                table.insert(layer, name)
+                table.insert(removal, index)
+            end
+        end
+        for index = #removal, 1, -1 do
+            table.remove(scopes, removal[index])
+        end
+        if #layer == 0 then error("circular") end
+        table.insert(order, layer)
+    end
+    return order
+end
+)";
+
+void BM_SortScopes_Native(benchmark::State& state)
+{
+    const auto product = MakeProduct(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        auto layers =
+          Frasy::Models::Solver::SortScopes(product.scopes, std::nullopt, std::nullopt, product.dependencies);
+        auto sections = Frasy::Models::Solver::Sectionize(layers, product.synchronized);
+        benchmark::DoNotOptimize(sections);
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_SortScopes_Native)->RangeMultiplier(2)->Range(1000, 10000)->Complexity();
+
+/// What Orchestrator.Generate() actually pays: the native sort, including the conversion of the tables.
+void BM_SortScopes_Lua(benchmark::State& state)
+{
+    auto lua = MakeState();
+    Frasy::Lua::ImportSolver(lua);
+    PushProduct(lua, MakeProduct(static_cast<std::size_t>(state.range(0))));
+    lua["Sort"] = lua.require_file("Sort", "lua/core/framework/sort_utils.lua");
+    sol::protected_function sort =
+      lua.script("return function() return Sort.Sectionize(Sort.SortScopes(scopes, nil, nil, requirements), "
+                 "synchronized) end");
+    for (auto _ : state) {
+        auto result = sort();
+        benchmark::DoNotOptimize(result.valid());
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_SortScopes_Lua)->RangeMultiplier(2)->Range(1000, 10000)->Complexity();
+
+/// Reference point, capped to 2k tests: the former sort is cubic and takes seconds beyond that.
+void BM_SortScopes_LegacyLua(benchmark::State& state)
+{
+    auto lua = MakeState();
+    PushProduct(lua, MakeProduct(static_cast<std::size_t>(state.range(0))));
+    sol::protected_function legacy = lua.script(s_legacySort);
+    sol::protected_function copy   = lua.script("return function(t) return table.move(t, 1, #t, 1, {}) end");
+    for (auto _ : state) {
+        state.PauseTiming();
+        sol::table scopes = copy(lua["scopes"]);
+        state.ResumeTiming();
+        auto result = legacy(scopes, lua["requirements"]);
+        benchmark::DoNotOptimize(result.valid());
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_SortScopes_LegacyLua)
+  ->Arg(250)
+  ->Arg(500)
+  ->Arg(1000)
+  ->Arg(2000)
+  ->Complexity()
+  ->Unit(benchmark::kMillisecond);
+}    // namespace
@@ -0,0 +1,123 @@
+/**
+ * @file    pdo.cpp
+ * @brief   Unit tests for Frasy::CanOpen::PdoDispatcher and Frasy::CanOpen::PdoQueue.
+ */
+#include <gtest/gtest.h>
+#include <utils/communication/can_open/services/pdo.h>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+using Frasy::CanOpen::PdoDispatcher;
+using Frasy::CanOpen::PdoFrame;
+
+namespace {
+constexpr std::array<uint8_t, 8> s_data = {1, 2, 3, 4, 5, 6, 7, 8};
+}    // namespace
+
+TEST(PdoDispatcher, UsesThePredefinedConnectionSet)
+{
+    EXPECT_EQ(PdoDispatcher::cobId(0x02, 1), 0x182);
+    EXPECT_EQ(PdoDispatcher::cobId(0x02, 2), 0x282);
+    EXPECT_EQ(PdoDispatcher::cobId(0x7F, 4), 0x4FF);
+}
+
+TEST(PdoDispatcher, CallsTheSubscribersOfATpdo)
+{
+    PdoDispatcher         dispatcher;
+    std::vector<PdoFrame> frames;
+    auto handle = dispatcher.subscribe(0x02, 2, [&](const PdoFrame& frame) { frames.push_back(frame); });
+
+    dispatcher.dispatch(0x282, s_data.data(), 6);
+    dispatcher.dispatch(0x182, s_data.data(), 8);    // Other TPDO.
+    dispatcher.dispatch(0x283, s_data.data(), 8);    // Other node.
+    dispatcher.dispatch(0x702, s_data.data(), 1);    // Not a TPDO.
+    ASSERT_EQ(frames.size(), 1);
+    EXPECT_EQ(frames[0].nodeId, 0x02);
+    EXPECT_EQ(frames[0].tpdo, 2);
+    EXPECT_EQ(frames[0].size, 6);
+    EXPECT_EQ(frames[0].data[5], 6);
+    EXPECT_EQ(frames[0].data[6], 0);
+
+    dispatcher.unsubscribe(handle);
+    EXPECT_EQ(dispatcher.subscriptions(), 0);
+    dispatcher.dispatch(0x282, s_data.data(), 6);
+    EXPECT_EQ(frames.size(), 1);
+}
+
+TEST(PdoDispatcher, QueuesTheFramesOfAListener)
+{
+    PdoDispatcher dispatcher;
+    auto          queue = dispatcher.listen(0x10, 1);
+    dispatcher.dispatch(0x190, s_data.data(), 8);
+    dispatcher.dispatch(0x190, s_data.data(), 2);
+
+    auto first = queue->wait(0ms);
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(first->size, 8);
+    auto second = queue->wait(0ms);
+    ASSERT_TRUE(second.has_value());
+    EXPECT_EQ(second->size, 2);
+    EXPECT_FALSE(queue->wait(10ms).has_value());
+}
+
+TEST(PdoDispatcher, WakesUpAWaitingListener)
+{
+    PdoDispatcher dispatcher;
+    auto          queue = dispatcher.listen(0x10, 3);
+
+    std::jthread sender {[&] {
+        std::this_thread::sleep_for(20ms);
+        dispatcher.dispatch(0x390, s_data.data(), 4);
+    }};
+    auto frame = queue->wait(5s);
+    ASSERT_TRUE(frame.has_value());
+    EXPECT_EQ(frame->tpdo, 3);
+    EXPECT_LT(std::chrono::steady_clock::now() - frame->receivedAt, 1s);
+}
+
+TEST(PdoDispatcher, DropsFramesOfAFullListener)
+{
+    PdoDispatcher dispatcher;
+    auto          queue = dispatcher.listen(0x10, 1, 2);
+    for (int i = 0; i < 5; ++i) {
+        dispatcher.dispatch(0x190, s_data.data(), 8);
+    }
+    EXPECT_EQ(queue->dropped(), 3);
+    queue->clear();
+    EXPECT_FALSE(queue->wait(0ms).has_value());
+}
+
+TEST(PdoDispatcher, ForgetsClosedAndDestroyedListeners)
+{
+    PdoDispatcher dispatcher;
+    auto          closed    = dispatcher.listen(0x10, 1);
+    auto          destroyed = dispatcher.listen(0x10, 1);
+    auto          kept      = dispatcher.listen(0x10, 1);
+    EXPECT_EQ(dispatcher.subscriptions(), 3);
+
+    closed->close();
+    destroyed.reset();
+    dispatcher.dispatch(0x190, s_data.data(), 8);
+    EXPECT_EQ(dispatcher.subscriptions(), 1);
+    EXPECT_FALSE(closed->wait(0ms).has_value());
+    EXPECT_TRUE(kept->wait(0ms).has_value());
+}
+
+TEST(PdoQueue, CloseWakesUpAWaitingThread)
+{
+    PdoDispatcher dispatcher;
+    auto          queue = dispatcher.listen(0x10, 1);
+
+    std::jthread closer {[&] {
+        std::this_thread::sleep_for(20ms);
+        queue->close();
+    }};
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(queue->wait(5s).has_value());
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 1s);
+}
@@ -0,0 +1,108 @@
+/**
+ * @file    sdo.cpp
+ * @brief   Unit tests for Frasy::CanOpen::SdoManager, through a CanOpen instance talking to a simulated node on a
+ *          virtual bus.
+ */
+#include <gtest/gtest.h>
+#include <utils/communication/can_open/can_open.h>
+#include <utils/communication/can_open/simulation/simulated_node.h>
+#include <utils/communication/slcan/virtual_port.h>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <optional>
+#include <string>
+
+using namespace std::chrono_literals;
+using Frasy::CanOpen::CanOpen;
+using Frasy::CanOpen::EdsDictionary;
+using Frasy::CanOpen::SdoManager;
+using Frasy::CanOpen::SdoRequestStatus;
+using Frasy::CanOpen::SimulatedNode;
+using Frasy::SlCan::VirtualBus;
+using Frasy::SlCan::VirtualPort;
+
+namespace {
+constexpr uint8_t s_nodeId = 0x10;
+
+constexpr auto s_eds = R"(
+[1017]
+ParameterName=Producer heartbeat time
+DataType=0x0006
+AccessType=rw
+DefaultValue=10
+)";
+
+class SdoTest : public ::testing::Test {
+protected:
+    //! Starts CANopen with the simulated node on the bus, which answers after latency.
+    void start(std::chrono::microseconds latency)
+    {
+        const std::string bus = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        node.emplace(VirtualBus::get(bus),
+                     s_nodeId,
+                     EdsDictionary::parse(s_eds, s_nodeId),
+                     SimulatedNode::Options {.latency = latency});
+        ASSERT_TRUE(canOpen.addDevice(std::string {VirtualPort::s_prefix} + bus));
+        canOpen.addNode(s_nodeId);
+        canOpen.start();
+    }
+
+    SdoManager& sdo() { return *(*canOpen.getNode(s_nodeId))->sdoInterface(); }
+
+    //! Uploads the heartbeat time of the node, 10.
+    auto upload() { return sdo().uploadData(0x1017, 0); }
+
+    std::optional<SimulatedNode> node;
+    CanOpen                      canOpen;    // Stopped before the node is destroyed.
+};
+}    // namespace
+
+TEST_F(SdoTest, CompletesARequestQueuedRightAfterReopening)
+{
+    start(0us);
+
+    canOpen.reopen(std::array {s_nodeId});
+    auto request = upload();
+
+    ASSERT_EQ(request.future.wait_for(2s), std::future_status::ready);
+    auto result = request.future.get();
+    EXPECT_EQ(request.status(), SdoRequestStatus::Complete);
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result->size(), 2);
+    EXPECT_EQ((*result)[0], 10);
+}
+
+TEST_F(SdoTest, ReopeningFailsOnlyTheRequestsQueuedBefore)
+{
+    // Slow enough for the first request to still be in progress when the port is reopened.
+    start(200ms);
+
+    auto inProgress = upload();
+    auto queued     = upload();
+    canOpen.reopen(std::array {s_nodeId});
+    auto after = upload();
+
+    EXPECT_EQ(queued.future.wait_for(0s), std::future_status::ready);
+    EXPECT_EQ(queued.status(), SdoRequestStatus::Cancelled);
+    ASSERT_EQ(inProgress.future.wait_for(1s), std::future_status::ready);
+    EXPECT_EQ(inProgress.status(), SdoRequestStatus::Cancelled);
+
+    ASSERT_EQ(after.future.wait_for(2s), std::future_status::ready);
+    EXPECT_TRUE(after.future.get().has_value());
+    EXPECT_EQ(after.status(), SdoRequestStatus::Complete);
+}
+
+TEST_F(SdoTest, ReopeningKeepsTheRequestsOfTheOtherNodes)
+{
+    start(200ms);
+
+    auto request = upload();
+    canOpen.reopen();
+
+    // Its frames may be lost with the port, it is then tried again once it times out.
+    ASSERT_EQ(request.future.wait_for(3s), std::future_status::ready);
+    EXPECT_EQ(request.status(), SdoRequestStatus::Complete);
+}
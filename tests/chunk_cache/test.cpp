@@ -0,0 +1,213 @@
+/**
+ * @file    test.cpp
+ * @brief   Unit tests for Frasy::Lua::ChunkCache.
+ */
+#include <gtest/gtest.h>
+#include <utils/lua/chunk_cache.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace {
+class ChunkCacheTest : public ::testing::Test {
+protected:
+    std::filesystem::path    dir = std::filesystem::temp_directory_path() / "frasy_chunk_cache_test";
+    Frasy::Lua::ChunkCache   cache;
+
+    void SetUp() override
+    {
+        std::filesystem::remove_all(dir);
+        std::filesystem::create_directories(dir);
+    }
+
+    void TearDown() override { std::filesystem::remove_all(dir); }
+
+    /// Write a Lua file in the temporary directory and return its path, using forward slashes like the orchestrator.
+    std::string writeFile(const std::string& name, const std::string& content)
+    {
+        auto          path = (dir / name).generic_string();
+        std::ofstream os {path, std::ios::binary};
+        os << content;
+        return path;
+    }
+
+    static sol::state makeState()
+    {
+        sol::state lua;
+        lua.open_libraries(sol::lib::base, sol::lib::package, sol::lib::debug, sol::lib::string);
+        return lua;
+    }
+};
+}    // namespace
+
+// --- scriptFile ---
+
+TEST_F(ChunkCacheTest, ScriptFileReturnsValues)
+{
+    auto path = writeFile("value.lua", "return 40 + 2");
+    auto lua  = makeState();
+
+    int value = cache.scriptFile(lua, path);
+
+    EXPECT_EQ(value, 42);
+}
+
+TEST_F(ChunkCacheTest, ScriptFileCompilesOnceAcrossStates)
+{
+    auto path = writeFile("value.lua", "return 'hello'");
+    auto a    = makeState();
+    auto b    = makeState();
+
+    std::string first  = cache.scriptFile(a, path);
+    std::string second = cache.scriptFile(b, path);
+
+    EXPECT_EQ(first, "hello");
+    EXPECT_EQ(second, "hello");
+    EXPECT_EQ(cache.stats().misses, 1);
+    EXPECT_EQ(cache.stats().hits, 1);
+}
+
+TEST_F(ChunkCacheTest, CachedChunkDoesNotRereadFile)
+{
+    auto path = writeFile("value.lua", "return 1");
+    auto lua  = makeState();
+    cache.setKey("abc");
+    (void)cache.scriptFile(lua, path);
+
+    std::filesystem::remove(path);
+
+    int value = cache.scriptFile(lua, path);
+    EXPECT_EQ(value, 1);
+}
+
+TEST_F(ChunkCacheTest, ChunkKeepsSourceName)
+{
+    auto path = writeFile("source.lua", "return debug.getinfo(1, 'S').source");
+    auto lua  = makeState();
+    (void)cache.scriptFile(lua, path);
+
+    std::string source = cache.scriptFile(lua, path);
+
+    EXPECT_EQ(source, "@" + path);
+}
+
+TEST_F(ChunkCacheTest, SkipsBomAndShebangWithoutShiftingLines)
+{
+    auto path = writeFile("prefix.lua", "\xEF\xBB\xBF#!/usr/bin/lua\nreturn debug.getinfo(1, 'l').currentline");
+    auto lua  = makeState();
+
+    int line = cache.scriptFile(lua, path);
+
+    EXPECT_EQ(line, 2);
+}
+
+TEST_F(ChunkCacheTest, SyntaxErrorThrows)
+{
+    auto path = writeFile("broken.lua", "return +");
+    auto lua  = makeState();
+
+    EXPECT_THROW((void)cache.scriptFile(lua, path), sol::error);
+    EXPECT_THROW((void)cache.scriptFile(lua, path), sol::error);
+    EXPECT_EQ(cache.stats().failures, 2);
+}
+
+TEST_F(ChunkCacheTest, MissingFileThrows)
+{
+    auto lua = makeState();
+
+    EXPECT_THROW((void)cache.scriptFile(lua, (dir / "missing.lua").generic_string()), sol::error);
+}
+
+TEST_F(ChunkCacheTest, RuntimeErrorThrows)
+{
+    auto path = writeFile("error.lua", "error('nope')");
+    auto lua  = makeState();
+
+    EXPECT_THROW((void)cache.scriptFile(lua, path), sol::error);
+}
+
+// --- Keys ---
+
+TEST_F(ChunkCacheTest, SameKeyKeepsChunks)
+{
+    auto path = writeFile("value.lua", "return 1");
+    auto lua  = makeState();
+    cache.setKey("abc");
+    (void)cache.scriptFile(lua, path);
+
+    cache.setKey("abc");
+    (void)cache.scriptFile(lua, path);
+
+    EXPECT_EQ(cache.stats().misses, 1);
+}
+
+TEST_F(ChunkCacheTest, DifferentKeyDropsChunks)
+{
+    auto path = writeFile("value.lua", "return 1");
+    auto lua  = makeState();
+    cache.setKey("abc");
+    (void)cache.scriptFile(lua, path);
+
+    writeFile("value.lua", "return 2");
+    cache.setKey("def");
+    int value = cache.scriptFile(lua, path);
+
+    EXPECT_EQ(value, 2);
+    EXPECT_EQ(cache.stats().misses, 2);
+}
+
+TEST_F(ChunkCacheTest, EmptyKeyAlwaysDropsChunks)
+{
+    auto path = writeFile("value.lua", "return 1");
+    auto lua  = makeState();
+    cache.setKey("");
+    (void)cache.scriptFile(lua, path);
+
+    cache.setKey("");
+    (void)cache.scriptFile(lua, path);
+
+    EXPECT_EQ(cache.stats().misses, 2);
+}
+
+// --- require ---
+
+TEST_F(ChunkCacheTest, RequireGoesThroughCache)
+{
+    writeFile("module.lua", "return { answer = 42 }");
+    auto a = makeState();
+    auto b = makeState();
+    for (auto* lua : {&a, &b}) {
+        cache.install(*lua);
+        (*lua)["package"]["path"] = (dir / "?.lua").generic_string();
+    }
+
+    int first  = a.script("return require('module').answer");
+    int second = b.script("return require('module').answer");
+
+    EXPECT_EQ(first, 42);
+    EXPECT_EQ(second, 42);
+    EXPECT_EQ(cache.stats().misses, 1);
+}
+
+TEST_F(ChunkCacheTest, RequireUnknownModuleFails)
+{
+    auto lua = makeState();
+    cache.install(lua);
+    lua["package"]["path"] = (dir / "?.lua").generic_string();
+
+    auto result = lua.safe_script("return require('unknown')", sol::script_pass_on_error);
+
+    EXPECT_FALSE(result.valid());
+}
+
+TEST_F(ChunkCacheTest, RequireFileSetsGlobalAndLoaded)
+{
+    auto path = writeFile("json.lua", "return { name = 'json' }");
+    auto lua  = makeState();
+
+    cache.requireFile(lua, "Json", path);
+
+    EXPECT_EQ(lua["Json"]["name"].get<std::string>(), "json");
+    EXPECT_EQ(lua["package"]["loaded"]["Json"]["name"].get<std::string>(), "json");
+}
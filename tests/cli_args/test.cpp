@@ -47,6 +47,8 @@ TEST(CliArgs, NoArgsReturnsDefaults)
     EXPECT_EQ(args.outputDir, "logs");
     EXPECT_FALSE(args.skipVerification);
     EXPECT_EQ(args.popupTimeoutSeconds, 0);
+    EXPECT_FALSE(args.parallelTests);
+    EXPECT_TRUE(args.tracePath.empty());
 }
 
 TEST(CliArgs, HeadlessFlagParsed)
@@ -138,6 +140,23 @@ TEST(CliArgs, SkipVerificationParsed)
     EXPECT_TRUE(args.skipVerification);
 }
 
+TEST(CliArgs, ParallelTestsParsed)
+{
+    ArgvBuilder ab {"frasy.exe", "--headless", "--product", "P", "--operator",
+                    "Op",        "--serial",   "SN1",       "--parallel-tests"};
+    auto        args = Frasy::CliArgs::parse(ab.argc(), ab.argv());
+
+    EXPECT_TRUE(args.parallelTests);
+}
+
+TEST(CliArgs, TracePathParsed)
+{
+    ArgvBuilder ab {"frasy.exe", "--trace", "out.json"};
+    auto        args = Frasy::CliArgs::parse(ab.argc(), ab.argv());
+
+    EXPECT_EQ(args.tracePath, "out.json");
+}
+
 TEST(CliArgs, PopupTimeoutParsed)
 {
     ArgvBuilder ab {"frasy.exe",   "--headless", "--product", "P", "--operator",
@@ -0,0 +1,131 @@
+/**
+ * @file    test.cpp
+ * @brief   Unit tests for Frasy::Lua::GenerationCache and the JSON serialization of Models::Solution.
+ */
+#include <gtest/gtest.h>
+#include <utils/lua/orchestrator/generation_cache.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using Frasy::Lua::GenerationCache;
+using Frasy::Models::Solution;
+
+namespace {
+class GenerationCacheTest : public ::testing::Test {
+protected:
+    std::filesystem::path dir   = std::filesystem::temp_directory_path() / "frasy_generation_cache_test";
+    GenerationCache       cache = GenerationCache {dir / "product" / "generation_cache.json"};
+
+    void SetUp() override { std::filesystem::remove_all(dir); }
+
+    void TearDown() override { std::filesystem::remove_all(dir); }
+
+    static Solution makeSolution()
+    {
+        Solution solution;
+        solution.sections = {
+          {{{"Init", {{"Setup"}}}}},
+          {{{"Run", {{"T1", "T2"}, {"T3"}}}, {"Other", {{"T1"}}}}, {{"Run", {}}}},
+        };
+        return solution;
+    }
+
+    void writeCache(const std::string& content) const
+    {
+        std::filesystem::create_directories(cache.path().parent_path());
+        std::ofstream os {cache.path()};
+        os << content;
+    }
+};
+
+TEST_F(GenerationCacheTest, MissingFileIsAMiss)
+{ EXPECT_FALSE(cache.load("key").has_value()); }
+
+TEST_F(GenerationCacheTest, StoreThenLoad)
+{
+    const auto solution = makeSolution();
+    ASSERT_TRUE(cache.store("key", solution));
+
+    auto loaded = cache.load("key");
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(loaded->sections, solution.sections);
+}
+
+TEST_F(GenerationCacheTest, LoadRegistersSequencesAndTests)
+{
+    ASSERT_TRUE(cache.store("key", makeSolution()));
+    auto loaded = cache.load("key");
+    ASSERT_TRUE(loaded.has_value());
+
+    ASSERT_EQ(loaded->sequences.size(), 3);
+    EXPECT_EQ(loaded->sequences.at("Init").tests.size(), 1);
+    EXPECT_EQ(loaded->sequences.at("Run").tests.size(), 3);
+    EXPECT_TRUE(loaded->sequences.at("Other").tests.contains("T1"));
+}
+
+TEST_F(GenerationCacheTest, OtherKeyIsAMiss)
+{
+    ASSERT_TRUE(cache.store("key", makeSolution()));
+    EXPECT_FALSE(cache.load("other").has_value());
+}
+
+TEST_F(GenerationCacheTest, EmptyKeyIsNeverCached)
+{
+    EXPECT_FALSE(cache.store("", makeSolution()));
+    EXPECT_FALSE(std::filesystem::exists(cache.path()));
+    EXPECT_FALSE(cache.load("").has_value());
+}
+
+TEST_F(GenerationCacheTest, StoreReplacesPreviousSolution)
+{
+    ASSERT_TRUE(cache.store("first", makeSolution()));
+    ASSERT_TRUE(cache.store("second", Solution {}));
+
+    EXPECT_FALSE(cache.load("first").has_value());
+    auto loaded = cache.load("second");
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_TRUE(loaded->sections.empty());
+    EXPECT_FALSE(std::filesystem::exists(std::filesystem::path(cache.path()) += ".tmp"));
+}
+
+TEST_F(GenerationCacheTest, InvalidFileIsAMiss)
+{
+    writeCache("{ not json");
+    EXPECT_FALSE(cache.load("key").has_value());
+
+    writeCache(R"({"version": 1, "key": "key", "solution": [[[{"tests": []}]]]})");
+    EXPECT_FALSE(cache.load("key").has_value());
+}
+
+TEST_F(GenerationCacheTest, OtherVersionIsAMiss)
+{
+    writeCache(R"({"version": 0, "key": "key", "solution": []})");
+    EXPECT_FALSE(cache.load("key").has_value());
+}
+
+TEST_F(GenerationCacheTest, Invalidate)
+{
+    ASSERT_TRUE(cache.store("key", makeSolution()));
+    cache.invalidate();
+    EXPECT_FALSE(std::filesystem::exists(cache.path()));
+    EXPECT_FALSE(cache.load("key").has_value());
+}
+
+TEST(SolutionJson, MatchesTheLayoutGeneratedInLua)
+{
+    // As written by SaveAsJson from Orchestrator.Generate().
+    const auto json = nlohmann::json::parse(R"([[[{"name": "Seq", "tests": [["T1"], ["T2", "T3"]]}]]])");
+
+    const auto solution = json.get<Solution>();
+    ASSERT_EQ(solution.sections.size(), 1);
+    ASSERT_EQ(solution.sections[0].size(), 1);
+    ASSERT_EQ(solution.sections[0][0].size(), 1);
+    EXPECT_EQ(solution.sections[0][0][0].first, "Seq");
+    EXPECT_EQ(solution.sections[0][0][0].second.size(), 2);
+    EXPECT_EQ(solution.sequences.at("Seq").tests.size(), 3);
+
+    EXPECT_EQ(nlohmann::json(solution), json);
+}
+}    // namespace
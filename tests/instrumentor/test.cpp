@@ -0,0 +1,134 @@
+/**
+ * @file    test.cpp
+ * @brief   Unit tests for Brigerad::Instrumentor and its queue.
+ */
+#include <Brigerad/Debug/Instrumentor.h>
+#include <gtest/gtest.h>
+#include <json.hpp>
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+using Brigerad::Instrumentor;
+using Brigerad::ProfileResult;
+using Brigerad::ProfileResultQueue;
+
+namespace {
+nlohmann::json ReadSession(const std::filesystem::path& path)
+{
+    std::ifstream file {path};
+    return nlohmann::json::parse(file);
+}
+}    // namespace
+
+TEST(ProfileResultQueue, PopsInPushOrder)
+{
+    ProfileResultQueue queue {8};
+    for (long long i = 0; i < 5; ++i) {
+        ASSERT_TRUE(queue.Push({"event", i, i + 1, 0}));
+    }
+    ProfileResult result;
+    for (long long i = 0; i < 5; ++i) {
+        ASSERT_TRUE(queue.Pop(result));
+        EXPECT_EQ(result.Start, i);
+    }
+    EXPECT_FALSE(queue.Pop(result));
+}
+
+TEST(ProfileResultQueue, RejectsWhenFull)
+{
+    ProfileResultQueue queue {4};
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(queue.Push({"event", i, i, 0}));
+    }
+    EXPECT_FALSE(queue.Push({"event", 4, 4, 0}));
+
+    // A popped slot is reusable.
+    ProfileResult result;
+    ASSERT_TRUE(queue.Pop(result));
+    EXPECT_TRUE(queue.Push({"event", 4, 4, 0}));
+}
+
+TEST(ProfileResultQueue, ConcurrentProducersLoseNothingButDrops)
+{
+    constexpr int      producers = 4;
+    constexpr int      perThread = 50'000;
+    ProfileResultQueue queue {1024};
+    std::atomic_int    dropped = 0;
+    std::atomic_bool   done    = false;
+    int                popped  = 0;
+
+    std::thread consumer([&] {
+        ProfileResult result;
+        for (;;) {
+            const bool finished = done.load();
+            while (queue.Pop(result)) {
+                ++popped;
+            }
+            if (finished) { break; }
+            std::this_thread::yield();
+        }
+    });
+    std::vector<std::thread> threads;
+    for (int t = 0; t < producers; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < perThread; ++i) {
+                if (!queue.Push({"event", i, i, 0})) { ++dropped; }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    done = true;
+    consumer.join();
+
+    EXPECT_EQ(popped + dropped, producers * perThread);
+}
+
+TEST(Instrumentor, SessionIsAValidTraceWithEveryScope)
+{
+    const auto path = std::filesystem::temp_directory_path() / "frasy_instrumentor_session.json";
+    auto&      instrumentor = Instrumentor::Get();
+    instrumentor.BeginSession("Test", path.string());
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([] {
+            for (int i = 0; i < 1000; ++i) {
+                BR_PROFILE_SCOPE("Scope \"quoted\"");
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    instrumentor.EndSession();
+
+    const auto session = ReadSession(path);
+    const auto dropped = session["otherData"]["droppedEvents"].get<std::size_t>();
+    EXPECT_EQ(dropped, instrumentor.DroppedResults());
+    EXPECT_EQ(session["traceEvents"].size() + dropped, 4000);
+    ASSERT_FALSE(session["traceEvents"].empty());
+    EXPECT_EQ(session["traceEvents"][0]["name"], "Scope 'quoted'");
+    EXPECT_EQ(session["traceEvents"][0]["ph"], "X");
+    std::filesystem::remove(path);
+}
+
+TEST(Instrumentor, ScopesOutsideASessionAreNotWritten)
+{
+    const auto path = std::filesystem::temp_directory_path() / "frasy_instrumentor_empty.json";
+    {
+        BR_PROFILE_SCOPE("Before");
+    }
+    BR_PROFILE_BEGIN_SESSION("Test", path.string());
+    BR_PROFILE_END_SESSION();
+    {
+        BR_PROFILE_SCOPE("After");
+    }
+
+    EXPECT_TRUE(ReadSession(path)["traceEvents"].empty());
+    std::filesystem::remove(path);
+}
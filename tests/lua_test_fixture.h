@@ -11,6 +11,7 @@
 
 #include <gtest/gtest.h>
 #include <sol/sol.hpp>
+#include <utils/lua/solution_table.h>
 
 #include <filesystem>
 #include <string>
@@ -20,6 +21,7 @@
  * Base test fixture that sets up a Lua state with:
  * - Standard libraries (base, string, table, math, io, debug, package)
  * - C++ mock functions for bindings that don't exist in test context
+ * - The native solver used by sort_utils.lua (__solver)
  * - Framework globals (Stage, Context, Orchestrator, exception constructors)
  * - Utility globals from global.lua (Print, ToString, Equals, Traverse, LineSplit, ToInt)
  * - package.path configured to resolve require("lua/core/...") from the test binary dir
@@ -114,6 +116,9 @@ protected:
         lua.set_function("__exclusive", [](int /*value*/, sol::function func) { func(); });
         lua.set_function("__once", [](int /*hash*/, sol::function func) { func(); });
 
+        // Not a mock: the sort of the solution is done natively
+        Frasy::Lua::ImportSolver(lua);
+
         // Log mock — used by many scripts (orchestrator, sort_utils, exception handling)
         lua.script(R"(
             Log = {
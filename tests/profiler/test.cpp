@@ -0,0 +1,276 @@
+/**
+ * @file    test.cpp
+ * @brief   Unit tests for Frasy::Profiler.
+ *
+ * The profiler is a singleton, every test starts by resetting it and only looks at the events of the threads it
+ * started itself.
+ */
+#include <Brigerad/Debug/Instrumentor.h>
+#include <gtest/gtest.h>
+#include <json.hpp>
+#include <utils/lua/profile_events.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Frasy::ProfileEvent;
+using Frasy::Profiler;
+
+class ProfilerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        Profiler::get().enable();
+        Profiler::get().reset();
+    }
+
+    /// Events of the calling thread, after a merge.
+    static const std::list<ProfileEvent>* threadEvents(std::thread::id id = std::this_thread::get_id())
+    {
+        const auto& events = Profiler::get().getEvents();
+        auto        it     = events.find(id);
+        return it == events.end() ? nullptr : &it->second.getEvents();
+    }
+
+    static const ProfileEvent* find(const std::list<ProfileEvent>& events, const std::string& name)
+    {
+        auto it = std::ranges::find_if(events, [&](const ProfileEvent& event) { return event.header.name == name; });
+        return it == events.end() ? nullptr : &*it;
+    }
+};
+
+TEST_F(ProfilerTest, InternIsStable)
+{
+    auto& profiler = Profiler::get();
+    auto  a        = profiler.intern("a", "file", 1);
+    EXPECT_EQ(profiler.intern("a", "file", 1), a);
+    EXPECT_NE(profiler.intern("a", "file", 2), a);
+    EXPECT_NE(profiler.intern("b", "file", 1), a);
+}
+
+TEST_F(ProfilerTest, NestedScopesBuildATree)
+{
+    for (int i = 0; i < 3; ++i) {
+        FRASY_PROFILE_SCOPE("Outer");
+        {
+            FRASY_PROFILE_SCOPE("Inner");
+        }
+    }
+
+    const auto* events = threadEvents();
+    ASSERT_NE(events, nullptr);
+    ASSERT_EQ(events->size(), 1);
+    const auto& outer = events->front();
+    EXPECT_EQ(outer.header.name, "Outer");
+    EXPECT_EQ(outer.hitCount, 3);
+    EXPECT_EQ(outer.history.size(), 3);
+    ASSERT_EQ(outer.childs.size(), 1);
+    EXPECT_EQ(outer.childs.front().header.name, "Inner");
+    EXPECT_EQ(outer.childs.front().hitCount, 3);
+    EXPECT_EQ(outer.childs.front().parent, &outer);
+    EXPECT_GE(outer.totalTime, outer.childs.front().totalTime);
+}
+
+TEST_F(ProfilerTest, DynamicHeadersAreMergedTogether)
+{
+    auto& profiler = Profiler::get();
+    for (int i = 0; i < 5; ++i) {
+        std::string name = "LuaFunction";
+        ASSERT_TRUE(profiler.reportCallEvent(name, "@script.lua", 12));
+        profiler.reportReturnEvent();
+    }
+    profiler.reportCallEvent("LuaFunction", "@script.lua", 13);
+    profiler.reportReturnEvent();
+
+    const auto* events = threadEvents();
+    ASSERT_NE(events, nullptr);
+    ASSERT_EQ(events->size(), 2);
+    EXPECT_EQ(events->front().hitCount, 5);
+    EXPECT_EQ(events->front().header.source, "@script.lua");
+    EXPECT_EQ(events->back().hitCount, 1);
+}
+
+TEST_F(ProfilerTest, EventsKeepAccumulatingAcrossMerges)
+{
+    for (int i = 0; i < 2; ++i) {
+        {
+            FRASY_PROFILE_SCOPE("Event");
+        }
+        Profiler::get().getEvents();
+    }
+    const auto* events = threadEvents();
+    ASSERT_NE(events, nullptr);
+    ASSERT_NE(find(*events, "Event"), nullptr);
+    EXPECT_EQ(find(*events, "Event")->hitCount, 2);
+}
+
+TEST_F(ProfilerTest, EventInProgressIsCompletedByALaterMerge)
+{
+    {
+        FRASY_PROFILE_SCOPE("Outer");
+        {
+            FRASY_PROFILE_SCOPE("Inner");
+        }
+        const auto* events = threadEvents();
+        ASSERT_NE(events, nullptr);
+        EXPECT_EQ(find(*events, "Outer")->hitCount, 0);
+    }
+    EXPECT_EQ(find(*threadEvents(), "Outer")->hitCount, 1);
+}
+
+TEST_F(ProfilerTest, ThreadsHaveTheirOwnEvents)
+{
+    constexpr int                threadCount = 4;
+    constexpr int                eventCount  = 10'000;
+    std::vector<std::thread>     threads;
+    std::vector<std::thread::id> ids(threadCount);
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&ids, t] {
+            ids[t] = std::this_thread::get_id();
+            for (int i = 0; i < eventCount; ++i) {
+                FRASY_PROFILE_SCOPE("Worker");
+            }
+        });
+    }
+    // Merging while the threads are running is what the profiler panel does.
+    for (int i = 0; i < 100; ++i) {
+        Profiler::get().getEvents();
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (const auto& id : ids) {
+        const auto* events = threadEvents(id);
+        ASSERT_NE(events, nullptr);
+        ASSERT_EQ(events->size(), 1);
+        EXPECT_EQ(events->front().hitCount, eventCount);
+    }
+}
+
+TEST_F(ProfilerTest, DisabledProfilerRecordsNothing)
+{
+    Profiler::get().disable();
+    {
+        FRASY_PROFILE_SCOPE("Disabled");
+    }
+    Profiler::get().enable();
+
+    const auto* events = threadEvents();
+    EXPECT_TRUE(events == nullptr || find(*events, "Disabled") == nullptr);
+}
+
+TEST_F(ProfilerTest, ResetForgetsTheEventsInProgress)
+{
+    {
+        FRASY_PROFILE_SCOPE("Outer");
+        Profiler::get().reset();
+        {
+            FRASY_PROFILE_SCOPE("Inner");
+        }
+    }
+    {
+        FRASY_PROFILE_SCOPE("Next");
+    }
+
+    const auto* events = threadEvents();
+    ASSERT_NE(events, nullptr);
+    EXPECT_EQ(find(*events, "Outer"), nullptr);
+    ASSERT_NE(find(*events, "Inner"), nullptr);
+    ASSERT_NE(find(*events, "Next"), nullptr);
+    EXPECT_EQ(find(*events, "Next")->hitCount, 1);
+}
+
+TEST_F(ProfilerTest, UncollectedEventsAreDroppedByWholeScopes)
+{
+    // Nothing merges the events here, past the limit the profiler must drop them without breaking the tree.
+    auto&          profiler = Profiler::get();
+    constexpr auto count    = Profiler::s_maxPendingRecords;
+    profiler.reportCallEvent("Outer", "test", 0);
+    for (std::size_t i = 0; i < count; ++i) {
+        profiler.reportCallEvent("Inner", "test", 0);
+        profiler.reportCallEvent("Leaf", "test", 0);
+        profiler.reportReturnEvent();
+        profiler.reportReturnEvent();
+    }
+    profiler.reportReturnEvent();
+
+    const auto& details = profiler.getEvents().at(std::this_thread::get_id());
+    EXPECT_GT(details.droppedEvents(), 0);
+    const auto* outer = find(details.getEvents(), "Outer");
+    ASSERT_NE(outer, nullptr);
+    EXPECT_EQ(outer->hitCount, 1);
+    ASSERT_EQ(outer->childs.size(), 1);
+    const auto& inner = outer->childs.front();
+    ASSERT_EQ(inner.childs.size(), 1);
+    const auto& leaf = inner.childs.front();
+    EXPECT_LT(inner.hitCount, static_cast<int>(count));
+    EXPECT_LE(leaf.hitCount, inner.hitCount);
+    EXPECT_EQ(details.droppedEvents(), 4 * count - 2 * inner.hitCount - 2 * leaf.hitCount);
+
+    // Once merged, the events are recorded again.
+    profiler.reportCallEvent("Next", "test", 0);
+    profiler.reportReturnEvent();
+    const auto* next = find(*threadEvents(), "Next");
+    ASSERT_NE(next, nullptr);
+    EXPECT_EQ(next->hitCount, 1);
+}
+
+TEST_F(ProfilerTest, TraceHasTheTimelineOfEveryThread)
+{
+    auto&      profiler = Profiler::get();
+    const auto path     = std::filesystem::temp_directory_path() / "frasy_profiler_trace.json";
+    {
+        FRASY_PROFILE_SCOPE("BeforeTrace");
+    }
+    ASSERT_TRUE(profiler.startTrace(path));
+    EXPECT_TRUE(profiler.isTracing());
+    EXPECT_FALSE(profiler.startTrace(path));
+    {
+        FRASY_PROFILE_SCOPE("Outer \"quoted\"");
+        profiler.reportCallEvent("LuaFunction", "@script.lua", 12);
+        profiler.reportReturnEvent();
+    }
+    std::thread([] { FRASY_PROFILE_SCOPE("OtherThread"); }).join();
+    {
+        BR_PROFILE_SCOPE("BrigeradScope");
+    }
+    profiler.stopTrace();
+    EXPECT_FALSE(profiler.isTracing());
+
+    std::ifstream file {path};
+    auto          trace = nlohmann::json::parse(file);
+    auto          find  = [&](const std::string& name) -> const nlohmann::json* {
+        auto& events = trace["traceEvents"];
+        auto  it     = std::ranges::find_if(events, [&](const nlohmann::json& event) { return event["name"] == name; });
+        return it == events.end() ? nullptr : &*it;
+    };
+
+    EXPECT_EQ(find("BeforeTrace"), nullptr);
+    const auto* outer = find("Outer \"quoted\"");
+    const auto* lua   = find("LuaFunction");
+    const auto* other = find("OtherThread");
+    ASSERT_NE(outer, nullptr);
+    ASSERT_NE(lua, nullptr);
+    ASSERT_NE(other, nullptr);
+    ASSERT_NE(find("BrigeradScope"), nullptr);
+    EXPECT_EQ((*outer)["ph"], "X");
+    EXPECT_EQ((*lua)["cat"], "lua");
+    EXPECT_EQ((*lua)["args"]["line"], 12);
+    EXPECT_EQ((*outer)["tid"], (*lua)["tid"]);
+    EXPECT_NE((*outer)["tid"], (*other)["tid"]);
+    EXPECT_LE((*outer)["ts"].get<double>(), (*lua)["ts"].get<double>());
+    EXPECT_GE((*outer)["dur"].get<double>(), (*lua)["dur"].get<double>());
+    std::filesystem::remove(path);
+}
+
+TEST_F(ProfilerTest, TraceFailsOnUnwritablePath)
+{
+    EXPECT_FALSE(Profiler::get().startTrace(std::filesystem::path("missing_directory") / "trace.json"));
+    EXPECT_FALSE(Profiler::get().isTracing());
+}
@@ -0,0 +1,215 @@
+/**
+ * @file    analyzer.cpp
+ * @brief   Unit tests for Frasy::Analyzers::ResultAnalyzer, fed by the result index.
+ */
+#include "report_fixture.h"
+
+#include <gtest/gtest.h>
+#include <utils/result_analyzer/analyzer.h>
+#include <utils/result_analyzer/expectations/to_be_exact_base.h>
+#include <utils/result_analyzer/expectations/to_be_value_base.h>
+
+#include <filesystem>
+#include <format>
+#include <typeinfo>
+#include <vector>
+
+using Frasy::Analyzers::ResultAnalysisResults;
+using Frasy::Analyzers::ResultAnalyzer;
+using Frasy::Analyzers::ResultIndex;
+using Frasy::Analyzers::ResultOptions;
+using Frasy::Analyzers::ToBeExactBase;
+using Frasy::Analyzers::ToBeValueBase;
+using ReportFixture::ArchiveTest;
+using ReportFixture::MakeReport;
+
+namespace {
+constexpr std::string_view s_title = "Product";
+
+std::array<char, 32> Option(std::string_view value)
+{
+    std::array<char, 32> option = {};
+    std::ranges::copy(value, option.begin());
+    return option;
+}
+
+//! The statistics merged from several threads are only equal to a few roundings.
+void ExpectSameExpectation(ResultAnalysisResults::Expectation& expected, ResultAnalysisResults::Expectation& actual)
+{
+    auto expectedJson = expected.serialize();
+    auto actualJson   = actual.serialize();
+    for (std::string_view key : {"mean", "std_dev", "pp", "ppk"}) {
+        if (!expectedJson.contains(key)) { continue; }
+        EXPECT_NEAR(expectedJson.at(key).get<float>(), actualJson.at(key).get<float>(), 1e-4f) << key;
+        expectedJson.erase(key);
+        actualJson.erase(key);
+    }
+    expectedJson.erase("statistics");
+    actualJson.erase("statistics");
+    EXPECT_EQ(expectedJson, actualJson) << expected.Name;
+}
+}    // namespace
+
+TEST_F(ArchiveTest, IndexesTheArchivedReports)
+{
+    Archive(std::string {s_title}, MakeReport(1, "SN1", 3.3f), 10);
+    Archive(std::string {s_title}, MakeReport(2, "SN2", 3.5f), 11);
+    Archive(std::string {s_title}, MakeReport(1, "SN3", 3.25f, false), 12);
+
+    ResultAnalyzer analyzer;
+    auto           results = analyzer.Analyze(std::string {s_title});
+    EXPECT_EQ(analyzer.Analyzed, analyzer.ToAnalyze);
+    EXPECT_EQ(ResultIndex::Load(std::filesystem::path("logs") / s_title / "index").Reports.Flags.size(), 3);
+
+    ASSERT_TRUE(results.Locations.contains("Total"));
+    const auto& location = results.Locations.at("Total");
+    EXPECT_EQ(location.Total, 3);
+    EXPECT_EQ(location.Passed, 2);
+    EXPECT_DOUBLE_EQ(location.AverageDuration, 2.0);
+
+    const auto& test = location.Sequences.at("Power").Tests.at("Rails");
+    EXPECT_EQ(test.Name, "Rails");
+    EXPECT_EQ(test.Total, 3);
+    EXPECT_EQ(test.Skipped, 1);
+    EXPECT_EQ(test.Passed, 2);
+    EXPECT_FLOAT_EQ(test.PassedPercent, 100.0f);
+    EXPECT_FALSE(test.Expectations.contains("Pattern"));
+
+    auto* voltage = dynamic_cast<ToBeValueBase*>(test.Expectations.at("3V3").get());
+    ASSERT_NE(voltage, nullptr);
+    EXPECT_EQ(voltage->Total, 3);
+    EXPECT_EQ(voltage->Passed, 2);
+    EXPECT_FLOAT_EQ(voltage->Min, 3.2f);
+    EXPECT_FLOAT_EQ(voltage->MaxObserved, 3.5f);
+
+    auto* good = dynamic_cast<ToBeExactBase*>(test.Expectations.at("Good").get());
+    ASSERT_NE(good, nullptr);
+    EXPECT_EQ(good->Values.at("true").Seen, 2);
+    EXPECT_EQ(good->Values.at("false").Seen, 1);
+    EXPECT_EQ(good->Values.at("true").Type, "boolean");
+    auto* firmware = dynamic_cast<ToBeExactBase*>(test.Expectations.at("Firmware").get());
+    ASSERT_NE(firmware, nullptr);
+    EXPECT_EQ(firmware->Values.at("\"1.2\"").Seen, 3);
+    EXPECT_EQ(firmware->Values.at("\"1.2\"").Type, "string");
+}
+
+TEST_F(ArchiveTest, OnlyIndexesTheNewReports)
+{
+    Archive(std::string {s_title}, MakeReport(1, "SN1", 3.3f), 10);
+    ResultAnalyzer {}.Analyze(std::string {s_title});
+
+    Archive(std::string {s_title}, MakeReport(2, "SN2", 3.3f), 11);
+    ResultAnalyzer analyzer;
+    auto           results = analyzer.Analyze(std::string {s_title});
+    EXPECT_EQ(results.Locations.at("Total").Total, 2);
+    EXPECT_EQ(ResultIndex::Load(std::filesystem::path("logs") / s_title / "index").Reports.Flags.size(), 2);
+}
+
+TEST_F(ArchiveTest, FiltersWithTheOptions)
+{
+    Archive(std::string {s_title}, MakeReport(1, "SN1", 3.3f), 10);
+    Archive(std::string {s_title}, MakeReport(2, "SN2", 3.5f), 11);
+    Archive(std::string {s_title}, MakeReport(2, "XY3", 3.3f), 12);
+
+    auto bySerial = ResultAnalyzer {ResultOptions {.SerialNumbers = {Option("SN")}}}.Analyze(std::string {s_title});
+    EXPECT_EQ(bySerial.Locations.at("Total").Total, 2);
+
+    auto byLocation =
+      ResultAnalyzer {ResultOptions {.Uuts = {Option("2")}, .Ganged = false}}.Analyze(std::string {s_title});
+    ASSERT_EQ(byLocation.Locations.size(), 1);
+    EXPECT_EQ(byLocation.Locations.at("Location 2").Total, 2);
+
+    auto byTest = ResultAnalyzer {ResultOptions {.Tests = {Option("Other")}}}.Analyze(std::string {s_title});
+    EXPECT_TRUE(byTest.Locations.at("Total").Sequences.at("Power").Tests.empty());
+}
+
+TEST_F(ArchiveTest, RebuildsACorruptedIndex)
+{
+    Archive(std::string {s_title}, MakeReport(1, "SN1", 3.3f), 10);
+    ResultAnalyzer {}.Analyze(std::string {s_title});
+    std::filesystem::resize_file(std::filesystem::path("logs") / s_title / "index" / "tests.name", 1);
+
+    auto results = ResultAnalyzer {}.Analyze(std::string {s_title});
+    EXPECT_EQ(results.Locations.at("Total").Total, 1);
+}
+
+TEST_F(ArchiveTest, GivesTheSameResultsOnEveryThread)
+{
+    for (int i = 0; i < 40; ++i) {
+        Archive(std::string {s_title},
+                MakeReport(1 + (i % 3), std::format("SN{}", i), 3.2f + (static_cast<float>(i % 7) * 0.05f), i % 5 != 0),
+                100 + i);
+    }
+
+    for (bool ganged : {true, false}) {
+        auto analyze = [ganged](size_t threads) {
+            return ResultAnalyzer {ResultOptions {.Ganged = ganged, .KeepValues = true, .Threads = threads}}.Analyze(
+              std::string {s_title});
+        };
+        auto serial   = analyze(1);
+        auto parallel = analyze(8);
+        ASSERT_EQ(serial.Locations.size(), ganged ? 1 : 3);
+        ASSERT_EQ(serial.Locations.size(), parallel.Locations.size());
+        for (auto&& [name, location] : serial.Locations) {
+            const auto& other = parallel.Locations.at(name);
+            EXPECT_EQ(location.Total, other.Total);
+            EXPECT_EQ(location.Passed, other.Passed);
+            EXPECT_EQ(location.Durations, other.Durations);
+            for (auto&& [sName, sequence] : location.Sequences) {
+                for (auto&& [tName, test] : sequence.Tests) {
+                    const auto& otherTest = other.Sequences.at(sName).Tests.at(tName);
+                    EXPECT_EQ(test.Total, otherTest.Total);
+                    EXPECT_EQ(test.Skipped, otherTest.Skipped);
+                    EXPECT_EQ(test.Passed, otherTest.Passed);
+                    ASSERT_EQ(test.Expectations.size(), otherTest.Expectations.size());
+                    for (auto&& [eName, expectation] : test.Expectations) {
+                        ExpectSameExpectation(*expectation, *otherTest.Expectations.at(eName));
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_F(ArchiveTest, StopsWhenCancelled)
+{
+    Archive(std::string {s_title}, MakeReport(1, "SN1", 3.3f), 10);
+
+    ResultAnalyzer analyzer;
+    analyzer.Cancel();
+    EXPECT_TRUE(analyzer.Analyze(std::string {s_title}).Locations.empty());
+    EXPECT_TRUE(ResultIndex::Load(std::filesystem::path("logs") / s_title / "index").Reports.Flags.empty());
+
+    EXPECT_EQ(ResultAnalyzer {}.Analyze(std::string {s_title}).Locations.at("Total").Total, 1);
+}
+
+TEST(Expectation, MergesTheValuesOfAnotherShard)
+{
+    ToBeValueBase values {3.3f, 3.2f, 3.4f};
+    ToBeValueBase other {3.3f, 3.2f, 3.4f};
+    values.KeepValues = true;
+    other.KeepValues  = true;
+    values.AddObservation({.Passed = true, .Value = 3.3f});
+    other.AddObservation({.Passed = false, .Value = 3.5f});
+    other.AddObservation({.Passed = true, .Value = 3.25f});
+    values.Merge(other);
+    EXPECT_EQ(values.Total, 3);
+    EXPECT_EQ(values.Passed, 2);
+    EXPECT_EQ(values.Values, (std::vector {3.3f, 3.5f, 3.25f}));
+    EXPECT_EQ(values.Statistics.Count(), 3);
+    EXPECT_FLOAT_EQ(values.Statistics.Max(), 3.5f);
+
+    ToBeExactBase texts;
+    ToBeExactBase otherTexts;
+    texts.AddObservation({.Passed = true, .Text = "1", .Type = "number"});
+    otherTexts.AddObservation({.Passed = false, .Text = "1", .Type = "number"});
+    otherTexts.AddObservation({.Passed = false, .Text = "2", .Type = "number"});
+    texts.Merge(otherTexts);
+    EXPECT_EQ(texts.Total, 3);
+    EXPECT_EQ(texts.Passed, 1);
+    EXPECT_EQ(texts.Values.at("1").Seen, 2);
+    EXPECT_TRUE(texts.Values.at("1").Passed);
+    EXPECT_EQ(texts.Values.at("2").Seen, 1);
+
+    EXPECT_THROW(values.Merge(texts), std::bad_cast);
+}
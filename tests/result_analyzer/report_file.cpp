@@ -0,0 +1,128 @@
+/**
+ * @file    report_file.cpp
+ * @brief   Unit tests for Frasy::Analyzers::ReportFile, the archived reports in JSON or CBOR.
+ */
+#include "report_fixture.h"
+
+#include <gtest/gtest.h>
+#include <utils/result_analyzer/analyzer.h>
+#include <utils/result_analyzer/report_file.h>
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using Frasy::Analyzers::ReportFile;
+using Frasy::Analyzers::ResultAnalyzer;
+using Frasy::Analyzers::ResultIndex;
+using ReportFixture::ArchiveTest;
+using ReportFixture::MakeReport;
+
+namespace {
+constexpr std::string_view s_title = "Product";
+}    // namespace
+
+TEST_F(ArchiveTest, SavesAndLoadsEitherFormat)
+{
+    const auto report = MakeReport(1, "SN1", 3.3f);
+    ReportFile::Save(report, "report.txt", ReportFile::Format::Json);
+    ReportFile::Save(report, "report.cbor", ReportFile::Format::Cbor);
+
+    EXPECT_EQ(ReportFile::Load("report.txt"), report);
+    EXPECT_EQ(ReportFile::Load("report.cbor"), report);
+    EXPECT_LT(std::filesystem::file_size("report.cbor"), std::filesystem::file_size("report.txt"));
+    EXPECT_FALSE(std::filesystem::exists("report.cbor.tmp"));
+}
+
+TEST_F(ArchiveTest, TellsTheFormatsApartByTheirContent)
+{
+    const auto report = MakeReport(1, "SN1", 3.3f);
+    ReportFile::Save(report, "cbor.txt", ReportFile::Format::Cbor);
+    ReportFile::Save(report, "json.cbor", ReportFile::Format::Json);
+
+    EXPECT_EQ(ReportFile::Load("cbor.txt"), report);
+    EXPECT_EQ(ReportFile::Load("json.cbor"), report);
+}
+
+TEST_F(ArchiveTest, ThrowsOnInvalidReports)
+{
+    std::ofstream("truncated.cbor", std::ios::binary) << "\xD9\xD9\xF7\xA1";
+    std::ofstream("truncated.txt") << R"({"info": )";
+
+    EXPECT_THROW(ReportFile::Load("truncated.cbor"), nlohmann::json::exception);
+    EXPECT_THROW(ReportFile::Load("truncated.txt"), nlohmann::json::exception);
+    EXPECT_THROW(ReportFile::Load("missing.txt"), std::runtime_error);
+}
+
+TEST(ReportFile, ParsesTheFormatNames)
+{
+    EXPECT_EQ(ReportFile::ParseFormat("json"), ReportFile::Format::Json);
+    EXPECT_EQ(ReportFile::ParseFormat("cbor"), ReportFile::Format::Cbor);
+    EXPECT_FALSE(ReportFile::ParseFormat("xml").has_value());
+}
+
+TEST(ReportFile, KeysTheReportsWithoutTheirExtension)
+{
+    EXPECT_EQ(ReportFile::ArchiveKey("pass/10_SN1.txt"), "pass/10_SN1");
+    EXPECT_EQ(ReportFile::ArchiveKey("pass/10_SN1.cbor"), "pass/10_SN1");
+    EXPECT_EQ(ReportFile::ArchiveKey("pass.d/10_SN1"), "pass.d/10_SN1");
+}
+
+TEST_F(ArchiveTest, ConvertsTheArchive)
+{
+    const auto passed = Archive(std::string {s_title}, MakeReport(1, "SN1", 3.3f), 10);
+    const auto failed = Archive(std::string {s_title}, MakeReport(2, "SN2", 3.5f), 11);
+    const auto root   = std::filesystem::path("logs") / s_title;
+
+    auto conversion = ReportFile::ConvertArchive(root, ReportFile::Format::Cbor);
+    EXPECT_EQ(conversion.Converted, 2);
+    EXPECT_EQ(conversion.Failed, 0);
+    EXPECT_LT(conversion.BytesAfter, conversion.BytesBefore);
+    EXPECT_FALSE(std::filesystem::exists(root / passed));
+    EXPECT_FALSE(std::filesystem::exists(root / failed));
+    EXPECT_EQ(ReportFile::Load(root / "pass/10_SN1.cbor"), MakeReport(1, "SN1", 3.3f));
+    EXPECT_EQ(ReportFile::Load(root / "fail/11_SN2.cbor"), MakeReport(2, "SN2", 3.5f));
+
+    // Converting again has nothing left to do.
+    EXPECT_EQ(ReportFile::ConvertArchive(root, ReportFile::Format::Cbor).Converted, 0);
+    EXPECT_EQ(ReportFile::ConvertArchive(root, ReportFile::Format::Json).Converted, 2);
+    EXPECT_TRUE(std::filesystem::exists(root / passed));
+}
+
+TEST_F(ArchiveTest, StopsConvertingWhenCancelled)
+{
+    Archive(std::string {s_title}, MakeReport(1, "SN1", 3.3f), 10);
+    const std::atomic<bool> cancelled = true;
+
+    auto conversion =
+      ReportFile::ConvertArchive(std::filesystem::path("logs") / s_title, ReportFile::Format::Cbor, &cancelled);
+    EXPECT_EQ(conversion.Converted, 0);
+}
+
+TEST_F(ArchiveTest, AnalyzesTheConvertedReportsOnce)
+{
+    Archive(std::string {s_title}, MakeReport(1, "SN1", 3.3f), 10);
+    ResultAnalyzer {}.Analyze(std::string {s_title});
+
+    // Indexed as text, then converted.
+    ReportFile::ConvertArchive(std::filesystem::path("logs") / s_title, ReportFile::Format::Cbor);
+    Archive(std::string {s_title}, MakeReport(2, "SN2", 3.3f), 11);
+    ReportFile::ConvertArchive(std::filesystem::path("logs") / s_title, ReportFile::Format::Cbor);
+
+    ResultAnalyzer analyzer;
+    auto           results = analyzer.Analyze(std::string {s_title});
+    EXPECT_EQ(results.Locations.at("Total").Total, 2);
+    EXPECT_EQ(ResultIndex::Load(std::filesystem::path("logs") / s_title / "index").Reports.Flags.size(), 2);
+}
+
+TEST_F(ArchiveTest, AnalyzesAReportInBothFormatsOnce)
+{
+    // As when a conversion is interrupted between writing the new file and removing the old one.
+    Archive(std::string {s_title}, MakeReport(1, "SN1", 3.3f), 10);
+    const auto converted = std::filesystem::path("logs") / s_title / "pass/10_SN1.cbor";
+    ReportFile::Save(MakeReport(1, "SN1", 3.3f), converted, ReportFile::Format::Cbor);
+
+    auto results = ResultAnalyzer {}.Analyze(std::string {s_title});
+    EXPECT_EQ(results.Locations.at("Total").Total, 1);
+}
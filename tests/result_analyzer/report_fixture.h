@@ -0,0 +1,81 @@
+/**
+ * @file    report_fixture.h
+ * @brief   Reports in the format of the orchestrator, and a temporary directory to archive them in.
+ */
+#ifndef FRASY_TESTS_RESULT_ANALYZER_REPORT_FIXTURE_H
+#define FRASY_TESTS_RESULT_ANALYZER_REPORT_FIXTURE_H
+
+#include <gtest/gtest.h>
+#include <json.hpp>
+
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <string>
+
+namespace ReportFixture {
+inline nlohmann::json MakeReport(int uut, const std::string& serial, float voltage, bool enabled = true)
+{
+    const bool     inRange      = 3.2f <= voltage && voltage <= 3.4f;
+    nlohmann::json expectations = nlohmann::json::array();
+    expectations.push_back({{"name", "3V3"},
+                            {"method", "ToBeInRange"},
+                            {"min", 3.2},
+                            {"max", 3.4},
+                            {"value", voltage},
+                            {"pass", inRange},
+                            {"note", "ignored"}});
+    expectations.push_back(
+      {{"name", "Good"}, {"method", "ToBeTrue"}, {"expected", true}, {"value", inRange}, {"pass", inRange}});
+    expectations.push_back(
+      {{"name", "Firmware"}, {"method", "ToBeEqual"}, {"expected", "1.2"}, {"value", "1.2"}, {"pass", true}});
+    expectations.push_back({{"name", "Pattern"}, {"method", "ToMatch"}, {"value", "x"}, {"pass", true}});
+
+    nlohmann::json report;
+    report["info"] = {{"uut", uut}, {"serial", serial}, {"pass", inRange}, {"time", {{"process", 2.0}}}};
+    auto& sequence = report["sequences"]["Power"];
+    sequence       = {{"enabled", true}, {"skipped", false}, {"pass", inRange}, {"time", {{"process", 1.5}}}};
+    auto& test     = sequence["tests"]["Rails"];
+    test = {{"enabled", enabled}, {"skipped", !enabled}, {"pass", inRange}, {"time", {{"process", 1.0}}}};
+    test["expectations"] = expectations;
+    return report;
+}
+
+//! Runs every test in a fresh directory, made the working directory.
+class ArchiveTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        m_previous = std::filesystem::current_path();
+        m_root     = std::filesystem::temp_directory_path() /
+                 std::format("frasy_result_index_{}", ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        std::filesystem::remove_all(m_root);
+        std::filesystem::create_directories(m_root);
+        std::filesystem::current_path(m_root);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::current_path(m_previous);
+        std::filesystem::remove_all(m_root);
+    }
+
+    //! Archives a report the way the orchestrator does, in logs/<title>/pass or fail.
+    static std::string Archive(const std::string& title, const nlohmann::json& report, int64_t timestamp)
+    {
+        std::string file = std::format("{}/{}_{}.txt",
+                                       report["info"]["pass"].get<bool>() ? "pass" : "fail",
+                                       timestamp,
+                                       report["info"]["serial"].get<std::string>());
+        std::filesystem::create_directories(std::filesystem::path("logs") / title / "pass");
+        std::filesystem::create_directories(std::filesystem::path("logs") / title / "fail");
+        std::ofstream(std::filesystem::path("logs") / title / file) << report.dump(2, ' ');
+        return file;
+    }
+
+    std::filesystem::path m_root;
+    std::filesystem::path m_previous;
+};
+}    // namespace ReportFixture
+
+#endif    // FRASY_TESTS_RESULT_ANALYZER_REPORT_FIXTURE_H
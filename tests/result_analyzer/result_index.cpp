@@ -0,0 +1,133 @@
+/**
+ * @file    result_index.cpp
+ * @brief   Unit tests for Frasy::Analyzers::ResultIndex.
+ */
+#include "report_fixture.h"
+
+#include <gtest/gtest.h>
+#include <utils/result_analyzer/result_index.h>
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+using Frasy::Analyzers::ResultIndex;
+using ReportFixture::ArchiveTest;
+using ReportFixture::MakeReport;
+
+namespace {
+const std::filesystem::path s_directory = "index";
+
+std::vector<ResultIndex::Entry> MakeEntries(std::initializer_list<float> voltages)
+{
+    std::vector<ResultIndex::Entry> entries;
+    for (float voltage : voltages) {
+        const int uut = static_cast<int>(entries.size()) + 1;
+        entries.push_back({.File      = std::format("pass/{}_SN{}.txt", uut, uut),
+                           .Timestamp = uut,
+                           .Report    = MakeReport(uut, std::format("SN{}", uut), voltage)});
+    }
+    return entries;
+}
+}    // namespace
+
+TEST_F(ArchiveTest, MissingIndexIsEmpty)
+{
+    auto index = ResultIndex::Load(s_directory);
+    EXPECT_TRUE(index.Reports.Flags.empty());
+    EXPECT_EQ(index.StringCount(), 0);
+}
+
+TEST_F(ArchiveTest, FlattensTheReports)
+{
+    ResultIndex::Append(s_directory, MakeEntries({3.3f, 3.5f}));
+    auto index = ResultIndex::Load(s_directory);
+
+    ASSERT_EQ(index.Reports.Flags.size(), 2);
+    EXPECT_EQ(index.String(index.Reports.File[1]), "pass/2_SN2.txt");
+    EXPECT_EQ(index.String(index.Reports.Serial[1]), "SN2");
+    EXPECT_EQ(index.Reports.Uut[1], 2);
+    EXPECT_EQ(index.Reports.Timestamp[1], 2);
+    EXPECT_EQ(index.Reports.Flags[0], ResultIndex::Passed);
+    EXPECT_EQ(index.Reports.Flags[1], 0);
+
+    ASSERT_EQ(index.Sequences.Flags.size(), 2);
+    EXPECT_EQ(index.Sequences.Report[1], 1);
+    EXPECT_EQ(index.String(index.Sequences.Name[1]), "Power");
+    ASSERT_EQ(index.Tests.Flags.size(), 2);
+    EXPECT_EQ(index.Tests.Sequence[1], 1);
+    EXPECT_EQ(index.Tests.Duration[1], 1.0);
+
+    // ToMatch isn't supported by the analyzer, it isn't kept.
+    ASSERT_EQ(index.Expectations.Flags.size(), 6);
+    EXPECT_EQ(index.Expectations.Test[3], 1);
+    EXPECT_EQ(index.String(index.Expectations.Name[3]), "3V3");
+    EXPECT_FLOAT_EQ(index.Expectations.Value[3], 3.5f);
+    EXPECT_EQ(index.Expectations.Text[3], ResultIndex::s_noString);
+    EXPECT_EQ(index.Expectations.Flags[3], 0);
+    // Only the fields that are the same in every report define an expectation.
+    EXPECT_EQ(index.Expectations.Definition[0], index.Expectations.Definition[3]);
+    EXPECT_EQ(index.String(index.Expectations.Definition[0]),
+              R"({"max":3.4,"method":"ToBeInRange","min":3.2,"name":"3V3"})");
+    EXPECT_TRUE(std::isnan(index.Expectations.Value[5]));
+    EXPECT_EQ(index.String(index.Expectations.Text[5]), "\"1.2\"");
+}
+
+TEST_F(ArchiveTest, AppendsToTheCommittedRows)
+{
+    ResultIndex::Append(s_directory, MakeEntries({3.3f}));
+    ResultIndex::Append(s_directory, MakeEntries({3.1f, 3.25f}));
+    auto index = ResultIndex::Load(s_directory);
+
+    ASSERT_EQ(index.Reports.Flags.size(), 3);
+    EXPECT_EQ(index.Sequences.Report[2], 2);
+    EXPECT_EQ(index.Expectations.Test[8], 2);
+    EXPECT_FLOAT_EQ(index.Expectations.Value[6], 3.25f);
+    // The names are interned once.
+    EXPECT_EQ(index.Sequences.Name[0], index.Sequences.Name[2]);
+}
+
+TEST_F(ArchiveTest, RecordsTheInvalidReports)
+{
+    std::vector<ResultIndex::Entry> entries = MakeEntries({3.3f, 3.3f});
+    entries[0].Report["sequences"]["Power"]["tests"]["Rails"].erase("time");
+    ResultIndex::Append(s_directory, entries);
+    auto index = ResultIndex::Load(s_directory);
+
+    ASSERT_EQ(index.Reports.Flags.size(), 2);
+    EXPECT_EQ(index.Reports.Flags[0], ResultIndex::Invalid);
+    EXPECT_EQ(index.String(index.Reports.File[0]), "pass/1_SN1.txt");
+    // The rows of the invalid report are discarded.
+    ASSERT_EQ(index.Sequences.Flags.size(), 1);
+    EXPECT_EQ(index.Sequences.Report[0], 1);
+    EXPECT_EQ(index.Expectations.Flags.size(), 3);
+}
+
+TEST_F(ArchiveTest, DiscardsTheRowsOfAnInterruptedAppend)
+{
+    ResultIndex::Append(s_directory, MakeEntries({3.3f}));
+    {
+        // Rows written without being committed.
+        std::ofstream column(s_directory / "tests.flags", std::ios::binary | std::ios::app);
+        column << "garbage";
+    }
+    EXPECT_EQ(ResultIndex::Load(s_directory).Tests.Flags.size(), 1);
+
+    ResultIndex::Append(s_directory, MakeEntries({3.25f}));
+    auto index = ResultIndex::Load(s_directory);
+    ASSERT_EQ(index.Tests.Flags.size(), 2);
+    EXPECT_EQ(index.Tests.Flags[1], ResultIndex::Enabled | ResultIndex::Passed);
+}
+
+TEST_F(ArchiveTest, RefusesACorruptedIndex)
+{
+    ResultIndex::Append(s_directory, MakeEntries({3.3f}));
+    std::filesystem::resize_file(s_directory / "expectations.value", 2);
+    EXPECT_THROW(ResultIndex::Load(s_directory), std::runtime_error);
+
+    ResultIndex::Remove(s_directory);
+    EXPECT_FALSE(std::filesystem::exists(s_directory));
+    ResultIndex::Append(s_directory, MakeEntries({3.3f}));
+    EXPECT_EQ(ResultIndex::Load(s_directory).Reports.Flags.size(), 1);
+}
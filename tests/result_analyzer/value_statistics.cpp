@@ -0,0 +1,134 @@
+/**
+ * @file    value_statistics.cpp
+ * @brief   Unit tests for Frasy::Analyzers::ValueStatistics.
+ */
+#include <gtest/gtest.h>
+#include <utils/result_analyzer/value_statistics.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using Frasy::Analyzers::ValueStatistics;
+
+namespace {
+std::vector<double> Normal(size_t count, double mean, double stdDev, uint32_t seed)
+{
+    std::mt19937                     rng {seed};
+    std::normal_distribution<double> distribution {mean, stdDev};
+    std::vector<double>              values(count);
+    for (auto&& value : values) { value = distribution(rng); }
+    return values;
+}
+
+double ExactQuantile(std::vector<double> values, double q)
+{
+    std::ranges::sort(values);
+    return values[static_cast<size_t>(q * static_cast<double>(values.size() - 1))];
+}
+}    // namespace
+
+TEST(ValueStatistics, IsEmptyAtFirst)
+{
+    ValueStatistics statistics;
+    EXPECT_EQ(statistics.Count(), 0);
+    EXPECT_EQ(statistics.Variance(), 0.0);
+    EXPECT_TRUE(std::isnan(statistics.Quantile(0.5)));
+    EXPECT_EQ(statistics.Cdf(1.0), 0.0);
+}
+
+TEST(ValueStatistics, HasTheExactMomentsAndExtremes)
+{
+    const auto      values = Normal(10'000, 3.3, 0.05, 1);
+    ValueStatistics statistics;
+    for (double value : values) { statistics.Add(value); }
+
+    const double mean     = std::accumulate(values.begin(), values.end(), 0.0) / static_cast<double>(values.size());
+    const double variance = std::accumulate(values.begin(),
+                                            values.end(),
+                                            0.0,
+                                            [mean](double sum, double value) {
+                                                return sum + ((value - mean) * (value - mean));
+                                            }) /
+                            static_cast<double>(values.size());
+    EXPECT_EQ(statistics.Count(), values.size());
+    EXPECT_NEAR(statistics.Mean(), mean, 1e-12);
+    EXPECT_NEAR(statistics.Variance(), variance, 1e-12);
+    EXPECT_EQ(statistics.Min(), *std::ranges::min_element(values));
+    EXPECT_EQ(statistics.Max(), *std::ranges::max_element(values));
+}
+
+TEST(ValueStatistics, EstimatesTheQuantiles)
+{
+    const auto      values = Normal(100'000, 3.3, 0.05, 2);
+    ValueStatistics statistics;
+    for (double value : values) { statistics.Add(value); }
+
+    // Within a tenth of a standard deviation, even far in the tails.
+    for (double q : {0.001, 0.01, 0.25, 0.5, 0.75, 0.99, 0.999}) {
+        EXPECT_NEAR(statistics.Quantile(q), ExactQuantile(values, q), 0.005) << q;
+        EXPECT_NEAR(statistics.Cdf(ExactQuantile(values, q)), q, 0.005) << q;
+    }
+    EXPECT_NEAR(statistics.Quantile(0.5), ExactQuantile(values, 0.5), 0.001);
+    EXPECT_EQ(statistics.Quantile(0.0), statistics.Min());
+    EXPECT_EQ(statistics.Quantile(1.0), statistics.Max());
+    EXPECT_LT(statistics.serialize().at("centroids").size(), 200);
+}
+
+TEST(ValueStatistics, HasTheExactMedianOfAFewValues)
+{
+    ValueStatistics statistics;
+    for (double value : {4.0, 1.0, 3.0, 2.0}) { statistics.Add(value); }
+    EXPECT_DOUBLE_EQ(statistics.Quantile(0.5), 2.5);
+    statistics.Add(5.0);
+    EXPECT_DOUBLE_EQ(statistics.Quantile(0.5), 3.0);
+}
+
+TEST(ValueStatistics, MergesLikeASingleStream)
+{
+    const auto      values = Normal(50'000, 12.0, 1.5, 3);
+    ValueStatistics single;
+    ValueStatistics shards[4];
+    for (size_t i = 0; i < values.size(); ++i) {
+        single.Add(values[i]);
+        shards[(i * 4) / values.size()].Add(values[i]);
+    }
+    ValueStatistics merged;
+    for (auto&& shard : shards) { merged.Merge(shard); }
+
+    EXPECT_EQ(merged.Count(), single.Count());
+    EXPECT_NEAR(merged.Mean(), single.Mean(), 1e-9);
+    EXPECT_NEAR(merged.Variance(), single.Variance(), 1e-9);
+    EXPECT_EQ(merged.Min(), single.Min());
+    EXPECT_EQ(merged.Max(), single.Max());
+    for (double q : {0.01, 0.5, 0.99}) { EXPECT_NEAR(merged.Quantile(q), ExactQuantile(values, q), 0.05) << q; }
+}
+
+TEST(ValueStatistics, MakesHistograms)
+{
+    const auto      values = Normal(20'000, 0.0, 1.0, 4);
+    ValueStatistics statistics;
+    for (double value : values) { statistics.Add(value); }
+
+    const auto bins = statistics.Histogram(statistics.Min(), statistics.Max(), 40);
+    ASSERT_EQ(bins.size(), 40);
+    EXPECT_NEAR(std::accumulate(bins.begin(), bins.end(), 0.0), static_cast<double>(values.size()), 1e-6);
+    const auto fullest = std::ranges::max_element(bins) - bins.begin();
+    const auto middle  = static_cast<std::ptrdiff_t>(-statistics.Min() / (statistics.Max() - statistics.Min()) * 40);
+    EXPECT_LE(std::abs(fullest - middle), 2);
+}
+
+TEST(ValueStatistics, SurvivesASerialization)
+{
+    ValueStatistics statistics;
+    for (double value : Normal(5'000, -2.0, 0.5, 5)) { statistics.Add(value); }
+
+    const auto loaded = ValueStatistics::deserialize(statistics.serialize());
+    EXPECT_EQ(loaded.Count(), statistics.Count());
+    EXPECT_EQ(loaded.Mean(), statistics.Mean());
+    EXPECT_EQ(loaded.Variance(), statistics.Variance());
+    EXPECT_EQ(loaded.Min(), statistics.Min());
+    EXPECT_NEAR(loaded.Quantile(0.5), statistics.Quantile(0.5), 1e-3);
+}
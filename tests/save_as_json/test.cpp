@@ -0,0 +1,125 @@
+/**
+ * @file    test.cpp
+ * @brief   Unit tests for Frasy::Lua::SaveAsJson, checked against nlohmann::json's own output.
+ */
+#include <gtest/gtest.h>
+#include <json.hpp>
+#include <sol/sol.hpp>
+#include <utils/lua/save_as_json.h>
+
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <string>
+
+using Frasy::Lua::SaveAsJson;
+
+namespace {
+class SaveAsJsonTest : public ::testing::Test {
+protected:
+    std::filesystem::path dir  = std::filesystem::temp_directory_path() / "frasy_save_as_json_test";
+    std::filesystem::path file = dir / "report.json";
+    sol::state            lua;
+
+    void SetUp() override
+    {
+        std::filesystem::remove_all(dir);
+        std::filesystem::create_directories(dir);
+        lua.open_libraries(sol::lib::base, sol::lib::string);
+    }
+
+    void TearDown() override { std::filesystem::remove_all(dir); }
+
+    //! Saves the table returned by script.
+    void save(const std::string& script)
+    {
+        const int top = lua_gettop(lua.lua_state());
+        SaveAsJson(lua.script(script).get<sol::table>(), file.string());
+        EXPECT_EQ(lua_gettop(lua.lua_state()), top);
+    }
+
+    [[nodiscard]] std::string content() const
+    {
+        std::ifstream is {file};
+        return {std::istreambuf_iterator<char> {is}, {}};
+    }
+
+    //! The output of the implementation that built the document before dumping it.
+    static std::string dump(const nlohmann::json& j)
+    {
+        return j.dump(2, ' ', false, nlohmann::detail::error_handler_t::replace);
+    }
+};
+}    // namespace
+
+TEST_F(SaveAsJsonTest, WritesLikeNlohmann)
+{
+    save(R"(
+        return {
+            info = { uut = 1, serial = "SN\"1\"\n", pass = true, time = { process = 0.125 } },
+            sequences = {
+                Power = {
+                    tests = { { name = "Rails", value = 3.3 }, { name = "Idle", value = -0.0 } },
+                    flags = { true, false },
+                },
+            },
+            empty = {},
+            strings = { "tab\t", "\1", "héllo", "bad \255 byte" },
+            numbers = { 0/0, 1e300, 1/3 },
+        }
+    )");
+
+    nlohmann::json expected;
+    expected["info"]    = {{"uut", 1.0}, {"serial", "SN\"1\"\n"}, {"pass", true}, {"time", {{"process", 0.125}}}};
+    auto& power         = expected["sequences"]["Power"];
+    power["tests"]      = {{{"name", "Rails"}, {"value", 3.3}}, {{"name", "Idle"}, {"value", -0.0}}};
+    power["flags"]      = {true, false};
+    expected["empty"]   = nullptr;
+    expected["strings"] = {"tab\t", "\1", "héllo", "bad \xFF byte"};
+    expected["numbers"] = {std::numeric_limits<double>::quiet_NaN(), 1e300, 1.0 / 3.0};
+    EXPECT_EQ(content(), dump(expected));
+}
+
+TEST_F(SaveAsJsonTest, SortsTheKeys)
+{
+    save(R"(return { b = 1, a = { z = "z", y = "y" }, B = 2, ["a b"] = 3 })");
+    EXPECT_EQ(content(), dump({{"b", 1.0}, {"a", {{"z", "z"}, {"y", "y"}}}, {"B", 2.0}, {"a b", 3.0}}));
+}
+
+TEST_F(SaveAsJsonTest, WritesAnEmptyTableAsNull)
+{
+    save("return {}");
+    EXPECT_EQ(content(), "null");
+}
+
+TEST_F(SaveAsJsonTest, WritesLargeTables)
+{
+    save(R"(
+        local report = { expectations = {} }
+        for i = 1, 10000 do
+            report.expectations[i] = { name = "E" .. i, value = i / 7, pass = i % 3 ~= 0 }
+        end
+        return report
+    )");
+
+    nlohmann::json expected;
+    for (int i = 1; i <= 10000; ++i) {
+        expected["expectations"].push_back(
+          {{"name", "E" + std::to_string(i)}, {"value", i / 7.0}, {"pass", i % 3 != 0}});
+    }
+    EXPECT_EQ(content(), dump(expected));
+}
+
+TEST_F(SaveAsJsonTest, RejectsInvalidTables)
+{
+    std::ofstream(file) << "previous";
+
+    save(R"(return { a = 1, [1] = 2 })");
+    save(R"(return { 1, "two" })");
+    save(R"(return { a = { b = print } })");
+    save(R"(return { [true] = 1 })");
+
+    // Nothing is written when the table can't be saved.
+    EXPECT_EQ(content(), "previous");
+    EXPECT_FALSE(std::filesystem::exists(file.string() + ".tmp"));
+}
@@ -0,0 +1,135 @@
+/**
+ * @file    eds_dictionary.cpp
+ * @brief   Unit tests for Frasy::CanOpen::EdsDictionary.
+ */
+#include <gtest/gtest.h>
+#include <utils/communication/can_open/simulation/eds_dictionary.h>
+
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+using Frasy::CanOpen::DataType;
+using Frasy::CanOpen::EdsDictionary;
+
+namespace {
+constexpr auto s_eds = R"(
+[DeviceInfo]
+VendorName=Test
+ProductNumber=1
+
+[1000]
+ParameterName=Device type
+ObjectType=0x7
+DataType=0x0007
+AccessType=ro
+DefaultValue=0x00000191
+PDOMapping=0
+
+[1200]
+ParameterName=SDO server parameter
+ObjectType=0x9
+SubNumber=2
+
+[1200sub0]
+ParameterName=Highest sub-index supported
+ObjectType=0x7
+DataType=0x0005
+AccessType=const
+DefaultValue=0x02
+
+[1200sub1]
+ParameterName=COB-ID client to server (rx)
+ObjectType=0x7
+DataType=0x0007
+AccessType=ro
+DefaultValue=$NODEID+0x600
+PDOMapping=1
+
+[2000]
+ParameterName=Gain
+ObjectType=0x7
+;DataType=0x0005
+DataType=0x0008
+AccessType=rw
+DefaultValue=1.5
+
+[2001]
+ParameterName=Offset
+DataType=0x0003
+AccessType=wo
+DefaultValue=-2
+
+[2002]
+ParameterName=Name
+DataType=0x0009
+AccessType=rw
+DefaultValue=DAQ 1
+
+[2003]
+ParameterName=Calibration
+ObjectType=0x2
+DataType=0x000F
+AccessType=rw
+)";
+}    // namespace
+
+TEST(EdsDictionary, ParsesVariablesAndSubObjects)
+{
+    const auto dictionary = EdsDictionary::parse(s_eds, 0x12);
+    EXPECT_EQ(dictionary.size(), 7);
+
+    const auto* deviceType = dictionary.find(0x1000, 0);
+    ASSERT_NE(deviceType, nullptr);
+    EXPECT_EQ(deviceType->name, "Device type");
+    EXPECT_EQ(deviceType->dataType, DataType::unsigned32);
+    EXPECT_TRUE(deviceType->readable);
+    EXPECT_FALSE(deviceType->writable);
+    EXPECT_EQ(deviceType->value, (std::vector<uint8_t> {0x91, 0x01, 0x00, 0x00}));
+
+    // The RECORD itself isn't a variable, its sub-objects are.
+    EXPECT_EQ(dictionary.find(0x1200, 0)->name, "Highest sub-index supported");
+    EXPECT_TRUE(dictionary.hasObject(0x1200));
+    EXPECT_EQ(dictionary.find(0x1200, 5), nullptr);
+    EXPECT_FALSE(dictionary.hasObject(0x1201));
+    EXPECT_TRUE(dictionary.find(0x1200, 1)->pdoMappable);
+}
+
+TEST(EdsDictionary, ConvertsDefaultValues)
+{
+    const auto dictionary = EdsDictionary::parse(s_eds, 0x12);
+
+    EXPECT_EQ(dictionary.find(0x1200, 1)->value, (std::vector<uint8_t> {0x12, 0x06, 0x00, 0x00}));
+
+    const auto& gain = dictionary.find(0x2000, 0)->value;
+    ASSERT_EQ(gain.size(), 4);
+    EXPECT_EQ(std::bit_cast<float>(gain[0] | (gain[1] << 8) | (gain[2] << 16) | (uint32_t {gain[3]} << 24)), 1.5F);
+
+    EXPECT_EQ(dictionary.find(0x2001, 0)->value, (std::vector<uint8_t> {0xFE, 0xFF}));
+    EXPECT_EQ(dictionary.find(0x2002, 0)->value, (std::vector<uint8_t> {'D', 'A', 'Q', ' ', '1'}));
+    EXPECT_TRUE(dictionary.find(0x2003, 0)->value.empty());
+    EXPECT_EQ(dictionary.find(0x2003, 0)->typeSize(), 0);
+}
+
+TEST(EdsDictionary, ReadsAccessTypes)
+{
+    const auto dictionary = EdsDictionary::parse(s_eds, 1);
+    EXPECT_FALSE(dictionary.find(0x1200, 0)->writable);
+    EXPECT_TRUE(dictionary.find(0x2000, 0)->writable);
+    EXPECT_FALSE(dictionary.find(0x2001, 0)->readable);
+    EXPECT_TRUE(dictionary.find(0x2001, 0)->writable);
+}
+
+TEST(EdsDictionary, LoadsTheBoardsOfTheFramework)
+{
+    for (const auto* path :
+         {"lua/core/cep/eds/daq.eds", "lua/core/cep/eds/pio.eds", "lua/core/cep/eds/r8l_1.1.0.eds"}) {
+        const auto dictionary = EdsDictionary::load(path, 0x10);
+        ASSERT_TRUE(dictionary.has_value()) << path;
+        EXPECT_GT(dictionary->size(), 20) << path;
+        const auto* heartbeat = dictionary->find(0x1017, 0);
+        ASSERT_NE(heartbeat, nullptr) << path;
+        EXPECT_EQ(heartbeat->value.size(), 2) << path;
+    }
+    EXPECT_FALSE(EdsDictionary::load("missing.eds", 1).has_value());
+}
@@ -0,0 +1,339 @@
+/**
+ * @file    simulated_node.cpp
+ * @brief   Unit tests for Frasy::CanOpen::SimulatedNode, driven by raw CAN frames on a virtual bus.
+ */
+#include <gtest/gtest.h>
+#include <utils/communication/can_open/simulation/simulated_node.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+using namespace std::chrono_literals;
+using Frasy::CanOpen::EdsDictionary;
+using Frasy::CanOpen::SimulatedNode;
+using Frasy::SlCan::CanPacket;
+using Frasy::SlCan::VirtualBus;
+using Frame = std::array<uint8_t, 8>;
+
+namespace {
+constexpr uint8_t s_nodeId = 0x10;
+
+constexpr auto s_eds = R"(
+[1000]
+ParameterName=Device type
+DataType=0x0007
+AccessType=ro
+DefaultValue=0x00000191
+
+[1017]
+ParameterName=Producer heartbeat time
+DataType=0x0006
+AccessType=rw
+DefaultValue=10
+
+[2000]
+ParameterName=Setpoint
+DataType=0x0006
+AccessType=rw
+DefaultValue=0
+
+[2001]
+ParameterName=Name
+DataType=0x0009
+AccessType=rw
+DefaultValue=Simulated instrumentation board
+
+[2002]
+ParameterName=Calibration
+ObjectType=0x2
+DataType=0x000F
+AccessType=rw
+)";
+
+uint16_t Crc16(const std::vector<uint8_t>& data)
+{
+    uint16_t crc = 0;
+    for (uint8_t byte : data) {
+        crc ^= static_cast<uint16_t>(byte << 8);
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 0x8000) != 0 ? static_cast<uint16_t>((crc << 1) ^ 0x1021) : static_cast<uint16_t>(crc << 1);
+        }
+    }
+    return crc;
+}
+
+uint32_t AbortCode(const Frame& frame)
+{
+    return frame[4] | (frame[5] << 8) | (frame[6] << 16) | (uint32_t {frame[7]} << 24);
+}
+
+/// Other end of the bus, playing the SDO client and the NMT master.
+class Client {
+public:
+    explicit Client(std::shared_ptr<VirtualBus> bus) : m_bus(std::move(bus))
+    {
+        m_handle = m_bus->attach([this](const CanPacket& frame) {
+            std::lock_guard lock {m_lock};
+            m_frames.push_back(frame);
+            m_cv.notify_all();
+        });
+    }
+    ~Client() { m_bus->detach(m_handle); }
+
+    void send(uint32_t id, const Frame& data, uint8_t length = 8)
+    {
+        CanPacket frame {.id = id, .dataLen = length};
+        std::copy_n(data.begin(), length, &frame.data[0]);
+        m_bus->send(frame, m_handle);
+    }
+
+    /// Takes the first frame with the ID.
+    std::optional<CanPacket> wait(uint32_t id, std::chrono::milliseconds timeout = 1s)
+    {
+        std::unique_lock lock {m_lock};
+        std::optional<CanPacket> found;
+        m_cv.wait_for(lock, timeout, [&] {
+            auto it = std::ranges::find_if(m_frames, [id](const CanPacket& frame) { return frame.id == id; });
+            if (it == m_frames.end()) { return false; }
+            found = *it;
+            m_frames.erase(it);
+            return true;
+        });
+        return found;
+    }
+
+    Frame request(const Frame& data)
+    {
+        send(0x600 + s_nodeId, data);
+        auto response = wait(0x580 + s_nodeId);
+        EXPECT_TRUE(response.has_value());
+        Frame frame = {};
+        if (response) { std::copy_n(&response->data[0], 8, frame.begin()); }
+        return frame;
+    }
+
+    void nmt(uint8_t command) { send(0x000, {command, s_nodeId}, 2); }
+
+private:
+    std::shared_ptr<VirtualBus> m_bus;
+    VirtualBus::Handle          m_handle = 0;
+    std::mutex                  m_lock;
+    std::condition_variable     m_cv;
+    std::deque<CanPacket>       m_frames;
+};
+
+class SimulatedNodeTest : public ::testing::Test {
+protected:
+    std::shared_ptr<VirtualBus> bus = std::make_shared<VirtualBus>("test");
+    Client                      client {bus};
+
+    std::unique_ptr<SimulatedNode> makeNode(SimulatedNode::Options options = {})
+    {
+        auto node = std::make_unique<SimulatedNode>(bus, s_nodeId, EdsDictionary::parse(s_eds, s_nodeId), options);
+        EXPECT_TRUE(client.wait(0x700 + s_nodeId).has_value());    // Boot-up.
+        return node;
+    }
+
+    std::vector<uint8_t> blockUpload(uint16_t index, uint8_t blockSize)
+    {
+        auto response =
+          client.request({0xA4, static_cast<uint8_t>(index), static_cast<uint8_t>(index >> 8), 0, blockSize});
+        EXPECT_EQ(response[0], 0xC6);
+        const uint32_t size = AbortCode(response);
+
+        std::vector<uint8_t> data;
+        client.send(0x600 + s_nodeId, {0xA3});
+        for (bool last = false; !last;) {
+            uint8_t sequence = 0;
+            while (sequence < blockSize && !last) {
+                auto segment = client.wait(0x580 + s_nodeId);
+                EXPECT_TRUE(segment.has_value());
+                if (!segment) { return {}; }
+                EXPECT_EQ(segment->data[0] & 0x7F, ++sequence);
+                last = (segment->data[0] & 0x80) != 0;
+                data.insert(data.end(), &segment->data[1], &segment->data[8]);
+            }
+            client.send(0x600 + s_nodeId, {0xA2, sequence, blockSize});
+        }
+        auto end = client.wait(0x580 + s_nodeId);
+        EXPECT_TRUE(end.has_value());
+        if (!end) { return {}; }
+        std::copy_n(&end->data[0], 8, response.begin());
+        EXPECT_EQ(response[0] & 0xE3, 0xC1);
+        data.resize(data.size() - ((response[0] >> 2) & 0x07));
+        EXPECT_EQ(data.size(), size);
+        EXPECT_EQ(response[1] | (response[2] << 8), Crc16(data));
+        client.send(0x600 + s_nodeId, {0xA1});
+        return data;
+    }
+};
+}    // namespace
+
+TEST_F(SimulatedNodeTest, BootsUpAndSendsItsHeartbeat)
+{
+    auto node      = makeNode();
+    auto heartbeat = client.wait(0x700 + s_nodeId);
+    ASSERT_TRUE(heartbeat.has_value());
+    EXPECT_EQ(heartbeat->data[0], 0x7F);
+    EXPECT_EQ(node->state(), SimulatedNode::NmtState::PreOperational);
+}
+
+TEST_F(SimulatedNodeTest, FollowsNmtCommands)
+{
+    auto node = makeNode();
+    ASSERT_TRUE(node->write<uint16_t>(0x2000, 0, 1234));
+
+    client.nmt(0x01);
+    client.request({0x40, 0x00, 0x10, 0x00});    // Handled in order, the node is started once it answered.
+    EXPECT_EQ(node->state(), SimulatedNode::NmtState::Operational);
+
+    client.nmt(0x02);
+    client.send(0x600 + s_nodeId, {0x40, 0x00, 0x10, 0x00});
+    EXPECT_FALSE(client.wait(0x580 + s_nodeId, 50ms).has_value());    // Stopped nodes don't serve SDOs.
+    EXPECT_EQ(node->state(), SimulatedNode::NmtState::Stopped);
+
+    client.nmt(0x81);
+    std::optional<CanPacket> bootUp;
+    do {
+        bootUp = client.wait(0x700 + s_nodeId);    // Skips the heartbeats sent before the reset.
+        ASSERT_TRUE(bootUp.has_value());
+    } while (bootUp->data[0] != 0x00);
+    EXPECT_EQ(node->read(0x2000, 0), (std::vector<uint8_t> {0, 0}));
+}
+
+TEST_F(SimulatedNodeTest, ServesExpeditedTransfers)
+{
+    auto node = makeNode();
+    EXPECT_EQ(client.request({0x40, 0x00, 0x10, 0x00}), (Frame {0x43, 0x00, 0x10, 0x00, 0x91, 0x01, 0x00, 0x00}));
+
+    int downloads = 0;
+    node->setDownloadCallback([&](SimulatedNode&, uint16_t index, uint8_t subIndex) {
+        EXPECT_EQ(index, 0x2000);
+        EXPECT_EQ(subIndex, 0);
+        ++downloads;
+    });
+    EXPECT_EQ(client.request({0x2B, 0x00, 0x20, 0x00, 0x34, 0x12}), (Frame {0x60, 0x00, 0x20, 0x00}));
+    EXPECT_EQ(node->read(0x2000, 0), (std::vector<uint8_t> {0x34, 0x12}));
+    EXPECT_EQ(downloads, 1);
+    EXPECT_EQ(node->sdoTransfers(), 2);
+}
+
+TEST_F(SimulatedNodeTest, AbortsRefusedAccesses)
+{
+    auto node = makeNode();
+    EXPECT_EQ(AbortCode(client.request({0x23, 0x00, 0x10, 0x00, 1, 2, 3, 4})), 0x06010002);
+    EXPECT_EQ(AbortCode(client.request({0x40, 0x00, 0x30, 0x00})), 0x06020000);
+    EXPECT_EQ(AbortCode(client.request({0x40, 0x00, 0x10, 0x01})), 0x06090011);
+    // A 32 bits value doesn't fit a 16 bits variable.
+    EXPECT_EQ(AbortCode(client.request({0x23, 0x00, 0x20, 0x00, 1, 2, 3, 4})), 0x06070010);
+    EXPECT_EQ(node->sdoAborts(), 4);
+}
+
+TEST_F(SimulatedNodeTest, ServesSegmentedTransfers)
+{
+    auto node = makeNode();
+
+    auto response = client.request({0x40, 0x01, 0x20, 0x00});
+    EXPECT_EQ(response[0], 0x41);
+    EXPECT_EQ(AbortCode(response), 31);
+    std::string name;
+    for (uint8_t toggle = 0;; toggle ^= 0x10) {
+        response = client.request({static_cast<uint8_t>(0x60 | toggle)});
+        EXPECT_EQ(response[0] & 0x10, toggle);
+        name.append(&response[1], &response[8 - ((response[0] >> 1) & 0x07)]);
+        if ((response[0] & 0x01) != 0) { break; }
+    }
+    EXPECT_EQ(name, "Simulated instrumentation board");
+
+    EXPECT_EQ(client.request({0x21, 0x01, 0x20, 0x00, 9}), (Frame {0x60, 0x01, 0x20, 0x00}));
+    EXPECT_EQ(client.request({0x00, 'B', 'o', 'a', 'r', 'd', ' ', '#'}), (Frame {0x20}));
+    EXPECT_EQ(client.request({0x1B, '2', '!'}), (Frame {0x30}));
+    const std::vector<uint8_t> expected = {'B', 'o', 'a', 'r', 'd', ' ', '#', '2', '!'};
+    EXPECT_EQ(node->read(0x2001, 0), expected);
+
+    // The toggle bit must alternate.
+    client.request({0x21, 0x01, 0x20, 0x00, 14});
+    client.request({0x00, 1, 2, 3, 4, 5, 6, 7});
+    EXPECT_EQ(AbortCode(client.request({0x00, 1, 2, 3, 4, 5, 6, 7})), 0x05030000);
+}
+
+TEST_F(SimulatedNodeTest, ServesBlockDownloads)
+{
+    auto                 node = makeNode();
+    std::vector<uint8_t> data(100);
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>(i * 3);
+    }
+
+    constexpr uint8_t blockSize = 127;
+    auto response = client.request({0xC6, 0x02, 0x20, 0x00, static_cast<uint8_t>(data.size())});
+    EXPECT_EQ(response, (Frame {0xA4, 0x02, 0x20, 0x00, blockSize}));
+
+    const std::size_t segments = (data.size() + 6) / 7;
+    for (std::size_t i = 0; i < segments; ++i) {
+        Frame segment = {static_cast<uint8_t>((i + 1) | (i + 1 == segments ? 0x80 : 0x00))};
+        std::copy(data.begin() + static_cast<std::ptrdiff_t>(7 * i),
+                  data.begin() + static_cast<std::ptrdiff_t>(std::min(data.size(), 7 * (i + 1))),
+                  segment.begin() + 1);
+        client.send(0x600 + s_nodeId, segment);
+    }
+    auto ack = client.wait(0x580 + s_nodeId);
+    ASSERT_TRUE(ack.has_value());
+    EXPECT_EQ(ack->data[0], 0xA2);
+    EXPECT_EQ(ack->data[1], segments);
+
+    const auto crc    = Crc16(data);
+    const auto unused = static_cast<uint8_t>(7 * segments - data.size());
+    response          = client.request(
+      {static_cast<uint8_t>(0xC1 | (unused << 2)), static_cast<uint8_t>(crc), static_cast<uint8_t>(crc >> 8)});
+    EXPECT_EQ(response[0], 0xA1);
+    EXPECT_EQ(node->read(0x2002, 0), data);
+}
+
+TEST_F(SimulatedNodeTest, RejectsBlockDownloadsWithABadCrc)
+{
+    auto node = makeNode();
+    client.request({0xC6, 0x02, 0x20, 0x00, 3});
+    client.send(0x600 + s_nodeId, {0x81, 1, 2, 3});
+    ASSERT_TRUE(client.wait(0x580 + s_nodeId).has_value());
+    EXPECT_EQ(AbortCode(client.request({0xC1 | (4 << 2), 0x00, 0x00})), 0x05040004);
+    EXPECT_TRUE(node->read(0x2002, 0)->empty());
+}
+
+TEST_F(SimulatedNodeTest, ServesBlockUploads)
+{
+    auto                 node = makeNode();
+    std::vector<uint8_t> data(200);
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>(255 - i);
+    }
+    ASSERT_TRUE(node->write(0x2002, 0, data));
+
+    // 29 segments in blocks of 10.
+    const auto uploaded = blockUpload(0x2002, 10);
+    EXPECT_EQ(uploaded, data);
+}
+
+TEST_F(SimulatedNodeTest, CanRefuseBlockTransfers)
+{
+    auto node = makeNode({.blockTransfers = false});
+    EXPECT_EQ(AbortCode(client.request({0xC6, 0x02, 0x20, 0x00, 20})), 0x05040001);
+    EXPECT_EQ(AbortCode(client.request({0xA4, 0x02, 0x20, 0x00, 20})), 0x05040001);
+    // Segmented transfers still work.
+    EXPECT_EQ(client.request({0x40, 0x00, 0x10, 0x00})[0], 0x43);
+}
+
+TEST_F(SimulatedNodeTest, AnswersAfterItsLatency)
+{
+    auto       node  = makeNode({.latency = 20ms});
+    const auto start = std::chrono::steady_clock::now();
+    client.request({0x40, 0x00, 0x10, 0x00});
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 20ms);
+}
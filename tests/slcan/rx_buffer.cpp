@@ -0,0 +1,102 @@
+/**
+ * @file    rx_buffer.cpp
+ * @brief   Unit tests for Frasy::SlCan::RxBuffer.
+ */
+#include <gtest/gtest.h>
+#include <utils/communication/slcan/rx_buffer.h>
+
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+using Frasy::SlCan::Command;
+using Frasy::SlCan::Packet;
+using Frasy::SlCan::RxBuffer;
+
+namespace {
+/// Writes the bytes like a read of the port would, returns the packets they complete.
+std::vector<Packet> Feed(RxBuffer& buffer, std::string_view bytes)
+{
+    auto writable = buffer.writable();
+    EXPECT_GE(writable.size(), bytes.size());
+    std::memcpy(writable.data(), bytes.data(), bytes.size());
+    std::vector<Packet> packets;
+    buffer.commit(bytes.size(), [&](const Packet& packet) { packets.push_back(packet); });
+    return packets;
+}
+}    // namespace
+
+TEST(RxBuffer, ParsesEveryFrameOfARead)
+{
+    RxBuffer buffer;
+    auto     packets = Feed(buffer, "t70A105\rt58A84B00100000000000\rT1234567820102\r");
+    ASSERT_EQ(packets.size(), 3);
+    EXPECT_EQ(packets[0].command, Command::TransmitDataFrame);
+    EXPECT_EQ(packets[0].data.packetData.id, 0x70A);
+    EXPECT_EQ(packets[0].data.packetData.dataLen, 1);
+    EXPECT_EQ(packets[0].data.packetData.data[0], 0x05);
+    EXPECT_EQ(packets[1].data.packetData.id, 0x58A);
+    EXPECT_EQ(packets[1].data.packetData.data[0], 0x4B);
+    EXPECT_EQ(packets[2].command, Command::TransmitExtDataFrame);
+    EXPECT_EQ(packets[2].data.packetData.id, 0x12345678);
+    EXPECT_EQ(buffer.pending(), 0);
+}
+
+TEST(RxBuffer, KeepsAnIncompleteFrameForTheNextRead)
+{
+    RxBuffer buffer;
+    auto     packets = Feed(buffer, "t70A105\rt58A84B00");
+    ASSERT_EQ(packets.size(), 1);
+    EXPECT_EQ(buffer.pending(), 9);
+
+    packets = Feed(buffer, "100000000000\r");
+    ASSERT_EQ(packets.size(), 1);
+    EXPECT_EQ(packets[0].data.packetData.id, 0x58A);
+    EXPECT_EQ(packets[0].data.packetData.data[1], 0x00);
+    EXPECT_EQ(packets[0].data.packetData.data[2], 0x10);
+    EXPECT_EQ(buffer.pending(), 0);
+}
+
+TEST(RxBuffer, FrameSplitOnEveryByte)
+{
+    RxBuffer               buffer;
+    constexpr std::string_view frame = "t18B80102030405060708\r";
+    std::vector<Packet>    packets;
+    for (char c : frame) {
+        auto read = Feed(buffer, std::string_view {&c, 1});
+        packets.insert(packets.end(), read.begin(), read.end());
+    }
+    ASSERT_EQ(packets.size(), 1);
+    EXPECT_EQ(packets[0].data.packetData.id, 0x18B);
+    EXPECT_EQ(packets[0].data.packetData.data[7], 0x08);
+}
+
+TEST(RxBuffer, SkipsAcknowledgements)
+{
+    RxBuffer buffer;
+    auto     packets = Feed(buffer, "\r\rt70A105\r");
+    ASSERT_EQ(packets.size(), 1);
+    EXPECT_EQ(packets[0].data.packetData.id, 0x70A);
+}
+
+TEST(RxBuffer, InvalidFrameDoesNotStopTheOthers)
+{
+    RxBuffer buffer;
+    auto     packets = Feed(buffer, "t70G105\rt70A105\r");
+    ASSERT_EQ(packets.size(), 2);
+    EXPECT_EQ(packets[0].command, Command::Invalid);
+    EXPECT_EQ(packets[1].data.packetData.id, 0x70A);
+}
+
+TEST(RxBuffer, DiscardsAFullBufferWithoutTerminator)
+{
+    RxBuffer          buffer;
+    const std::string garbage(RxBuffer::s_capacity, 'x');
+    EXPECT_TRUE(Feed(buffer, garbage).empty());
+    EXPECT_EQ(buffer.discarded(), RxBuffer::s_capacity);
+    EXPECT_EQ(buffer.pending(), 0);
+
+    auto packets = Feed(buffer, "t70A105\r");
+    ASSERT_EQ(packets.size(), 1);
+}
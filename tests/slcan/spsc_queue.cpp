@@ -0,0 +1,64 @@
+/**
+ * @file    spsc_queue.cpp
+ * @brief   Unit tests for Frasy::SlCan::SpscQueue.
+ */
+#include <gtest/gtest.h>
+#include <utils/communication/slcan/spsc_queue.h>
+
+#include <cstdint>
+#include <thread>
+
+using Frasy::SlCan::SpscQueue;
+
+TEST(SpscQueue, PopsInPushOrder)
+{
+    SpscQueue<int, 8> queue;
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_TRUE(queue.push(i));
+    }
+    EXPECT_EQ(queue.size(), 5);
+    int item = 0;
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_TRUE(queue.pop(item));
+        EXPECT_EQ(item, i);
+    }
+    EXPECT_FALSE(queue.pop(item));
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(SpscQueue, RefusesPushesWhenFull)
+{
+    SpscQueue<int, 4> queue;
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(queue.push(i));
+    }
+    EXPECT_FALSE(queue.push(4));
+
+    int item = 0;
+    ASSERT_TRUE(queue.pop(item));
+    EXPECT_TRUE(queue.push(4));
+    for (int i = 1; i <= 4; ++i) {
+        ASSERT_TRUE(queue.pop(item));
+        EXPECT_EQ(item, i);
+    }
+}
+
+TEST(SpscQueue, WaitPopGetsEveryItemFromAnotherThread)
+{
+    constexpr std::uint32_t       count = 100'000;
+    SpscQueue<std::uint32_t, 64> queue;
+    std::thread                   producer([&] {
+        for (std::uint32_t i = 0; i < count; ++i) {
+            while (!queue.push(i)) {
+                queue.notify();
+                std::this_thread::yield();
+            }
+            if (i % 16 == 0) { queue.notify(); }
+        }
+        queue.notify();
+    });
+    for (std::uint32_t i = 0; i < count; ++i) {
+        ASSERT_EQ(queue.waitPop(), i);
+    }
+    producer.join();
+}
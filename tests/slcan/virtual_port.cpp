@@ -0,0 +1,105 @@
+/**
+ * @file    virtual_port.cpp
+ * @brief   Unit tests for Frasy::SlCan::VirtualPort and Frasy::SlCan::VirtualBus.
+ */
+#include <gtest/gtest.h>
+#include <utils/communication/slcan/virtual_port.h>
+
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+
+using namespace std::chrono_literals;
+using Frasy::SlCan::VirtualBus;
+using Frasy::SlCan::VirtualPort;
+
+namespace {
+void Write(VirtualPort& port, std::string_view bytes)
+{
+    EXPECT_EQ(port.write(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size()), bytes.size());
+}
+
+std::string Read(VirtualPort& port)
+{
+    uint8_t    buffer[256] = {};
+    const auto count       = port.read(&buffer[0], sizeof(buffer));
+    return std::string {reinterpret_cast<const char*>(&buffer[0]), count};
+}
+}    // namespace
+
+TEST(VirtualPort, RecognizesVirtualPortNames)
+{
+    EXPECT_TRUE(VirtualPort::isVirtual("virtual:fixture"));
+    EXPECT_FALSE(VirtualPort::isVirtual("COM3"));
+    EXPECT_EQ(VirtualPort::busName("virtual:fixture"), "fixture");
+}
+
+TEST(VirtualPort, SharesBusesByName)
+{
+    auto bus = VirtualBus::get("shared");
+    EXPECT_EQ(VirtualBus::get("shared"), bus);
+    EXPECT_NE(VirtualBus::get("other"), bus);
+}
+
+TEST(VirtualPort, CarriesFramesBetweenPorts)
+{
+    auto        bus = std::make_shared<VirtualBus>("test");
+    VirtualPort a {bus, 10ms};
+    VirtualPort b {bus, 10ms};
+
+    Write(a, "t70A105\rt58A84B00100000000000\r");
+    EXPECT_EQ(Read(b), "t70A105\rt58A84B00100000000000\r");
+    EXPECT_EQ(Read(a), "");    // A port doesn't receive its own frames.
+    EXPECT_EQ(bus->framesSent(), 2);
+}
+
+TEST(VirtualPort, AcknowledgesConfigurationCommands)
+{
+    auto        bus = std::make_shared<VirtualBus>("test");
+    VirtualPort port {bus, 10ms};
+    Write(port, "S8\rO\r");
+    EXPECT_EQ(Read(port), "\r\r");
+    EXPECT_EQ(bus->framesSent(), 0);
+}
+
+TEST(VirtualPort, CancelUnblocksARead)
+{
+    auto        bus = std::make_shared<VirtualBus>("test");
+    VirtualPort port {bus, 10s};
+
+    std::jthread reader {[&] { EXPECT_EQ(Read(port), ""); }};
+    std::this_thread::sleep_for(20ms);
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_TRUE(port.cancel(reader));
+    reader.join();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 1s);
+}
+
+TEST(VirtualPort, CloseUnblocksARead)
+{
+    auto        bus = std::make_shared<VirtualBus>("test");
+    VirtualPort port {bus, 10s};
+
+    std::jthread reader {[&] { EXPECT_THROW(Read(port), std::runtime_error); }};
+    std::this_thread::sleep_for(20ms);
+    port.close();
+    reader.join();
+    EXPECT_FALSE(port.isOpen());
+    EXPECT_THROW(Write(port, "O\r"), std::runtime_error);
+}
+
+TEST(VirtualPort, DropsFramesWhenNotRead)
+{
+    auto        bus = std::make_shared<VirtualBus>("test");
+    VirtualPort sender {bus, 10ms};
+    VirtualPort receiver {bus, 10ms};
+
+    // "t1238" and 16 digits and '\r', 22 bytes per frame.
+    const std::size_t frames = VirtualPort::s_rxCapacity / 22 + 10;
+    for (std::size_t i = 0; i < frames; ++i) {
+        Write(sender, "t12380011223344556677\r");
+    }
+    EXPECT_EQ(receiver.droppedFrames(), frames - VirtualPort::s_rxCapacity / 22);
+}
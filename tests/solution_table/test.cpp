@@ -0,0 +1,127 @@
+#include "orchestrator_test_fixture.h"
+
+#include <gtest/gtest.h>
+#include <utils/lua/solution_table.h>
+
+using Frasy::Lua::SolutionFromTable;
+using Frasy::Lua::SolutionToTable;
+using Frasy::Models::Solution;
+
+class SolutionTableTest : public OrchestratorTestFixture
+{
+protected:
+    sol::table generate()
+    {
+        return lua.script("return Orchestrator.Generate()").get<sol::table>();
+    }
+
+    /// Flatten the solution currently held by the Lua context into "section:sequence:test" entries
+    std::vector<std::string> flattenContext()
+    {
+        return lua.script(R"(
+            local flat = {}
+            for is, section in ipairs(Context.orchestrator.solution) do
+                for _, stage in ipairs(section) do
+                    for _, seq in ipairs(stage) do
+                        for _, tstage in ipairs(seq.tests) do
+                            for _, t in ipairs(tstage) do
+                                table.insert(flat, is .. ":" .. seq.name .. ":" .. t)
+                            end
+                        end
+                    end
+                end
+            end
+            return flat
+        )").get<std::vector<std::string>>();
+    }
+};
+
+TEST_F(SolutionTableTest, EmptySolution)
+{
+    Solution solution = SolutionFromTable(lua.create_table());
+    EXPECT_TRUE(solution.sections.empty());
+    EXPECT_TRUE(solution.sequences.empty());
+
+    sol::table table = SolutionToTable(lua, solution);
+    EXPECT_EQ(table.size(), 0);
+}
+
+TEST_F(SolutionTableTest, FromGeneratedTable)
+{
+    lua.script(R"(
+        Sequence("Init", function()
+            Test("Setup", function() end)
+        end)
+        Sequence("Run", function()
+            Requires(Sequence("Init"):ToPass())
+            Test("T1", function() end)
+            Test("T2", function()
+                Requires(Test("T1"):ToPass())
+            end)
+        end)
+    )");
+    Solution solution = SolutionFromTable(generate());
+
+    ASSERT_EQ(solution.sections.size(), 1);
+    std::vector<std::string> sequences;
+    for (const auto& stage : solution.sections[0]) {
+        for (const auto& sequence : stage) { sequences.push_back(sequence.first); }
+    }
+    EXPECT_EQ(sequences, (std::vector<std::string> {"Init", "Run"}));
+
+    ASSERT_EQ(solution.sequences.size(), 2);
+    EXPECT_TRUE(solution.sequences.at("Init").tests.contains("Setup"));
+    EXPECT_TRUE(solution.sequences.at("Run").tests.contains("T1"));
+    EXPECT_TRUE(solution.sequences.at("Run").tests.contains("T2"));
+}
+
+TEST_F(SolutionTableTest, SameSequenceInSeveralSections)
+{
+    lua.script(R"(
+        Sequence("Seq", function()
+            Test("Before", function()
+                Sync()
+            end)
+            Test("After", function() end)
+        end)
+    )");
+    Solution solution = SolutionFromTable(generate());
+
+    EXPECT_GT(solution.sections.size(), 1);
+    ASSERT_EQ(solution.sequences.size(), 1);
+    EXPECT_EQ(solution.sequences.at("Seq").tests.size(), 2);
+}
+
+TEST_F(SolutionTableTest, RoundTripMatchesGeneratedSolution)
+{
+    lua.script(R"(
+        Sequence("A", function()
+            Test("T1", function() end)
+            Test("T2", function()
+                Sync()
+            end)
+            Test("T3", function() end)
+        end)
+        Sequence("B", function()
+            Requires(Sequence("A"):ToPass())
+            Test("T1", function() end)
+        end)
+    )");
+    Solution solution  = SolutionFromTable(generate());
+    auto     generated = flattenContext();
+
+    lua.script("Context.orchestrator.solution = {}");
+    lua["Orchestrator"]["SetSolution"](SolutionToTable(lua, solution));
+    EXPECT_EQ(flattenContext(), generated);
+    EXPECT_FALSE(generated.empty());
+}
+
+TEST_F(SolutionTableTest, InvalidLayoutThrows)
+{
+    EXPECT_THROW(SolutionFromTable(lua.script("return { 'not a section' }").get<sol::table>()), sol::error);
+    EXPECT_THROW(SolutionFromTable(lua.script("return { { { { tests = {} } } } }").get<sol::table>()), sol::error);
+    EXPECT_THROW(SolutionFromTable(lua.script("return { { { { name = 'Seq' } } } }").get<sol::table>()), sol::error);
+    EXPECT_THROW(
+      SolutionFromTable(lua.script("return { { { { name = 'Seq', tests = { { 42 } } } } } }").get<sol::table>()),
+      sol::error);
+}
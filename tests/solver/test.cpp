@@ -0,0 +1,148 @@
+/**
+ * @file    test.cpp
+ * @brief   Unit tests for Frasy::Models::Solver.
+ *
+ * The Lua side (Sort.SortScopes, Sort.Sectionize, Sort.CombineSectionized) is covered by tests/sort_utils and
+ * tests/orchestrator_generate, these tests check the exact layout of the output.
+ */
+#include <gtest/gtest.h>
+#include <utils/models/solver.h>
+
+using namespace Frasy::Models::Solver;
+using Frasy::Models::Solution;
+
+// =============================================================================
+// SortScopes
+// =============================================================================
+
+TEST(SolverSortScopes, Empty)
+{ EXPECT_TRUE(SortScopes({}, std::nullopt, std::nullopt, {}).empty()); }
+
+TEST(SolverSortScopes, LayersKeepTheOrderOfTheScopes)
+{
+    const Dependencies dependencies = {{"B", {"D"}}, {"C", {"D"}}};
+    EXPECT_EQ(SortScopes({"C", "A", "D", "B"}, std::nullopt, std::nullopt, dependencies),
+              (Layers {{"A", "D"}, {"C", "B"}}));
+}
+
+TEST(SolverSortScopes, Chain)
+{
+    const Dependencies dependencies = {{"A", {"B"}}, {"B", {"C"}}};
+    EXPECT_EQ(SortScopes({"A", "B", "C"}, std::nullopt, std::nullopt, dependencies), (Layers {{"C"}, {"B"}, {"A"}}));
+}
+
+TEST(SolverSortScopes, LayerHoldsEveryScopeWhoseDependenciesAreMet)
+{
+    // D only depends on A, it runs alongside B even though C also waits on B.
+    const Dependencies dependencies = {{"B", {"A"}}, {"C", {"B"}}, {"D", {"A"}}};
+    EXPECT_EQ(SortScopes({"A", "B", "C", "D"}, std::nullopt, std::nullopt, dependencies),
+              (Layers {{"A"}, {"B", "D"}, {"C"}}));
+}
+
+TEST(SolverSortScopes, UnknownDependenciesAreMet)
+{
+    const Dependencies dependencies = {{"A", {"Unknown"}}};
+    EXPECT_EQ(SortScopes({"A", "B"}, std::nullopt, std::nullopt, dependencies), (Layers {{"A", "B"}}));
+}
+
+TEST(SolverSortScopes, FirstAndLast)
+{
+    const Dependencies dependencies = {{"B", {"A", "D"}}};
+    EXPECT_EQ(SortScopes({"A", "B", "C", "D"}, "A", "D", dependencies), (Layers {{"A"}, {"B", "C"}, {"D"}}));
+}
+
+TEST(SolverSortScopes, FirstAndLastAreAlwaysPlaced)
+{ EXPECT_EQ(SortScopes({"B"}, "A", "C", {}), (Layers {{"A"}, {"B"}, {"C"}})); }
+
+TEST(SolverSortScopes, CircularDependenciesThrow)
+{
+    const Dependencies dependencies = {{"A", {"B"}}, {"B", {"A"}}};
+    EXPECT_THROW(SortScopes({"A", "B", "C"}, std::nullopt, std::nullopt, dependencies), InvalidRequirement);
+}
+
+TEST(SolverSortScopes, SelfDependencyThrows)
+{
+    const Dependencies dependencies = {{"A", {"A"}}};
+    EXPECT_THROW(SortScopes({"A"}, std::nullopt, std::nullopt, dependencies), InvalidRequirement);
+}
+
+TEST(SolverSortScopes, LargeProduct)
+{
+    std::vector<std::string> scopes;
+    Dependencies             dependencies;
+    for (int i = 0; i < 10000; ++i) {
+        scopes.push_back(std::to_string(i));
+        if (i != 0) { dependencies[scopes.back()] = {std::to_string(i / 2)}; }
+    }
+    auto layers = SortScopes(scopes, std::nullopt, std::nullopt, dependencies);
+    // Scope i runs after i / 2, i.e. in layer floor(log2(i)) + 1.
+    ASSERT_EQ(layers.size(), 15);
+    EXPECT_EQ(layers[0], (Layer {"0"}));
+    EXPECT_EQ(layers[1], (Layer {"1"}));
+    EXPECT_EQ(layers[2], (Layer {"2", "3"}));
+    EXPECT_EQ(layers[3], (Layer {"4", "5", "6", "7"}));
+    EXPECT_EQ(layers[14].size(), 10000 - 8192);
+}
+
+// =============================================================================
+// Sectionize
+// =============================================================================
+
+TEST(SolverSectionize, NoSynchronizedScope)
+{
+    const Layers stages = {{"A", "B"}, {"C"}};
+    EXPECT_EQ(Sectionize(stages, {}), (Sections {stages}));
+}
+
+TEST(SolverSectionize, SynchronizedScopeGetsItsOwnSection)
+{
+    EXPECT_EQ(Sectionize({{"A", "B"}, {"C"}}, {"B"}), (Sections {{{"A"}}, {{"B"}}, {{"C"}}}));
+}
+
+TEST(SolverSectionize, SynchronizedScopesOfTheSameLayer)
+{
+    EXPECT_EQ(Sectionize({{"A", "B", "C"}, {"D"}}, {"A", "C"}),
+              (Sections {{{"B"}}, {{"A"}}, {{"C"}}, {{"D"}}}));
+}
+
+TEST(SolverSectionize, FirstLayerSynchronized)
+{ EXPECT_EQ(Sectionize({{"A"}, {"B"}}, {"A"}), (Sections {{{"A"}}, {{"B"}}})); }
+
+// =============================================================================
+// CombineSectionized
+// =============================================================================
+
+TEST(SolverCombineSectionized, SingleSectionOfTests)
+{
+    const Sections                                  sequences = {{{"S1", "S2"}}};
+    const std::unordered_map<std::string, Sections> tests     = {
+      {"S1", {{{"T1", "T2"}}}},
+      {"S2", {{{"T1"}, {"T2"}}}},
+    };
+    const std::vector<Solution::section> expected = {{{{"S1", {{"T1", "T2"}}}, {"S2", {{"T1"}, {"T2"}}}}}};
+    EXPECT_EQ(CombineSectionized(sequences, tests), expected);
+}
+
+TEST(SolverCombineSectionized, MultipleSectionsOfTestsSplitTheSolution)
+{
+    const Sections                                  sequences = {{{"S1", "S2"}, {"S3"}}};
+    const std::unordered_map<std::string, Sections> tests     = {
+      {"S1", {{{"T1"}}}},
+      {"S2", {{{"T1"}}, {{"T2"}}}},
+      {"S3", {{{"T1"}}}},
+    };
+    const std::vector<Solution::section> expected = {
+      {{{"S1", {{"T1"}}}, {"S2", {{"T1"}}}}},
+      {{{"S2", {{"T2"}}}}},
+      {{{"S3", {{"T1"}}}}},
+    };
+    EXPECT_EQ(CombineSectionized(sequences, tests), expected);
+}
+
+TEST(SolverCombineSectionized, SequenceWithoutTestsIsDropped)
+{
+    const Sections                                  sequences = {{{"S1", "S2"}}};
+    const std::unordered_map<std::string, Sections> tests     = {{"S1", {}}, {"S2", {{{"T1"}}}}};
+    const std::vector<Solution::section>            expected  = {{{{"S2", {{"T1"}}}}}};
+    EXPECT_EQ(CombineSectionized(sequences, tests), expected);
+}
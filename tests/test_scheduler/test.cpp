@@ -0,0 +1,268 @@
+/**
+ * @file    test.cpp
+ * @brief   Unit tests for the concurrent execution of the tests of a stage.
+ *
+ * Time is virtual: __now() returns a counter that only SleepFor advances, so the expected interleaving and the total
+ * duration of a stage are exact.
+ */
+#include "orchestrator_test_fixture.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+class TestSchedulerTest : public OrchestratorTestFixture
+{
+protected:
+    void SetUp() override
+    {
+        OrchestratorTestFixture::SetUp();
+        lua.open_libraries(sol::lib::os, sol::lib::coroutine);
+        lua.script(R"(
+            TestScheduler = require("lua/core/framework/test_scheduler")
+            __time = 0
+            __log = {}
+            function __now() return __time end
+            function SleepFor(ms) __time = __time + ms end
+            function Trace(what) table.insert(__log, what) end
+        )");
+    }
+
+    std::vector<std::string> log() { return lua["__log"].get<std::vector<std::string>>(); }
+    int                      elapsed() { return lua["__time"].get<int>(); }
+};
+
+// =============================================================================
+// TestScheduler.Run
+// =============================================================================
+
+TEST_F(TestSchedulerTest, DisjointTasksInterleave)
+{
+    lua.script(R"(
+        TestScheduler.Run({
+            { resources = { DAQ = true }, run = function() Trace("A1") SleepFor(10) Trace("A2") end },
+            { resources = { PIO = true }, run = function() Trace("B1") SleepFor(10) Trace("B2") end },
+        }, __now)
+    )");
+    EXPECT_EQ(log(), (std::vector<std::string> {"A1", "B1", "A2", "B2"}));
+    EXPECT_EQ(elapsed(), 10);
+}
+
+TEST_F(TestSchedulerTest, ShortestSleepWakesUpFirst)
+{
+    lua.script(R"(
+        TestScheduler.Run({
+            { resources = { DAQ = true }, run = function() SleepFor(30) Trace("A") end },
+            { resources = { PIO = true }, run = function() SleepFor(10) Trace("B") SleepFor(10) Trace("B") end },
+        }, __now)
+    )");
+    EXPECT_EQ(log(), (std::vector<std::string> {"B", "B", "A"}));
+    EXPECT_EQ(elapsed(), 30);
+}
+
+TEST_F(TestSchedulerTest, TasksSharingAResourceRunOneAfterTheOther)
+{
+    lua.script(R"(
+        TestScheduler.Run({
+            { resources = { DAQ = true }, run = function() Trace("A1") SleepFor(10) Trace("A2") end },
+            { resources = { DAQ = true, PIO = true }, run = function() Trace("B1") SleepFor(10) Trace("B2") end },
+        }, __now)
+    )");
+    EXPECT_EQ(log(), (std::vector<std::string> {"A1", "A2", "B1", "B2"}));
+    EXPECT_EQ(elapsed(), 20);
+}
+
+TEST_F(TestSchedulerTest, TaskWithoutResourcesRunsAlone)
+{
+    lua.script(R"(
+        TestScheduler.Run({
+            { resources = { DAQ = true }, run = function() Trace("A1") SleepFor(10) Trace("A2") end },
+            { run = function() Trace("U1") SleepFor(10) Trace("U2") end },
+            { resources = { PIO = true }, run = function() Trace("B1") SleepFor(10) Trace("B2") end },
+        }, __now)
+    )");
+    EXPECT_EQ(log(), (std::vector<std::string> {"A1", "B1", "A2", "B2", "U1", "U2"}));
+    EXPECT_EQ(elapsed(), 20);
+}
+
+TEST_F(TestSchedulerTest, EmptyResourcesNeverConflict)
+{
+    lua.script(R"(
+        TestScheduler.Run({
+            { resources = {}, run = function() Trace("A1") SleepFor(10) Trace("A2") end },
+            { resources = {}, run = function() Trace("B1") SleepFor(10) Trace("B2") end },
+        }, __now)
+    )");
+    EXPECT_EQ(log(), (std::vector<std::string> {"A1", "B1", "A2", "B2"}));
+}
+
+TEST_F(TestSchedulerTest, EnterIsCalledOnEveryResume)
+{
+    lua.script(R"(
+        __current = nil
+        local function Task(name, resource)
+            return {
+                resources = { [resource] = true },
+                enter = function() __current = name end,
+                run = function() Trace(__current) SleepFor(10) Trace(__current) end,
+            }
+        end
+        TestScheduler.Run({ Task("A", "DAQ"), Task("B", "PIO") }, __now)
+    )");
+    EXPECT_EQ(log(), (std::vector<std::string> {"A", "B", "A", "B"}));
+}
+
+TEST_F(TestSchedulerTest, SleepWithinExclusiveBlocks)
+{
+    // __exclusive calls back into Lua from C++, the task can't yield while it holds the lock.
+    lua.script(R"(
+        TestScheduler.Run({
+            { resources = { DAQ = true }, run = function()
+                Exclusive(1, function() Trace("A1") SleepFor(10) Trace("A2") end)
+            end },
+            { resources = { PIO = true }, run = function() Trace("B1") SleepFor(5) Trace("B2") end },
+        }, __now)
+    )");
+    EXPECT_EQ(log(), (std::vector<std::string> {"A1", "A2", "B1", "B2"}));
+    EXPECT_EQ(elapsed(), 15);
+}
+
+TEST_F(TestSchedulerTest, SleepOutsideOfTheTasksBlocks)
+{
+    lua.script(R"(
+        TestScheduler.Run({
+            { resources = {}, run = function()
+                local co = coroutine.wrap(function() SleepFor(10) Trace("nested") end)
+                co()
+                Trace("A")
+            end },
+        }, __now)
+    )");
+    EXPECT_EQ(log(), (std::vector<std::string> {"nested", "A"}));
+    EXPECT_EQ(elapsed(), 10);
+}
+
+TEST_F(TestSchedulerTest, ErrorStopsNewTasksAndIsRaisedOnceTheOthersAreDone)
+{
+    auto result = lua.safe_script(R"(
+        TestScheduler.Run({
+            { resources = { DAQ = true }, run = function() SleepFor(10) Trace("A") end },
+            { resources = { PIO = true }, run = function() error(GenericError("boom")) end },
+            { resources = { DAQ = true }, run = function() Trace("C") end },
+        }, __now)
+    )",
+                                  sol::script_pass_on_error);
+    ASSERT_FALSE(result.valid());
+    EXPECT_EQ(log(), (std::vector<std::string> {"A"}));
+}
+
+TEST_F(TestSchedulerTest, ErrorKeepsItsValue)
+{
+    lua.script(R"(
+        __status, __err = pcall(TestScheduler.Run, {
+            { resources = {}, run = function() error(GenericError("boom")) end },
+        }, __now)
+    )");
+    EXPECT_FALSE(lua["__status"].get<bool>());
+    EXPECT_EQ(lua.script("return __err.code").get<int>(), lua.script("return GenericError().code").get<int>());
+}
+
+TEST_F(TestSchedulerTest, SleepForIsRestored)
+{
+    lua.script(R"(
+        __sleep = SleepFor
+        TestScheduler.Run({ { resources = {}, run = function() SleepFor(1) end } }, __now)
+        __restored = SleepFor == __sleep
+        pcall(TestScheduler.Run, { { resources = {}, run = function() error("boom") end } }, __now)
+        __restoredAfterError = SleepFor == __sleep
+    )");
+    EXPECT_TRUE(lua["__restored"].get<bool>());
+    EXPECT_TRUE(lua["__restoredAfterError"].get<bool>());
+}
+
+// =============================================================================
+// Orchestrator
+// =============================================================================
+
+class ParallelTestsTest : public TestSchedulerTest
+{
+protected:
+    void SetUp() override
+    {
+        TestSchedulerTest::SetUp();
+        resetOrchestrator();
+        setStage("execution");
+        lua.script(R"(
+            Sequence("Seq", function()
+                Test("Rails", function()
+                    Trace("Rails") SleepFor(100) Expect(1, "rails"):ToBeEqual(1) Trace("Rails")
+                end, { "DAQ" })
+                Test("Inputs", function()
+                    Trace("Inputs") SleepFor(50) Expect(2, "inputs"):ToBeEqual(2) Trace("Inputs")
+                end, "PIO")
+                Test("Leds", function()
+                    Trace("Leds") SleepFor(20) Trace("Leds")
+                end, { "PIO" })
+            end)
+            Context.orchestrator.solution = {
+                { { { name = "Seq", tests = { { "Rails", "Inputs", "Leds" } } } } }
+            }
+        )");
+    }
+
+    void run() { lua.script("Orchestrator.RunSequence(1, require('lua/core/framework/scope'):New('Seq'))"); }
+};
+
+TEST_F(ParallelTestsTest, DisabledByDefault)
+{
+    run();
+    EXPECT_EQ(log(), (std::vector<std::string> {"Rails", "Rails", "Inputs", "Inputs", "Leds", "Leds"}));
+    EXPECT_EQ(elapsed(), 170);
+}
+
+TEST_F(ParallelTestsTest, TestsOnDisjointResourcesRunConcurrently)
+{
+    lua.script("Context.orchestrator.parallel_tests = true");
+    run();
+    EXPECT_EQ(log(), (std::vector<std::string> {"Rails", "Inputs", "Inputs", "Leds", "Leds", "Rails"}));
+    EXPECT_EQ(elapsed(), 100);
+    EXPECT_TRUE(lua.script("return Context.orchestrator.sequences.Seq.result.pass").get<bool>());
+}
+
+TEST_F(ParallelTestsTest, ExpectationsGoToTheirTest)
+{
+    lua.script("Context.orchestrator.parallel_tests = true");
+    run();
+    lua.script(R"(
+        local tests = Context.orchestrator.sequences.Seq.tests
+        __rails = tests.Rails.expectations[1].name
+        __inputs = tests.Inputs.expectations[1].name
+        __leds = #tests.Leds.expectations
+    )");
+    EXPECT_EQ(lua["__rails"].get<std::string>(), "rails");
+    EXPECT_EQ(lua["__inputs"].get<std::string>(), "inputs");
+    EXPECT_EQ(lua["__leds"].get<int>(), 0);
+}
+
+TEST_F(ParallelTestsTest, TeamsRunSequentially)
+{
+    lua.script(R"(
+        Context.orchestrator.parallel_tests = true
+        Team.HasTeam = function() return true end
+    )");
+    run();
+    EXPECT_EQ(log(), (std::vector<std::string> {"Rails", "Rails", "Inputs", "Inputs", "Leds", "Leds"}));
+}
+
+TEST_F(ParallelTestsTest, ResourcesAreKeptAsASet)
+{
+    run();
+    lua.script(R"(
+        local tests = Context.orchestrator.sequences.Seq.tests
+        __rails = tests.Rails.resources.DAQ
+        __inputs = tests.Inputs.resources.PIO
+    )");
+    EXPECT_TRUE(lua["__rails"].get<bool>());
+    EXPECT_TRUE(lua["__inputs"].get<bool>());
+}
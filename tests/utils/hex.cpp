@@ -0,0 +1,109 @@
+/**
+ * @file    hex.cpp
+ * @brief   Unit tests for Frasy::Hex, every instruction set the CPU supports against the scalar one.
+ */
+#include <gtest/gtest.h>
+#include <utils/misc/hex.h>
+
+#include <cstdint>
+#include <initializer_list>
+#include <random>
+#include <string>
+#include <vector>
+
+using Frasy::Hex::Isa;
+
+namespace {
+std::vector<Isa> SupportedIsas()
+{
+    std::vector<Isa> isas;
+    for (auto isa : {Isa::Scalar, Isa::Ssse3, Isa::Avx2}) {
+        if (Frasy::Hex::isSupported(isa)) { isas.push_back(isa); }
+    }
+    return isas;
+}
+
+std::vector<uint8_t> RandomBytes(std::size_t count)
+{
+    static std::mt19937             generator {42};
+    std::uniform_int_distribution<> distribution {0, 255};
+    std::vector<uint8_t>            bytes(count);
+    for (auto& byte : bytes) {
+        byte = static_cast<uint8_t>(distribution(generator));
+    }
+    return bytes;
+}
+
+std::string ToString(const std::vector<uint8_t>& chars)
+{
+    return {chars.begin(), chars.end()};
+}
+}    // namespace
+
+TEST(Hex, ScalarIsAlwaysSupported)
+{
+    EXPECT_TRUE(Frasy::Hex::isSupported(Isa::Scalar));
+    EXPECT_TRUE(Frasy::Hex::isSupported(Frasy::Hex::bestIsa()));
+}
+
+TEST(Hex, EncodeIsUppercase)
+{
+    const std::vector<uint8_t> bytes = {0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0xCD, 0xEF, 0x00, 0xFF};
+    for (auto isa : SupportedIsas()) {
+        std::vector<uint8_t> chars(2 * bytes.size());
+        Frasy::Hex::encode(bytes.data(), bytes.size(), chars.data(), isa);
+        EXPECT_EQ(ToString(chars), "0123456789ABCDEF00FF") << static_cast<int>(isa);
+    }
+}
+
+TEST(Hex, DecodeAcceptsBothCases)
+{
+    const std::string chars = "0123456789abcdefABCDEF00ff";
+    for (auto isa : SupportedIsas()) {
+        std::vector<uint8_t> bytes(chars.size() / 2);
+        ASSERT_TRUE(
+          Frasy::Hex::decode(reinterpret_cast<const uint8_t*>(chars.data()), bytes.size(), bytes.data(), isa));
+        EXPECT_EQ(bytes, (std::vector<uint8_t> {0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0xCD, 0xEF, 0xAB, 0xCD, 0xEF, 0x00,
+                                                0xFF}))
+          << static_cast<int>(isa);
+    }
+}
+
+TEST(Hex, RoundTripOfEverySize)
+{
+    for (std::size_t count = 0; count <= 100; ++count) {
+        const auto           bytes = RandomBytes(count);
+        std::vector<uint8_t> expected(2 * count);
+        Frasy::Hex::encode(bytes.data(), count, expected.data(), Isa::Scalar);
+        for (auto isa : SupportedIsas()) {
+            std::vector<uint8_t> chars(2 * count);
+            Frasy::Hex::encode(bytes.data(), count, chars.data(), isa);
+            EXPECT_EQ(chars, expected) << "count " << count << ", isa " << static_cast<int>(isa);
+
+            std::vector<uint8_t> decoded(count);
+            EXPECT_TRUE(Frasy::Hex::decode(chars.data(), count, decoded.data(), isa));
+            EXPECT_EQ(decoded, bytes) << "count " << count << ", isa " << static_cast<int>(isa);
+        }
+    }
+}
+
+TEST(Hex, InvalidCharacterIsFoundAnywhere)
+{
+    constexpr std::size_t count = 80;
+    // Right next to the valid ranges, and far from them.
+    const std::initializer_list<int> invalidChars = {'/', ':', '@', 'G', '`', 'g', ' ', '\r', 0x00, 0x80, 0xC1, 0xFF};
+    for (auto isa : SupportedIsas()) {
+        for (std::size_t position = 0; position < count; ++position) {
+            for (int invalid : invalidChars) {
+                std::vector<uint8_t> chars(count, 'a');
+                chars[position] = static_cast<uint8_t>(invalid);
+                EXPECT_EQ(Frasy::Hex::findNonHex(chars.data(), count, isa), position);
+                std::vector<uint8_t> bytes(count / 2);
+                EXPECT_FALSE(Frasy::Hex::decode(chars.data(), count / 2, bytes.data(), isa))
+                  << "position " << position << ", char " << invalid;
+            }
+        }
+        std::vector<uint8_t> valid(count, 'F');
+        EXPECT_EQ(Frasy::Hex::findNonHex(valid.data(), count, isa), count);
+    }
+}
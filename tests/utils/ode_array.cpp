@@ -0,0 +1,62 @@
+#include "lua_test_fixture.h"
+
+#include <gtest/gtest.h>
+#include <utils/communication/can_open/types.h>
+#include <utils/lua/ode_deserializer.h>
+
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+// =============================================================================
+// deserializeOdeArray
+// =============================================================================
+
+using Frasy::CanOpen::DataType;
+
+class OdeArrayTest : public LuaTestFixture
+{
+protected:
+    sol::table deserialize(DataType type, std::vector<uint8_t> bytes)
+    {
+        sol::state_view view = lua;
+        return deserializeOdeArray(view, static_cast<uint16_t>(type), bytes);
+    }
+};
+
+TEST_F(OdeArrayTest, Real32)
+{
+    const float          samples[] = {1.5F, -2.25F, 3.0F};
+    std::vector<uint8_t> bytes(sizeof(samples));
+    std::memcpy(bytes.data(), samples, sizeof(samples));
+
+    auto table = deserialize(DataType::real32, bytes);
+    ASSERT_EQ(table.size(), 3);
+    EXPECT_FLOAT_EQ(table.get<float>(1), 1.5F);
+    EXPECT_FLOAT_EQ(table.get<float>(2), -2.25F);
+    EXPECT_FLOAT_EQ(table.get<float>(3), 3.0F);
+}
+
+TEST_F(OdeArrayTest, SignedIntegersAreSignExtended)
+{
+    auto table = deserialize(DataType::integer16, {0xFF, 0xFF, 0x02, 0x00, 0x00, 0x80});
+    ASSERT_EQ(table.size(), 3);
+    EXPECT_EQ(table.get<int64_t>(1), -1);
+    EXPECT_EQ(table.get<int64_t>(2), 2);
+    EXPECT_EQ(table.get<int64_t>(3), -32768);
+}
+
+TEST_F(OdeArrayTest, EmptyBuffer)
+{
+    EXPECT_EQ(deserialize(DataType::unsigned32, {}).size(), 0);
+}
+
+TEST_F(OdeArrayTest, RejectsIncompleteElements)
+{
+    EXPECT_THROW(deserialize(DataType::unsigned32, {1, 2, 3, 4, 5}), std::runtime_error);
+}
+
+TEST_F(OdeArrayTest, RejectsVariableSizedTypes)
+{
+    EXPECT_THROW(deserialize(DataType::visibleString, {'a', 'b'}), std::runtime_error);
+}